@@ -134,6 +134,7 @@
 #define MATSEQSELL         'seqsell'
 #define MATMPISELL         'mpisell'
 #define MATDUMMY           'dummy'
+#define MATAUTO            'auto'
 
 !
 ! MatMFFDType values
@@ -161,6 +162,7 @@
 #define MATSOLVERMATLAB          'matlab'
 #define MATSOLVERPETSC           'petsc'
 #define MATSOLVERBAS             'bas'
+#define MATSOLVERCHOWILU         'chowilu'
 #define MATSOLVERCUSPARSE        'cusparse'
 
 !
@@ -157,6 +157,14 @@ typedef struct {
   IS                   globalVertexNumbers;
   IS                   globalCellNumbers;
 
+  /* Closure dof cache */
+  PetscSection         clDofSection;      /* Size and offset of the closure dofs of each cell */
+  PetscSection         clLocalSection;    /* The local section the cache was built for */
+  PetscSection         clGlobalSection;   /* The global section the cache was built for */
+  PetscInt            *clDofs;            /* Local offsets of the closure dofs with point symmetries applied, -(off+1) for constrained dofs */
+  PetscInt            *clGlobalDofs;      /* Global indices of the closure dofs, as from DMPlexGetClosureIndices(), or NULL if the mesh has anchors */
+  PetscScalar         *clFlips;           /* Orientation flips of the closure dofs, or NULL if there are none */
+
   /* Constraints */
   PetscSection         anchorSection;      /* maps constrained points to anchor points */
   IS                   anchorIS;           /* anchors indexed by the above section */
@@ -240,7 +248,7 @@ PETSC_INTERN PetscErrorCode DMPlexBuildFromCellList_Internal(DM, PetscInt, Petsc
 PETSC_INTERN PetscErrorCode DMPlexBuildFromCellList_Parallel_Internal(DM, PetscInt, PetscInt, PetscInt, PetscInt, const int[], PetscBool, PetscSF *);
 PETSC_INTERN PetscErrorCode DMPlexBuildCoordinates_Internal(DM, PetscInt, PetscInt, PetscInt, const double[]);
 PETSC_INTERN PetscErrorCode DMPlexBuildCoordinates_Parallel_Internal(DM, PetscInt, PetscInt, PetscInt, PetscSF, const PetscReal[]);
-PETSC_INTERN PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM, PetscViewer);
+PETSC_INTERN PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM, PetscSF, PetscViewer);
 PETSC_INTERN PetscErrorCode DMPlexView_HDF5_Internal(DM, PetscViewer);
 PETSC_INTERN PetscErrorCode DMPlexLoad_HDF5_Internal(DM, PetscViewer);
 PETSC_INTERN PetscErrorCode DMPlexLoad_HDF5_Xdmf_Internal(DM, PetscViewer);
@@ -277,6 +285,7 @@ PETSC_EXTERN PetscErrorCode indicesPointFields_private(PetscSection,PetscInt,Pet
 PETSC_INTERN PetscErrorCode DMPlexLocatePoint_Internal(DM,PetscInt,const PetscScalar [],PetscInt,PetscInt *);
 
 PETSC_INTERN PetscErrorCode DMPlexCreateCellNumbering_Internal(DM, PetscBool, IS *);
+PETSC_INTERN PetscErrorCode DMPlexDestroyClosureDofIndex_Internal(DM);
 PETSC_INTERN PetscErrorCode DMPlexCreateVertexNumbering_Internal(DM, PetscBool, IS *);
 PETSC_INTERN PetscErrorCode DMPlexRefine_Internal(DM, DMLabel, DM *);
 PETSC_INTERN PetscErrorCode DMPlexCoarsen_Internal(DM, DMLabel, DM *);
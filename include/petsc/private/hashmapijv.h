@@ -0,0 +1,44 @@
+#if !defined(_PETSC_HASHMAPIJV_H)
+#define _PETSC_HASHMAPIJV_H
+
+#include <petsc/private/hashmap.h>
+
+#if !defined(_PETSC_HASHIJKEY)
+#define _PETSC_HASHIJKEY
+typedef struct _PetscHashIJKey { PetscInt i, j; } PetscHashIJKey;
+#define PetscHashIJKeyHash(key) PetscHashCombine(PetscHashInt((key).i),PetscHashInt((key).j))
+#define PetscHashIJKeyEqual(k1,k2) (((k1).i == (k2).i) ? ((k1).j == (k2).j) : 0)
+#endif
+
+/* Nearby columns of the same row hash to nearby buckets, which keeps row-wise insertion cache friendly */
+#define PetscHashIJVKeyHash(key) (PetscHashInt((key).i) + (PetscHash_t)(key).j)
+PETSC_HASH_MAP(HMapIJV, PetscHashIJKey, PetscScalar, PetscHashIJVKeyHash, PetscHashIJKeyEqual, -1)
+
+/*
+  PetscHMapIJVQueryAdd - Add a value to the value of a key in the hash table, inserting the (key,value) entry if the key is missing
+
+  Input Parameters:
++ ht  - The hash table
+. key - The key
+- val - The value to add
+
+  Output Parameter:
+. missing - PETSC_TRUE if the key was not present in the table
+*/
+PETSC_STATIC_INLINE PETSC_UNUSED
+PetscErrorCode PetscHMapIJVQueryAdd(PetscHMapIJV ht,PetscHashIJKey key,PetscScalar val,PetscBool *missing)
+{
+  int      ret;
+  khiter_t iter;
+  PetscFunctionBeginHot;
+  PetscValidPointer(ht,1);
+  PetscValidPointer(missing,3);
+  iter = kh_put(HMapIJV,ht,key,&ret);
+  PetscHashAssert(ret>=0);
+  if (ret) kh_val(ht,iter) = val;
+  else     kh_val(ht,iter) += val;
+  *missing = ret ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+#endif /* _PETSC_HASHMAPIJV_H */
@@ -0,0 +1,30 @@
+#if !defined(_PETSC_HASHMAPIV_H)
+#define _PETSC_HASHMAPIV_H
+
+#include <petsc/private/hashmap.h>
+
+PETSC_HASH_MAP(HMapIV, PetscInt, PetscScalar, PetscHashInt, PetscHashEqual, -1)
+
+/*
+  PetscHMapIVAddValue - Add a value to the value of a key in the hash table, inserting the (key,value) entry if the key is missing
+
+  Input Parameters:
++ ht  - The hash table
+. key - The key
+- val - The value to add
+*/
+PETSC_STATIC_INLINE PETSC_UNUSED
+PetscErrorCode PetscHMapIVAddValue(PetscHMapIV ht,PetscInt key,PetscScalar val)
+{
+  int      ret;
+  khiter_t iter;
+  PetscFunctionBeginHot;
+  PetscValidPointer(ht,1);
+  iter = kh_put(HMapIV,ht,key,&ret);
+  PetscHashAssert(ret>=0);
+  if (ret) kh_val(ht,iter) = val;
+  else     kh_val(ht,iter) += val;
+  PetscFunctionReturn(0);
+}
+
+#endif /* _PETSC_HASHMAPIV_H */
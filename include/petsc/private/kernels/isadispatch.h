@@ -0,0 +1,55 @@
+
+/*
+    Support for building SIMD kernels for several x86 instruction sets into the same library and
+  selecting among them at run time, see MatGetKernelISA_Private().
+
+    With GNU compatible compilers each kernel is compiled with __attribute__((target())), so the
+  AVX, AVX2 and AVX-512 variants are always available regardless of the -march flags used to build
+  PETSc, and the processor is queried with __builtin_cpu_supports(). With other compilers only the
+  instruction sets enabled at compile time are available.
+
+    The kernels gather double precision values with 32 bit indices, hence they are only available
+  for real double precision builds with 32 bit PetscInt.
+*/
+#if !defined(__ISADISPATCH_H)
+#define __ISADISPATCH_H
+
+#include <petscsys.h>
+
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PETSC_HAVE_KERNEL_ISA_RUNTIME_DISPATCH 1
+#define PETSC_HAVE_KERNEL_AVX    1
+#define PETSC_HAVE_KERNEL_AVX2   1
+#define PETSC_HAVE_KERNEL_AVX512 1
+#define PETSC_KERNEL_TARGET_AVX    __attribute__((target("avx")))
+#define PETSC_KERNEL_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define PETSC_KERNEL_TARGET_AVX512 __attribute__((target("avx2,fma,avx512f")))
+#else
+#if defined(__AVX__)
+#define PETSC_HAVE_KERNEL_AVX    1
+#define PETSC_KERNEL_TARGET_AVX
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#define PETSC_HAVE_KERNEL_AVX2   1
+#define PETSC_KERNEL_TARGET_AVX2
+#endif
+#if defined(__AVX512F__)
+#define PETSC_HAVE_KERNEL_AVX512 1
+#define PETSC_KERNEL_TARGET_AVX512
+#endif
+#endif
+#endif
+
+#if defined(PETSC_HAVE_KERNEL_AVX)
+#include <immintrin.h>
+
+#if !defined(_MM_SCALE_8)
+#define _MM_SCALE_8    8
+#endif
+#if !defined(_MM_SCALE_4)
+#define _MM_SCALE_4    4
+#endif
+#endif
+
+#endif
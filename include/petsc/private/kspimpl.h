@@ -182,6 +182,34 @@ PETSC_STATIC_INLINE PetscErrorCode KSPLogResidualHistory(KSP ksp,PetscReal norm)
 PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP,PetscBool,KSPNormType*,PCSide*);
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP,PetscInt,const PetscReal*,const PetscReal*);
+PETSC_INTERN PetscErrorCode KSPChebyshevEstEigBatched_Private(PetscInt,KSP[]);
+
+/*
+   Polynomial basis used by the s-step (communication avoiding) Krylov methods to generate s basis vectors
+   with the matrix powers kernel,
+
+       w_{i+1} = alpha_i (Op w_i - theta_i w_i - sigma_i w_{i-1}),   i = 0,...,s-1,  sigma_0 = 0
+
+   so that Op [w_0 ... w_{s-1}] = [w_0 ... w_s] B where B is the (s+1) x s tridiagonal change of basis matrix with
+   B(i+1,i) = 1/alpha_i, B(i,i) = theta_i and B(i-1,i) = sigma_i
+*/
+typedef enum {KSP_SSTEP_BASIS_MONOMIAL,KSP_SSTEP_BASIS_NEWTON,KSP_SSTEP_BASIS_CHEBYSHEV} KSPSStepBasisType;
+PETSC_INTERN const char *const KSPSStepBasisTypes[];
+
+typedef struct {
+  KSPSStepBasisType type;
+  PetscInt          s;
+  PetscReal         *alpha;
+  PetscScalar       *theta,*sigma;
+  PetscBool         spectrum;          /* the basis has been built from Ritz values, otherwise it is the unscaled monomial basis */
+} KSPSStepBasis;
+
+PETSC_INTERN PetscErrorCode KSPSStepBasisSetUp_Private(KSPSStepBasis*,PetscInt);
+PETSC_INTERN PetscErrorCode KSPSStepBasisReset_Private(KSPSStepBasis*);
+PETSC_INTERN PetscErrorCode KSPSStepBasisSetMonomial_Private(KSPSStepBasis*);
+PETSC_INTERN PetscErrorCode KSPSStepBasisSetSpectrum_Private(KSPSStepBasis*,PetscInt,const PetscScalar*,PetscInt);
+PETSC_INTERN PetscErrorCode KSPSStepBasisAdvance_Private(KSPSStepBasis*,PetscInt,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode KSPSStepBasisView_Private(KSPSStepBasis*,PetscViewer);
 
 typedef struct _p_DMKSP *DMKSP;
 typedef struct _DMKSPOps *DMKSPOps;
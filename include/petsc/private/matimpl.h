@@ -402,6 +402,7 @@ struct _p_Mat {
   void                   *spptr;          /* pointer for special library like SuperLU */
   char                   *solvertype;
   PetscBool              checksymmetryonassembly,checknullspaceonassembly;
+  PetscBool              autotune;          /* select the fastest format for MatMult() at the next final assembly */
   PetscReal              checksymmetrytol;
   Mat                    schur;             /* Schur complement matrix */
   MatFactorSchurStatus   schur_status;      /* status of the Schur complement matrix */
@@ -641,6 +642,40 @@ typedef struct { /* used by MatCreateSubMatrices_MPIAIJ_SingleIS_Local() and Mat
   PetscErrorCode (*destroy)(Mat);
 } Mat_SubSppt;
 
+/*
+    Instruction sets for which some of the sequential formats provide matrix-vector product kernels,
+  selected at run time (see include/petsc/private/kernels/isadispatch.h)
+*/
+typedef enum {MAT_KERNEL_SCALAR,MAT_KERNEL_AVX,MAT_KERNEL_AVX2,MAT_KERNEL_AVX512} MatKernelISA;
+PETSC_INTERN const char *const MatKernelISAs[];
+PETSC_INTERN PetscErrorCode MatGetKernelISA_Private(Mat,MatKernelISA*);
+PETSC_INTERN PetscErrorCode MatKernelISAView_Private(Mat,MatKernelISA,const char[]);
+PETSC_INTERN PetscErrorCode MatAutotune_Private(Mat);
+PETSC_INTERN PetscErrorCode MatCOOSortEntries_Private(PetscInt,PetscInt,const PetscInt[],const PetscInt[],PetscInt**,PetscInt**,PetscInt**,PetscInt**);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_Basic(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_Basic(Mat,const PetscScalar[],InsertMode);
+
+/*
+    Multicolor ordering of the (block) rows of a sequential matrix for thread-parallel MatSOR(), see MatSORSetMulticolor()
+*/
+typedef struct {
+  PetscInt         nthreads;            /* threads sharing the rows of each color, 0 if MatSOR() sweeps the rows in their natural order */
+  PetscBool        valid;               /* no two coupled rows have the same color */
+  PetscInt         bs;                  /* block size of the entries */
+  PetscInt         ncolors;
+  PetscInt         *cstart;             /* rows of color c are at positions cstart[c] to cstart[c+1]-1 */
+  PetscInt         *rows;               /* (block) row at each position */
+  PetscInt         *i,*j;               /* off-diagonal (block) entries of the row at each position */
+  MatScalar        *a;
+  PetscScalar      *work;               /* one block of work space per thread */
+  PetscObjectState nonzerostate,state;  /* states of the matrix when it was colored and when its entries were copied */
+} MatSORMulticolor;
+
+PETSC_INTERN PetscErrorCode MatSORMulticolorSetUp_Private(Mat,PetscInt,PetscInt,const PetscInt[],const PetscInt[],const MatScalar[],MatSORMulticolor*);
+PETSC_INTERN PetscErrorCode MatSORMulticolorApply_Private(const MatSORMulticolor*,PetscReal,MatSORType,PetscInt,const MatScalar[],const PetscScalar[],PetscScalar[]);
+PETSC_INTERN PetscErrorCode MatSORMulticolorReset_Private(MatSORMulticolor*);
+PETSC_INTERN PetscErrorCode MatSORMulticolorSetNumThreads_Private(Mat,PetscInt,MatSORMulticolor*);
+
 PETSC_EXTERN PetscErrorCode MatFactorDumpMatrix(Mat);
 PETSC_INTERN PetscErrorCode MatShift_Basic(Mat,PetscScalar);
 PETSC_INTERN PetscErrorCode MatSetBlockSizes_Default(Mat,PetscInt,PetscInt);
@@ -1694,6 +1729,8 @@ PETSC_EXTERN PetscLogEvent MATMFFD_Mult;
 PETSC_EXTERN PetscLogEvent MAT_GetMultiProcBlock;
 PETSC_EXTERN PetscLogEvent MAT_CUSPARSECopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_SetValuesBatch;
+PETSC_EXTERN PetscLogEvent MAT_PreallCOO;
+PETSC_EXTERN PetscLogEvent MAT_SetVCOO;
 PETSC_EXTERN PetscLogEvent MAT_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_Merge;
 PETSC_EXTERN PetscLogEvent MAT_Residual;
@@ -9,6 +9,7 @@ struct _PCGAMGOps {
   PetscErrorCode (*coarsen)(PC, Mat*, PetscCoarsenData**);
   PetscErrorCode (*prolongator)(PC, Mat, Mat, PetscCoarsenData*, Mat*);
   PetscErrorCode (*optprolongator)(PC, Mat, Mat*);
+  PetscErrorCode (*optprolongatornumeric)(PC, Mat, Mat, Mat); /* recomputes the values of an optimized prolongator from the tentative one */
   PetscErrorCode (*createlevel)(PC, Mat, PetscInt, Mat *, Mat *, PetscMPIInt *, IS *, PetscBool);
   PetscErrorCode (*createdefaultdata)(PC, Mat); /* for data methods that have a default (SA) */
   PetscErrorCode (*setfromoptions)(PetscOptionItems*,PC);
@@ -23,6 +24,8 @@ typedef struct gamg_TAG {
   PetscInt  setup_count;
   PetscBool repart;
   PetscBool reuse_prol;
+  PetscBool reuse_aggs;
+  PetscBool coarse_ptap;   /* the coarse operators were computed by MatPtAP() with the current interpolations */
   PetscBool use_aggs_in_asm;
   PetscBool use_parallel_coarse_grid_solver;
   PetscInt  min_eq_proc;
@@ -40,6 +43,12 @@ typedef struct gamg_TAG {
   PetscReal *data;          /* [data_sz] blocked vector of vertex data on fine grid (coordinates/nullspace) */
   PetscReal *orig_data;          /* cache data */
 
+  /* kept when reuse_aggs is set, indexed like the interpolations of PCSetUp_GAMG() (0 is the finest level) */
+  PetscObjectState nonzerostate;                 /* nonzero state of the fine grid matrix */
+  Mat       Ptent[PETSC_GAMG_MAXLEVELS];         /* tentative prolongators from level i to level i-1 */
+  Mat       Psmooth[PETSC_GAMG_MAXLEVELS];       /* optimized prolongators, before the permutation of their columns */
+  IS        Pcolperm[PETSC_GAMG_MAXLEVELS];      /* columns of Psmooth[] kept by the repartitioning, NULL if none */
+
   struct _PCGAMGOps *ops;
   char *gamg_type_name;
 
@@ -27,6 +27,8 @@ typedef struct {
   Mat           restrct;                       /* restrict is a reserved word in C99 and on Cray */
   Mat           inject;                        /* Used for moving state if provided. */
   Vec           rscale;                        /* scaling of restriction matrix */
+  PC            agglomerate;                   /* PCTELESCOPE applying this level and the coarser ones on fewer processes */
+  Vec           aggwork;                       /* work vector for the later cycles through the agglomerated levels */
   PetscLogEvent eventsmoothsetup;              /* if logging times for each level */
   PetscLogEvent eventsmoothsolve;
   PetscLogEvent eventresidual;
@@ -48,6 +50,8 @@ typedef struct {
   PetscInt     default_smoothu;               /* number of smooths per level if not over-ridden */
   PetscInt     default_smoothd;               /*  with calls to KSPSetTolerances() */
   PetscReal    rtol,abstol,dtol,ttol;         /* tolerances for when running with PCApplyRichardson_MG */
+  PetscBool    esteigbatched;                 /* estimate the eigenvalues of the Chebyshev smoothers of all levels together */
+  PetscInt     agglomerate_eq_limit;          /* agglomerate the levels with fewer rows per process than this, 0 to never */
 
   void          *innerctx;                    /* optional data for preconditioner, like PCEXOTIC that inherits off of PCMG */
   PetscLogStage stageApply;
@@ -131,6 +131,14 @@ typedef struct {
   PetscInt cellType;
 } PetscFE_Basic;
 
+typedef struct {
+  PetscInt     numCells;  /* The number of cells integrated together in a block */
+  PetscInt     rworkSize; /* The size of the real work array */
+  PetscReal   *rwork;     /* Geometry for a block of cells: quadrature weights, inverse Jacobians, and coordinates */
+  PetscInt     sworkSize; /* The size of the scalar work array */
+  PetscScalar *swork;     /* Coefficients, field jets, pointwise function values, and element data for a block of cells */
+} PetscFE_Batch;
+
 #ifdef PETSC_HAVE_OPENCL
 
 #ifdef __APPLE__
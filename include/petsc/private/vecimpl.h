@@ -286,6 +286,10 @@ typedef struct {
   PetscInt               bs;
   PetscBool              sendfirst;
   PetscBool              contiq;
+  /* run-length encoding of indices[], used by the pack and unpack kernels when consecutive entries form long contiguous runs */
+  PetscInt               *runstarts; /* [n+1] for each processor, offset of its runs in runpos[] and runlen[]; NULL if runs are not used */
+  PetscInt               *runpos;    /* position in indices[] and values[] (in blocks) of the first entry of each run */
+  PetscInt               *runlen;    /* number of blocks in each run */
   /* for MPI_Alltoallv() approach */
   PetscBool              use_alltoallv;
   PetscMPIInt            *counts,*displs;
@@ -348,8 +352,16 @@ PETSC_INTERN PetscErrorCode VecScatterCreate_MPI1(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI3(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI3Node(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterLocalOptimizeCopy_Private(VecScatter,VecScatter_Seq_General*,VecScatter_Seq_General*,PetscInt);
+PETSC_INTERN PetscErrorCode VecScatterCreateRuns_Private(VecScatter,VecScatter_MPI_General*);
+PETSC_INTERN PetscErrorCode VecScatterDestroyRuns_Private(VecScatter_MPI_General*);
+PETSC_INTERN PetscErrorCode VecScatterPackRuns_Private(VecScatter_MPI_General*,PetscInt,PetscInt,const PetscScalar*,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecScatterUnPackRuns_Private(VecScatter_MPI_General*,PetscInt,PetscInt,const PetscScalar*,PetscScalar*,InsertMode);
+PETSC_EXTERN PetscErrorCode VecScatterEndByMessageSupported_Private(VecScatter,PetscBool*);
+PETSC_EXTERN PetscErrorCode VecScatterEndByMessage_Private(VecScatter,Vec,Vec,PetscErrorCode (*)(void*,PetscInt,const PetscScalar*),void*);
 
 
+PETSC_INTERN PetscErrorCode VecSeqThreadsInitialize_Private(void);
+
 PETSC_INTERN PetscErrorCode VecStashCreate_Private(MPI_Comm,PetscInt,VecStash*);
 PETSC_INTERN PetscErrorCode VecStashDestroy_Private(VecStash*);
 PETSC_EXTERN PetscErrorCode VecStashExpand_Private(VecStash*,PetscInt);
@@ -29,6 +29,15 @@ typedef void (*PetscPointJac)(PetscInt, PetscInt, PetscInt,
                               const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                               const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                               PetscReal, PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]);
+/* Versions of the pointwise functions which evaluate a block of points at once, with the point index innermost */
+typedef void (*PetscPointFuncVec)(PetscInt, PetscInt, PetscInt, PetscInt,
+                                  const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                  const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                  PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]);
+typedef void (*PetscPointJacVec)(PetscInt, PetscInt, PetscInt, PetscInt,
+                                 const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                 const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                 PetscReal, PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]);
 typedef void (*PetscBdPointFunc)(PetscInt, PetscInt, PetscInt,
                                  const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                  const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
@@ -142,6 +151,10 @@ PETSC_EXTERN PetscErrorCode PetscDSSetJacobian(PetscDS, PetscInt, PetscInt,
                                                         const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                                         PetscReal, PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]));
 PETSC_EXTERN PetscErrorCode PetscDSUseJacobianPreconditioner(PetscDS, PetscBool);
+PETSC_EXTERN PetscErrorCode PetscDSGetResidualVec(PetscDS, PetscInt, PetscPointFuncVec *, PetscPointFuncVec *);
+PETSC_EXTERN PetscErrorCode PetscDSSetResidualVec(PetscDS, PetscInt, PetscPointFuncVec, PetscPointFuncVec);
+PETSC_EXTERN PetscErrorCode PetscDSGetJacobianVec(PetscDS, PetscInt, PetscInt, PetscPointJacVec *, PetscPointJacVec *, PetscPointJacVec *, PetscPointJacVec *);
+PETSC_EXTERN PetscErrorCode PetscDSSetJacobianVec(PetscDS, PetscInt, PetscInt, PetscPointJacVec, PetscPointJacVec, PetscPointJacVec, PetscPointJacVec);
 PETSC_EXTERN PetscErrorCode PetscDSHasJacobianPreconditioner(PetscDS, PetscBool *);
 PETSC_EXTERN PetscErrorCode PetscDSGetJacobianPreconditioner(PetscDS, PetscInt, PetscInt,
                                                void (**)(PetscInt, PetscInt, PetscInt,
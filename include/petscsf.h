@@ -16,17 +16,20 @@ PETSC_EXTERN PetscClassId PETSCSF_CLASSID;
    Level: beginner
 
    Notes:
-    The two approaches provided are
-$     PETSCSFBASIC which uses MPI 1 message passing to perform the communication and
+    The three approaches provided are
+$     PETSCSFBASIC which uses MPI 1 message passing to perform the communication,
 $     PETSCSFWINDOW which uses MPI 2 one-sided operations to perform the communication, this may be more efficient,
 $                   but may not be available for all MPI distributions. In particular OpenMPI has bugs in its one-sided
-$                   operations that prevent its use.
+$                   operations that prevent its use, and
+$     PETSCSFNEIGHBOR which uses MPI 3 neighborhood collectives on a distributed graph communicator, this lets the MPI
+$                   implementation aggregate the many small messages of unstructured halo exchanges.
 
 .seealso: PetscSFSetType(), PetscSF
 J*/
 typedef const char *PetscSFType;
 #define PETSCSFBASIC  "basic"
 #define PETSCSFWINDOW "window"
+#define PETSCSFNEIGHBOR "neighbor"
 
 /*E
     PetscSFWindowSyncType - Type of synchronization for PETSCSFWINDOW
@@ -382,6 +382,8 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   PetscBool        *tmpi, *tmpa;
   PetscPointFunc   *tmpobj, *tmpf, *tmpup;
   PetscPointJac    *tmpg, *tmpgp, *tmpgt;
+  PetscPointFuncVec *tmpfv;
+  PetscPointJacVec  *tmpgv;
   PetscBdPointFunc *tmpfbd;
   PetscBdPointJac  *tmpgbd;
   PetscRiemannFunc *tmpr;
@@ -429,6 +431,14 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   prob->r   = tmpr;
   prob->update = tmpup;
   prob->ctx = tmpctx;
+  ierr = PetscCalloc2(NfNew*2, &tmpfv, NfNew*NfNew*4, &tmpgv);CHKERRQ(ierr);
+  for (f = 0; f < Nf*2; ++f) tmpfv[f] = prob->fVec[f];
+  for (f = 0; f < Nf*Nf*4; ++f) tmpgv[f] = prob->gVec[f];
+  for (f = Nf*2; f < NfNew*2; ++f) tmpfv[f] = NULL;
+  for (f = Nf*Nf*4; f < NfNew*NfNew*4; ++f) tmpgv[f] = NULL;
+  ierr = PetscFree2(prob->fVec, prob->gVec);CHKERRQ(ierr);
+  prob->fVec = tmpfv;
+  prob->gVec = tmpgv;
   ierr = PetscCalloc3(NfNew*2, &tmpfbd, NfNew*NfNew*4, &tmpgbd, NfNew, &tmpexactSol);CHKERRQ(ierr);
   for (f = 0; f < Nf*2; ++f) tmpfbd[f] = prob->fBd[f];
   for (f = 0; f < Nf*Nf*4; ++f) tmpgbd[f] = prob->gBd[f];
@@ -481,6 +491,7 @@ PetscErrorCode PetscDSDestroy(PetscDS *prob)
   ierr = PetscFree3((*prob)->disc, (*prob)->implicit, (*prob)->adjacency);CHKERRQ(ierr);
   ierr = PetscFree7((*prob)->obj,(*prob)->f,(*prob)->g,(*prob)->gp,(*prob)->gt,(*prob)->r,(*prob)->ctx);CHKERRQ(ierr);
   ierr = PetscFree((*prob)->update);CHKERRQ(ierr);
+  ierr = PetscFree2((*prob)->fVec,(*prob)->gVec);CHKERRQ(ierr);
   ierr = PetscFree3((*prob)->fBd,(*prob)->gBd,(*prob)->exactSol);CHKERRQ(ierr);
   if ((*prob)->ops->destroy) {ierr = (*(*prob)->ops->destroy)(*prob);CHKERRQ(ierr);}
   next = (*prob)->boundary;
@@ -1067,6 +1078,95 @@ PetscErrorCode PetscDSSetResidual(PetscDS prob, PetscInt f,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDSGetResidualVec - Get the residual functions for a given test field which evaluate a block of points at once
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+- f    - The test field number
+
+  Output Parameters:
++ f0 - integrand for the test function term
+- f1 - integrand for the test function gradient term
+
+  Level: intermediate
+
+.seealso: PetscDSSetResidualVec(), PetscDSGetResidual()
+@*/
+PetscErrorCode PetscDSGetResidualVec(PetscDS prob, PetscInt f, PetscPointFuncVec *f0, PetscPointFuncVec *f1)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if (f0) {PetscValidPointer(f0, 3); *f0 = prob->fVec[f*2+0];}
+  if (f1) {PetscValidPointer(f1, 4); *f1 = prob->fVec[f*2+1];}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDSSetResidualVec - Set the residual functions for a given test field which evaluate a block of points at once
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. f0 - integrand for the test function term
+- f1 - integrand for the test function gradient term
+
+  Note: These are the same integrands as in PetscDSSetResidual(), but each call evaluates Ne points, such as the same
+quadrature point in Ne different cells. Every pointwise array is stored with the point index innermost, so that entry i
+of the pointwise callback for point e is found at index i*Ne + e. The calling sequence for the callbacks f0 and f1 is
+
+$ f0(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Ne,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+
++ dim - the spatial dimension
+. Nf - the number of fields
+. NfAux - the number of auxiliary fields
+. Ne - the number of points in the block
+. uOff - the offset into u[] and u_t[] for each field, which must be multiplied by Ne
+. uOff_x - the offset into u_x[] for each field, which must be multiplied by Ne
+. u - each field evaluated at the points
+. u_t - the time derivative of each field evaluated at the points
+. u_x - the gradient of each field evaluated at the points
+. aOff - the offset into a[] and a_t[] for each auxiliary field, which must be multiplied by Ne
+. aOff_x - the offset into a_x[] for each auxiliary field, which must be multiplied by Ne
+. a - each auxiliary field evaluated at the points
+. a_t - the time derivative of each auxiliary field evaluated at the points
+. a_x - the gradient of auxiliary each field evaluated at the points
+. t - current time
+. x - coordinates of the points
+. numConstants - number of constant parameters
+. constants - constant parameters
+- f0 - output values at the points
+
+  A pointwise function set with PetscDSSetResidual() takes precedence. The block functions are used by PETSCFEBATCH,
+and by PETSCFEBASIC one point at a time.
+
+  Level: intermediate
+
+.seealso: PetscDSGetResidualVec(), PetscDSSetResidual(), PETSCFEBATCH
+@*/
+PetscErrorCode PetscDSSetResidualVec(PetscDS prob, PetscInt f, PetscPointFuncVec f0, PetscPointFuncVec f1)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (f0) PetscValidFunction(f0, 3);
+  if (f1) PetscValidFunction(f1, 4);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  ierr = PetscDSEnlarge_Static(prob, f+1);CHKERRQ(ierr);
+  prob->fVec[f*2+0] = f0;
+  prob->fVec[f*2+1] = f1;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscDSHasJacobian - Signals that Jacobian functions have been set
 
@@ -1092,7 +1192,8 @@ PetscErrorCode PetscDSHasJacobian(PetscDS prob, PetscBool *hasJac)
   for (f = 0; f < prob->Nf; ++f) {
     for (g = 0; g < prob->Nf; ++g) {
       for (h = 0; h < 4; ++h) {
-        if (prob->g[(f*prob->Nf + g)*4+h]) *hasJac = PETSC_TRUE;
+        if (prob->g[(f*prob->Nf + g)*4+h])    *hasJac = PETSC_TRUE;
+        if (prob->gVec[(f*prob->Nf + g)*4+h]) *hasJac = PETSC_TRUE;
       }
     }
   }
@@ -1262,6 +1363,87 @@ PetscErrorCode PetscDSSetJacobian(PetscDS prob, PetscInt f, PetscInt g,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDSGetJacobianVec - Get the Jacobian functions for given test and basis field which evaluate a block of points at once
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+- g    - The field number
+
+  Output Parameters:
++ g0 - integrand for the test and basis function term
+. g1 - integrand for the test function and basis function gradient term
+. g2 - integrand for the test function gradient and basis function term
+- g3 - integrand for the test function gradient and basis function gradient term
+
+  Level: intermediate
+
+.seealso: PetscDSSetJacobianVec(), PetscDSGetJacobian()
+@*/
+PetscErrorCode PetscDSGetJacobianVec(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacVec *g0, PetscPointJacVec *g1, PetscPointJacVec *g2, PetscPointJacVec *g3)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if ((g < 0) || (g >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", g, prob->Nf);
+  if (g0) {PetscValidPointer(g0, 4); *g0 = prob->gVec[(f*prob->Nf + g)*4+0];}
+  if (g1) {PetscValidPointer(g1, 5); *g1 = prob->gVec[(f*prob->Nf + g)*4+1];}
+  if (g2) {PetscValidPointer(g2, 6); *g2 = prob->gVec[(f*prob->Nf + g)*4+2];}
+  if (g3) {PetscValidPointer(g3, 7); *g3 = prob->gVec[(f*prob->Nf + g)*4+3];}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDSSetJacobianVec - Set the Jacobian functions for given test and basis fields which evaluate a block of points at once
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. g    - The field number
+. g0 - integrand for the test and basis function term
+. g1 - integrand for the test function and basis function gradient term
+. g2 - integrand for the test function gradient and basis function term
+- g3 - integrand for the test function gradient and basis function gradient term
+
+  Note: These are the same integrands as in PetscDSSetJacobian(), evaluated on Ne points at once with the layout described
+in PetscDSSetResidualVec(). The calling sequence for the callbacks g0, g1, g2 and g3 is
+
+$ g0(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Ne,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+
+  A pointwise function set with PetscDSSetJacobian() takes precedence.
+
+  Level: intermediate
+
+.seealso: PetscDSGetJacobianVec(), PetscDSSetJacobian(), PetscDSSetResidualVec(), PETSCFEBATCH
+@*/
+PetscErrorCode PetscDSSetJacobianVec(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacVec g0, PetscPointJacVec g1, PetscPointJacVec g2, PetscPointJacVec g3)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (g0) PetscValidFunction(g0, 4);
+  if (g1) PetscValidFunction(g1, 5);
+  if (g2) PetscValidFunction(g2, 6);
+  if (g3) PetscValidFunction(g3, 7);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  if (g < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", g);
+  ierr = PetscDSEnlarge_Static(prob, PetscMax(f, g)+1);CHKERRQ(ierr);
+  prob->gVec[(f*prob->Nf + g)*4+0] = g0;
+  prob->gVec[(f*prob->Nf + g)*4+1] = g1;
+  prob->gVec[(f*prob->Nf + g)*4+2] = g2;
+  prob->gVec[(f*prob->Nf + g)*4+3] = g3;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscDSUseJacobianPreconditioner - Whether to construct a Jacobian preconditioner
 
@@ -2883,6 +3065,7 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
     const PetscInt   f = fields ? fields[fn] : fn;
     PetscPointFunc   obj;
     PetscPointFunc   f0, f1;
+    PetscPointFuncVec f0v, f1v;
     PetscBdPointFunc f0Bd, f1Bd;
     PetscRiemannFunc r;
 
@@ -2893,12 +3076,15 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
     ierr = PetscDSGetRiemannSolver(prob, f, &r);CHKERRQ(ierr);
     ierr = PetscDSSetObjective(newprob, fn, obj);CHKERRQ(ierr);
     ierr = PetscDSSetResidual(newprob, fn, f0, f1);CHKERRQ(ierr);
+    ierr = PetscDSGetResidualVec(prob, f, &f0v, &f1v);CHKERRQ(ierr);
+    ierr = PetscDSSetResidualVec(newprob, fn, f0v, f1v);CHKERRQ(ierr);
     ierr = PetscDSSetBdResidual(newprob, fn, f0Bd, f1Bd);CHKERRQ(ierr);
     ierr = PetscDSSetRiemannSolver(newprob, fn, r);CHKERRQ(ierr);
     for (gn = 0; gn < numFields; ++gn) {
       const PetscInt  g = fields ? fields[gn] : gn;
       PetscPointJac   g0, g1, g2, g3;
       PetscPointJac   g0p, g1p, g2p, g3p;
+      PetscPointJacVec g0v, g1v, g2v, g3v;
       PetscBdPointJac g0Bd, g1Bd, g2Bd, g3Bd;
 
       if (g >= Nf) SETERRQ2(PetscObjectComm((PetscObject) prob), PETSC_ERR_ARG_SIZ, "Field %D must be in [0, %D)", g, Nf);
@@ -2906,6 +3092,8 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
       ierr = PetscDSGetJacobianPreconditioner(prob, f, g, &g0p, &g1p, &g2p, &g3p);CHKERRQ(ierr);
       ierr = PetscDSGetBdJacobian(prob, f, g, &g0Bd, &g1Bd, &g2Bd, &g3Bd);CHKERRQ(ierr);
       ierr = PetscDSSetJacobian(newprob, fn, gn, g0, g1, g2, g3);CHKERRQ(ierr);
+      ierr = PetscDSGetJacobianVec(prob, f, g, &g0v, &g1v, &g2v, &g3v);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobianVec(newprob, fn, gn, g0v, g1v, g2v, g3v);CHKERRQ(ierr);
       ierr = PetscDSSetJacobianPreconditioner(prob, fn, gn, g0p, g1p, g2p, g3p);CHKERRQ(ierr);
       ierr = PetscDSSetBdJacobian(newprob, fn, gn, g0Bd, g1Bd, g2Bd, g3Bd);CHKERRQ(ierr);
     }
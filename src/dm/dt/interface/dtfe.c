@@ -5067,6 +5067,7 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscIn
   const PetscInt     debug = 0;
   PetscPointFunc     f0_func;
   PetscPointFunc     f1_func;
+  PetscPointFuncVec  f0_vec, f1_vec;
   PetscQuadrature    quad;
   PetscScalar       *f0, *f1, *u, *u_t = NULL, *u_x, *a, *a_x, *refSpaceDer, *refSpaceDerAux;
   const PetscScalar *constants;
@@ -5091,6 +5092,9 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscIn
   ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
   ierr = PetscDSGetFieldOffset(prob, field, &fOffset);CHKERRQ(ierr);
   ierr = PetscDSGetResidual(prob, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  ierr = PetscDSGetResidualVec(prob, field, &f0_vec, &f1_vec);CHKERRQ(ierr);
+  if (f0_func) f0_vec = NULL;
+  if (f1_func) f1_vec = NULL;
   ierr = PetscDSGetEvaluationArrays(prob, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
   ierr = PetscDSGetRefCoordArrays(prob, &x, &refSpaceDer);CHKERRQ(ierr);
   ierr = PetscDSGetWeakFormArrays(prob, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
@@ -5147,11 +5151,13 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscIn
       EvaluateFieldJets(dim, Nf, Nb, Nc, q, B, D, refSpaceDer, invJ, &coefficients[cOffset], &coefficients_t[cOffset], u, u_x, u_t);
       if (probAux) EvaluateFieldJets(dim, NfAux, NbAux, NcAux, q, BAux, DAux, refSpaceDerAux, invJ, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);
       if (f0_func) f0_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, &f0[q*NcI]);
-      if (f1_func) {
+      if (f0_vec)  f0_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, &f0[q*NcI]);
+      if (f1_func || f1_vec) {
         ierr = PetscMemzero(refSpaceDer, NcI*dim * sizeof(PetscScalar));CHKERRQ(ierr);
-        f1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, refSpaceDer);
+        if (f1_func) f1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, refSpaceDer);
+        else         f1_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, v, numConstants, constants, refSpaceDer);
       }
-      TransformF(dim, NcI, q, invJ, detJ, quadWeights, refSpaceDer, f0_func ? f0 : NULL, f1_func ? f1 : NULL);
+      TransformF(dim, NcI, q, invJ, detJ, quadWeights, refSpaceDer, f0_func || f0_vec ? f0 : NULL, f1_func || f1_vec ? f1 : NULL);
     }
     UpdateElementVec(dim, Nq, NbI, NcI, BI, DI, f0, f1, &elemVec[cOffset+fOffset]);
     cOffset    += totDim;
@@ -5274,6 +5280,7 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
   PetscPointJac      g1_func;
   PetscPointJac      g2_func;
   PetscPointJac      g3_func;
+  PetscPointJacVec   g0_vec = NULL, g1_vec = NULL, g2_vec = NULL, g3_vec = NULL;
   PetscInt           cOffset    = 0; /* Offset into coefficients[] for element e */
   PetscInt           cOffsetAux = 0; /* Offset into coefficientsAux[] for element e */
   PetscInt           eOffset    = 0; /* Offset into elemMat[] for element e */
@@ -5305,9 +5312,16 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
   switch(jtype) {
   case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
   case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
-  case PETSCFE_JACOBIAN:     ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:
+    ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+    ierr = PetscDSGetJacobianVec(prob, fieldI, fieldJ, &g0_vec, &g1_vec, &g2_vec, &g3_vec);CHKERRQ(ierr);
+    break;
   }
-  if (!g0_func && !g1_func && !g2_func && !g3_func) PetscFunctionReturn(0);
+  if (g0_func) g0_vec = NULL;
+  if (g1_func) g1_vec = NULL;
+  if (g2_func) g2_vec = NULL;
+  if (g3_func) g3_vec = NULL;
+  if (!g0_func && !g1_func && !g2_func && !g3_func && !g0_vec && !g1_vec && !g2_vec && !g3_vec) PetscFunctionReturn(0);
   ierr = PetscDSGetEvaluationArrays(prob, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
   ierr = PetscDSGetRefCoordArrays(prob, &x, &refSpaceDer);CHKERRQ(ierr);
   ierr = PetscDSGetWeakFormArrays(prob, NULL, NULL, &g0, &g1, &g2, &g3);CHKERRQ(ierr);
@@ -5368,15 +5382,17 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
       w = detJ*quadWeights[q];
       EvaluateFieldJets(dim, Nf, Nb, Nc, q, B, D, refSpaceDer, invJ, &coefficients[cOffset], &coefficients_t[cOffset], u, u_x, u_t);
       if (probAux) EvaluateFieldJets(dim, NfAux, NbAux, NcAux, q, BAux, DAux, refSpaceDerAux, invJ, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);
-      if (g0_func) {
+      if (g0_func || g0_vec) {
         ierr = PetscMemzero(g0, NcI*NcJ * sizeof(PetscScalar));CHKERRQ(ierr);
-        g0_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, g0);
+        if (g0_func) g0_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, g0);
+        else         g0_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, g0);
         for (c = 0; c < NcI*NcJ; ++c) g0[c] *= w;
       }
-      if (g1_func) {
+      if (g1_func || g1_vec) {
         PetscInt d, d2;
         ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
-        g1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+        if (g1_func) g1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+        else         g1_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
         for (fc = 0; fc < NcI; ++fc) {
           for (gc = 0; gc < NcJ; ++gc) {
             for (d = 0; d < dim; ++d) {
@@ -5387,10 +5403,11 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
           }
         }
       }
-      if (g2_func) {
+      if (g2_func || g2_vec) {
         PetscInt d, d2;
         ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
-        g2_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+        if (g2_func) g2_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+        else         g2_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
         for (fc = 0; fc < NcI; ++fc) {
           for (gc = 0; gc < NcJ; ++gc) {
             for (d = 0; d < dim; ++d) {
@@ -5401,10 +5418,11 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscFE
           }
         }
       }
-      if (g3_func) {
+      if (g3_func || g3_vec) {
         PetscInt d, d2, dp, d3;
         ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim*dim * sizeof(PetscScalar));CHKERRQ(ierr);
-        g3_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+        if (g3_func) g3_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
+        else         g3_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, v, numConstants, constants, refSpaceDer);
         for (fc = 0; fc < NcI; ++fc) {
           for (gc = 0; gc < NcJ; ++gc) {
             for (d = 0; d < dim; ++d) {
@@ -6795,6 +6813,626 @@ PETSC_EXTERN PetscErrorCode PetscFECreate_Composite(PetscFE fem)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode PetscFEDestroy_Batch(PetscFE fem)
+{
+  PetscFE_Batch *b = (PetscFE_Batch *) fem->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(b->rwork);CHKERRQ(ierr);
+  ierr = PetscFree(b->swork);CHKERRQ(ierr);
+  ierr = PetscFree(b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscFESetFromOptions_Batch(PetscOptionItems *PetscOptionsObject, PetscFE fem)
+{
+  PetscFE_Batch *b = (PetscFE_Batch *) fem->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscFE batch options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-petscfe_batch_cells", "The number of cells integrated together in a block", "None", b->numCells, &b->numCells, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  if (b->numCells < 1) SETERRQ1(PetscObjectComm((PetscObject) fem), PETSC_ERR_ARG_OUTOFRANGE, "Number of cells in a block %D must be positive", b->numCells);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscFEView_Batch(PetscFE fe, PetscViewer viewer)
+{
+  PetscFE_Batch *b = (PetscFE_Batch *) fe->data;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fe, PETSCFE_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer, "Batch Finite Element in blocks of %D cells:\n", b->numCells);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+    ierr = PetscFEView_Basic_Ascii(fe, viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* The work arrays are kept between calls, since integration is called for every field on every chunk of cells */
+static PetscErrorCode PetscFEBatchGetWorkArrays_Static(PetscFE fem, PetscInt rsize, PetscInt ssize, PetscReal **rwork, PetscScalar **swork)
+{
+  PetscFE_Batch *b = (PetscFE_Batch *) fem->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (rsize > b->rworkSize) {
+    ierr = PetscFree(b->rwork);CHKERRQ(ierr);
+    ierr = PetscMalloc1(rsize, &b->rwork);CHKERRQ(ierr);
+    b->rworkSize = rsize;
+  }
+  if (ssize > b->sworkSize) {
+    ierr = PetscFree(b->swork);CHKERRQ(ierr);
+    ierr = PetscMalloc1(ssize, &b->swork);CHKERRQ(ierr);
+    b->sworkSize = ssize;
+  }
+  *rwork = b->rwork;
+  *swork = b->swork;
+  PetscFunctionReturn(0);
+}
+
+/* Transpose the data for cells [e0, e0+Ne) into a block with the cell index innermost */
+PETSC_STATIC_INLINE void PetscFEBatchTranspose_Static(PetscInt e0, PetscInt Ne, PetscInt n, const PetscScalar in[], PetscScalar out[])
+{
+  PetscInt e, i;
+
+  for (e = 0; e < Ne; ++e) for (i = 0; i < n; ++i) out[i*Ne+e] = in[(e0+e)*n+i];
+}
+
+/* Compute the quadrature weight times detJ, the inverse Jacobian, and the real coordinates of quadrature point q for cells [e0, e0+Ne) */
+static void PetscFEBatchGeometry_Static(PetscFEGeom *geom, PetscInt e0, PetscInt Ne, PetscInt dim, PetscInt q, const PetscReal quadPoints[], const PetscReal quadWeights[], PetscReal w[], PetscReal invJ[], PetscReal x[])
+{
+  const PetscInt Np = geom->numPoints;
+  PetscReal      xq[3];
+  PetscInt       e, i, d;
+
+  for (e = 0; e < Ne; ++e) {
+    const PetscInt   c  = e0+e;
+    const PetscInt   gq = geom->isAffine ? c : c*Np+q;
+    const PetscReal *iJ = &geom->invJ[gq*dim*dim];
+
+    if (geom->isAffine) CoordinatesRefToReal(dim, dim, geom->xi, &geom->v[c*Np*dim], &geom->J[c*Np*dim*dim], &quadPoints[q*dim], xq);
+    else for (d = 0; d < dim; ++d) xq[d] = geom->v[gq*dim+d];
+    w[e] = geom->detJ[gq]*quadWeights[q];
+    for (i = 0; i < dim*dim; ++i) invJ[i*Ne+e] = iJ[i];
+    for (d = 0; d < dim; ++d)     x[d*Ne+e]    = xq[d];
+  }
+}
+
+/* The analogue of EvaluateFieldJets() for a block of Ne cells, where every array has the cell index innermost */
+static void EvaluateFieldJets_Batch(PetscInt dim, PetscInt Nf, const PetscInt Nb[], const PetscInt Nc[], PetscInt q, PetscReal *basisField[], PetscReal *basisFieldDer[], PetscInt Ne, const PetscReal invJ[], const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscScalar refSpaceDer[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt dOffset = 0, fOffset = 0, f;
+
+  for (f = 0; f < Nf; ++f) {
+    const PetscInt   Nbf = Nb[f], Ncf = Nc[f];
+    const PetscReal *Bq  = &basisField[f][q*Nbf*Ncf];
+    const PetscReal *Dq  = &basisFieldDer[f][q*Nbf*Ncf*dim];
+    PetscScalar     *uf  = &u[fOffset*Ne], *uf_x = &u_x[fOffset*dim*Ne];
+    PetscInt         b, c, d, k, e;
+
+    for (e = 0; e < Ncf*Ne; ++e)     uf[e] = 0.0;
+    for (e = 0; e < Ncf*dim*Ne; ++e) refSpaceDer[e] = 0.0;
+    for (b = 0; b < Nbf; ++b) {
+      const PetscScalar *coef = &coefficients[(dOffset+b)*Ne];
+
+      for (c = 0; c < Ncf; ++c) {
+        const PetscInt  cidx = b*Ncf+c;
+        const PetscReal Bv   = Bq[cidx];
+        PetscScalar    *ufc  = &uf[c*Ne];
+
+        for (e = 0; e < Ne; ++e) ufc[e] += Bv*coef[e];
+        for (d = 0; d < dim; ++d) {
+          const PetscReal Dv = Dq[cidx*dim+d];
+          PetscScalar    *rd = &refSpaceDer[(c*dim+d)*Ne];
+
+          for (e = 0; e < Ne; ++e) rd[e] += Dv*coef[e];
+        }
+      }
+    }
+    for (c = 0; c < Ncf; ++c) {
+      for (d = 0; d < dim; ++d) {
+        PetscScalar *ux = &uf_x[(c*dim+d)*Ne];
+
+        for (e = 0; e < Ne; ++e) ux[e] = 0.0;
+        for (k = 0; k < dim; ++k) {
+          const PetscReal   *iJ = &invJ[(k*dim+d)*Ne];
+          const PetscScalar *rd = &refSpaceDer[(c*dim+k)*Ne];
+
+          for (e = 0; e < Ne; ++e) ux[e] += iJ[e]*rd[e];
+        }
+      }
+    }
+    if (u_t) {
+      PetscScalar *uf_t = &u_t[fOffset*Ne];
+
+      for (e = 0; e < Ncf*Ne; ++e) uf_t[e] = 0.0;
+      for (b = 0; b < Nbf; ++b) {
+        const PetscScalar *coef_t = &coefficients_t[(dOffset+b)*Ne];
+
+        for (c = 0; c < Ncf; ++c) {
+          const PetscReal Bv = Bq[b*Ncf+c];
+
+          for (e = 0; e < Ne; ++e) uf_t[c*Ne+e] += Bv*coef_t[e];
+        }
+      }
+    }
+    fOffset += Ncf;
+    dOffset += Nbf;
+  }
+}
+
+/* Copy the values for cell e out of a block of Ne cells, so that a pointwise function can be called */
+PETSC_STATIC_INLINE void PetscFEBatchExtract_Static(PetscInt n, PetscInt Ne, PetscInt e, const PetscScalar in[], PetscScalar out[])
+{
+  PetscInt i;
+
+  for (i = 0; i < n; ++i) out[i] = in[i*Ne+e];
+}
+
+PETSC_STATIC_INLINE void PetscFEBatchInsert_Static(PetscInt n, PetscInt Ne, PetscInt e, const PetscScalar in[], PetscScalar out[])
+{
+  PetscInt i;
+
+  for (i = 0; i < n; ++i) out[i*Ne+e] = in[i];
+}
+
+PetscErrorCode PetscFEIntegrateResidual_Batch(PetscFE fem, PetscDS prob, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
+                                              const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  PetscFE_Batch     *b = (PetscFE_Batch *) fem->data;
+  PetscPointFunc     f0_func, f1_func;
+  PetscPointFuncVec  f0_vec, f1_vec;
+  PetscQuadrature    quad;
+  PetscScalar       *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *f0, *f1;
+  PetscScalar       *swork, *coef, *coef_t = NULL, *coefAux = NULL, *uB, *uB_t = NULL, *uB_x, *aB = NULL, *aB_x = NULL, *refSpaceDer, *f0B, *f1B, *elemB;
+  const PetscScalar *constants;
+  PetscReal         *x, *rwork, *w, *invJ, *xB;
+  PetscReal        **B, **D, **BAux = NULL, **DAux = NULL, *BI, *DI;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL, *Nb, *Nc, *NbAux = NULL, *NcAux = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, totNc, totNcAux = 0, fOffset, NbI, NcI, maxNc = 0;
+  PetscInt           Nm, Nbl, e0, e, i, f, c, d, k;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           qNc, Nq, q;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  if (!Ne) PetscFunctionReturn(0);
+  if (cgeom->dimEmbed != dim) {
+    ierr = PetscFEIntegrateResidual_Basic(fem, prob, field, Ne, cgeom, coefficients, coefficients_t, probAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &totNc);CHKERRQ(ierr);
+  ierr = PetscDSGetDimensions(prob, &Nb);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetResidual(prob, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  ierr = PetscDSGetResidualVec(prob, field, &f0_vec, &f1_vec);CHKERRQ(ierr);
+  if (f0_func) f0_vec = NULL;
+  if (f1_func) f1_vec = NULL;
+  ierr = PetscDSGetEvaluationArrays(prob, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetRefCoordArrays(prob, &x, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(prob, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(prob, &B, &D);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(prob, &numConstants, &constants);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) maxNc = PetscMax(maxNc, Nc[f]);
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &totNcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetDimensions(probAux, &NbAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(probAux, &BAux, &DAux);CHKERRQ(ierr);
+    for (f = 0; f < NfAux; ++f) maxNc = PetscMax(maxNc, NcAux[f]);
+  }
+  NbI = Nb[field];
+  NcI = Nc[field];
+  BI  = B[field];
+  DI  = D[field];
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  /* Every block array is sized for the largest block, and indexed with the size of the current block */
+  Nm   = PetscMin(b->numCells, Ne);
+  ierr = PetscFEBatchGetWorkArrays_Static(fem, (1 + dim*dim + dim)*Nm, ((coefficients_t ? 2 : 1)*(totDim + totNc) + totNc*dim + totDimAux + totNcAux*(1 + dim) + maxNc*dim + NcI*(1 + dim) + NbI)*Nm, &rwork, &swork);CHKERRQ(ierr);
+  w     = rwork;
+  invJ  = w    + Nm;
+  xB    = invJ + dim*dim*Nm;
+  coef  = swork;
+  uB    = coef + totDim*Nm;
+  uB_x  = uB   + totNc*Nm;
+  refSpaceDer = uB_x + totNc*dim*Nm;
+  f0B   = refSpaceDer + maxNc*dim*Nm;
+  f1B   = f0B  + NcI*Nm;
+  elemB = f1B  + NcI*dim*Nm;
+  if (probAux) {
+    aB      = elemB + NbI*Nm;
+    coefAux = aB + totNcAux*Nm;
+    aB_x    = coefAux + totDimAux*Nm;
+  }
+  if (coefficients_t) {
+    coef_t = elemB + (NbI + totNcAux*(1 + dim) + totDimAux)*Nm;
+    uB_t   = coef_t + totDim*Nm;
+  }
+  for (e0 = 0; e0 < Ne; e0 += Nbl) {
+    Nbl  = PetscMin(Nm, Ne - e0);
+    PetscFEBatchTranspose_Static(e0, Nbl, totDim, coefficients, coef);
+    if (coefficients_t) PetscFEBatchTranspose_Static(e0, Nbl, totDim, coefficients_t, coef_t);
+    if (probAux)        PetscFEBatchTranspose_Static(e0, Nbl, totDimAux, coefficientsAux, coefAux);
+    for (i = 0; i < NbI*Nbl; ++i) elemB[i] = 0.0;
+    for (q = 0; q < Nq; ++q) {
+      const PetscReal *BIq = &BI[q*NbI*NcI], *DIq = &DI[q*NbI*NcI*dim];
+
+      PetscFEBatchGeometry_Static(cgeom, e0, Nbl, dim, q, quadPoints, quadWeights, w, invJ, xB);
+      EvaluateFieldJets_Batch(dim, Nf, Nb, Nc, q, B, D, Nbl, invJ, coef, coef_t, refSpaceDer, uB, uB_x, uB_t);
+      if (probAux) EvaluateFieldJets_Batch(dim, NfAux, NbAux, NcAux, q, BAux, DAux, Nbl, invJ, coefAux, NULL, refSpaceDer, aB, aB_x, NULL);
+      for (i = 0; i < NcI*Nbl; ++i)     f0B[i] = 0.0;
+      for (i = 0; i < NcI*dim*Nbl; ++i) f1B[i] = 0.0;
+      if (f0_vec) f0_vec(dim, Nf, NfAux, Nbl, uOff, uOff_x, uB, uB_t, uB_x, aOff, aOff_x, aB, NULL, aB_x, t, xB, numConstants, constants, f0B);
+      if (f1_vec) f1_vec(dim, Nf, NfAux, Nbl, uOff, uOff_x, uB, uB_t, uB_x, aOff, aOff_x, aB, NULL, aB_x, t, xB, numConstants, constants, f1B);
+      if (f0_func || f1_func) {
+        for (e = 0; e < Nbl; ++e) {
+          PetscFEBatchExtract_Static(totNc, Nbl, e, uB, u);
+          PetscFEBatchExtract_Static(totNc*dim, Nbl, e, uB_x, u_x);
+          if (u_t)     PetscFEBatchExtract_Static(totNc, Nbl, e, uB_t, u_t);
+          if (probAux) PetscFEBatchExtract_Static(totNcAux, Nbl, e, aB, a);
+          if (probAux) PetscFEBatchExtract_Static(totNcAux*dim, Nbl, e, aB_x, a_x);
+          for (d = 0; d < dim; ++d) x[d] = xB[d*Nbl+e];
+          if (f0_func) {
+            ierr = PetscMemzero(f0, NcI * sizeof(PetscScalar));CHKERRQ(ierr);
+            f0_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, x, numConstants, constants, f0);
+            PetscFEBatchInsert_Static(NcI, Nbl, e, f0, f0B);
+          }
+          if (f1_func) {
+            ierr = PetscMemzero(f1, NcI*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+            f1_func(dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, x, numConstants, constants, f1);
+            PetscFEBatchInsert_Static(NcI*dim, Nbl, e, f1, f1B);
+          }
+        }
+      }
+      /* Apply the quadrature weight and pull f1 back to the reference cell, as in TransformF() */
+      for (c = 0; c < NcI; ++c) {
+        PetscScalar *f0c = &f0B[c*Nbl];
+
+        for (e = 0; e < Nbl; ++e) f0c[e] *= w[e];
+        for (d = 0; d < dim; ++d) {
+          PetscScalar *f1t = &refSpaceDer[(c*dim+d)*Nbl];
+
+          for (e = 0; e < Nbl; ++e) f1t[e] = 0.0;
+          for (k = 0; k < dim; ++k) {
+            const PetscReal   *iJ = &invJ[(d*dim+k)*Nbl];
+            const PetscScalar *f1c = &f1B[(c*dim+k)*Nbl];
+
+            for (e = 0; e < Nbl; ++e) f1t[e] += iJ[e]*f1c[e];
+          }
+          for (e = 0; e < Nbl; ++e) f1t[e] *= w[e];
+        }
+      }
+      for (f = 0; f < NbI; ++f) {
+        PetscScalar *ev = &elemB[f*Nbl];
+
+        for (c = 0; c < NcI; ++c) {
+          const PetscInt     cidx = f*NcI+c;
+          const PetscReal    Bv   = BIq[cidx];
+          const PetscScalar *f0c  = &f0B[c*Nbl];
+
+          for (e = 0; e < Nbl; ++e) ev[e] += Bv*f0c[e];
+          for (d = 0; d < dim; ++d) {
+            const PetscReal    Dv  = DIq[cidx*dim+d];
+            const PetscScalar *f1t = &refSpaceDer[(c*dim+d)*Nbl];
+
+            for (e = 0; e < Nbl; ++e) ev[e] += Dv*f1t[e];
+          }
+        }
+      }
+    }
+    for (e = 0; e < Nbl; ++e) PetscFEBatchExtract_Static(NbI, Nbl, e, elemB, &elemVec[(e0+e)*totDim+fOffset]);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscFEIntegrateJacobian_Batch(PetscFE fem, PetscDS prob, PetscFEJacobianType jtype, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *geom,
+                                              const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+{
+  PetscFE_Batch     *b = (PetscFE_Batch *) fem->data;
+  PetscPointJac      g_func[4];
+  PetscPointJacVec   g_vec[4] = {NULL, NULL, NULL, NULL};
+  PetscQuadrature    quad;
+  PetscScalar       *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *g[4];
+  PetscScalar       *swork, *coef, *coef_t = NULL, *coefAux = NULL, *uB, *uB_t = NULL, *uB_x, *aB = NULL, *aB_x = NULL, *refSpaceDer, *gB[4], *elemB;
+  const PetscScalar *constants;
+  PetscReal         *x, *rwork, *w, *invJ, *xB;
+  PetscReal        **B, **D, **BAux = NULL, **DAux = NULL, *BI, *DI, *BJ, *DJ;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL, *Nb, *Nc, *NbAux = NULL, *NcAux = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, totNc, totNcAux = 0, offsetI, offsetJ, NbI, NcI, NbJ, NcJ, maxNc = 0;
+  PetscInt           gSize[4], Nm, Nbl, e0, e, i, f, fc, gb, gc, d, d2, d3, h;
+  PetscBool          hasG[4], hasFunc = PETSC_FALSE, hasAny = PETSC_FALSE;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           qNc, Nq, q;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  if (!Ne) PetscFunctionReturn(0);
+  if (geom->dimEmbed != dim) {
+    ierr = PetscFEIntegrateJacobian_Basic(fem, prob, jtype, fieldI, fieldJ, Ne, geom, coefficients, coefficients_t, probAux, coefficientsAux, t, u_tshift, elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  switch(jtype) {
+  case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(prob, fieldI, fieldJ, &g_func[0], &g_func[1], &g_func[2], &g_func[3]);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(prob, fieldI, fieldJ, &g_func[0], &g_func[1], &g_func[2], &g_func[3]);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:
+    ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g_func[0], &g_func[1], &g_func[2], &g_func[3]);CHKERRQ(ierr);
+    ierr = PetscDSGetJacobianVec(prob, fieldI, fieldJ, &g_vec[0], &g_vec[1], &g_vec[2], &g_vec[3]);CHKERRQ(ierr);
+    break;
+  }
+  for (h = 0; h < 4; ++h) {
+    if (g_func[h]) g_vec[h] = NULL;
+    hasG[h]  = g_func[h] || g_vec[h] ? PETSC_TRUE : PETSC_FALSE;
+    hasFunc  = hasFunc || g_func[h] ? PETSC_TRUE : PETSC_FALSE;
+    hasAny   = hasAny || hasG[h] ? PETSC_TRUE : PETSC_FALSE;
+  }
+  if (!hasAny) PetscFunctionReturn(0);
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &totNc);CHKERRQ(ierr);
+  ierr = PetscDSGetDimensions(prob, &Nb);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldJ, &offsetJ);CHKERRQ(ierr);
+  ierr = PetscDSGetEvaluationArrays(prob, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetRefCoordArrays(prob, &x, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(prob, NULL, NULL, &g[0], &g[1], &g[2], &g[3]);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(prob, &B, &D);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(prob, &numConstants, &constants);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) maxNc = PetscMax(maxNc, Nc[f]);
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &totNcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetDimensions(probAux, &NbAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(probAux, &BAux, &DAux);CHKERRQ(ierr);
+    for (f = 0; f < NfAux; ++f) maxNc = PetscMax(maxNc, NcAux[f]);
+  }
+  NbI = Nb[fieldI], NbJ = Nb[fieldJ];
+  NcI = Nc[fieldI], NcJ = Nc[fieldJ];
+  BI  = B[fieldI],  BJ  = B[fieldJ];
+  DI  = D[fieldI],  DJ  = D[fieldJ];
+  gSize[0] = NcI*NcJ;
+  gSize[1] = NcI*NcJ*dim;
+  gSize[2] = NcI*NcJ*dim;
+  gSize[3] = NcI*NcJ*dim*dim;
+  ierr = PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  if (qNc != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %D components\n", qNc);
+  /* Every block array is sized for the largest block, and indexed with the size of the current block */
+  Nm   = PetscMin(b->numCells, Ne);
+  ierr = PetscFEBatchGetWorkArrays_Static(fem, (1 + dim*dim + dim)*Nm, ((coefficients_t ? 2 : 1)*(totDim + totNc) + totNc*dim + totDimAux + totNcAux*(1 + dim) + PetscMax(maxNc, dim)*dim + gSize[0] + gSize[1] + gSize[2] + gSize[3] + NbI*NbJ)*Nm, &rwork, &swork);CHKERRQ(ierr);
+  w     = rwork;
+  invJ  = w    + Nm;
+  xB    = invJ + dim*dim*Nm;
+  coef  = swork;
+  uB    = coef + totDim*Nm;
+  uB_x  = uB   + totNc*Nm;
+  refSpaceDer = uB_x + totNc*dim*Nm;
+  gB[0] = refSpaceDer + PetscMax(maxNc, dim)*dim*Nm;
+  for (h = 1; h < 4; ++h) gB[h] = gB[h-1] + gSize[h-1]*Nm;
+  elemB = gB[3] + gSize[3]*Nm;
+  if (probAux) {
+    aB      = elemB + NbI*NbJ*Nm;
+    coefAux = aB + totNcAux*Nm;
+    aB_x    = coefAux + totDimAux*Nm;
+  }
+  if (coefficients_t) {
+    coef_t = elemB + (NbI*NbJ + totNcAux*(1 + dim) + totDimAux)*Nm;
+    uB_t   = coef_t + totDim*Nm;
+  }
+  for (e0 = 0; e0 < Ne; e0 += Nbl) {
+    Nbl  = PetscMin(Nm, Ne - e0);
+    PetscFEBatchTranspose_Static(e0, Nbl, totDim, coefficients, coef);
+    if (coefficients_t) PetscFEBatchTranspose_Static(e0, Nbl, totDim, coefficients_t, coef_t);
+    if (probAux)        PetscFEBatchTranspose_Static(e0, Nbl, totDimAux, coefficientsAux, coefAux);
+    for (i = 0; i < NbI*NbJ*Nbl; ++i) elemB[i] = 0.0;
+    for (q = 0; q < Nq; ++q) {
+      const PetscReal *BIq = &BI[q*NbI*NcI], *BJq = &BJ[q*NbJ*NcJ];
+      const PetscReal *DIq = &DI[q*NbI*NcI*dim], *DJq = &DJ[q*NbJ*NcJ*dim];
+
+      PetscFEBatchGeometry_Static(geom, e0, Nbl, dim, q, quadPoints, quadWeights, w, invJ, xB);
+      EvaluateFieldJets_Batch(dim, Nf, Nb, Nc, q, B, D, Nbl, invJ, coef, coef_t, refSpaceDer, uB, uB_x, uB_t);
+      if (probAux) EvaluateFieldJets_Batch(dim, NfAux, NbAux, NcAux, q, BAux, DAux, Nbl, invJ, coefAux, NULL, refSpaceDer, aB, aB_x, NULL);
+      for (h = 0; h < 4; ++h) {
+        if (!hasG[h]) continue;
+        for (i = 0; i < gSize[h]*Nbl; ++i) gB[h][i] = 0.0;
+        if (g_vec[h]) g_vec[h](dim, Nf, NfAux, Nbl, uOff, uOff_x, uB, uB_t, uB_x, aOff, aOff_x, aB, NULL, aB_x, t, u_tshift, xB, numConstants, constants, gB[h]);
+      }
+      if (hasFunc) {
+        for (e = 0; e < Nbl; ++e) {
+          PetscFEBatchExtract_Static(totNc, Nbl, e, uB, u);
+          PetscFEBatchExtract_Static(totNc*dim, Nbl, e, uB_x, u_x);
+          if (u_t)     PetscFEBatchExtract_Static(totNc, Nbl, e, uB_t, u_t);
+          if (probAux) PetscFEBatchExtract_Static(totNcAux, Nbl, e, aB, a);
+          if (probAux) PetscFEBatchExtract_Static(totNcAux*dim, Nbl, e, aB_x, a_x);
+          for (d = 0; d < dim; ++d) x[d] = xB[d*Nbl+e];
+          for (h = 0; h < 4; ++h) {
+            if (!g_func[h]) continue;
+            ierr = PetscMemzero(g[h], gSize[h] * sizeof(PetscScalar));CHKERRQ(ierr);
+            g_func[h](dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, u_tshift, x, numConstants, constants, g[h]);
+            PetscFEBatchInsert_Static(gSize[h], Nbl, e, g[h], gB[h]);
+          }
+        }
+      }
+      /* Apply the quadrature weight and pull the gradient terms back to the reference cell */
+      if (hasG[0]) {
+        for (i = 0; i < gSize[0]; ++i) for (e = 0; e < Nbl; ++e) gB[0][i*Nbl+e] *= w[e];
+      }
+      for (h = 1; h < 3; ++h) {
+        if (!hasG[h]) continue;
+        for (i = 0; i < NcI*NcJ; ++i) {
+          PetscScalar *gi = &gB[h][i*dim*Nbl];
+
+          for (d = 0; d < dim*Nbl; ++d) refSpaceDer[d] = gi[d];
+          for (d = 0; d < dim; ++d) {
+            for (e = 0; e < Nbl; ++e) gi[d*Nbl+e] = 0.0;
+            for (d2 = 0; d2 < dim; ++d2) {
+              const PetscReal *iJ = &invJ[(d*dim+d2)*Nbl];
+
+              for (e = 0; e < Nbl; ++e) gi[d*Nbl+e] += iJ[e]*refSpaceDer[d2*Nbl+e];
+            }
+            for (e = 0; e < Nbl; ++e) gi[d*Nbl+e] *= w[e];
+          }
+        }
+      }
+      if (hasG[3]) {
+        for (i = 0; i < NcI*NcJ; ++i) {
+          PetscScalar *gi = &gB[3][i*dim*dim*Nbl];
+
+          for (d = 0; d < dim*dim*Nbl; ++d) refSpaceDer[d] = gi[d];
+          for (d = 0; d < dim; ++d) {
+            for (d3 = 0; d3 < dim; ++d3) {
+              PetscScalar *gdd = &gi[(d*dim+d3)*Nbl];
+
+              for (e = 0; e < Nbl; ++e) gdd[e] = 0.0;
+              for (d2 = 0; d2 < dim; ++d2) {
+                const PetscReal *iJ = &invJ[(d*dim+d2)*Nbl];
+                PetscInt         d4;
+
+                for (d4 = 0; d4 < dim; ++d4) {
+                  const PetscReal   *iJp = &invJ[(d3*dim+d4)*Nbl];
+                  const PetscScalar *rd  = &refSpaceDer[(d2*dim+d4)*Nbl];
+
+                  for (e = 0; e < Nbl; ++e) gdd[e] += iJ[e]*rd[e]*iJp[e];
+                }
+              }
+              for (e = 0; e < Nbl; ++e) gdd[e] *= w[e];
+            }
+          }
+        }
+      }
+      for (f = 0; f < NbI; ++f) {
+        for (fc = 0; fc < NcI; ++fc) {
+          const PetscInt fidx = f*NcI+fc; /* Test function basis index */
+
+          for (gb = 0; gb < NbJ; ++gb) {
+            PetscScalar *em = &elemB[(f*NbJ+gb)*Nbl];
+
+            for (gc = 0; gc < NcJ; ++gc) {
+              const PetscInt gidx = gb*NcJ+gc; /* Trial function basis index */
+              const PetscInt cc   = fc*NcJ+gc;
+
+              if (hasG[0]) {
+                const PetscReal    cv  = BIq[fidx]*BJq[gidx];
+                const PetscScalar *gv  = &gB[0][cc*Nbl];
+
+                for (e = 0; e < Nbl; ++e) em[e] += cv*gv[e];
+              }
+              for (d = 0; d < dim; ++d) {
+                if (hasG[1]) {
+                  const PetscReal    cv = BIq[fidx]*DJq[gidx*dim+d];
+                  const PetscScalar *gv = &gB[1][(cc*dim+d)*Nbl];
+
+                  for (e = 0; e < Nbl; ++e) em[e] += cv*gv[e];
+                }
+                if (hasG[2]) {
+                  const PetscReal    cv = DIq[fidx*dim+d]*BJq[gidx];
+                  const PetscScalar *gv = &gB[2][(cc*dim+d)*Nbl];
+
+                  for (e = 0; e < Nbl; ++e) em[e] += cv*gv[e];
+                }
+                if (hasG[3]) {
+                  for (d2 = 0; d2 < dim; ++d2) {
+                    const PetscReal    cv = DIq[fidx*dim+d]*DJq[gidx*dim+d2];
+                    const PetscScalar *gv = &gB[3][((cc*dim+d)*dim+d2)*Nbl];
+
+                    for (e = 0; e < Nbl; ++e) em[e] += cv*gv[e];
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    for (e = 0; e < Nbl; ++e) {
+      PetscScalar *eMat = &elemMat[(e0+e)*totDim*totDim];
+
+      for (f = 0; f < NbI; ++f) {
+        for (gb = 0; gb < NbJ; ++gb) eMat[(offsetI+f)*totDim+offsetJ+gb] += elemB[(f*NbJ+gb)*Nbl+e];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscFEInitialize_Batch(PetscFE fem)
+{
+  PetscFunctionBegin;
+  fem->ops->setfromoptions          = PetscFESetFromOptions_Batch;
+  fem->ops->setup                   = PetscFESetUp_Basic;
+  fem->ops->view                    = PetscFEView_Batch;
+  fem->ops->destroy                 = PetscFEDestroy_Batch;
+  fem->ops->getdimension            = PetscFEGetDimension_Basic;
+  fem->ops->gettabulation           = PetscFEGetTabulation_Basic;
+  fem->ops->integrate               = PetscFEIntegrate_Basic;
+  fem->ops->integrateresidual       = PetscFEIntegrateResidual_Batch;
+  fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
+  fem->ops->integratejacobianaction = NULL;
+  fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Batch;
+  fem->ops->integratebdjacobian     = PetscFEIntegrateBdJacobian_Basic;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  PETSCFEBATCH = "batch" - A PetscFE object that integrates blocks of cells together
+
+  Notes:
+  The residual and Jacobian are integrated over blocks of -petscfe_batch_cells cells (default 16). For each quadrature point, the
+  fields, the pointwise functions, and the element vectors or matrices are computed for the whole block, with the cell index
+  innermost, so that the inner loops are unit stride and can be vectorized by the compiler. Pointwise functions which evaluate
+  a whole block at once are given to PetscDSSetResidualVec() and PetscDSSetJacobianVec(), and pointwise functions from
+  PetscDSSetResidual() and PetscDSSetJacobian() are called one cell at a time. Boundary integrals use the PETSCFEBASIC kernels.
+
+  Level: intermediate
+
+.seealso: PetscFEType, PetscFECreate(), PetscFESetType(), PETSCFEBASIC, PetscDSSetResidualVec(), PetscDSSetJacobianVec()
+M*/
+PETSC_EXTERN PetscErrorCode PetscFECreate_Batch(PetscFE fem)
+{
+  PetscFE_Batch *b;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fem, PETSCFE_CLASSID, 1);
+  ierr      = PetscNewLog(fem, &b);CHKERRQ(ierr);
+  fem->data = b;
+
+  b->numCells = 16;
+
+  ierr = PetscFEInitialize_Batch(fem);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_EXTERN PetscErrorCode PetscFECreatePointTrace(PetscFE fe, PetscInt refPoint, PetscFE *trFE)
 {
   PetscSpace     bsp, bsubsp;
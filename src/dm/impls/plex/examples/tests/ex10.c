@@ -12,6 +12,8 @@ typedef struct {
   PetscInt *numComponents;     /* The number of field components */
   PetscInt *numDof;            /* The dof signature for the section */
   PetscInt  numGroups;         /* If greater than 1, use grouping in test */
+  char      order[256];        /* The ordering used for the test */
+  PetscBool distribute;        /* Distribute the mesh before reordering */
 } AppCtx;
 
 PetscErrorCode ProcessOptions(AppCtx *options)
@@ -30,6 +32,8 @@ PetscErrorCode ProcessOptions(AppCtx *options)
   options->numComponents     = NULL;
   options->numDof            = NULL;
   options->numGroups         = 0;
+  options->distribute        = PETSC_FALSE;
+  ierr = PetscStrcpy(options->order, MATORDERINGRCM);CHKERRQ(ierr);
 
   ierr = PetscOptionsBegin(PETSC_COMM_SELF, "", "Meshing Problem Options", "DMPLEX");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex10.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
@@ -49,6 +53,8 @@ PetscErrorCode ProcessOptions(AppCtx *options)
   ierr = PetscOptionsIntArray("-num_dof", "The dof signature for the section", "ex10.c", options->numDof, &len, &flg);CHKERRQ(ierr);
   if (flg && (len != (options->dim+1) * PetscMax(1, options->numFields))) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Length of dof array is %D should be %D", len, (options->dim+1) * PetscMax(1, options->numFields));
   ierr = PetscOptionsInt("-num_groups", "Group permutation by this many label values", "ex10.c", options->numGroups, &options->numGroups, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-order", "The mesh ordering to test", "ex10.c", options->order, options->order, sizeof(options->order), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-distribute", "Distribute the mesh before reordering", "ex10.c", options->distribute, &options->distribute, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -78,13 +84,91 @@ PetscErrorCode CreateTestMesh(MPI_Comm comm, DM *dm, AppCtx *options)
   PetscFunctionReturn(0);
 }
 
+/* Set each vertex dof to a function of the vertex coordinates, and check that ghost values survive a global update */
+PetscErrorCode TestGhostValues(DM dm, AppCtx *user)
+{
+  PetscSection       s, cs;
+  Vec                coordinates, locX, X;
+  const PetscScalar *coords, *x;
+  PetscScalar       *lx;
+  PetscReal          error = 0.0, gerror;
+  PetscInt           cdim, vStart, vEnd, v, d;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetDefaultSection(dm, &s);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &cs);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dm, &X);CHKERRQ(ierr);
+  ierr = VecSet(locX, 0.0);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(locX, &lx);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    PetscScalar val = 0.0, scale = 1.0;
+    PetscInt    dof, off, coff;
+
+    ierr = PetscSectionGetDof(s, v, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(s, v, &off);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(cs, v, &coff);CHKERRQ(ierr);
+    for (d = 0; d < cdim; ++d, scale *= 10.0) val += scale*coords[coff+d];
+    for (d = 0; d < dof; ++d) lx[off+d] = val;
+  }
+  ierr = VecRestoreArray(locX, &lx);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locX, INSERT_VALUES, X);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locX, INSERT_VALUES, X);CHKERRQ(ierr);
+  ierr = VecSet(locX, 0.0);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(locX, &x);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    PetscScalar val = 0.0, scale = 1.0;
+    PetscInt    dof, off, coff;
+
+    ierr = PetscSectionGetDof(s, v, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(s, v, &off);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(cs, v, &coff);CHKERRQ(ierr);
+    for (d = 0; d < cdim; ++d, scale *= 10.0) val += scale*coords[coff+d];
+    for (d = 0; d < dof; ++d) error = PetscMax(error, PetscAbsScalar(x[off+d] - val));
+  }
+  ierr = VecRestoreArrayRead(locX, &x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm, &X);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&error, &gerror, 1, MPIU_REAL, MPIU_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  if (gerror > PETSC_SMALL) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_PLIB, "Ghost values are inconsistent after reordering, error %g", (double) gerror);
+  PetscFunctionReturn(0);
+}
+
+/* The reordering is local to each process, so in parallel only the bandwidth of the diagonal blocks is meaningful */
+PetscErrorCode ComputeLocalBandwidth(Mat A, PetscInt *bw)
+{
+  Mat            Ad;
+  PetscInt       lbw;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject) A), &size);CHKERRQ(ierr);
+  if (size == 1) {
+    ierr = MatComputeBandwidth(A, 0.0, bw);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MatGetDiagonalBlock(A, &Ad);CHKERRQ(ierr);
+  ierr = MatComputeBandwidth(Ad, 0.0, &lbw);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&lbw, bw, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) A));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode TestReordering(DM dm, AppCtx *user)
 {
   DM              pdm;
   IS              perm;
   Mat             A, pA;
   PetscInt        bw, pbw;
-  MatOrderingType order = MATORDERINGRCM;
+  MatOrderingType order = user->order;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -92,10 +176,11 @@ PetscErrorCode TestReordering(DM dm, AppCtx *user)
   ierr = DMPlexPermute(dm, perm, &pdm);CHKERRQ(ierr);
   ierr = DMSetFromOptions(pdm);CHKERRQ(ierr);
   ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  ierr = TestGhostValues(pdm, user);CHKERRQ(ierr);
   ierr = DMCreateMatrix(dm, &A);CHKERRQ(ierr);
   ierr = DMCreateMatrix(pdm, &pA);CHKERRQ(ierr);
-  ierr = MatComputeBandwidth(A, 0.0, &bw);CHKERRQ(ierr);
-  ierr = MatComputeBandwidth(pA, 0.0, &pbw);CHKERRQ(ierr);
+  ierr = ComputeLocalBandwidth(A, &bw);CHKERRQ(ierr);
+  ierr = ComputeLocalBandwidth(pA, &pbw);CHKERRQ(ierr);
   ierr = MatDestroy(&A);CHKERRQ(ierr);
   ierr = MatDestroy(&pA);CHKERRQ(ierr);
   ierr = DMDestroy(&pdm);CHKERRQ(ierr);
@@ -161,6 +246,18 @@ int main(int argc, char **argv)
   if (user.numGroups < 1) {
     ierr = DMPlexCreateDoublet(PETSC_COMM_WORLD, user.dim, user.cellSimplex, user.interpolate, user.refinementUniform, user.refinementLimit, &dm);CHKERRQ(ierr);
     ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+    if (user.distribute) {
+      DM dmDist;
+
+      ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+      if (dmDist) {
+        ierr = DMDestroy(&dm);CHKERRQ(ierr);
+        dm   = dmDist;
+      }
+      /* Options such as -dist_dm_plex_reorder now act on the distributed mesh */
+      ierr = DMSetOptionsPrefix(dm, "dist_");CHKERRQ(ierr);
+      ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+    }
     ierr = DMPlexCreateSection(dm, user.dim, user.numFields, user.numComponents, user.numDof, 0, NULL, NULL, NULL, NULL, &s);CHKERRQ(ierr);
     ierr = DMSetDefaultSection(dm, s);CHKERRQ(ierr);
     ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
@@ -209,7 +306,28 @@ int main(int argc, char **argv)
   test:
     suffix: 7
     args: -dim 3 -interpolate 1 -cell_simplex 0 -refinement_uniform       -num_dof 1,0,0,0
+  # Other orderings
+  test:
+    suffix: hilbert_0
+    args: -dim 2 -interpolate 1 -cell_simplex 0 -refinement_uniform -num_dof 1,0,0 -order hilbert
+  test:
+    suffix: hilbert_1
+    args: -dim 3 -interpolate 1 -cell_simplex 0 -refinement_uniform -num_dof 1,0,0,0 -order hilbert
+  test:
+    suffix: nd
+    args: -dim 2 -interpolate 1 -cell_simplex 0 -refinement_uniform -num_dof 1,0,0 -order nd
+  test:
+    suffix: reorder_option
+    args: -dim 2 -interpolate 1 -cell_simplex 0 -refinement_uniform -num_dof 1,0,0 -distribute -dist_dm_plex_reorder hilbert
   # Parallel tests
+  test:
+    suffix: dist_0
+    nsize: 2
+    args: -dim 2 -interpolate 1 -cell_simplex 0 -refinement_uniform -num_dof 1,0,0 -distribute -dist_dm_plex_reorder hilbert -order hilbert
+  test:
+    suffix: dist_1
+    nsize: 2
+    args: -dim 2 -interpolate 1 -cell_simplex 0 -refinement_uniform -num_dof 1,0,0 -distribute -order rcm
   # Grouping tests
   test:
     suffix: group_1
@@ -12,6 +12,7 @@ typedef struct {
   PetscInt *numComponents;   /* The number of field components */
   PetscInt *numDof;          /* The dof signature for the section */
   PetscBool reuseArray;      /* Pass in user allocated array to VecGetClosure() */
+  PetscBool dofIndex;        /* Use the closure dof index from DMPlexCreateClosureDofIndex() */
   /* Test data */
   PetscBool errors;            /* Treat failures as errors */
   PetscInt  iterations;        /* The number of iterations for a query */
@@ -36,6 +37,7 @@ static PetscErrorCode ProcessOptions(AppCtx *options)
   options->numComponents     = NULL;
   options->numDof            = NULL;
   options->reuseArray        = PETSC_FALSE;
+  options->dofIndex          = PETSC_FALSE;
   options->errors            = PETSC_FALSE;
   options->iterations        = 1;
   options->maxConeTime       = 0.0;
@@ -70,6 +72,7 @@ static PetscErrorCode ProcessOptions(AppCtx *options)
   }
 
   ierr = PetscOptionsBool("-reuse_array", "Pass in user allocated array to VecGetClosure()", "ex9.c", options->reuseArray, &options->reuseArray, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-closure_dof_index", "Check and use the closure dof index from DMPlexCreateClosureDofIndex()", "ex9.c", options->dofIndex, &options->dofIndex, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-errors", "Treat failures as errors", "ex9.c", options->errors, &options->errors, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-iterations", "The number of iterations for a query", "ex9.c", options->iterations, &options->iterations, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsReal("-max_cone_time", "The maximum time per run for DMPlexGetCone()", "ex9.c", options->maxConeTime, &options->maxConeTime, NULL);CHKERRQ(ierr);
@@ -339,6 +342,7 @@ static PetscErrorCode TestVecClosure(DM dm, PetscBool useIndex, PetscBool useSpe
   ierr = DMSetDefaultSection(dm, s);CHKERRQ(ierr);
   if (useIndex) {ierr = DMPlexCreateClosureIndex(dm, s);CHKERRQ(ierr);}
   if (useSpectral) {ierr = DMPlexCreateSpectralClosurePermutation(dm, PETSC_DETERMINE, s);CHKERRQ(ierr);}
+  if (user->dofIndex) {ierr = DMPlexCreateClosureDofIndex(dm, s, NULL);CHKERRQ(ierr);}
   ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
   ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
   ierr = DMGetLocalVector(dm, &v);CHKERRQ(ierr);
@@ -372,6 +376,144 @@ static PetscErrorCode TestVecClosure(DM dm, PetscBool useIndex, PetscBool useSpe
   PetscFunctionReturn(0);
 }
 
+/* Reverses the edge dofs for negative orientations and flips the sign of every other one */
+static PetscErrorCode SetEdgeSymmetries(DM dm, PetscSection s, AppCtx *user)
+{
+  DMLabel        depthLabel;
+  PetscInt       f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetDepthLabel(dm, &depthLabel);CHKERRQ(ierr);
+  for (f = 0; f < PetscMax(1, user->numFields); ++f) {
+    PetscSectionSym sym;
+    PetscInt      **perms;
+    PetscScalar   **flips;
+    PetscInt        numDof = user->numDof[f*(user->dim+1)+1], o, i;
+
+    if (!numDof) continue;
+    ierr = PetscSectionSymCreateLabel(PetscObjectComm((PetscObject) s), depthLabel, &sym);CHKERRQ(ierr);
+    ierr = PetscCalloc1(4, &perms);CHKERRQ(ierr);
+    ierr = PetscCalloc1(4, &flips);CHKERRQ(ierr);
+    for (o = -2; o < 0; ++o) {
+      ierr = PetscMalloc1(numDof, &perms[o+2]);CHKERRQ(ierr);
+      ierr = PetscMalloc1(numDof, &flips[o+2]);CHKERRQ(ierr);
+      for (i = 0; i < numDof; ++i) {perms[o+2][i] = numDof-1-i; flips[o+2][i] = i%2 ? -1.0 : 1.0;}
+    }
+    ierr = PetscSectionSymLabelSetStratum(sym, 1, numDof, -2, 2, PETSC_OWN_POINTER, (const PetscInt **) perms, (const PetscScalar **) flips);CHKERRQ(ierr);
+    if (user->numFields) {ierr = PetscSectionSetFieldSym(s, f, sym);CHKERRQ(ierr);}
+    else                 {ierr = PetscSectionSetSym(s, sym);CHKERRQ(ierr);}
+    ierr = PetscSectionSymDestroy(&sym);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Applies the closure operations for all cells, storing the closure values and indices in cvals and cinds */
+static PetscErrorCode ApplyClosures(DM dm, Vec v, Vec w, Mat A, PetscInt clSize, PetscScalar cvals[], PetscInt cinds[])
+{
+  PetscSection   s, gs;
+  PetscScalar   *elemMat;
+  PetscInt       cStart, cEnd, c, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetDefaultSection(dm, &s);CHKERRQ(ierr);
+  ierr = DMGetDefaultGlobalSection(dm, &gs);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1(clSize*clSize, &elemMat);CHKERRQ(ierr);
+  ierr = VecSet(w, 0.0);CHKERRQ(ierr);
+  ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *closure = NULL, *userClosure = &cvals[(c-cStart)*clSize];
+    PetscInt    *indices, numIndices, size = clSize;
+
+    ierr = DMPlexVecGetClosure(dm, NULL, v, c, &size, &userClosure);CHKERRQ(ierr);
+    if (size != clSize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure size %D should be %D", size, clSize);
+    ierr = DMPlexVecGetClosure(dm, NULL, v, c, &size, &closure);CHKERRQ(ierr);
+    for (i = 0; i < size; ++i) if (closure[i] != userClosure[i]) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure of cell %D differs for a user array", c);
+    ierr = DMPlexVecSetClosure(dm, NULL, w, c, closure, ADD_VALUES);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosure(dm, NULL, w, c, closure, INSERT_BC_VALUES);CHKERRQ(ierr);
+    ierr = DMPlexVecRestoreClosure(dm, NULL, v, c, &size, &closure);CHKERRQ(ierr);
+    ierr = DMPlexGetClosureIndices(dm, s, gs, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+    ierr = PetscMemcpy(&cinds[(c-cStart)*clSize], indices, clSize * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = DMPlexRestoreClosureIndices(dm, s, gs, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+    for (i = 0; i < clSize*clSize; ++i) elemMat[i] = (PetscScalar) (c*clSize*clSize + i + 1);
+    ierr = DMPlexMatSetClosure(dm, NULL, NULL, A, c, elemMat, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(elemMat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TestClosureDofIndex(DM dm, AppCtx *user)
+{
+  PetscSection   s;
+  Vec            v, w, wRef;
+  Mat            A, ARef;
+  PetscScalar   *vals, *valsRef, *batch, *a;
+  PetscInt      *inds, *indsRef;
+  PetscInt       cStart, cEnd, clSize, batchSize, n, i;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (user->numFields) {
+    PetscInt bcField[1] = {0};
+    IS       bcPoints[1];
+
+    ierr = DMGetStratumIS(dm, "marker", 1, &bcPoints[0]);CHKERRQ(ierr);
+    ierr = DMPlexCreateSection(dm, user->dim, user->numFields, user->numComponents, user->numDof, 1, bcField, NULL, bcPoints, NULL, &s);CHKERRQ(ierr);
+    ierr = ISDestroy(&bcPoints[0]);CHKERRQ(ierr);
+  } else {
+    ierr = DMPlexCreateSection(dm, user->dim, user->numFields, user->numComponents, user->numDof, 0, NULL, NULL, NULL, NULL, &s);CHKERRQ(ierr);
+  }
+  if (user->interpolate) {ierr = SetEdgeSymmetries(dm, s, user);CHKERRQ(ierr);}
+  ierr = DMSetDefaultSection(dm, s);CHKERRQ(ierr);
+  if (user->spectral) {ierr = DMPlexCreateSpectralClosurePermutation(dm, PETSC_DETERMINE, s);CHKERRQ(ierr);}
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(dm, &v);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(v, &n);CHKERRQ(ierr);
+  ierr = VecGetArray(v, &a);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) a[i] = (PetscScalar) (i+1);
+  ierr = VecRestoreArray(v, &a);CHKERRQ(ierr);
+  ierr = VecDuplicate(v, &w);CHKERRQ(ierr);
+  ierr = VecDuplicate(v, &wRef);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(dm, &A);CHKERRQ(ierr);
+  ierr = MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &ARef);CHKERRQ(ierr);
+  ierr = DMPlexVecGetClosure(dm, NULL, v, cStart, &clSize, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc5(clSize*(cEnd-cStart), &vals, clSize*(cEnd-cStart), &valsRef, clSize*(cEnd-cStart), &batch, clSize*(cEnd-cStart), &inds, clSize*(cEnd-cStart), &indsRef);CHKERRQ(ierr);
+  /* Reference results from traversing the closures */
+  ierr = ApplyClosures(dm, v, wRef, ARef, clSize, valsRef, indsRef);CHKERRQ(ierr);
+  /* Results from the precomputed closure dofs */
+  ierr = DMPlexCreateClosureDofIndex(dm, NULL, NULL);CHKERRQ(ierr);
+  ierr = ApplyClosures(dm, v, w, A, clSize, vals, inds);CHKERRQ(ierr);
+  ierr = DMPlexVecGetClosureBatch(dm, NULL, v, cStart, cEnd, &batchSize, NULL);CHKERRQ(ierr);
+  if (batchSize != clSize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Batch closure size %D should be %D", batchSize, clSize);
+  ierr = DMPlexVecGetClosureBatch(dm, NULL, v, cStart, cEnd, &batchSize, batch);CHKERRQ(ierr);
+  for (i = 0; i < clSize*(cEnd-cStart); ++i) {
+    if (vals[i]  != valsRef[i]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cached closure value %D is %g should be %g", i, (double) PetscRealPart(vals[i]), (double) PetscRealPart(valsRef[i]));
+    if (batch[i] != valsRef[i]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Batch closure value %D is %g should be %g", i, (double) PetscRealPart(batch[i]), (double) PetscRealPart(valsRef[i]));
+    if (inds[i]  != indsRef[i]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cached closure index %D is %D should be %D", i, inds[i], indsRef[i]);
+  }
+  ierr = VecAXPY(w, -1.0, wRef);CHKERRQ(ierr);
+  ierr = VecNorm(w, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  if (norm > 0.0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cached closure update differs by %g", (double) norm);
+  ierr = MatAXPY(A, -1.0, ARef, DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(A, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  if (norm > 0.0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cached closure matrix assembly differs by %g", (double) norm);
+  ierr = PetscPrintf(PETSC_COMM_SELF, "Closure dof index: %D cells with closure size %D match\n", cEnd-cStart, clSize);CHKERRQ(ierr);
+  ierr = PetscFree5(vals, valsRef, batch, inds, indsRef);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&ARef);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&wRef);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode CleanupContext(AppCtx *user)
 {
   PetscErrorCode ierr;
@@ -392,6 +534,7 @@ int main(int argc, char **argv)
   ierr = ProcessOptions(&user);CHKERRQ(ierr);
   ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
   ierr = CreateMesh(PETSC_COMM_SELF, &user, &dm);CHKERRQ(ierr);
+  if (user.dofIndex) {ierr = TestClosureDofIndex(dm, &user);CHKERRQ(ierr);}
   ierr = TestCone(dm, &user);CHKERRQ(ierr);
   ierr = TestTransitiveClosure(dm, &user);CHKERRQ(ierr);
   ierr = TestVecClosure(dm, PETSC_FALSE, PETSC_FALSE, &user);CHKERRQ(ierr);
@@ -450,6 +593,17 @@ int main(int argc, char **argv)
     TODO: missing output file
     args: -interpolate -refinement_limit 1.0e-4 -num_fields 1 -num_components 1 -num_dof 1,0,0 -iterations 2 -max_cone_time 2.1e-8 -max_closure_time 6.5e-7 -max_vec_closure_time 1.2e-6
 
+  # Closure dof index tests
+  test:
+    suffix: dof_index_0
+    args: -cellSimplex 0 -interpolate -num_fields 2 -num_components 2,1 -num_dof 1,2,1,1,0,0 -closure_dof_index -reuse_array -max_cone_time 1 -max_closure_time 1 -max_vec_closure_time 1
+  test:
+    suffix: dof_index_1
+    args: -cellSimplex 0 -interpolate -num_fields 1 -num_components 1 -num_dof 1,3,9 -spectral -closure_dof_index -max_cone_time 1 -max_closure_time 1 -max_vec_closure_time 1
+  test:
+    suffix: dof_index_2
+    args: -dim 3 -cellSimplex 0 -interpolate -num_fields 2 -num_components 3,1 -num_dof 1,2,4,8,1,0,0,0 -closure_dof_index -max_cone_time 1 -max_closure_time 1 -max_vec_closure_time 1
+
   # 2D Simplex P_1 vector tests
   # 2D Simplex P_2 scalar tests
   # 2D Simplex P_2 vector tests
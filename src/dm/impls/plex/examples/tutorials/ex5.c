@@ -11,6 +11,8 @@ typedef struct {
   char      filename[PETSC_MAX_PATH_LEN]; /* Mesh filename */
   PetscViewerFormat format;               /* Format to write and read */
   PetscBool second_write_read;            /* Write and read for the 2nd time */
+  PetscBool check;                        /* Run DMPlex checks on the loaded mesh */
+  PetscBool cellSimplex;                  /* The mesh has simplices, otherwise tensor cells */
 } AppCtx;
 
 static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
@@ -24,6 +26,8 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->filename[0] = '\0';
   options->format = PETSC_VIEWER_DEFAULT;
   options->second_write_read = PETSC_FALSE;
+  options->check = PETSC_FALSE;
+  options->cellSimplex = PETSC_TRUE;
 
   ierr = PetscOptionsBegin(comm, "", "Meshing Problem Options", "DMPLEX");CHKERRQ(ierr);
   ierr = PetscOptionsBool("-compare", "Compare the meshes using DMPlexEqual()", "ex5.c", options->compare, &options->compare, NULL);CHKERRQ(ierr);
@@ -32,6 +36,8 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   ierr = PetscOptionsString("-filename", "The mesh file", "ex5.c", options->filename, options->filename, PETSC_MAX_PATH_LEN, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnum("-format", "Format to write and read", "ex5.c", PetscViewerFormats, (PetscEnum)options->format, (PetscEnum*)&options->format, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-second_write_read", "Write and read for the 2nd time", "ex5.c", options->second_write_read, &options->second_write_read, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-check", "Run DMPlex checks on the loaded mesh", "ex5.c", options->check, &options->check, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-cell_simplex", "The mesh has simplices if true, otherwise tensor cells", "ex5.c", options->cellSimplex, &options->cellSimplex, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();
   PetscFunctionReturn(0);
 };
@@ -101,6 +107,21 @@ int main(int argc, char **argv)
   /* TODO: Is it still true? */
   /* The NATIVE format for coordiante viewing is killing parallel output, since we have a local vector. Map it to global, and it will work. */
 
+  /* The loaded mesh is spread over all processes, so check it is valid and lost no cells */
+  if (user.check) {
+    PetscInt cStart, cEnd, numCells[2], numCellsGlobal[2];
+
+    ierr = DMPlexCheckSymmetry(dmnew);CHKERRQ(ierr);
+    ierr = DMPlexCheckSkeleton(dmnew, user.cellSimplex, 0);CHKERRQ(ierr);
+    if (user.interpolate) {ierr = DMPlexCheckFaces(dmnew, user.cellSimplex, 0);CHKERRQ(ierr);}
+    ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    numCells[0] = cEnd - cStart;
+    ierr = DMPlexGetHeightStratum(dmnew, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    numCells[1] = cEnd - cStart;
+    ierr = MPIU_Allreduce(numCells, numCellsGlobal, 2, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);CHKERRQ(ierr);
+    if (numCellsGlobal[0] != numCellsGlobal[1]) SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Loaded mesh has %D cells, saved mesh has %D", numCellsGlobal[1], numCellsGlobal[0]);
+  }
+
   /* This currently makes sense only for sequential meshes. */
   if (user.compare) {
     ierr = DMPlexEqual(dmnew, dm, &flg);CHKERRQ(ierr);
@@ -162,6 +183,15 @@ int main(int argc, char **argv)
     args: -filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/blockcylinder-50.h5
     args: -dm_plex_create_from_hdf5_xdmf -distribute 0 -format hdf5_xdmf -second_write_read -compare
 
+  # Parallel load of the native format, the cells of the loaded mesh are dealt out to all processes
+  test:
+    suffix: 5
+    TODO: needs outputs produced on a build with HDF5 and ExodusII
+    requires: hdf5 exodusii
+    nsize: {{2 3}}
+    args: -filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/blockcylinder-50.exo
+    args: -petscpartitioner_type simple -format hdf5_petsc -interpolate {{0 1}} -cell_simplex 0 -check
+
   # reproduce PetscSFView() crash - fixed, left as regression test
   test:
     suffix: new_dm_view
@@ -1101,6 +1101,7 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   ierr = DMLabelDestroy(&mesh->subpointMap);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->globalVertexNumbers);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->globalCellNumbers);CHKERRQ(ierr);
+  ierr = DMPlexDestroyClosureDofIndex_Internal(dm);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&mesh->anchorSection);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->anchorIS);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&mesh->parentSection);CHKERRQ(ierr);
@@ -4040,6 +4041,42 @@ static PetscErrorCode DMPlexRestoreCompressedClosure(DM dm, PetscSection section
   PetscFunctionReturn(0);
 }
 
+/* Returns the cached closure dofs of point from DMPlexCreateClosureDofIndex(), or NULL if they do not apply */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexGetCachedClosureDofs_Static(DM dm, PetscSection section, PetscSection globalSection, PetscInt point, PetscInt *numDofs, const PetscInt *dofs[], const PetscInt *gdofs[], const PetscScalar *flips[])
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscInt       cStart, cEnd, off;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginHot;
+  *dofs = NULL;
+  if (gdofs) *gdofs = NULL;
+  if (!mesh->clDofSection || section != mesh->clLocalSection) PetscFunctionReturn(0);
+  if (globalSection && (globalSection != mesh->clGlobalSection || !mesh->clGlobalDofs || mesh->anchorSection)) PetscFunctionReturn(0);
+  ierr = PetscSectionGetChart(mesh->clDofSection, &cStart, &cEnd);CHKERRQ(ierr);
+  if ((point < cStart) || (point >= cEnd)) PetscFunctionReturn(0);
+  ierr = PetscSectionGetDof(mesh->clDofSection, point, numDofs);CHKERRQ(ierr);
+  ierr = PetscSectionGetOffset(mesh->clDofSection, point, &off);CHKERRQ(ierr);
+  *dofs  = &mesh->clDofs[off];
+  if (gdofs) *gdofs = &mesh->clGlobalDofs[off];
+  *flips = mesh->clFlips ? &mesh->clFlips[off] : NULL;
+  PetscFunctionReturn(0);
+}
+
+/* Gathers the closure values using the cached dofs, decoding constrained dofs */
+PETSC_STATIC_INLINE void DMPlexVecGetClosure_Cached_Static(PetscInt numDofs, const PetscInt dofs[], const PetscScalar flips[], const PetscInt clperm[], const PetscScalar vArray[], PetscScalar array[])
+{
+  PetscInt q;
+
+  if (clperm) {
+    if (flips) {for (q = 0; q < numDofs; ++q) {const PetscInt d = dofs[q]; array[clperm[q]] = vArray[d < 0 ? -(d+1) : d] * flips[q];}}
+    else       {for (q = 0; q < numDofs; ++q) {const PetscInt d = dofs[q]; array[clperm[q]] = vArray[d < 0 ? -(d+1) : d];}}
+  } else {
+    if (flips) {for (q = 0; q < numDofs; ++q) {const PetscInt d = dofs[q]; array[q] = vArray[d < 0 ? -(d+1) : d] * flips[q];}}
+    else       {for (q = 0; q < numDofs; ++q) {const PetscInt d = dofs[q]; array[q] = vArray[d < 0 ? -(d+1) : d];}}
+  }
+}
+
 PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Static(DM dm, PetscSection section, PetscInt numPoints, const PetscInt points[], const PetscInt clperm[], const PetscScalar vArray[], PetscInt *size, PetscScalar array[])
 {
   PetscInt          offset = 0, p;
@@ -4183,9 +4220,9 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
   PetscSection       clSection;
   IS                 clPoints;
   PetscScalar       *array;
-  const PetscScalar *vArray;
+  const PetscScalar *vArray, *flips;
   PetscInt          *points = NULL;
-  const PetscInt    *clp, *perm;
+  const PetscInt    *clp, *perm, *dofs;
   PetscInt           depth, numFields, numPoints, size;
   PetscErrorCode     ierr;
 
@@ -4200,9 +4237,28 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecGetClosure_Depth1_Static(dm, section, v, point, csize, values);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &perm);CHKERRQ(ierr);
+  /* Use the precomputed closure dofs */
+  ierr = DMPlexGetCachedClosureDofs_Static(dm, section, NULL, point, &size, &dofs, NULL, &flips);CHKERRQ(ierr);
+  if (dofs) {
+    if (!values) {
+      if (csize) *csize = size;
+      PetscFunctionReturn(0);
+    }
+    if (!*values) {ierr = DMGetWorkArray(dm, size, MPIU_SCALAR, &array);CHKERRQ(ierr);}
+    else {
+      if (size > *csize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Size of input array %D < actual size %D", *csize, size);
+      array = *values;
+    }
+    ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+    DMPlexVecGetClosure_Cached_Static(size, dofs, flips, perm, vArray, array);
+    ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+    if (csize) *csize = size;
+    *values = array;
+    PetscFunctionReturn(0);
+  }
   /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
-  ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &perm);CHKERRQ(ierr);
   /* Get array */
   if (!values || !*values) {
     PetscInt asize = 0, dof, p;
@@ -4275,6 +4331,67 @@ PetscErrorCode DMPlexVecRestoreClosure(DM dm, PetscSection section, Vec v, Petsc
   PetscFunctionReturn(0);
 }
 
+/*@C
+  DMPlexVecGetClosureBatch - Get the values on the closures of a contiguous range of cells in a single call
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in v, or NULL to use the default section
+. v - The local vector
+. cStart - The first cell
+. cEnd - One past the last cell
+- values - An array of length (cEnd - cStart) times the closure size, or NULL
+
+  Output Parameters:
++ csize - The number of values in the closure of each cell
+- values - The closure values, stored cell by cell in the order of DMPlexVecGetClosure()
+
+  Notes:
+  All cells in the range must have closures of the same size. If values is NULL, only csize is computed, so
+  that the caller can allocate the array. When DMPlexCreateClosureDofIndex() has been called for this section,
+  the values are gathered directly from the precomputed dof indices without traversing the closures.
+
+  Level: intermediate
+
+.seealso DMPlexVecGetClosure(), DMPlexCreateClosureDofIndex(), DMPlexVecSetClosure()
+@*/
+PetscErrorCode DMPlexVecGetClosureBatch(DM dm, PetscSection section, Vec v, PetscInt cStart, PetscInt cEnd, PetscInt *csize, PetscScalar values[])
+{
+  const PetscScalar *vArray, *flips;
+  const PetscInt    *perm, *dofs;
+  PetscInt           clSize = 0, size, c;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  PetscValidIntPointer(csize, 6);
+  if (cEnd > cStart) {ierr = DMPlexVecGetClosure(dm, section, v, cStart, &clSize, NULL);CHKERRQ(ierr);}
+  *csize = clSize;
+  if (!values || cEnd <= cStart) PetscFunctionReturn(0);
+  ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &perm);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *cvalues = &values[(c-cStart)*clSize];
+
+    ierr = DMPlexGetCachedClosureDofs_Static(dm, section, NULL, c, &size, &dofs, NULL, &flips);CHKERRQ(ierr);
+    if (dofs) {
+      if (size != clSize) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Closure size %D of cell %D differs from the batch closure size %D", size, c, clSize);
+      DMPlexVecGetClosure_Cached_Static(size, dofs, flips, perm, vArray, cvalues);
+    } else {
+      size = clSize;
+      ierr = DMPlexVecGetClosure(dm, section, v, c, &size, &cvalues);CHKERRQ(ierr);
+      if (size != clSize) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Closure size %D of cell %D differs from the batch closure size %D", size, c, clSize);
+    }
+  }
+  ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_STATIC_INLINE void add   (PetscScalar *x, PetscScalar y) {*x += y;}
 PETSC_STATIC_INLINE void insert(PetscScalar *x, PetscScalar y) {*x  = y;}
 
@@ -4523,6 +4640,22 @@ PETSC_STATIC_INLINE PetscErrorCode updatePointFieldsBC_private(PetscSection sect
   PetscFunctionReturn(0);
 }
 
+/* Scatters the closure values using the cached dofs, where negative entries are constrained dofs */
+PETSC_STATIC_INLINE void DMPlexVecSetClosure_Cached_Static(PetscInt numDofs, const PetscInt dofs[], const PetscScalar flips[], const PetscInt clperm[], void (*fuse)(PetscScalar*, PetscScalar), PetscBool setBC, PetscBool onlyBC, const PetscScalar values[], PetscScalar array[])
+{
+  PetscInt q;
+
+  for (q = 0; q < numDofs; ++q) {
+    PetscInt d = dofs[q];
+
+    if (d < 0) {
+      if (!setBC) continue;
+      d = -(d+1);
+    } else if (onlyBC) continue;
+    fuse(&array[d], values[clperm ? clperm[q] : q] * (flips ? flips[q] : 1.));
+  }
+}
+
 PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Depth1_Static(DM dm, PetscSection section, Vec v, PetscInt point, const PetscScalar values[], InsertMode mode)
 {
   PetscScalar    *array;
@@ -4604,12 +4737,13 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Depth1_Static(DM dm, Pets
 @*/
 PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt point, const PetscScalar values[], InsertMode mode)
 {
-  PetscSection    clSection;
-  IS              clPoints;
-  PetscScalar    *array;
-  PetscInt       *points = NULL;
-  const PetscInt *clp, *clperm;
-  PetscInt        depth, numFields, numPoints, p;
+  PetscSection       clSection;
+  IS                 clPoints;
+  PetscScalar       *array;
+  const PetscScalar *cflips;
+  PetscInt          *points = NULL;
+  const PetscInt    *clp, *clperm, *dofs;
+  PetscInt           depth, numFields, numPoints, numDofs, p;
   PetscErrorCode  ierr;
 
   PetscFunctionBeginHot;
@@ -4623,8 +4757,25 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecSetClosure_Depth1_Static(dm, section, v, point, values, mode);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
-  /* Get points */
   ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &clperm);CHKERRQ(ierr);
+  /* Use the precomputed closure dofs */
+  ierr = DMPlexGetCachedClosureDofs_Static(dm, section, NULL, point, &numDofs, &dofs, NULL, &cflips);CHKERRQ(ierr);
+  if (dofs) {
+    ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+    switch (mode) {
+    case INSERT_VALUES:     DMPlexVecSetClosure_Cached_Static(numDofs, dofs, cflips, clperm, insert, PETSC_FALSE, PETSC_FALSE, values, array);break;
+    case INSERT_ALL_VALUES: DMPlexVecSetClosure_Cached_Static(numDofs, dofs, cflips, clperm, insert, PETSC_TRUE,  PETSC_FALSE, values, array);break;
+    case INSERT_BC_VALUES:  DMPlexVecSetClosure_Cached_Static(numDofs, dofs, cflips, clperm, insert, PETSC_TRUE,  PETSC_TRUE,  values, array);break;
+    case ADD_VALUES:        DMPlexVecSetClosure_Cached_Static(numDofs, dofs, cflips, clperm, add,    PETSC_FALSE, PETSC_FALSE, values, array);break;
+    case ADD_ALL_VALUES:    DMPlexVecSetClosure_Cached_Static(numDofs, dofs, cflips, clperm, add,    PETSC_TRUE,  PETSC_FALSE, values, array);break;
+    case ADD_BC_VALUES:     DMPlexVecSetClosure_Cached_Static(numDofs, dofs, cflips, clperm, add,    PETSC_TRUE,  PETSC_TRUE,  values, array);break;
+    default:
+      SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+    }
+    ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   /* Get array */
   ierr = VecGetArray(v, &array);CHKERRQ(ierr);
@@ -5502,15 +5653,16 @@ PetscErrorCode DMPlexAnchorsModifyMat(DM dm, PetscSection section, PetscInt numP
 @*/
 PetscErrorCode DMPlexGetClosureIndices(DM dm, PetscSection section, PetscSection globalSection, PetscInt point, PetscInt *numIndices, PetscInt **indices, PetscInt *outOffsets)
 {
-  PetscSection    clSection;
-  IS              clPoints;
-  const PetscInt *clp;
-  const PetscInt  **perms[32] = {NULL};
-  PetscInt       *points = NULL, *pointsNew;
-  PetscInt        numPoints, numPointsNew;
-  PetscInt        offsets[32];
-  PetscInt        Nf, Nind, NindNew, off, globalOff, f, p;
-  PetscErrorCode  ierr;
+  PetscSection       clSection;
+  IS                 clPoints;
+  const PetscInt    *clp, *dofs, *gdofs;
+  const PetscScalar *flips;
+  const PetscInt   **perms[32] = {NULL};
+  PetscInt          *points = NULL, *pointsNew;
+  PetscInt           numPoints, numPointsNew;
+  PetscInt           offsets[32];
+  PetscInt           Nf, Nind, NindNew, off, globalOff, f, p;
+  PetscErrorCode     ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
@@ -5520,6 +5672,15 @@ PetscErrorCode DMPlexGetClosureIndices(DM dm, PetscSection section, PetscSection
   PetscValidPointer(indices, 5);
   ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
   if (Nf > 31) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D limited to 31", Nf);
+  /* Use the precomputed closure indices */
+  ierr = DMPlexGetCachedClosureDofs_Static(dm, section, globalSection, point, &Nind, &dofs, &gdofs, &flips);CHKERRQ(ierr);
+  if (dofs && (!outOffsets || !Nf)) {
+    ierr = DMGetWorkArray(dm, Nind, MPIU_INT, indices);CHKERRQ(ierr);
+    ierr = PetscMemcpy(*indices, gdofs, Nind * sizeof(PetscInt));CHKERRQ(ierr);
+    if (outOffsets) outOffsets[0] = 0;
+    if (numIndices) *numIndices = Nind;
+    PetscFunctionReturn(0);
+  }
   ierr = PetscMemzero(offsets, 32 * sizeof(PetscInt));CHKERRQ(ierr);
   /* Get points in closure */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
@@ -5575,6 +5736,7 @@ PetscErrorCode DMPlexGetClosureIndices(DM dm, PetscSection section, PetscSection
       DMPlexGetIndicesPointFields_Internal(section, points[2*p], globalOff < 0 ? -(globalOff+1) : globalOff, offsets, PETSC_FALSE, perms, p, *indices);
     }
   } else {
+    if (outOffsets) outOffsets[0] = 0;
     for (p = 0, off = 0; p < numPoints; p++) {
       const PetscInt *perm = perms[0] ? perms[0][p] : NULL;
 
@@ -5625,6 +5787,33 @@ PetscErrorCode DMPlexRestoreClosureIndices(DM dm, PetscSection section, PetscSec
   PetscFunctionReturn(0);
 }
 
+/* Inserts the element matrix of 'point' on the closure indices, reporting them if the insertion fails */
+static PetscErrorCode DMPlexMatSetClosureValues_Static(DM dm, Mat A, PetscInt point, PetscInt numIndices, const PetscInt indices[], const PetscScalar values[], InsertMode mode)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr);}
+  ierr = MatSetValues(A, numIndices, indices, numIndices, indices, values, mode);
+  if (mesh->printFEM > 1) {
+    PetscInt i;
+    ierr = PetscPrintf(PETSC_COMM_SELF, "  Indices:");CHKERRQ(ierr);
+    for (i = 0; i < numIndices; ++i) {ierr = PetscPrintf(PETSC_COMM_SELF, " %D", indices[i]);CHKERRQ(ierr);}
+    ierr = PetscPrintf(PETSC_COMM_SELF, "\n");CHKERRQ(ierr);
+  }
+  if (ierr) {
+    PetscMPIInt    rank;
+    PetscErrorCode ierr2;
+
+    ierr2 = MPI_Comm_rank(PetscObjectComm((PetscObject)A), &rank);CHKERRQ(ierr2);
+    ierr2 = (*PetscErrorPrintf)("[%d]ERROR in DMPlexMatSetClosure\n", rank);CHKERRQ(ierr2);
+    ierr2 = DMPlexPrintMatSetValues(PETSC_VIEWER_STDERR_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr2);
+    CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexMatSetClosure - Set an array of the values on the closure of 'point'
 
@@ -5648,11 +5837,11 @@ PetscErrorCode DMPlexRestoreClosureIndices(DM dm, PetscSection section, PetscSec
 @*/
 PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection globalSection, Mat A, PetscInt point, const PetscScalar values[], InsertMode mode)
 {
-  DM_Plex            *mesh   = (DM_Plex*) dm->data;
   PetscSection        clSection;
   IS                  clPoints;
   PetscInt           *points = NULL, *newPoints;
-  const PetscInt     *clp;
+  const PetscInt     *clp, *dofs, *gdofs;
+  const PetscScalar  *cflips;
   PetscInt           *indices;
   PetscInt            offsets[32];
   const PetscInt    **perms[32] = {NULL};
@@ -5671,6 +5860,29 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (numFields > 31) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D limited to 31", numFields);
+  /* Use the precomputed closure indices */
+  ierr = DMPlexGetCachedClosureDofs_Static(dm, section, globalSection, point, &numIndices, &dofs, &gdofs, &cflips);CHKERRQ(ierr);
+  if (dofs) {
+    if (values && cflips) { /* apply sign changes to the element matrix */
+      PetscInt i, k;
+
+      ierr = DMGetWorkArray(dm,numIndices*numIndices,MPIU_SCALAR,&valCopy);CHKERRQ(ierr);
+      ierr = PetscMemcpy(valCopy, values, numIndices*numIndices * sizeof(PetscScalar));CHKERRQ(ierr);
+      for (i = 0; i < numIndices; ++i) {
+        const PetscScalar fval = cflips[i];
+
+        if (fval == (PetscScalar) 1.0) continue;
+        for (k = 0; k < numIndices; ++k) {
+          valCopy[numIndices * i + k] *= fval;
+          valCopy[numIndices * k + i] *= fval;
+        }
+      }
+      values = valCopy;
+    }
+    ierr = DMPlexMatSetClosureValues_Static(dm, A, point, numIndices, gdofs, values, mode);CHKERRQ(ierr);
+    if (valCopy) {ierr = DMRestoreWorkArray(dm,numIndices*numIndices,MPIU_SCALAR,&valCopy);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
   ierr = PetscMemzero(offsets, 32 * sizeof(PetscInt));CHKERRQ(ierr);
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   for (p = 0, numIndices = 0; p < numPoints*2; p += 2) {
@@ -5755,24 +5967,7 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
       DMPlexGetIndicesPoint_Internal(section, points[2*p], globalOff < 0 ? -(globalOff+1) : globalOff, &off, PETSC_FALSE, perm, indices);
     }
   }
-  if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr);}
-  ierr = MatSetValues(A, numIndices, indices, numIndices, indices, values, mode);
-  if (mesh->printFEM > 1) {
-    PetscInt i;
-    ierr = PetscPrintf(PETSC_COMM_SELF, "  Indices:");CHKERRQ(ierr);
-    for (i = 0; i < numIndices; ++i) {ierr = PetscPrintf(PETSC_COMM_SELF, " %D", indices[i]);CHKERRQ(ierr);}
-    ierr = PetscPrintf(PETSC_COMM_SELF, "\n");CHKERRQ(ierr);
-  }
-  if (ierr) {
-    PetscMPIInt    rank;
-    PetscErrorCode ierr2;
-
-    ierr2 = MPI_Comm_rank(PetscObjectComm((PetscObject)A), &rank);CHKERRQ(ierr2);
-    ierr2 = (*PetscErrorPrintf)("[%d]ERROR in DMPlexMatSetClosure\n", rank);CHKERRQ(ierr2);
-    ierr2 = DMPlexPrintMatSetValues(PETSC_VIEWER_STDERR_SELF, A, point, numIndices, indices, 0, NULL, values);CHKERRQ(ierr2);
-    ierr2 = DMRestoreWorkArray(dm, numIndices, MPIU_INT, &indices);CHKERRQ(ierr2);
-    CHKERRQ(ierr);
-  }
+  ierr = DMPlexMatSetClosureValues_Static(dm, A, point, numIndices, indices, values, mode);CHKERRQ(ierr);
   for (f = 0; f < PetscMax(1,numFields); f++) {
     if (numFields) {ierr = PetscSectionRestoreFieldPointSyms(section,f,numPoints,points,&perms[f],&flips[f]);CHKERRQ(ierr);}
     else           {ierr = PetscSectionRestorePointSyms(section,numPoints,points,&perms[f],&flips[f]);CHKERRQ(ierr);}
@@ -2237,7 +2237,8 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *PetscOption
 static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject,DM dm)
 {
   PetscInt       refine = 0, coarsen = 0, r;
-  PetscBool      isHierarchy;
+  PetscBool      isHierarchy, reorder;
+  char           otype[256] = MATORDERINGRCM;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -2311,6 +2312,27 @@ static PetscErrorCode DMSetFromOptions_Plex(PetscOptionItems *PetscOptionsObject
       ierr = DMDestroy(&coarseMesh);CHKERRQ(ierr);
     }
   }
+  /* Handle DMPlex reordering */
+  ierr = PetscOptionsString("-dm_plex_reorder", "Reorder the mesh points for locality with this ordering", "DMPlexGetOrdering", otype, otype, sizeof(otype), &reorder);CHKERRQ(ierr);
+  if (reorder) {
+    DM           pdm;
+    IS           perm;
+    PetscSection section;
+    PetscInt     cMax, fMax, eMax, vMax;
+
+    ierr = DMPlexGetHybridBounds(dm, &cMax, &fMax, &eMax, &vMax);CHKERRQ(ierr);
+    if ((cMax >= 0) || (fMax >= 0) || (eMax >= 0) || (vMax >= 0)) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Cannot reorder a mesh with hybrid points");
+    ierr = DMPlexGetOrdering(dm, otype, NULL, &perm);CHKERRQ(ierr);
+    ierr = DMPlexPermute(dm, perm, &pdm);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+    /* Total hack since we do not pass in a pointer */
+    ierr = DMPlexReplace_Static(dm, pdm);CHKERRQ(ierr);
+    ierr = DMGetDefaultSection(pdm, &section);CHKERRQ(ierr);
+    if (section) {ierr = DMSetDefaultSection(dm, section);CHKERRQ(ierr);}
+    /* The dof SF was built for the old numbering, DMGetDefaultSF() rebuilds it from the permuted section */
+    ierr = PetscSFReset(dm->defaultSF);CHKERRQ(ierr);
+    ierr = DMDestroy(&pdm);CHKERRQ(ierr);
+  }
   /* Handle */
   ierr = DMSetFromOptions_NonRefinement_Plex(PetscOptionsObject, dm);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
@@ -2495,6 +2517,12 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
   mesh->depthState          = -1;
   mesh->globalVertexNumbers = NULL;
   mesh->globalCellNumbers   = NULL;
+  mesh->clDofSection        = NULL;
+  mesh->clLocalSection      = NULL;
+  mesh->clGlobalSection     = NULL;
+  mesh->clDofs              = NULL;
+  mesh->clGlobalDofs        = NULL;
+  mesh->clFlips             = NULL;
   mesh->anchorSection       = NULL;
   mesh->anchorIS            = NULL;
   mesh->createanchors       = NULL;
@@ -1,6 +1,7 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
 #include <petsc/private/isimpl.h>
 #include <petsc/private/vecimpl.h>
+#include <petsc/private/hashmapi.h>
 #include <petscviewerhdf5.h>
 
 PETSC_EXTERN PetscErrorCode VecView_MPI(Vec, PetscViewer);
@@ -733,12 +734,17 @@ typedef struct {
   DM          dm;
   PetscViewer viewer;
   DMLabel     label;
+  PetscSF     sfDir;      /* Maps local points to their entries in the file point directory, NULL for a serial load */
+  PetscLayout dirLayout;
+  PetscInt   *dirFlags;
+  PetscInt   *pointFlags;
 } LabelCtx;
 
 static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5L_info_t *info, void *op_data)
 {
   PetscViewer     viewer = ((LabelCtx *) op_data)->viewer;
   DMLabel         label  = ((LabelCtx *) op_data)->label;
+  PetscSF         sfDir  = ((LabelCtx *) op_data)->sfDir;
   IS              stratumIS;
   const PetscInt *ind;
   PetscInt        value, N, i;
@@ -752,7 +758,7 @@ static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5
   ierr = DMLabelGetName(label, &lname);
   ierr = PetscSNPrintf(group, PETSC_MAX_PATH_LEN, "/labels/%s/%s", lname, name);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PushGroup(viewer, group);CHKERRQ(ierr);
-  {
+  if (!sfDir) {
     /* Force serial load */
     ierr = PetscViewerHDF5ReadSizes(viewer, "indices", NULL, &N);CHKERRQ(ierr);
     ierr = PetscLayoutSetLocalSize(stratumIS->map, !((LabelCtx *) op_data)->rank ? N : 0);CHKERRQ(ierr);
@@ -762,7 +768,30 @@ static herr_t ReadLabelStratumHDF5_Static(hid_t g_id, const char *name, const H5
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
   ierr = ISGetLocalSize(stratumIS, &N);
   ierr = ISGetIndices(stratumIS, &ind);
-  for (i = 0; i < N; ++i) {ierr = DMLabelSetValue(label, ind[i], value);}
+  if (sfDir) {
+    PetscLayout dirLayout  = ((LabelCtx *) op_data)->dirLayout;
+    PetscInt   *dirFlags   = ((LabelCtx *) op_data)->dirFlags;
+    PetscInt   *pointFlags = ((LabelCtx *) op_data)->pointFlags;
+    PetscSF     sfStratum;
+    PetscInt   *ones, nroots, nleaves;
+
+    /* The stratum slab holds file point numbers, so flag them in the directory and pull the flags to the local points */
+    ierr = PetscMalloc1(N, &ones);CHKERRQ(ierr);
+    for (i = 0; i < N; ++i) ones[i] = 1;
+    ierr = PetscSFCreate(PetscObjectComm((PetscObject) viewer), &sfStratum);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sfStratum, dirLayout, N, NULL, PETSC_OWN_POINTER, ind);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(sfStratum, MPIU_INT, ones, dirFlags, MPI_MAX);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sfStratum, MPIU_INT, ones, dirFlags, MPI_MAX);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfStratum);CHKERRQ(ierr);
+    ierr = PetscFree(ones);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfDir, MPIU_INT, dirFlags, pointFlags);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfDir, MPIU_INT, dirFlags, pointFlags);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sfDir, &nroots, &nleaves, NULL, NULL);CHKERRQ(ierr);
+    for (i = 0; i < nleaves; ++i) if (pointFlags[i]) {ierr = DMLabelSetValue(label, i, value);CHKERRQ(ierr);}
+    for (i = 0; i < nroots; ++i) dirFlags[i] = 0;
+  } else {
+    for (i = 0; i < N; ++i) {ierr = DMLabelSetValue(label, ind[i], value);}
+  }
   ierr = ISRestoreIndices(stratumIS, &ind);
   ierr = ISDestroy(&stratumIS);
   return 0;
@@ -781,7 +810,11 @@ static herr_t ReadLabelHDF5_Static(hid_t g_id, const char *name, const H5L_info_
   return err;
 }
 
-PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
+/*
+  If sfDir is given, it maps the local points to the point numbers stored in the file, and each process reads a
+  contiguous slab of every stratum. Otherwise the label indices are local point numbers and are read onto process 0.
+*/
+PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscSF sfDir, PetscViewer viewer)
 {
   LabelCtx        ctx;
   hid_t           fileId, groupId;
@@ -790,102 +823,357 @@ PetscErrorCode DMPlexLoadLabels_HDF5_Internal(DM dm, PetscViewer viewer)
 
   PetscFunctionBegin;
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &ctx.rank);CHKERRQ(ierr);
-  ctx.dm     = dm;
-  ctx.viewer = viewer;
+  ctx.dm         = dm;
+  ctx.viewer     = viewer;
+  ctx.sfDir      = sfDir;
+  ctx.dirLayout  = NULL;
+  ctx.dirFlags   = NULL;
+  ctx.pointFlags = NULL;
+  if (sfDir) {
+    PetscInt nroots, nleaves;
+
+    ierr = PetscSFGetGraph(sfDir, &nroots, &nleaves, NULL, NULL);CHKERRQ(ierr);
+    ierr = PetscLayoutCreate(PetscObjectComm((PetscObject) dm), &ctx.dirLayout);CHKERRQ(ierr);
+    ierr = PetscLayoutSetLocalSize(ctx.dirLayout, nroots);CHKERRQ(ierr);
+    ierr = PetscLayoutSetBlockSize(ctx.dirLayout, 1);CHKERRQ(ierr);
+    ierr = PetscLayoutSetUp(ctx.dirLayout);CHKERRQ(ierr);
+    ierr = PetscCalloc2(nroots, &ctx.dirFlags, nleaves, &ctx.pointFlags);CHKERRQ(ierr);
+  }
   ierr = PetscViewerHDF5PushGroup(viewer, "/labels");CHKERRQ(ierr);
   ierr = PetscViewerHDF5OpenGroup(viewer, &fileId, &groupId);CHKERRQ(ierr);
   PetscStackCallHDF5(H5Literate,(groupId, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, ReadLabelHDF5_Static, &ctx));
   PetscStackCallHDF5(H5Gclose,(groupId));
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&ctx.dirLayout);CHKERRQ(ierr);
+  ierr = PetscFree2(ctx.dirFlags, ctx.pointFlags);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-/* The first version will read everything onto proc 0, letting the user distribute
-   The next will create a naive partition, and then rebalance after reading
+/*
+  Build the local part of a parallel Plex from a contiguous slab of the DAG stored in the file
+
+  Input Parameters:
++ dm                - The DMPlex
+. numPoints         - The number of points in the slab
+. order             - The file point number of each slab point
+. coneSizes         - The cone size of each slab point
+. cones             - The cones of the slab points, concatenated, in file point numbers
+. ornts             - The cone orientations of the slab points, concatenated
+- numGlobalVertices - The number of vertices in the file coordinate array
+
+  Output Parameters:
++ sfDir         - The SF from the local points to their entries in the point directory
+. numCells      - The number of local cells, which are numbered [0, numCells)
+. numVertices   - The number of local vertices, which are numbered [numCells, numCells+numVertices)
+- vertexNumbers - The row of each local vertex in the file coordinate array
+
+  The slabs are first scattered to a directory, the file point numbers split evenly over the processes, so that the
+  cone of any point can be looked up in parallel. The depth of the points is computed there, and the cells, the points
+  of maximal depth, are dealt out in contiguous chunks of the file order. Points which are in no cone but are not cells,
+  such as isolated vertices, stay on the process holding their directory entry. Each process then pulls the closure of
+  its points from the directory one level at a time. No process ever holds more than its own closure and its share of
+  the directory. As in the serial load, the local points are numbered cells, vertices, and then the intermediate strata
+  from the highest down, each in file order.
+*/
+static PetscErrorCode DMPlexBuildFromDAGSlab_Static(DM dm, PetscInt numPoints, const PetscInt order[], const PetscInt coneSizes[], const PetscInt cones[], const PetscInt ornts[], PetscInt numGlobalVertices, PetscSF *sfDir, PetscInt *numCells, PetscInt *numVertices, PetscInt *vertexNumbers[])
+{
+  MPI_Comm       comm;
+  MPI_Datatype   blockType;
+  PetscLayout    dirLayout, cellLayout;
+  PetscSF        sf, sfPoint;
+  PetscHMapI     pointMap;
+  PetscSFNode   *pointOwner, *rootOwner, *remotePoints;
+  PetscInt      *blocks, *dirSizes, *dirBlocks, *dirFlags, *dirDepth, *entries, *ones, *gpoints, *sizes, *depth, *classSize, *perm, *newPoint, *keys, *localPoints, *vnum;
+  PetscInt       maxConeSize = 0, bs, numDir, dStart, numEntries = 0, numDirCells = 0, numDirOrphans = 0, numDirVertices = 0, off, gsize, nc, nl, fStart, fEnd, numGhosts, maxDepth, d, p, q, c, l;
+  PetscMPIInt    rank;
+  PetscBool      changed, lchanged;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  /* Cones and orientations travel together in fixed blocks */
+  for (p = 0; p < numPoints; ++p) maxConeSize = PetscMax(maxConeSize, coneSizes[p]);
+  ierr = MPIU_Allreduce(&maxConeSize, &bs, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  bs   = 2*PetscMax(bs, 1);
+  ierr = MPI_Type_contiguous((PetscMPIInt) bs, MPIU_INT, &blockType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&blockType);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numPoints*bs, &blocks);CHKERRQ(ierr);
+  for (p = 0, q = 0; p < numPoints; ++p) {
+    for (c = 0; c < bs; ++c) blocks[p*bs+c] = -1;
+    for (c = 0; c < coneSizes[p]; ++c, ++q) {blocks[p*bs+c] = cones[q]; blocks[p*bs+bs/2+c] = ornts[q];}
+  }
+  /* Scatter the slab to the directory */
+  ierr = MPIU_Allreduce(&numPoints, &gsize, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &dirLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(dirLayout, gsize);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(dirLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(dirLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(dirLayout, &numDir);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRange(dirLayout, &dStart, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numDir, &dirSizes, numDir*bs, &dirBlocks, numDir, &dirFlags);CHKERRQ(ierr);
+  for (d = 0; d < numDir; ++d) {dirSizes[d] = -1; dirFlags[d] = 0;}
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, dirLayout, numPoints, NULL, PETSC_OWN_POINTER, order);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, coneSizes, dirSizes, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, coneSizes, dirSizes, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, blockType, blocks, dirBlocks, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, blockType, blocks, dirBlocks, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree(blocks);CHKERRQ(ierr);
+  for (d = 0; d < numDir; ++d) {
+    if (dirSizes[d] < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Point %D is missing from the topology", dStart+d);
+    numEntries += dirSizes[d];
+  }
+  /* Flag the points which lie in some cone, and compute the depth of each point one stratum per sweep */
+  ierr = PetscMalloc1(numDir, &dirDepth);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numEntries, &entries, numEntries, &ones);CHKERRQ(ierr);
+  for (d = 0, q = 0; d < numDir; ++d) {
+    dirDepth[d] = 0;
+    for (c = 0; c < dirSizes[d]; ++c, ++q) {entries[q] = dirBlocks[d*bs+c]; ones[q] = 1;}
+  }
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, dirLayout, numEntries, NULL, PETSC_OWN_POINTER, entries);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, ones, dirFlags, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, ones, dirFlags, MPI_MAX);CHKERRQ(ierr);
+  do {
+    ierr = PetscSFBcastBegin(sf, MPIU_INT, dirDepth, ones);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_INT, dirDepth, ones);CHKERRQ(ierr);
+    lchanged = PETSC_FALSE;
+    for (d = 0, q = 0; d < numDir; ++d) {
+      for (c = 0, p = 0; c < dirSizes[d]; ++c, ++q) p = PetscMax(p, ones[q]+1);
+      if (p != dirDepth[d]) {dirDepth[d] = p; lchanged = PETSC_TRUE;}
+    }
+    ierr = MPIU_Allreduce(&lchanged, &changed, 1, MPIU_BOOL, MPI_LOR, comm);CHKERRQ(ierr);
+  } while (changed);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree2(entries, ones);CHKERRQ(ierr);
+  for (d = 0, p = 0; d < numDir; ++d) p = PetscMax(p, dirDepth[d]);
+  ierr = MPIU_Allreduce(&p, &maxDepth, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  /* Deal out the cells, the points of maximal depth, in file order */
+  for (d = 0; d < numDir; ++d) {
+    if (dirDepth[d] == maxDepth) ++numDirCells;
+    else if (!dirFlags[d])       ++numDirOrphans;
+  }
+  ierr = MPI_Scan(&numDirCells, &off, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  off -= numDirCells;
+  ierr = MPIU_Allreduce(&numDirCells, &gsize, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &cellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(cellLayout, gsize);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(cellLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(cellLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetLocalSize(cellLayout, &nc);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numDirCells, &entries, numDirCells, &ones);CHKERRQ(ierr);
+  for (d = 0, q = 0; d < numDir; ++d) if (dirDepth[d] == maxDepth) {entries[q] = off+q; ones[q] = dStart+d; ++q;}
+  nl   = PetscMax(2*nc+numDirOrphans, 1);
+  ierr = PetscMalloc1(nl, &gpoints);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nl, &sizes);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nl*bs, &blocks);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, cellLayout, numDirCells, NULL, PETSC_OWN_POINTER, entries);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, ones, gpoints, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, ones, gpoints, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree2(entries, ones);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&cellLayout);CHKERRQ(ierr);
+  /* Points in no cone which are not cells, such as isolated vertices, stay with their directory entry */
+  for (d = 0, l = nc; d < numDir; ++d) if (dirDepth[d] < maxDepth && !dirFlags[d]) gpoints[l++] = dStart+d;
+  ierr = PetscFree(dirDepth);CHKERRQ(ierr);
+  /* Pull in the closure of the local cells, the points found in each sweep are fetched in the next */
+  ierr = PetscHMapICreate(&pointMap);CHKERRQ(ierr);
+  for (l = 0; l < nc+numDirOrphans; ++l) {ierr = PetscHMapISet(pointMap, gpoints[l], l);CHKERRQ(ierr);}
+  for (fStart = 0, fEnd = nl = nc+numDirOrphans;;) {
+    PetscInt numFront = fEnd - fStart, numNew = 0, maxFront;
+
+    ierr = MPIU_Allreduce(&numFront, &maxFront, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+    if (!maxFront) break;
+    ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf, dirLayout, numFront, NULL, PETSC_OWN_POINTER, &gpoints[fStart]);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, MPIU_INT, dirSizes, &sizes[fStart]);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, MPIU_INT, dirSizes, &sizes[fStart]);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, blockType, dirBlocks, &blocks[fStart*bs]);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, blockType, dirBlocks, &blocks[fStart*bs]);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    for (l = fStart; l < fEnd; ++l) numNew += sizes[l];
+    numNew = PetscMax(nl+numNew, 1);
+    ierr = PetscRealloc(numNew*sizeof(PetscInt), &gpoints);CHKERRQ(ierr);
+    ierr = PetscRealloc(numNew*sizeof(PetscInt), &sizes);CHKERRQ(ierr);
+    ierr = PetscRealloc(numNew*bs*sizeof(PetscInt), &blocks);CHKERRQ(ierr);
+    for (l = fStart; l < fEnd; ++l) {
+      for (c = 0; c < sizes[l]; ++c) {
+        ierr = PetscHMapIGet(pointMap, blocks[l*bs+c], &q);CHKERRQ(ierr);
+        if (q < 0) {
+          ierr = PetscHMapISet(pointMap, blocks[l*bs+c], nl);CHKERRQ(ierr);
+          gpoints[nl++] = blocks[l*bs+c];
+        }
+      }
+    }
+    fStart = fEnd; fEnd = nl;
+  }
+  ierr = MPI_Type_free(&blockType);CHKERRQ(ierr);
+  for (l = 0; l < nl; ++l) {
+    for (c = 0; c < sizes[l]; ++c) {ierr = PetscHMapIGet(pointMap, blocks[l*bs+c], &blocks[l*bs+c]);CHKERRQ(ierr);}
+  }
+  ierr = PetscHMapIDestroy(&pointMap);CHKERRQ(ierr);
+  /* Order the local points as cells, vertices, and then the remaining strata from the highest down */
+  ierr = PetscCalloc1(nl, &depth);CHKERRQ(ierr);
+  do {
+    changed = PETSC_FALSE;
+    for (l = nl-1; l >= 0; --l) {
+      for (c = 0, d = 0; c < sizes[l]; ++c) d = PetscMax(d, depth[blocks[l*bs+c]]+1);
+      if (d != depth[l]) {depth[l] = d; changed = PETSC_TRUE;}
+    }
+  } while (changed);
+  for (l = 0; l < nl; ++l) depth[l] = l < nc ? 0 : (!depth[l] ? 1 : maxDepth-depth[l]+1);
+  ierr = PetscCalloc1(maxDepth+3, &classSize);CHKERRQ(ierr);
+  for (l = 0; l < nl; ++l) ++classSize[depth[l]+1];
+  for (d = 1; d < maxDepth+3; ++d) classSize[d] += classSize[d-1];
+  ierr = PetscMalloc3(nl, &perm, nl, &newPoint, nl, &keys);CHKERRQ(ierr);
+  for (l = 0; l < nl; ++l) {q = classSize[depth[l]]++; perm[q] = l; keys[q] = gpoints[l];}
+  for (d = 0, q = 0; d < maxDepth+2; ++d) {
+    ierr = PetscSortIntWithArray(classSize[d]-q, &keys[q], &perm[q]);CHKERRQ(ierr);
+    q = classSize[d];
+  }
+  for (q = 0; q < nl; ++q) newPoint[perm[q]] = q;
+  *numCells    = nc;
+  *numVertices = classSize[1]-classSize[0];
+  ierr = PetscFree(classSize);CHKERRQ(ierr);
+  ierr = PetscFree(depth);CHKERRQ(ierr);
+  /* Create cones */
+  ierr = DMPlexSetChart(dm, 0, nl);CHKERRQ(ierr);
+  for (l = 0; l < nl; ++l) {ierr = DMPlexSetConeSize(dm, newPoint[l], sizes[l]);CHKERRQ(ierr);}
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  for (l = 0; l < nl; ++l) {
+    for (c = 0; c < sizes[l]; ++c) blocks[l*bs+c] = newPoint[blocks[l*bs+c]];
+    ierr = DMPlexSetCone(dm, newPoint[l], &blocks[l*bs]);CHKERRQ(ierr);
+    ierr = DMPlexSetConeOrientation(dm, newPoint[l], &blocks[l*bs+bs/2]);CHKERRQ(ierr);
+  }
+  for (q = 0; q < nl; ++q) keys[q] = gpoints[perm[q]];
+  ierr = PetscFree(gpoints);CHKERRQ(ierr);
+  ierr = PetscFree(sizes);CHKERRQ(ierr);
+  ierr = PetscFree(blocks);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, sfDir);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *sfDir, "Point Directory SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(*sfDir, dirLayout, nl, NULL, PETSC_OWN_POINTER, keys);CHKERRQ(ierr);
+  ierr = PetscFree3(perm, newPoint, keys);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&dirLayout);CHKERRQ(ierr);
+  /* Build pointSF */
+  ierr = PetscMalloc2(nl, &pointOwner, numDir, &rootOwner);CHKERRQ(ierr);
+  for (p = 0; p < nl;     ++p) {pointOwner[p].rank = rank; pointOwner[p].index = p;}
+  for (d = 0; d < numDir; ++d) {rootOwner[d].rank  = -1;   rootOwner[d].index  = -1;}
+  ierr = PetscSFReduceBegin(*sfDir, MPIU_2INT, pointOwner, rootOwner, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(*sfDir, MPIU_2INT, pointOwner, rootOwner, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(*sfDir, MPIU_2INT, rootOwner, pointOwner);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(*sfDir, MPIU_2INT, rootOwner, pointOwner);CHKERRQ(ierr);
+  for (p = 0, numGhosts = 0; p < nl; ++p) if (pointOwner[p].rank != rank) ++numGhosts;
+  ierr = PetscMalloc1(numGhosts, &localPoints);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numGhosts, &remotePoints);CHKERRQ(ierr);
+  for (p = 0, q = 0; p < nl; ++p) {
+    if (pointOwner[p].rank != rank) {
+      localPoints[q]        = p;
+      remotePoints[q].rank  = pointOwner[p].rank;
+      remotePoints[q].index = pointOwner[p].index;
+      ++q;
+    }
+  }
+  ierr = PetscFree2(pointOwner, rootOwner);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) sfPoint, "point SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPoint, nl, numGhosts, localPoints, PETSC_OWN_POINTER, remotePoints, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* Fill in the rest of the topology structure */
+  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
+  /* The coordinates are stored for the vertices in file order */
+  for (d = 0; d < numDir; ++d) if (!dirSizes[d]) ++numDirVertices;
+  ierr = MPI_Scan(&numDirVertices, &off, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  off -= numDirVertices;
+  ierr = MPIU_Allreduce(&numDirVertices, &gsize, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  if (gsize != numGlobalVertices) SETERRQ2(comm, PETSC_ERR_FILE_UNEXPECTED, "Number of coordinates loaded %D does not match number of vertices %D", numGlobalVertices, gsize);
+  for (d = 0, q = 0; d < numDir; ++d) dirFlags[d] = dirSizes[d] ? -1 : off+q++;
+  ierr = PetscMalloc1(nl, &vnum);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(*sfDir, MPIU_INT, dirFlags, vnum);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(*sfDir, MPIU_INT, dirFlags, vnum);CHKERRQ(ierr);
+  ierr = PetscFree3(dirSizes, dirBlocks, dirFlags);CHKERRQ(ierr);
+  ierr = PetscMalloc1(*numVertices, vertexNumbers);CHKERRQ(ierr);
+  for (p = 0; p < *numVertices; ++p) (*vertexNumbers)[p] = vnum[nc+p];
+  ierr = PetscFree(vnum);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Each process reads a contiguous slab of the points, builds the closure of a contiguous chunk of the cells in file
+   order, and the user calls DMPlexDistribute() to rebalance. No process ever holds the whole mesh.
 */
 PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
 {
-  PetscSection    coordSection;
-  Vec             coordinates;
-  IS              orderIS, conesIS, cellsIS, orntsIS;
-  const PetscInt *order, *cones, *cells, *ornts;
-  PetscReal       lengthScale;
-  PetscInt       *cone, *ornt;
-  PetscInt        dim, spatialDim, N, numVertices, vStart, vEnd, v, pEnd, p, q, maxConeSize = 0, c;
-  PetscMPIInt     rank;
-  PetscErrorCode  ierr;
+  MPI_Comm           comm;
+  PetscSF            sfDir, sfVert;
+  PetscLayout        vLayout;
+  Vec                coordinates;
+  IS                 orderIS, conesIS, cellsIS, orntsIS;
+  const PetscInt    *order, *cones, *cells, *ornts;
+  const PetscScalar *coords;
+  PetscReal         *coordsReal;
+  PetscReal          lengthScale;
+  PetscInt          *vertexNumbers;
+  PetscInt           dim, spatialDim, N, numPoints, numConePoints = 0, numCoords, numCells, numVertices, p;
+  PetscErrorCode     ierr;
 
   PetscFunctionBegin;
-  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
   /* Read toplogy */
   ierr = PetscViewerHDF5ReadAttribute(viewer, "/topology/cells", "cell_dim", PETSC_INT, (void *) &dim);CHKERRQ(ierr);
   ierr = DMSetDimension(dm, dim);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PushGroup(viewer, "/topology");CHKERRQ(ierr);
 
-  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &orderIS);CHKERRQ(ierr);
+  ierr = ISCreate(comm, &orderIS);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) orderIS, "order");CHKERRQ(ierr);
-  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &conesIS);CHKERRQ(ierr);
+  ierr = ISCreate(comm, &conesIS);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) conesIS, "cones");CHKERRQ(ierr);
-  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &cellsIS);CHKERRQ(ierr);
+  ierr = ISCreate(comm, &cellsIS);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) cellsIS, "cells");CHKERRQ(ierr);
-  ierr = ISCreate(PetscObjectComm((PetscObject) dm), &orntsIS);CHKERRQ(ierr);
+  ierr = ISCreate(comm, &orntsIS);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) orntsIS, "orientation");CHKERRQ(ierr);
+  ierr = ISLoad(orderIS, viewer);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(orderIS, &numPoints);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5ReadSizes(viewer, "cones", NULL, &N);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(conesIS->map, numPoints);CHKERRQ(ierr);
+  ierr = PetscLayoutSetSize(conesIS->map, N);CHKERRQ(ierr);
+  ierr = ISLoad(conesIS, viewer);CHKERRQ(ierr);
+  ierr = ISGetIndices(conesIS, &cones);CHKERRQ(ierr);
+  for (p = 0; p < numPoints; ++p) numConePoints += cones[p];
   {
-    /* Force serial load */
-    ierr = PetscViewerHDF5ReadSizes(viewer, "order", NULL, &pEnd);CHKERRQ(ierr);
-    ierr = PetscLayoutSetLocalSize(orderIS->map, !rank ? pEnd : 0);CHKERRQ(ierr);
-    ierr = PetscLayoutSetSize(orderIS->map, pEnd);CHKERRQ(ierr);
-    ierr = PetscViewerHDF5ReadSizes(viewer, "cones", NULL, &pEnd);CHKERRQ(ierr);
-    ierr = PetscLayoutSetLocalSize(conesIS->map, !rank ? pEnd : 0);CHKERRQ(ierr);
-    ierr = PetscLayoutSetSize(conesIS->map, pEnd);CHKERRQ(ierr);
-    pEnd = !rank ? pEnd : 0;
+    /* The cone slab matches the point slab */
     ierr = PetscViewerHDF5ReadSizes(viewer, "cells", NULL, &N);CHKERRQ(ierr);
-    ierr = PetscLayoutSetLocalSize(cellsIS->map, !rank ? N : 0);CHKERRQ(ierr);
+    ierr = PetscLayoutSetLocalSize(cellsIS->map, numConePoints);CHKERRQ(ierr);
     ierr = PetscLayoutSetSize(cellsIS->map, N);CHKERRQ(ierr);
     ierr = PetscViewerHDF5ReadSizes(viewer, "orientation", NULL, &N);CHKERRQ(ierr);
-    ierr = PetscLayoutSetLocalSize(orntsIS->map, !rank ? N : 0);CHKERRQ(ierr);
+    ierr = PetscLayoutSetLocalSize(orntsIS->map, numConePoints);CHKERRQ(ierr);
     ierr = PetscLayoutSetSize(orntsIS->map, N);CHKERRQ(ierr);
   }
-  ierr = ISLoad(orderIS, viewer);CHKERRQ(ierr);
-  ierr = ISLoad(conesIS, viewer);CHKERRQ(ierr);
   ierr = ISLoad(cellsIS, viewer);CHKERRQ(ierr);
   ierr = ISLoad(orntsIS, viewer);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
   /* Read geometry */
   ierr = PetscViewerHDF5PushGroup(viewer, "/geometry");CHKERRQ(ierr);
-  ierr = VecCreate(PetscObjectComm((PetscObject) dm), &coordinates);CHKERRQ(ierr);
+  ierr = VecCreate(comm, &coordinates);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) coordinates, "vertices");CHKERRQ(ierr);
-  {
-    /* Force serial load */
-    ierr = PetscViewerHDF5ReadSizes(viewer, "vertices", &spatialDim, &N);CHKERRQ(ierr);
-    ierr = VecSetSizes(coordinates, !rank ? N : 0, N);CHKERRQ(ierr);
-    ierr = VecSetBlockSize(coordinates, spatialDim);CHKERRQ(ierr);
-  }
+  ierr = PetscViewerHDF5ReadSizes(viewer, "vertices", &spatialDim, &N);CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, PETSC_DECIDE, N);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinates, spatialDim);CHKERRQ(ierr);
   ierr = VecLoad(coordinates, viewer);CHKERRQ(ierr);
   ierr = PetscViewerHDF5PopGroup(viewer);CHKERRQ(ierr);
   ierr = DMPlexGetScale(dm, PETSC_UNIT_LENGTH, &lengthScale);CHKERRQ(ierr);
   ierr = VecScale(coordinates, 1.0/lengthScale);CHKERRQ(ierr);
-  ierr = VecGetLocalSize(coordinates, &numVertices);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coordinates, &numCoords);CHKERRQ(ierr);
+  ierr = VecGetSize(coordinates, &N);CHKERRQ(ierr);
   ierr = VecGetBlockSize(coordinates, &spatialDim);CHKERRQ(ierr);
-  numVertices /= spatialDim;
+  numCoords /= spatialDim;
+  N         /= spatialDim;
   /* Create Plex */
-  ierr = DMPlexSetChart(dm, 0, pEnd);CHKERRQ(ierr);
   ierr = ISGetIndices(orderIS, &order);CHKERRQ(ierr);
-  ierr = ISGetIndices(conesIS, &cones);CHKERRQ(ierr);
-  for (p = 0; p < pEnd; ++p) {
-    ierr = DMPlexSetConeSize(dm, order[p], cones[p]);CHKERRQ(ierr);
-    maxConeSize = PetscMax(maxConeSize, cones[p]);
-  }
-  ierr = DMSetUp(dm);CHKERRQ(ierr);
   ierr = ISGetIndices(cellsIS, &cells);CHKERRQ(ierr);
   ierr = ISGetIndices(orntsIS, &ornts);CHKERRQ(ierr);
-  ierr = PetscMalloc2(maxConeSize,&cone,maxConeSize,&ornt);CHKERRQ(ierr);
-  for (p = 0, q = 0; p < pEnd; ++p) {
-    for (c = 0; c < cones[p]; ++c, ++q) {cone[c] = cells[q]; ornt[c] = ornts[q];}
-    ierr = DMPlexSetCone(dm, order[p], cone);CHKERRQ(ierr);
-    ierr = DMPlexSetConeOrientation(dm, order[p], ornt);CHKERRQ(ierr);
-  }
-  ierr = PetscFree2(cone,ornt);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromDAGSlab_Static(dm, numPoints, order, cones, cells, ornts, N, &sfDir, &numCells, &numVertices, &vertexNumbers);CHKERRQ(ierr);
   ierr = ISRestoreIndices(orderIS, &order);CHKERRQ(ierr);
   ierr = ISRestoreIndices(conesIS, &cones);CHKERRQ(ierr);
   ierr = ISRestoreIndices(cellsIS, &cells);CHKERRQ(ierr);
@@ -894,24 +1182,33 @@ PetscErrorCode DMPlexLoad_HDF5_Internal(DM dm, PetscViewer viewer)
   ierr = ISDestroy(&conesIS);CHKERRQ(ierr);
   ierr = ISDestroy(&cellsIS);CHKERRQ(ierr);
   ierr = ISDestroy(&orntsIS);CHKERRQ(ierr);
-  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
-  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
   /* Create coordinates */
-  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
-  if (numVertices != vEnd - vStart) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Number of coordinates loaded %d does not match number of vertices %d", numVertices, vEnd - vStart);
-  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
-  ierr = PetscSectionSetNumFields(coordSection, 1);CHKERRQ(ierr);
-  ierr = PetscSectionSetFieldComponents(coordSection, 0, spatialDim);CHKERRQ(ierr);
-  ierr = PetscSectionSetChart(coordSection, vStart, vEnd);CHKERRQ(ierr);
-  for (v = vStart; v < vEnd; ++v) {
-    ierr = PetscSectionSetDof(coordSection, v, spatialDim);CHKERRQ(ierr);
-    ierr = PetscSectionSetFieldDof(coordSection, v, 0, spatialDim);CHKERRQ(ierr);
-  }
-  ierr = PetscSectionSetUp(coordSection);CHKERRQ(ierr);
-  ierr = DMSetCoordinates(dm, coordinates);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vLayout, numCoords);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vLayout);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfVert);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) sfVert, "Vertex Ownership SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfVert, vLayout, numVertices, NULL, PETSC_OWN_POINTER, vertexNumbers);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vLayout);CHKERRQ(ierr);
+  ierr = PetscFree(vertexNumbers);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscMalloc1(numCoords*spatialDim, &coordsReal);CHKERRQ(ierr);
+  for (p = 0; p < numCoords*spatialDim; ++p) coordsReal[p] = PetscRealPart(coords[p]);
+#else
+  coordsReal = (PetscReal *) coords;
+#endif
+  ierr = DMPlexBuildCoordinates_Parallel_Internal(dm, spatialDim, numCells, numCoords, sfVert, coordsReal);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscFree(coordsReal);CHKERRQ(ierr);
+#endif
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
   ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
   /* Read Labels */
-  ierr = DMPlexLoadLabels_HDF5_Internal(dm, viewer);CHKERRQ(ierr);
+  ierr = DMPlexLoadLabels_HDF5_Internal(dm, sfDir, viewer);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfDir);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 #endif
@@ -121,7 +121,7 @@ PetscErrorCode DMPlexLoad_HDF5_Xdmf_Internal(DM dm, PetscViewer viewer)
   }
 
   /* Read Labels */
-  ierr = DMPlexLoadLabels_HDF5_Internal(dm, viewer);CHKERRQ(ierr);
+  ierr = DMPlexLoadLabels_HDF5_Internal(dm, NULL, viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 #endif
@@ -71,3 +71,190 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = PetscSectionSetClosureIndex(section, (PetscObject) dm, closureSection, closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+PetscErrorCode DMPlexDestroyClosureDofIndex_Internal(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionDestroy(&mesh->clDofSection);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&mesh->clLocalSection);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&mesh->clGlobalSection);CHKERRQ(ierr);
+  ierr = PetscFree(mesh->clDofs);CHKERRQ(ierr);
+  ierr = PetscFree(mesh->clGlobalDofs);CHKERRQ(ierr);
+  ierr = PetscFree(mesh->clFlips);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Marks constrained dofs in the closure table by encoding the local offset as -(off+1) */
+static PetscErrorCode DMPlexClosureDofIndexPoint_Static(PetscSection section, PetscInt point, PetscInt f, PetscInt dof, PetscInt off, const PetscInt perm[], const PetscScalar flip[], PetscInt offset, PetscInt dofs[], PetscScalar flips[], PetscBool *hasFlip)
+{
+  const PetscInt *cdofs;
+  PetscInt        cdof, cind = 0, d;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (f < 0) {
+    ierr = PetscSectionGetConstraintDof(section, point, &cdof);CHKERRQ(ierr);
+    ierr = PetscSectionGetConstraintIndices(section, point, &cdofs);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSectionGetFieldConstraintDof(section, point, f, &cdof);CHKERRQ(ierr);
+    ierr = PetscSectionGetFieldConstraintIndices(section, point, f, &cdofs);CHKERRQ(ierr);
+  }
+  for (d = 0; d < dof; ++d) {
+    const PetscInt e = offset + (perm ? perm[d] : d);
+
+    if ((cind < cdof) && (d == cdofs[cind])) {dofs[e] = -(off+d+1); ++cind;}
+    else                                     {dofs[e] = off+d;}
+  }
+  if (flip) {
+    for (d = 0; d < dof; ++d) {
+      flips[offset+d] = flip[d];
+      if (flip[d] != (PetscScalar) 1.0) *hasFlip = PETSC_TRUE;
+    }
+  } else {
+    for (d = 0; d < dof; ++d) flips[offset+d] = 1.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexCreateClosureDofIndex - Precompute the dof indices of the closure of every cell for the given sections
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the local layout, or NULL to use the default section
+- globalSection - The section describing the parallel layout, or NULL to use the default global section
+
+  Notes:
+  For each cell this stores the local offsets of the closure dofs, with the point permutations and orientation
+  flips of the section symmetries already applied, and the global indices returned by DMPlexGetClosureIndices().
+  DMPlexVecGetClosure(), DMPlexVecSetClosure(), DMPlexGetClosureIndices() and DMPlexMatSetClosure() then reduce
+  to a single gather or scatter for cells, instead of traversing the closure and the section on every call.
+  The global indices are not cached if the mesh has anchors. The table must be recreated if the sections change.
+
+  The memory cost is one integer per closure dof per cell for each of the local and global tables.
+
+  Level: intermediate
+
+.seealso DMPlexCreateClosureIndex(), DMPlexVecGetClosure(), DMPlexVecGetClosureBatch(), DMPlexVecSetClosure(), DMPlexMatSetClosure(), DMPlexGetClosureIndices()
+@*/
+PetscErrorCode DMPlexCreateClosureDofIndex(DM dm, PetscSection section, PetscSection globalSection)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  PetscSection   clSection, anchorSection;
+  PetscScalar   *flips;
+  PetscInt      *dofs, *gdofs = NULL;
+  PetscInt       Nf, sStart, sEnd, cStart, cEnd, c, clSize;
+  PetscBool      hasFlip = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  if (!globalSection) {ierr = DMGetDefaultGlobalSection(dm, &globalSection);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
+  ierr = PetscObjectReference((PetscObject) section);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) globalSection);CHKERRQ(ierr);
+  ierr = DMPlexDestroyClosureDofIndex_Internal(dm);CHKERRQ(ierr);
+  mesh->clLocalSection  = section;
+  mesh->clGlobalSection = globalSection;
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(section, &sStart, &sEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, &clSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(clSection, cStart, cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *points = NULL, numPoints, p, dof, cldof = 0;
+
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    for (p = 0; p < numPoints*2; p += 2) {
+      if ((points[p] < sStart) || (points[p] >= sEnd)) continue;
+      ierr = PetscSectionGetDof(section, points[p], &dof);CHKERRQ(ierr);
+      cldof += dof;
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    ierr = PetscSectionSetDof(clSection, c, cldof);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(clSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(clSection, &clSize);CHKERRQ(ierr);
+  ierr = PetscMalloc1(clSize, &dofs);CHKERRQ(ierr);
+  ierr = PetscMalloc1(clSize, &flips);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *points = NULL, numPoints, p, q, cldof, cloff, offset;
+
+    ierr = PetscSectionGetDof(clSection, c, &cldof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(clSection, c, &cloff);CHKERRQ(ierr);
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    /* Compress out points not in the section, as DMPlexVecGetClosure() does */
+    for (p = 0, q = 0; p < numPoints; ++p) {
+      if ((points[2*p] < sStart) || (points[2*p] >= sEnd)) continue;
+      points[2*q]   = points[2*p];
+      points[2*q+1] = points[2*p+1];
+      ++q;
+    }
+    numPoints = q;
+    offset    = cloff;
+    if (Nf) {
+      PetscInt f;
+
+      for (f = 0; f < Nf; ++f) {
+        const PetscInt    **perms = NULL;
+        const PetscScalar **pflips = NULL;
+
+        ierr = PetscSectionGetFieldPointSyms(section, f, numPoints, points, &perms, &pflips);CHKERRQ(ierr);
+        for (p = 0; p < numPoints; ++p) {
+          PetscInt fdof, foff;
+
+          ierr = PetscSectionGetFieldDof(section, points[2*p], f, &fdof);CHKERRQ(ierr);
+          ierr = PetscSectionGetFieldOffset(section, points[2*p], f, &foff);CHKERRQ(ierr);
+          ierr = DMPlexClosureDofIndexPoint_Static(section, points[2*p], f, fdof, foff, perms ? perms[p] : NULL, pflips ? pflips[p] : NULL, offset, dofs, flips, &hasFlip);CHKERRQ(ierr);
+          offset += fdof;
+        }
+        ierr = PetscSectionRestoreFieldPointSyms(section, f, numPoints, points, &perms, &pflips);CHKERRQ(ierr);
+      }
+    } else {
+      const PetscInt    **perms = NULL;
+      const PetscScalar **pflips = NULL;
+
+      ierr = PetscSectionGetPointSyms(section, numPoints, points, &perms, &pflips);CHKERRQ(ierr);
+      for (p = 0; p < numPoints; ++p) {
+        PetscInt dof, off;
+
+        ierr = PetscSectionGetDof(section, points[2*p], &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(section, points[2*p], &off);CHKERRQ(ierr);
+        ierr = DMPlexClosureDofIndexPoint_Static(section, points[2*p], -1, dof, off, perms ? perms[p] : NULL, pflips ? pflips[p] : NULL, offset, dofs, flips, &hasFlip);CHKERRQ(ierr);
+        offset += dof;
+      }
+      ierr = PetscSectionRestorePointSyms(section, numPoints, points, &perms, &pflips);CHKERRQ(ierr);
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    if (offset-cloff != cldof) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Invalid size for closure %D should be %D", offset-cloff, cldof);
+  }
+  /* The global indices do not account for hanging node constraints */
+  ierr = DMPlexGetAnchors(dm, &anchorSection, NULL);CHKERRQ(ierr);
+  if (!anchorSection) {
+    ierr = PetscMalloc1(clSize, &gdofs);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      PetscInt *indices, numIndices, cldof, cloff;
+
+      ierr = PetscSectionGetDof(clSection, c, &cldof);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(clSection, c, &cloff);CHKERRQ(ierr);
+      ierr = DMPlexGetClosureIndices(dm, section, globalSection, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+      if (numIndices != cldof) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Invalid number of closure indices %D should be %D", numIndices, cldof);
+      ierr = PetscMemcpy(&gdofs[cloff], indices, cldof * sizeof(PetscInt));CHKERRQ(ierr);
+      ierr = DMPlexRestoreClosureIndices(dm, section, globalSection, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+    }
+  }
+  /* Only keep the flips if there are any, so that the unflipped gather is a pure copy */
+  if (!hasFlip) {ierr = PetscFree(flips);CHKERRQ(ierr);}
+  mesh->clDofSection = clSection;
+  mesh->clDofs       = dofs;
+  mesh->clGlobalDofs = gdofs;
+  mesh->clFlips      = flips;
+  PetscFunctionReturn(0);
+}
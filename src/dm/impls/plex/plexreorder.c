@@ -45,6 +45,102 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(0);
 }
 
+/* Skilling's transform of the integer coordinates X to the transposed Hilbert index, which is then interleaved into the key */
+static PetscInt DMPlexHilbertKey_Static(PetscInt dim, PetscInt bits, PetscInt X[])
+{
+  const PetscInt M = ((PetscInt) 1) << (bits-1);
+  PetscInt       P, Q, t, key = 0, b, i;
+
+  /* Inverse undo */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (i = 0; i < dim; ++i) {
+      if (X[i] & Q) X[0] ^= P;
+      else {t = (X[0] ^ X[i]) & P; X[0] ^= t; X[i] ^= t;}
+    }
+  }
+  /* Gray encode */
+  for (i = 1; i < dim; ++i) X[i] ^= X[i-1];
+  for (Q = M, t = 0; Q > 1; Q >>= 1) if (X[dim-1] & Q) t ^= Q - 1;
+  for (i = 0; i < dim; ++i) X[i] ^= t;
+  for (b = bits-1; b >= 0; --b) for (i = 0; i < dim; ++i) key = (key << 1) | ((X[i] >> b) & 1);
+  return key;
+}
+
+/* Order the cells along a Hilbert curve through their centroids, quantized on the bounding box of the local mesh */
+static PetscErrorCode DMPlexGetOrderingHilbert_Static(DM dm, PetscInt numCells, PetscInt cperm[])
+{
+  DM             cdm;
+  PetscSection   csection;
+  Vec            coordinates;
+  PetscReal     *centroids, lower[3] = {PETSC_MAX_REAL, PETSC_MAX_REAL, PETSC_MAX_REAL}, upper[3] = {PETSC_MIN_REAL, PETSC_MIN_REAL, PETSC_MIN_REAL};
+  PetscInt      *keys, cdim, bits, c, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim > 3) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Hilbert ordering not supported for coordinate dimension %D", cdim);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetDefaultSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numCells*cdim, &centroids, numCells, &keys);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    PetscScalar *coords = NULL;
+    PetscInt     csize, v;
+
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    for (d = 0; d < cdim; ++d) {
+      centroids[c*cdim+d] = 0.0;
+      for (v = 0; v < csize/cdim; ++v) centroids[c*cdim+d] += PetscRealPart(coords[v*cdim+d]);
+      centroids[c*cdim+d] /= (csize/cdim);
+      lower[d] = PetscMin(lower[d], centroids[c*cdim+d]);
+      upper[d] = PetscMax(upper[d], centroids[c*cdim+d]);
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+  }
+  /* The key must fit in a PetscInt */
+  bits = PetscMin(20, (PetscInt) (sizeof(PetscInt)*8 - 1)/cdim);
+  for (c = 0; c < numCells; ++c) {
+    PetscInt X[3];
+
+    for (d = 0; d < cdim; ++d) {
+      const PetscReal h = upper[d] > lower[d] ? (centroids[c*cdim+d] - lower[d])/(upper[d] - lower[d]) : 0.0;
+
+      X[d] = (PetscInt) (h * ((((PetscInt) 1) << bits) - 1));
+    }
+    keys[c]  = DMPlexHilbertKey_Static(cdim, bits, X);
+    cperm[c] = c;
+  }
+  ierr = PetscSortIntWithArray(numCells, keys, cperm);CHKERRQ(ierr);
+  ierr = PetscFree2(centroids, keys);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Order the cells using a MatOrdering of the cell adjacency graph */
+static PetscErrorCode DMPlexGetOrderingMat_Static(MatOrderingType otype, PetscInt numCells, PetscInt start[], PetscInt adjacency[], PetscInt cperm[])
+{
+  Mat             A;
+  IS              rperm, colperm;
+  PetscScalar    *vals;
+  const PetscInt *rp;
+  PetscInt        c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  for (c = 0; c < numCells; ++c) {ierr = PetscSortInt(start[c+1]-start[c], &adjacency[start[c]]);CHKERRQ(ierr);}
+  ierr = PetscCalloc1(start[numCells], &vals);CHKERRQ(ierr);
+  ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF, numCells, numCells, start, adjacency, vals, &A);CHKERRQ(ierr);
+  ierr = MatGetOrdering(A, otype, &rperm, &colperm);CHKERRQ(ierr);
+  ierr = ISGetIndices(rperm, &rp);CHKERRQ(ierr);
+  ierr = PetscMemcpy(cperm, rp, numCells * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = ISRestoreIndices(rperm, &rp);CHKERRQ(ierr);
+  ierr = ISDestroy(&rperm);CHKERRQ(ierr);
+  ierr = ISDestroy(&colperm);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFree(vals);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexGetOrdering - Calculate a reordering of the mesh
 
@@ -58,13 +154,20 @@ $     MATORDERINGND - Nested Dissection
 $     MATORDERING1WD - One-way Dissection
 $     MATORDERINGRCM - Reverse Cuthill-McKee
 $     MATORDERINGQMD - Quotient Minimum Degree
+$     DMPLEXORDERINGHILBERT - Hilbert space-filling curve through the cell centroids
 - label - [Optional] Label used to segregate ordering into sets, or NULL
 
 
   Output Parameter:
 . perm - The point permutation as an IS, perm[old point number] = new point number
 
-  Note: The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
+  Notes:
+  The cells are ordered first, and the faces, edges and vertices are then numbered in the order they are first reached
+  from the closures of the reordered cells, so that the points of a closure are close in memory. The graph orderings
+  use the cell adjacency through faces, while the Hilbert ordering only needs the coordinates. For a distributed mesh,
+  each process orders its local points.
+
+  The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
   has different types of cells, and then loop over each set of reordered cells for assembly.
 
   Level: intermediate
@@ -76,23 +179,33 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
 {
   PetscInt       numCells = 0;
   PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscBool      isRCM, isHilbert;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 3);
+  if (!otype) otype = MATORDERINGRCM;
+  ierr = PetscStrcmp(otype, MATORDERINGRCM, &isRCM);CHKERRQ(ierr);
+  ierr = PetscStrcmp(otype, DMPLEXORDERINGHILBERT, &isHilbert);CHKERRQ(ierr);
   ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
   ierr = PetscMalloc3(numCells,&cperm,numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
-  if (numCells) {
+  if (isHilbert) {
+    ierr = DMPlexGetOrderingHilbert_Static(dm, numCells, cperm);CHKERRQ(ierr);
+  } else if (!isRCM) {
+    if (numCells) {ierr = DMPlexGetOrderingMat_Static(otype, numCells, start, adjacency, cperm);CHKERRQ(ierr);}
+  } else {
+    if (numCells) {
+      /* Shift for Fortran numbering */
+      for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
+      for (i = 0; i <= numCells; ++i)       ++start[i];
+      ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
+    }
     /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i)       ++start[i];
-    ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
+    for (c = 0; c < numCells; ++c) --cperm[c];
   }
   ierr = PetscFree(start);CHKERRQ(ierr);
   ierr = PetscFree(adjacency);CHKERRQ(ierr);
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -151,10 +264,12 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   Output Parameter:
 . pdm - The permuted DM
 
+  Note: The point SF is permuted as well, so that a distributed mesh can be reordered locally.
+
   Level: intermediate
 
 .keywords: mesh
-.seealso: MatPermute()
+.seealso: DMPlexGetOrdering(), MatPermute()
 @*/
 PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
 {
@@ -179,8 +294,48 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   plexNew = (DM_Plex *) (*pdm)->data;
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, defaultSF */
+  /* Ignore defaultSF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
+  /* Remap the point SF, before the coordinate DM is created so that it is shared */
+  {
+    PetscSF            sf, sfNew;
+    const PetscSFNode *remote;
+    PetscSFNode       *remoteNew;
+    const PetscInt    *local, *pperm;
+    PetscInt          *localNew, *ranks, *indices, *rperm, nroots, nleaves, l;
+
+    ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &local, &remote);CHKERRQ(ierr);
+    if (nroots >= 0) {
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nroots, &rperm);CHKERRQ(ierr);
+      ierr = PetscMalloc3(nleaves, &localNew, nleaves, &ranks, nleaves, &indices);CHKERRQ(ierr);
+      /* The new numbers of the roots are known only to their owners */
+      ierr = PetscSFBcastBegin(sf, MPIU_INT, pperm, rperm);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf, MPIU_INT, pperm, rperm);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        const PetscInt p = local ? local[l] : l;
+
+        localNew[l] = pperm[p];
+        ranks[l]    = remote[l].rank;
+        indices[l]  = rperm[p];
+      }
+      /* Keep the leaves sorted, as the point SF is searched by local point */
+      ierr = PetscSortIntWithArrayPair(nleaves, localNew, ranks, indices);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nleaves, &remoteNew);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        remoteNew[l].rank  = ranks[l];
+        remoteNew[l].index = indices[l];
+      }
+      ierr = PetscSFCreate(PetscObjectComm((PetscObject) dm), &sfNew);CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfNew, nroots, nleaves, localNew, PETSC_COPY_VALUES, remoteNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+      ierr = DMSetPointSF(*pdm, sfNew);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+      ierr = PetscFree3(localNew, ranks, indices);CHKERRQ(ierr);
+      ierr = PetscFree(rperm);CHKERRQ(ierr);
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+    }
+  }
   /* Remap coordinates */
   {
     DM              cdm, cdmNew;
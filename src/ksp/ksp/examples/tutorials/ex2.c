@@ -287,6 +287,20 @@ int main(int argc,char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   test:
+      suffix: chowilu
+      args: -ksp_monitor_short -m 9 -n 9 -pc_type ilu -pc_factor_mat_solver_type chowilu -mat_chowilu_threads 2
+
+   test:
+      suffix: chowilu_2
+      nsize: 2
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_type bicg -sub_pc_type ilu -sub_pc_factor_levels 1 -sub_pc_factor_mat_solver_type chowilu -mat_chowilu_factor_sweeps 2 -mat_chowilu_solve_sweeps 4
+
+   test:
+      suffix: chowilu_3
+      args: -m 9 -n 9 -pc_type ilu -pc_factor_mat_solver_type chowilu -mat_chowilu_solve_sweeps 0 -mat_chowilu_threads 2 -info
+      filter: grep "for the forward solve"
+
    test:
       suffix: fbcgs
       args: -ksp_type fbcgs -pc_type ilu
@@ -340,11 +354,38 @@ int main(int argc,char **args)
       suffix: sell_mumps
       args: -ksp_type preonly -m 9 -n 12 -mat_type sell -pc_type lu -pc_factor_mat_solver_type mumps -pc_factor_mat_ordering_type natural
 
+   test:
+      suffix: sor_multicolor
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_type cg -pc_type sor -pc_sor_symmetric -pc_sor_omega 1.2 -mat_sor_multicolor 3
+
+   test:
+      suffix: sstepcg
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type sstepcg -m 15 -n 15 -pc_type jacobi
+
+   test:
+      suffix: sstepgmres
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type sstepgmres -m 9 -n 9 -ksp_sstepgmres_s 4 -ksp_sstepgmres_restart 16 -ksp_pc_side right
+
+   test:
+      suffix: dcgs
+      nsize: 2
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_gmres_delayedclassicalgramschmidt -ksp_gmres_restart 5
+
    test:
       suffix: telescope
       nsize: 4
       args: -m 100 -n 100 -ksp_converged_reason -pc_type telescope -pc_telescope_reduction_factor 4 -telescope_pc_type bjacobi
 
+   test:
+      suffix: threads_icc
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_type cg -pc_type icc -pc_factor_mat_ordering_type rcm -mat_seqaij_threads 3
+
+   test:
+      suffix: threads_ilu
+      args: -ksp_monitor_short -m 9 -n 9 -ksp_type bicg -pc_type ilu -pc_factor_levels 1 -mat_seqaij_threads 3
+
    test:
       suffix: umfpack
       requires: suitesparse
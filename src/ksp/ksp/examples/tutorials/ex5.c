@@ -348,6 +348,12 @@ int main(int argc,char **args)
       nsize: 2
       args: -pc_type jacobi -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -ksp_rtol .000001
 
+   test:
+      suffix: 2_hash
+      nsize: 2
+      args: -pc_type jacobi -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -ksp_rtol .000001 -mat_mpiaij_hash_assembly
+      output_file: output/ex5_2.out
+
    test:
       suffix: 5
       nsize: 2
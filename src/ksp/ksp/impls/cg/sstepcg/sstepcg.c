@@ -0,0 +1,398 @@
+/*
+    s-step (communication avoiding) preconditioned conjugate gradient: each block generates the bases
+    P = [p, M^{-1}A p, ...] (s+1 vectors) and Z = [z, M^{-1}A z, ...] (s vectors) with the matrix powers kernel,
+    computes their Gram matrix in a single global reduction and then performs s CG iterations on the coordinates
+    of the iterates in the basis Y = [P Z], without any further communication.
+*/
+#include <petsc/private/kspimpl.h>
+
+typedef struct {
+  PetscInt      s;                    /* number of iterations per block */
+  KSPSStepBasis basis;
+  Vec           *work;                /* storage of all the vectors below */
+  Vec           *P,*MP,*Z,*R;         /* the bases P and Z and M times them, R_0 is the residual */
+  Vec           *Y,*MY;               /* [P_0 ... P_sb Z_0 ... Z_{sb-1}] and M times it for the current block */
+  Vec           zn,rn,pn,mpn;         /* vectors recovered at the end of a block */
+  PetscScalar   *G,*Gn;               /* Gram matrices Y^H M Y and Y^H Y or Y^H M^H M Y for the norm */
+  PetscScalar   *xc,*zc,*pc,*uc;      /* coordinates of the iterates in Y */
+  PetscScalar   *T;                   /* Lanczos tridiagonal matrix from the first iterations */
+  PetscReal     *lalpha,*lbeta;       /* CG coefficients of the first iterations */
+  PetscInt      nlanczos;
+} KSP_SSTEPCG;
+
+#define G(i,j)  (sc->G[(i)+(j)*(2*sc->s+1)])
+#define Gn(i,j) (sc->Gn[(i)+(j)*(2*sc->s+1)])
+
+static PetscErrorCode KSPSetUp_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sc = (KSP_SSTEPCG*)ksp->data;
+  PetscInt       s   = sc->s,m = 2*s+1,i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps per block %D must be positive",s);
+  ierr = KSPCreateVecs(ksp,4*s+6,&sc->work,0,NULL);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,4*s+6,sc->work);CHKERRQ(ierr);
+  ierr = PetscMalloc6(s+1,&sc->P,s+1,&sc->MP,s,&sc->Z,s,&sc->R,m,&sc->Y,m,&sc->MY);CHKERRQ(ierr);
+  for (i=0; i<=s; i++) {
+    sc->P[i]  = sc->work[i];
+    sc->MP[i] = sc->work[s+1+i];
+  }
+  for (i=0; i<s; i++) {
+    sc->Z[i] = sc->work[2*s+2+i];
+    sc->R[i] = sc->work[3*s+2+i];
+  }
+  sc->zn  = sc->work[4*s+2];
+  sc->rn  = sc->work[4*s+3];
+  sc->pn  = sc->work[4*s+4];
+  sc->mpn = sc->work[4*s+5];
+  ierr = PetscMalloc6(m*m,&sc->G,m*m,&sc->Gn,4*m,&sc->xc,s*s,&sc->T,s,&sc->lalpha,s,&sc->lbeta);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(2*m*m+4*m+s*s)*sizeof(PetscScalar)+2*s*sizeof(PetscReal));CHKERRQ(ierr);
+  sc->zc = sc->xc + m;
+  sc->pc = sc->zc + m;
+  sc->uc = sc->pc + m;
+  ierr = KSPSStepBasisSetUp_Private(&sc->basis,s);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sc = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDestroyVecs(4*sc->s+6,&sc->work);CHKERRQ(ierr);
+  ierr = PetscFree6(sc->P,sc->MP,sc->Z,sc->R,sc->Y,sc->MY);CHKERRQ(ierr);
+  ierr = PetscFree6(sc->G,sc->Gn,sc->xc,sc->T,sc->lalpha,sc->lbeta);CHKERRQ(ierr);
+  ierr = KSPSStepBasisReset_Private(&sc->basis);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPCG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_SSTEPCG(ksp);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* u = B v where B represents M^{-1}A on the block basis Y = [P_0 ... P_sb Z_0 ... Z_{sb-1}] */
+static void KSPSStepCGApplyB_Private(KSPSStepBasis *basis,PetscInt sb,const PetscScalar *v,PetscScalar *u)
+{
+  PetscInt i,c,off,nc;
+
+  for (i=0; i<2*sb+1; i++) u[i] = 0.0;
+  for (off=0,nc=sb; off<2*sb+1; off+=sb+1,nc--) {
+    for (c=0; c<nc; c++) {
+      u[off+c+1] += v[off+c]/basis->alpha[c];
+      u[off+c]   += basis->theta[c]*v[off+c];
+      if (c) u[off+c-1] += basis->sigma[c]*v[off+c];
+    }
+  }
+}
+
+/* v^H G w */
+PETSC_STATIC_INLINE PetscScalar KSPSStepCGInner_Private(PetscInt m,PetscInt ld,const PetscScalar *G,const PetscScalar *v,const PetscScalar *w)
+{
+  PetscScalar sum = 0.0,t;
+  PetscInt    i,j;
+
+  for (j=0; j<m; j++) {
+    if (w[j] == 0.0) continue;
+    for (t=0.0,i=0; i<m; i++) t += PetscConj(v[i])*G[i+j*ld];
+    sum += t*w[j];
+  }
+  return sum;
+}
+
+/*
+   KSPSStepCGBlock_Private - Performs up to sb iterations with a single global reduction
+*/
+static PetscErrorCode KSPSStepCGBlock_Private(KSP ksp,Mat A,PetscInt sb,PetscBool first)
+{
+  KSP_SSTEPCG    *sc    = (KSP_SSTEPCG*)ksp->data;
+  KSPSStepBasis  *basis = &sc->basis;
+  PetscInt       m      = 2*sb+1,ld = 2*sc->s+1,i,j;
+  PetscScalar    *xc    = sc->xc,*zc = sc->zc,*pc = sc->pc,*uc = sc->uc,delta,deltanew,gamma,alpha,beta;
+  PetscReal      dp     = 0.0;
+  PetscBool      done   = PETSC_FALSE;
+  Vec            tmp;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)ksp,&comm);CHKERRQ(ierr);
+  /* matrix powers kernel, the recurrences are applied to the bases and to M times them */
+  for (i=0; i<sb; i++) {
+    ierr = KSP_MatMult(ksp,A,sc->P[i],sc->MP[i+1]);CHKERRQ(ierr);
+    ierr = KSP_PCApply(ksp,sc->MP[i+1],sc->P[i+1]);CHKERRQ(ierr);
+    ierr = KSPSStepBasisAdvance_Private(basis,i,i ? sc->P[i-1] : NULL,sc->P[i],sc->P[i+1]);CHKERRQ(ierr);
+    ierr = KSPSStepBasisAdvance_Private(basis,i,i ? sc->MP[i-1] : NULL,sc->MP[i],sc->MP[i+1]);CHKERRQ(ierr);
+  }
+  for (i=0; i<sb-1; i++) {
+    ierr = KSP_MatMult(ksp,A,sc->Z[i],sc->R[i+1]);CHKERRQ(ierr);
+    ierr = KSP_PCApply(ksp,sc->R[i+1],sc->Z[i+1]);CHKERRQ(ierr);
+    ierr = KSPSStepBasisAdvance_Private(basis,i,i ? sc->Z[i-1] : NULL,sc->Z[i],sc->Z[i+1]);CHKERRQ(ierr);
+    ierr = KSPSStepBasisAdvance_Private(basis,i,i ? sc->R[i-1] : NULL,sc->R[i],sc->R[i+1]);CHKERRQ(ierr);
+  }
+  for (i=0; i<=sb; i++) {
+    sc->Y[i]  = sc->P[i];
+    sc->MY[i] = sc->MP[i];
+  }
+  for (i=0; i<sb; i++) {
+    sc->Y[sb+1+i]  = sc->Z[i];
+    sc->MY[sb+1+i] = sc->R[i];
+  }
+
+  /* upper triangles of the Gram matrices, in a single reduction */
+  for (j=0; j<m; j++) {
+    ierr = VecMDotBegin(sc->Y[j],j+1,sc->MY,&G(0,j));CHKERRQ(ierr);
+    if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+      ierr = VecMDotBegin(sc->Y[j],j+1,sc->Y,&Gn(0,j));CHKERRQ(ierr);
+    } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      ierr = VecMDotBegin(sc->MY[j],j+1,sc->MY,&Gn(0,j));CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+  for (j=0; j<m; j++) {
+    ierr = VecMDotEnd(sc->Y[j],j+1,sc->MY,&G(0,j));CHKERRQ(ierr);
+    if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+      ierr = VecMDotEnd(sc->Y[j],j+1,sc->Y,&Gn(0,j));CHKERRQ(ierr);
+    } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      ierr = VecMDotEnd(sc->MY[j],j+1,sc->MY,&Gn(0,j));CHKERRQ(ierr);
+    }
+  }
+  for (j=0; j<m; j++) {
+    for (i=j+1; i<m; i++) {
+      G(i,j) = PetscConj(G(j,i));
+      if (ksp->normtype == KSP_NORM_PRECONDITIONED || ksp->normtype == KSP_NORM_UNPRECONDITIONED) Gn(i,j) = PetscConj(Gn(j,i));
+    }
+  }
+
+  for (i=0; i<m; i++) xc[i] = zc[i] = pc[i] = 0.0;
+  zc[sb+1] = 1.0;
+  pc[0]    = 1.0;
+  delta    = G(sb+1,sb+1);
+  KSPCheckDot(ksp,delta);
+  if (first) {
+    switch (ksp->normtype) {
+    case KSP_NORM_PRECONDITIONED:   dp = PetscSqrtReal(PetscAbsScalar(Gn(sb+1,sb+1)));break;
+    case KSP_NORM_UNPRECONDITIONED: dp = PetscSqrtReal(PetscAbsScalar(Gn(sb+1,sb+1)));break;
+    case KSP_NORM_NATURAL:          dp = PetscSqrtReal(PetscAbsScalar(delta));break;
+    default:                        dp = 0.0;
+    }
+    ierr       = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+    ierr       = KSPMonitor(ksp,0,dp);CHKERRQ(ierr);
+    ksp->rnorm = dp;
+    ierr = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+    if (ksp->reason) PetscFunctionReturn(0);
+  }
+
+  for (j=0; j<sb; j++) {
+    if (delta == 0.0) {
+      ksp->reason = KSP_CONVERGED_ATOL;
+      ierr        = PetscInfo(ksp,"converged due to beta = 0\n");CHKERRQ(ierr);
+      done        = PETSC_TRUE;
+      break;
+    }
+#if !defined(PETSC_USE_COMPLEX)
+    if (delta < 0.0) {
+      if (ksp->errorifnotconverged) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite preconditioner");
+      ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+      ierr        = PetscInfo(ksp,"diverging due to indefinite preconditioner\n");CHKERRQ(ierr);
+      done        = PETSC_TRUE;
+      break;
+    }
+#endif
+    KSPSStepCGApplyB_Private(basis,sb,pc,uc);
+    gamma = KSPSStepCGInner_Private(m,ld,sc->G,pc,uc);
+    if (PetscRealPart(gamma) <= 0.0) {
+      if (ksp->errorifnotconverged) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite matrix");
+      ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+      ierr        = PetscInfo(ksp,"diverging due to indefinite or negative definite matrix\n");CHKERRQ(ierr);
+      done        = PETSC_TRUE;
+      break;
+    }
+    alpha = delta/gamma;
+    for (i=0; i<m; i++) {
+      xc[i] += alpha*pc[i];
+      zc[i] -= alpha*uc[i];
+    }
+    deltanew = KSPSStepCGInner_Private(m,ld,sc->G,zc,zc);
+    beta     = deltanew/delta;
+    if (!basis->spectrum && sc->nlanczos < sc->s) {
+      sc->lalpha[sc->nlanczos] = PetscRealPart(alpha);
+      sc->lbeta[sc->nlanczos]  = PetscRealPart(beta);
+      sc->nlanczos++;
+    }
+    switch (ksp->normtype) {
+    case KSP_NORM_PRECONDITIONED:
+    case KSP_NORM_UNPRECONDITIONED: dp = PetscSqrtReal(PetscAbsScalar(KSPSStepCGInner_Private(m,ld,sc->Gn,zc,zc)));break;
+    case KSP_NORM_NATURAL:          dp = PetscSqrtReal(PetscAbsScalar(deltanew));break;
+    default:                        dp = 0.0;
+    }
+    ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->its++;
+    ksp->rnorm = dp;
+    ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+    ierr = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+    if (ksp->reason) {done = PETSC_TRUE; break;}
+    for (i=0; i<m; i++) pc[i] = zc[i] + beta*pc[i];
+    delta = deltanew;
+  }
+
+  ierr = VecMAXPY(ksp->vec_sol,m,xc,sc->Y);CHKERRQ(ierr);
+  if (done) PetscFunctionReturn(0);
+  ierr = VecSet(sc->zn,0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(sc->zn,m,zc,sc->Y);CHKERRQ(ierr);
+  ierr = VecSet(sc->rn,0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(sc->rn,m,zc,sc->MY);CHKERRQ(ierr);
+  ierr = VecSet(sc->pn,0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(sc->pn,m,pc,sc->Y);CHKERRQ(ierr);
+  ierr = VecSet(sc->mpn,0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(sc->mpn,m,pc,sc->MY);CHKERRQ(ierr);
+  tmp = sc->Z[0];  sc->Z[0]  = sc->zn;  sc->zn  = tmp;
+  tmp = sc->R[0];  sc->R[0]  = sc->rn;  sc->rn  = tmp;
+  tmp = sc->P[0];  sc->P[0]  = sc->pn;  sc->pn  = tmp;
+  tmp = sc->MP[0]; sc->MP[0] = sc->mpn; sc->mpn = tmp;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sc = (KSP_SSTEPCG*)ksp->data;
+  PetscInt       s   = sc->s,sb,j;
+  PetscBool      diagonalscale,first = PETSC_TRUE;
+  Mat            Amat,Pmat;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,ksp->vec_sol,sc->R[0]);CHKERRQ(ierr);   /*   r <- b - Ax   */
+    ierr = VecAYPX(sc->R[0],-1.0,ksp->vec_rhs);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(ksp->vec_rhs,sc->R[0]);CHKERRQ(ierr);
+  }
+  ierr = KSP_PCApply(ksp,sc->R[0],sc->Z[0]);CHKERRQ(ierr);              /*   z <- Br       */
+  ierr = VecCopy(sc->Z[0],sc->P[0]);CHKERRQ(ierr);                      /*   p <- z        */
+  ierr = VecCopy(sc->R[0],sc->MP[0]);CHKERRQ(ierr);                     /*   Mp <- r       */
+
+  /* single iteration blocks until the Ritz values for the basis are available */
+  ierr         = KSPSStepBasisSetMonomial_Private(&sc->basis);CHKERRQ(ierr);
+  sc->nlanczos = 0;
+  while (!ksp->reason) {
+    if (ksp->its >= ksp->max_it) {
+      ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    sb   = sc->basis.spectrum ? s : 1;
+    sb   = PetscMin(sb,ksp->max_it-ksp->its);
+    ierr = KSPSStepCGBlock_Private(ksp,Amat,sb,first);CHKERRQ(ierr);
+    first = PETSC_FALSE;
+    if (!ksp->reason && !sc->basis.spectrum && sc->nlanczos == s) {
+      ierr = PetscMemzero(sc->T,s*s*sizeof(PetscScalar));CHKERRQ(ierr);
+      for (j=0; j<s; j++) {
+        sc->T[j+j*s] = 1.0/sc->lalpha[j] + (j ? sc->lbeta[j-1]/sc->lalpha[j-1] : 0.0);
+        if (j < s-1) sc->T[j+1+j*s] = sc->T[j+(j+1)*s] = PetscSqrtReal(PetscAbsReal(sc->lbeta[j]))/sc->lalpha[j];
+      }
+      ierr = KSPSStepBasisSetSpectrum_Private(&sc->basis,s,sc->T,s);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_SSTEPCG(KSP ksp,PetscViewer viewer)
+{
+  KSP_SSTEPCG    *sc = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii,isstring;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERSTRING,&isstring);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  steps per block s=%D\n",sc->s);CHKERRQ(ierr);
+    ierr = KSPSStepBasisView_Private(&sc->basis,viewer);CHKERRQ(ierr);
+  } else if (isstring) {
+    ierr = PetscViewerStringSPrintf(viewer,"s %D",sc->s);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPCG(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_SSTEPCG    *sc = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step CG options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_sstepcg_s","Number of iterations per block (and global reduction)","",sc->s,&sc->s,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-ksp_sstepcg_basis","Polynomial basis of the matrix powers kernel","",KSPSStepBasisTypes,(PetscEnum)sc->basis.type,(PetscEnum*)&sc->basis.type,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPSSTEPCG - s-step (communication avoiding) preconditioned conjugate gradient method
+
+   Options Database Keys:
++   -ksp_sstepcg_s <s> - number of iterations per block, default 5
+-   -ksp_sstepcg_basis <chebyshev,newton,monomial> - polynomial basis used to generate the vectors, default chebyshev
+
+   Level: intermediate
+
+   Notes:
+   Each block applies the operator and the preconditioner 2s-1 times to generate the bases of the two Krylov spaces
+   spanned by the current search direction and preconditioned residual, the matrix powers kernel, and computes their Gram
+   matrix with a single global reduction. The next s iterations are then carried out on the coordinates of the iterates
+   in these bases without any communication, which reduces the number of global reductions by a factor of 2s compared
+   with KSPCG at the price of about twice as many applications of the operator and preconditioner.
+
+   The bases are generated with a Chebyshev (default) or Newton polynomial, built from the Ritz values of the first s
+   iterations of each KSPSolve() which perform one reduction per iteration, since the monomial basis quickly becomes
+   ill-conditioned.
+
+   The natural norm is used by default since it is available without extra work, the preconditioned and unpreconditioned
+   norms require an additional Gram matrix that is computed in the same reduction. Only left preconditioning is supported.
+
+   References:
+.   1. - E. Carson, Communication-avoiding Krylov subspace methods in theory and practice, PhD thesis, University of California Berkeley, 2015.
+
+.seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPCG, KSPSSTEPGMRES, KSPPIPECG, KSPPIPELCG, KSPGROPPCG
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *sc;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr      = PetscNewLog(ksp,&sc);CHKERRQ(ierr);
+  ksp->data = (void*)sc;
+
+  sc->s          = 5;
+  sc->basis.type = KSP_SSTEP_BASIS_CHEBYSHEV;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_SSTEPCG;
+  ksp->ops->solve          = KSPSolve_SSTEPCG;
+  ksp->ops->reset          = KSPReset_SSTEPCG;
+  ksp->ops->destroy        = KSPDestroy_SSTEPCG;
+  ksp->ops->view           = KSPView_SSTEPCG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_SSTEPCG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+  PetscFunctionReturn(0);
+}
@@ -1,6 +1,21 @@
 
 #include <../src/ksp/ksp/impls/cheby/chebyshevimpl.h>    /*I "petscksp.h" I*/
 
+static PetscErrorCode KSPChebyshevDeepHaloReset_Private(KSP ksp)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = ISDestroy(&cheb->isext);CHKERRQ(ierr);
+  if (cheb->Aext) {ierr = MatDestroySubMatrices(1,&cheb->Aext);CHKERRQ(ierr);}
+  ierr = VecScatterDestroy(&cheb->scext[0]);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&cheb->scext[1]);CHKERRQ(ierr);
+  ierr = VecDestroy(&cheb->dext);CHKERRQ(ierr);
+  if (cheb->vext) {ierr = VecDestroyVecs(5,&cheb->vext);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -8,6 +23,9 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPReset(cheb->kspest);CHKERRQ(ierr);
+  ierr = VecDestroy(&cheb->vpower);CHKERRQ(ierr);
+  ierr = KSPChebyshevDeepHaloReset_Private(ksp);CHKERRQ(ierr);
+  cheb->pmatnorm = 0.0;
   PetscFunctionReturn(0);
 }
 
@@ -68,6 +86,7 @@ static PetscErrorCode KSPChebyshevEstEigSet_Chebyshev(KSP ksp,PetscReal a,PetscR
     cheb->pmatid    = 0;
     cheb->amatstate = -1;
     cheb->pmatstate = -1;
+    cheb->pmatnorm  = 0.0;
   } else {
     ierr = KSPDestroy(&cheb->kspest);CHKERRQ(ierr);
   }
@@ -83,6 +102,17 @@ static PetscErrorCode KSPChebyshevEstEigSetUseNoisy_Chebyshev(KSP ksp,PetscBool
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode KSPChebyshevEstEigSetReuse_Chebyshev(KSP ksp,PetscReal rtol,PetscInt nrefresh)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  if (nrefresh < 0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of refresh steps %D cannot be negative",nrefresh);
+  cheb->reusertol    = rtol;
+  cheb->refreshsteps = nrefresh;
+  PetscFunctionReturn(0);
+}
+
 /*@
    KSPChebyshevSetEigenvalues - Sets estimates for the extreme eigenvalues
    of the preconditioned problem.
@@ -192,6 +222,103 @@ PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP ksp,PetscBool use)
   PetscFunctionReturn(0);
 }
 
+/*@
+   KSPChebyshevEstEigSetReuse - keep the computed eigenvalue estimates when the operator changes only slightly
+
+   Logically Collective on KSP
+
+   Input Arguments:
++  ksp - linear solver context
+.  rtol - the estimates are kept when the Frobenius norm of the preconditioning matrix changed by less than rtol relative to its value when they were computed, 0.0 disables reuse
+-  nrefresh - number of power iterations used to update the maximum eigenvalue estimate when it is kept, 0 to keep it unchanged
+
+   Options Database:
++  -ksp_chebyshev_esteig_reuse_rtol <rtol>
+-  -ksp_chebyshev_esteig_refresh_steps <nrefresh>
+
+   Notes:
+   By default the eigenvalues are estimated again, with a full Krylov solve, whenever the values of the operator change, for
+   example at each Newton step. When the operator changes little from one solve to the next the old estimates remain
+   good enough and this cost can be avoided.
+
+   The estimates are only kept while the same matrices are used; the comparison of the Frobenius norms is a heuristic and
+   requires MatNorm() to be supported by the preconditioning matrix. Since the power iterations start from the eigenvector
+   approximation left by the previous refresh a few of them usually suffice. A refresh may only increase the maximum
+   eigenvalue estimate, as underestimating it makes the Chebyshev smoother unstable.
+
+   Level: intermediate
+
+.seealso: KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+@*/
+PetscErrorCode KSPChebyshevEstEigSetReuse(KSP ksp,PetscReal rtol,PetscInt nrefresh)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveReal(ksp,rtol,2);
+  PetscValidLogicalCollectiveInt(ksp,nrefresh,3);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevEstEigSetReuse_C",(KSP,PetscReal,PetscInt),(ksp,rtol,nrefresh));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPChebyshevSetDeepHalo_Chebyshev(KSP ksp,PetscInt halo)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (halo < 0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Depth of the halo %D cannot be negative",halo);
+  if (halo != cheb->halo) {ierr = KSPChebyshevDeepHaloReset_Private(ksp);CHKERRQ(ierr);}
+  cheb->halo = halo;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPChebyshevSetDeepHalo - do the Chebyshev iterations on subdomains extended by several layers of overlap so that the
+   ghost values need to be exchanged only once every few iterations
+
+   Logically Collective on KSP
+
+   Input Arguments:
++  ksp - linear solver context
+-  halo - the number of layers of overlap, that is the number of iterations between two exchanges, 0 to disable
+
+   Options Database:
+.  -ksp_chebyshev_deep_halo <halo>
+
+   Notes:
+   Each process gathers the rows of the operator within halo layers of its own rows, from MatIncreaseOverlap() and
+   MatCreateSubMatrices(), and runs the iterations on this extended subdomain. The values on the outer layer are wrong
+   after one iteration since their couplings to the rest of the domain are missing, the error moves in by one layer at
+   each iteration, so after halo iterations the values on the owned rows are still exactly those of the standard method.
+   The ghost values are then exchanged again. This trades redundant computation for fewer messages, which pays off on
+   the coarse levels of multigrid where there is little local work and latency dominates. With a zero initial guess a
+   solve needs a single exchange, that of the right hand side, when halo is at least the number of iterations. With a
+   nonzero initial guess, the default for PCMG smoothers, the initial residual takes one more product with the
+   operator, so a single exchange needs halo to be at least the number of iterations plus one, for example with
+   -mg_levels_2_ksp_max_it 2 -mg_levels_2_ksp_chebyshev_deep_halo 3; with halo equal to the number of iterations there
+   are two exchanges.
+
+   This only applies when the preconditioner is diagonal (PCJACOBI or PCNONE), the operator supports
+   MatIncreaseOverlap() and MatCreateSubMatrices(), no norms are computed (KSP_NORM_NONE, the default for multigrid
+   smoothers) and no monitors are set; otherwise, and on one process, the standard iteration is used.
+
+   Level: advanced
+
+.seealso: KSPChebyshevEstEigSet(), PCMG
+@*/
+PetscErrorCode KSPChebyshevSetDeepHalo(KSP ksp,PetscInt halo)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,halo,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevSetDeepHalo_C",(KSP,PetscInt),(ksp,halo));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   KSPChebyshevEstEigGetKSP - Get the Krylov method context used to estimate eigenvalues for the Chebyshev method.  If
   a Krylov method is not being used for this purpose, NULL is returned.  The reference count of the returned KSP is
@@ -234,11 +361,16 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
   PetscInt       neigarg = 2, nestarg = 4;
   PetscReal      eminmax[2] = {0., 0.};
   PetscReal      tform[4] = {PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE};
-  PetscBool      flgeig, flgest;
+  PetscBool      flgeig, flgest, flghalo;
+  PetscInt       halo = cheb->halo;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"KSP Chebyshev Options");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-ksp_chebyshev_esteig_steps","Number of est steps in Chebyshev","",cheb->eststeps,&cheb->eststeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_chebyshev_deep_halo","Layers of overlap, iterations between two exchanges of ghost values","KSPChebyshevSetDeepHalo",halo,&halo,&flghalo);CHKERRQ(ierr);
+  if (flghalo) {
+    ierr = KSPChebyshevSetDeepHalo(ksp,halo);CHKERRQ(ierr);
+  }
   ierr = PetscOptionsRealArray("-ksp_chebyshev_eigenvalues","extreme eigenvalues","KSPChebyshevSetEigenvalues",eminmax,&neigarg,&flgeig);CHKERRQ(ierr);
   if (flgeig) {
     if (neigarg != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_chebyshev_eigenvalues: must specify 2 parameters, min and max eigenvalues");
@@ -266,7 +398,16 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
   }
 
   if (cheb->kspest) {
+    PetscReal rtol     = cheb->reusertol;
+    PetscInt  nrefresh = cheb->refreshsteps;
+    PetscBool flgrtol,flgrefresh;
+
     ierr = PetscOptionsBool("-ksp_chebyshev_esteig_noisy","Use noisy right hand side for estimate","KSPChebyshevEstEigSetUseNoisy",cheb->usenoisy,&cheb->usenoisy,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-ksp_chebyshev_esteig_reuse_rtol","Keep the estimates if the norm of the operator changed less than this","KSPChebyshevEstEigSetReuse",rtol,&rtol,&flgrtol);CHKERRQ(ierr);
+    ierr = PetscOptionsInt("-ksp_chebyshev_esteig_refresh_steps","Number of power iterations to refresh kept estimates","KSPChebyshevEstEigSetReuse",nrefresh,&nrefresh,&flgrefresh);CHKERRQ(ierr);
+    if (flgrtol || flgrefresh) {
+      ierr = KSPChebyshevEstEigSetReuse(ksp,rtol,nrefresh);CHKERRQ(ierr);
+    }
     ierr = KSPSetFromOptions(cheb->kspest);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
@@ -307,6 +448,396 @@ PETSC_STATIC_INLINE PetscScalar chebyhash(PetscInt xx)
   return (PetscScalar)((PetscInt64)x-2147483648)*5.e-10; /* center around zero, scaled about -1. to 1.*/
 }
 
+static PetscErrorCode KSPChebyshevSetNoisy_Private(Vec B)
+{
+  PetscErrorCode ierr;
+  PetscInt       n,i,istart;
+  PetscScalar    *xx;
+
+  PetscFunctionBegin;
+  ierr = VecGetOwnershipRange(B,&istart,NULL);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(B,&n);CHKERRQ(ierr);
+  ierr = VecGetArray(B,&xx);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    PetscScalar v = chebyhash(i+istart);
+    xx[i] = v;
+  }
+  ierr = VecRestoreArray(B,&xx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Determines if the eigenvalue estimates are out of date because the operators changed since they were computed and, if so,
+   if the previous estimates may be kept (see KSPChebyshevEstEigSetReuse())
+*/
+static PetscErrorCode KSPChebyshevEstEigCheck_Private(KSP ksp,PetscBool *estimate,PetscBool *reuse)
+{
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode   ierr;
+  Mat              Amat,Pmat;
+  PetscObjectId    amatid,    pmatid;
+  PetscObjectState amatstate, pmatstate;
+  PetscReal        nrm;
+
+  PetscFunctionBegin;
+  *estimate = PETSC_FALSE;
+  *reuse    = PETSC_FALSE;
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+  if (amatid == cheb->amatid && pmatid == cheb->pmatid && amatstate == cheb->amatstate && pmatstate == cheb->pmatstate) PetscFunctionReturn(0);
+  *estimate = PETSC_TRUE;
+  if (cheb->reusertol > 0.0 && cheb->pmatnorm > 0.0 && amatid == cheb->amatid && pmatid == cheb->pmatid) {
+    ierr = MatNorm(Pmat,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+    if (PetscAbsReal(nrm - cheb->pmatnorm) <= cheb->reusertol*cheb->pmatnorm) *reuse = PETSC_TRUE;
+    ierr = PetscInfo2(ksp,"Relative change of the operator norm %g, %s eigenvalue estimates\n",(double)(PetscAbsReal(nrm - cheb->pmatnorm)/cheb->pmatnorm),*reuse ? "keeping" : "recomputing");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Stores the eigenvalue estimates, the resulting Chebyshev bounds and the operators they correspond to; with savenorm the
+   norm of the preconditioning matrix is saved as the reference for KSPChebyshevEstEigCheck_Private()
+*/
+static PetscErrorCode KSPChebyshevEstEigUpdate_Private(KSP ksp,PetscReal min,PetscReal max,PetscBool savenorm)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  Mat            Amat,Pmat;
+
+  PetscFunctionBegin;
+  cheb->emin_computed = min;
+  cheb->emax_computed = max;
+  cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
+  cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
+
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Amat,&cheb->amatid);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Pmat,&cheb->pmatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Amat,&cheb->amatstate);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&cheb->pmatstate);CHKERRQ(ierr);
+  if (savenorm) {
+    PetscBool hasnorm;
+
+    cheb->pmatnorm = 0.0;
+    ierr = MatHasOperation(Pmat,MATOP_NORM,&hasnorm);CHKERRQ(ierr);
+    if (cheb->reusertol > 0.0 && hasnorm) {
+      ierr = MatNorm(Pmat,NORM_FROBENIUS,&cheb->pmatnorm);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Runs nsteps power iterations with B^{-1}A for each of the n Chebyshev solvers, starting from their vpower vectors, and
+   returns the resulting estimates of the largest eigenvalues. The norms of all the solvers are computed with split-phase
+   reductions so each iteration needs a single reduction for all of them, whatever n.
+*/
+static PetscErrorCode KSPChebyshevPowerIterations_Private(PetscInt n,KSP ksp[],PetscInt nsteps,PetscReal emax[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j;
+  Mat            Amat;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp[i]->data;
+
+    if (!cheb->vpower) {
+      ierr = VecDuplicate(ksp[i]->work[0],&cheb->vpower);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)ksp[i],(PetscObject)cheb->vpower);CHKERRQ(ierr);
+      ierr = KSPChebyshevSetNoisy_Private(cheb->vpower);CHKERRQ(ierr);
+    }
+    ierr = VecNormBegin(cheb->vpower,NORM_2,&emax[i]);CHKERRQ(ierr);
+  }
+  for (i=0; i<n; i++) {
+    KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp[i]->data;
+
+    ierr = VecNormEnd(cheb->vpower,NORM_2,&emax[i]);CHKERRQ(ierr);
+  }
+  for (j=0; j<nsteps; j++) {
+    for (i=0; i<n; i++) {
+      KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp[i]->data;
+
+      if (emax[i] == 0.0) continue; /* B^{-1}A vanishes on the iterate, nothing more to learn */
+      ierr = VecScale(cheb->vpower,1.0/emax[i]);CHKERRQ(ierr);
+      ierr = PCGetOperators(ksp[i]->pc,&Amat,NULL);CHKERRQ(ierr);
+      ierr = KSP_MatMult(ksp[i],Amat,cheb->vpower,ksp[i]->work[2]);CHKERRQ(ierr);
+      ierr = KSP_PCApply(ksp[i],ksp[i]->work[2],cheb->vpower);CHKERRQ(ierr);
+      ierr = VecNormBegin(cheb->vpower,NORM_2,&emax[i]);CHKERRQ(ierr);
+    }
+    for (i=0; i<n; i++) {
+      KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp[i]->data;
+
+      if (emax[i] == 0.0) continue;
+      ierr = VecNormEnd(cheb->vpower,NORM_2,&emax[i]);CHKERRQ(ierr);
+    }
+  }
+  for (i=0; i<n; i++) {
+    KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp[i]->data;
+
+    if (emax[i] != 0.0) {ierr = VecScale(cheb->vpower,1.0/emax[i]);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPChebyshevEstEigBatched_Private - Computes the eigenvalue estimates of several Chebyshev solvers together, for example
+   the smoothers of all the levels of a multigrid hierarchy.
+
+   Instead of one Krylov solve per solver, with several reductions per iteration each, power iterations are run on all the
+   solvers in lockstep so each iteration needs a single reduction for all of them. Only solvers whose Chebyshev bounds
+   depend on the maximum eigenvalue alone (the default transform) are handled, the others, and those that are not
+   KSPCHEBYSHEV, are left to estimate their eigenvalues in KSPSolve() as usual. The solvers must have been set up.
+*/
+PetscErrorCode KSPChebyshevEstEigBatched_Private(PetscInt n,KSP ksp[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i,nest = 0,nrefresh = 0,maxsteps = 0,maxrefresh = 0;
+  KSP            *kspest,*ksprefresh;
+  PetscReal      *emax;
+  PetscBool      ischeby,estimate,reuse;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc3(n,&kspest,n,&ksprefresh,n,&emax);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    KSP_Chebyshev *cheb;
+
+    if (!ksp[i] || !ksp[i]->work) continue;
+    ierr = PetscObjectTypeCompare((PetscObject)ksp[i],KSPCHEBYSHEV,&ischeby);CHKERRQ(ierr);
+    if (!ischeby) continue;
+    cheb = (KSP_Chebyshev*)ksp[i]->data;
+    if (!cheb->kspest || cheb->tform[0] != 0.0 || cheb->tform[2] != 0.0) continue;
+    ierr = KSPChebyshevEstEigCheck_Private(ksp[i],&estimate,&reuse);CHKERRQ(ierr);
+    if (!estimate) continue;
+    if (reuse && !cheb->refreshsteps) {
+      ierr = KSPChebyshevEstEigUpdate_Private(ksp[i],cheb->emin_computed,cheb->emax_computed,PETSC_FALSE);CHKERRQ(ierr);
+    } else if (reuse) {
+      ksprefresh[nrefresh++] = ksp[i];
+      maxrefresh = PetscMax(maxrefresh,cheb->refreshsteps);
+    } else {
+      /* the operator changed too much for the previous iterate to be a useful starting vector */
+      if (cheb->vpower) {ierr = KSPChebyshevSetNoisy_Private(cheb->vpower);CHKERRQ(ierr);}
+      kspest[nest++] = ksp[i];
+      maxsteps = PetscMax(maxsteps,cheb->eststeps);
+    }
+  }
+  if (nest) {
+    ierr = KSPChebyshevPowerIterations_Private(nest,kspest,maxsteps,emax);CHKERRQ(ierr);
+    for (i=0; i<nest; i++) {
+      KSP_Chebyshev *cheb = (KSP_Chebyshev*)kspest[i]->data;
+
+      ierr = PetscInfo1(kspest[i],"Maximum eigenvalue estimate from batched power iterations %g\n",(double)emax[i]);CHKERRQ(ierr);
+      ierr = KSPChebyshevEstEigUpdate_Private(kspest[i],0.0,emax[i],PETSC_TRUE);CHKERRQ(ierr);
+      cheb->estpower = PETSC_TRUE;
+    }
+  }
+  if (nrefresh) {
+    ierr = KSPChebyshevPowerIterations_Private(nrefresh,ksprefresh,maxrefresh,emax);CHKERRQ(ierr);
+    for (i=0; i<nrefresh; i++) {
+      KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksprefresh[i]->data;
+
+      ierr = PetscInfo2(ksprefresh[i],"Refreshed maximum eigenvalue estimate %g, previously %g\n",(double)emax[i],(double)cheb->emax_computed);CHKERRQ(ierr);
+      ierr = KSPChebyshevEstEigUpdate_Private(ksprefresh[i],cheb->emin_computed,PetscMax(emax[i],cheb->emax_computed),PETSC_FALSE);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree3(kspest,ksprefresh,emax);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Decides if the deep halo iteration can be used for this solve, see KSPChebyshevSetDeepHalo()
+*/
+static PetscErrorCode KSPChebyshevDeepHaloUsable_Private(KSP ksp,PetscBool *usable)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+  Mat            Amat;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  *usable = PETSC_FALSE;
+  if (!cheb->halo) PetscFunctionReturn(0);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)ksp),&size);CHKERRQ(ierr);
+  if (size == 1 || ksp->normtype != KSP_NORM_NONE || ksp->numbermonitors || ksp->transpose_solve) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompareAny((PetscObject)ksp->pc,&flg,PCJACOBI,PCNONE,"");CHKERRQ(ierr);
+  if (!flg) {
+    ierr = PetscInfo(ksp,"Deep halo iteration needs a diagonal preconditioner, using the standard iteration\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PCGetOperators(ksp->pc,&Amat,NULL);CHKERRQ(ierr);
+  ierr = MatHasOperation(Amat,MATOP_INCREASE_OVERLAP,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = MatHasOperation(Amat,MATOP_CREATE_SUBMATRICES,&flg);CHKERRQ(ierr);}
+  if (!flg) {
+    ierr = PetscInfo1(ksp,"Deep halo iteration not supported by matrix type %s, using the standard iteration\n",((PetscObject)Amat)->type_name);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  *usable = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Builds the subdomain extended by halo layers of the graph of the operator and gathers the operator and the diagonal
+   preconditioner onto it. Only the values are gathered again when the operators change but not their nonzero structure.
+*/
+static PetscErrorCode KSPChebyshevDeepHaloSetUp_Private(KSP ksp)
+{
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode   ierr;
+  Mat              Amat,Pmat;
+  PetscObjectId    amatid;
+  PetscObjectState amatstate,pmatstate,nonzerostate;
+  PetscInt         rstart,rend,n;
+  const PetscInt   *idx;
+
+  PetscFunctionBegin;
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(Amat,&nonzerostate);CHKERRQ(ierr);
+  if (cheb->Aext) {
+    if (amatid == cheb->haloid && nonzerostate == cheb->halononzerostate) {
+      if (amatstate == cheb->haloamatstate && pmatstate == cheb->halopmatstate) PetscFunctionReturn(0);
+      ierr = MatCreateSubMatrices(Amat,1,&cheb->isext,&cheb->isext,MAT_REUSE_MATRIX,&cheb->Aext);CHKERRQ(ierr);
+    } else {
+      ierr = KSPChebyshevDeepHaloReset_Private(ksp);CHKERRQ(ierr);
+    }
+  }
+  if (!cheb->Aext) {
+    ierr = MatGetOwnershipRange(Amat,&rstart,&rend);CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF,rend-rstart,rstart,1,&cheb->isext);CHKERRQ(ierr);
+    ierr = MatIncreaseOverlap(Amat,1,&cheb->isext,cheb->halo);CHKERRQ(ierr);
+    ierr = ISSort(cheb->isext);CHKERRQ(ierr);
+    ierr = MatCreateSubMatrices(Amat,1,&cheb->isext,&cheb->isext,MAT_INITIAL_MATRIX,&cheb->Aext);CHKERRQ(ierr);
+
+    ierr = ISGetLocalSize(cheb->isext,&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(cheb->isext,&idx);CHKERRQ(ierr);
+    for (cheb->ownext=0; cheb->ownext<n && idx[cheb->ownext]<rstart; cheb->ownext++) ;
+    ierr = ISRestoreIndices(cheb->isext,&idx);CHKERRQ(ierr);
+    ierr = VecCreateSeq(PETSC_COMM_SELF,n,&cheb->dext);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(cheb->dext,5,&cheb->vext);CHKERRQ(ierr);
+    ierr = VecScatterCreate(ksp->work[0],cheb->isext,cheb->dext,NULL,&cheb->scext[0]);CHKERRQ(ierr);
+    ierr = VecScatterCopy(cheb->scext[0],&cheb->scext[1]);CHKERRQ(ierr);
+    cheb->haloid           = amatid;
+    cheb->halononzerostate = nonzerostate;
+  }
+  /* the preconditioner is diagonal, applying it to ones gives its diagonal */
+  ierr = VecSet(ksp->work[0],1.0);CHKERRQ(ierr);
+  ierr = PCApply(ksp->pc,ksp->work[0],ksp->work[1]);CHKERRQ(ierr);
+  ierr = VecScatterBegin(cheb->scext[0],ksp->work[1],cheb->dext,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(cheb->scext[0],ksp->work[1],cheb->dext,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  cheb->haloamatstate = amatstate;
+  cheb->halopmatstate = pmatstate;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Copies the values of the owned rows of the extended subdomain vector xext to the global vector x
+*/
+static PetscErrorCode KSPChebyshevDeepHaloRestrict_Private(KSP ksp,Vec xext,Vec x)
+{
+  KSP_Chebyshev     *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode    ierr;
+  PetscInt          n;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(x,&n);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xext,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&ya);CHKERRQ(ierr);
+  ierr = PetscMemcpy(ya,xa+cheb->ownext,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArray(x,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xext,&xa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The Chebyshev iteration of KSPSolve_Chebyshev() run on the extended subdomain. Each product with the operator
+   invalidates one more layer of the subdomain, so after halo products the two iterates the recurrence depends on are
+   refreshed from their owned values with one exchange.
+*/
+static PetscErrorCode KSPSolve_Chebyshev_DeepHalo(KSP ksp)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       k,kp1,km1,ktmp,i,nmult = 0;
+  PetscScalar    alpha,omegaprod,mu,omega,Gamma,c[3],scale;
+  Vec            p[3],r,b,dext;
+  Mat            Aext;
+
+  PetscFunctionBegin;
+  ierr = KSPChebyshevDeepHaloSetUp_Private(ksp);CHKERRQ(ierr);
+  Aext = cheb->Aext[0];
+  dext = cheb->dext;
+  km1  = 0; k = 1; kp1 = 2;
+  p[0] = cheb->vext[0];
+  p[1] = cheb->vext[1];
+  p[2] = cheb->vext[2];
+  r    = cheb->vext[3];
+  b    = cheb->vext[4];
+
+  scale     = 2.0/(cheb->emax + cheb->emin);
+  alpha     = 1.0 - scale*(cheb->emin);
+  Gamma     = 1.0;
+  mu        = 1.0/alpha;
+  omegaprod = 2.0/alpha;
+
+  c[km1] = 1.0;
+  c[k]   = mu;
+
+  ierr = VecScatterBegin(cheb->scext[0],ksp->vec_rhs,b,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  if (!ksp->guess_zero) {ierr = VecScatterBegin(cheb->scext[1],ksp->vec_sol,p[km1],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);}
+  ierr = VecScatterEnd(cheb->scext[0],ksp->vec_rhs,b,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  if (!ksp->guess_zero) {
+    ierr = VecScatterEnd(cheb->scext[1],ksp->vec_sol,p[km1],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = MatMult(Aext,p[km1],r);CHKERRQ(ierr);
+    ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+    nmult++;
+  } else {
+    ierr = VecSet(p[km1],0.0);CHKERRQ(ierr);
+    ierr = VecCopy(b,r);CHKERRQ(ierr);
+  }
+  ierr = VecPointwiseMult(p[k],dext,r);CHKERRQ(ierr);
+  ierr = VecAYPX(p[k],scale,p[km1]);CHKERRQ(ierr);
+
+  ksp->its = 0;
+  for (i=0; i<ksp->max_it; i++) {
+    ksp->its++;
+    c[kp1] = 2.0*mu*c[k] - c[km1];
+    omega  = omegaprod*c[k]/c[kp1];
+
+    if (nmult == cheb->halo) {
+      ierr = KSPChebyshevDeepHaloRestrict_Private(ksp,p[k],ksp->work[0]);CHKERRQ(ierr);
+      ierr = KSPChebyshevDeepHaloRestrict_Private(ksp,p[km1],ksp->work[1]);CHKERRQ(ierr);
+      ierr = VecScatterBegin(cheb->scext[0],ksp->work[0],p[k],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterBegin(cheb->scext[1],ksp->work[1],p[km1],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(cheb->scext[0],ksp->work[0],p[k],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(cheb->scext[1],ksp->work[1],p[km1],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      nmult = 0;
+    }
+    ierr = MatMult(Aext,p[k],r);CHKERRQ(ierr);                  /*  r = b - Ap[k]    */
+    ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+    nmult++;
+    ierr = VecPointwiseMult(p[kp1],dext,r);CHKERRQ(ierr);       /*  p[kp1] = B^{-1}r  */
+
+    /* y^{k+1} = omega(y^{k} - y^{k-1} + Gamma*r^{k}) + y^{k-1} */
+    ierr = VecAXPBYPCZ(p[kp1],1.0-omega,omega,omega*Gamma*scale,p[km1],p[k]);CHKERRQ(ierr);
+
+    ktmp = km1;
+    km1  = k;
+    k    = kp1;
+    kp1  = ktmp;
+  }
+  ierr = KSPChebyshevDeepHaloRestrict_Private(ksp,p[k],ksp->vec_sol);CHKERRQ(ierr);
+  ksp->reason = KSP_CONVERGED_ITS;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -315,42 +846,35 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
   PetscScalar    alpha,omegaprod,mu,omega,Gamma,c[3],scale;
   PetscReal      rnorm = 0.0;
   Vec            sol_orig,b,p[3],r;
-  Mat            Amat,Pmat;
-  PetscBool      diagonalscale;
+  Mat            Amat;
+  PetscBool      diagonalscale,deephalo;
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
   if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
 
-  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PCGetOperators(ksp->pc,&Amat,NULL);CHKERRQ(ierr);
   if (cheb->kspest) {
-    PetscObjectId    amatid,    pmatid;
-    PetscObjectState amatstate, pmatstate;
-
-    ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
-    ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
-    ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
-    ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
-    if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
+    PetscBool estimate,reuse;
+
+    ierr = KSPChebyshevEstEigCheck_Private(ksp,&estimate,&reuse);CHKERRQ(ierr);
+    if (estimate && reuse) {
+      PetscReal max = cheb->emax_computed;
+
+      if (cheb->refreshsteps) {
+        ierr = KSPChebyshevPowerIterations_Private(1,&ksp,cheb->refreshsteps,&max);CHKERRQ(ierr);
+        ierr = PetscInfo2(ksp,"Refreshed maximum eigenvalue estimate %g, previously %g\n",(double)max,(double)cheb->emax_computed);CHKERRQ(ierr);
+        max  = PetscMax(max,cheb->emax_computed);
+      }
+      ierr = KSPChebyshevEstEigUpdate_Private(ksp,cheb->emin_computed,max,PETSC_FALSE);CHKERRQ(ierr);
+    } else if (estimate) {
       PetscReal          max=0.0,min=0.0;
       Vec                B;
       KSPConvergedReason reason;
 
       if (cheb->usenoisy) {
-        B  = ksp->work[1];
-        {
-          PetscErrorCode ierr;
-          PetscInt       n,i,istart;
-          PetscScalar    *xx;
-          ierr = VecGetOwnershipRange(B,&istart,NULL);CHKERRQ(ierr);
-          ierr = VecGetLocalSize(B,&n);CHKERRQ(ierr);
-          ierr = VecGetArray(B,&xx);CHKERRQ(ierr);
-          for (i=0; i<n; i++) {
-            PetscScalar v = chebyhash(i+istart);
-            xx[i] = v;
-          }
-          ierr = VecRestoreArray(B,&xx);CHKERRQ(ierr);
-        }
+        B    = ksp->work[1];
+        ierr = KSPChebyshevSetNoisy_Private(B);CHKERRQ(ierr);
       } else {
         PC        pc;
         PetscBool change;
@@ -388,19 +912,17 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
       }
 
       ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
-
-      cheb->emin_computed = min;
-      cheb->emax_computed = max;
-      cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
-      cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
-
-      cheb->amatid    = amatid;
-      cheb->pmatid    = pmatid;
-      cheb->amatstate = amatstate;
-      cheb->pmatstate = pmatstate;
+      ierr = KSPChebyshevEstEigUpdate_Private(ksp,min,max,PETSC_TRUE);CHKERRQ(ierr);
+      cheb->estpower = PETSC_FALSE;
     }
   }
 
+  ierr = KSPChebyshevDeepHaloUsable_Private(ksp,&deephalo);CHKERRQ(ierr);
+  if (deephalo) {
+    ierr = KSPSolve_Chebyshev_DeepHalo(ksp);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
   ksp->its = 0;
   maxit    = ksp->max_it;
 
@@ -516,8 +1038,15 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates used:  min = %g, max = %g\n",(double)cheb->emin,(double)cheb->emax);CHKERRQ(ierr);
-    if (cheb->kspest) {
+    if (cheb->halo) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  iterating on subdomains with %D layers of overlap\n",cheb->halo);CHKERRQ(ierr);
+    }
+    if (cheb->kspest && cheb->estpower) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  maximum eigenvalue estimate via power iterations %g\n",(double)cheb->emax_computed);CHKERRQ(ierr);
+    } else if (cheb->kspest) {
       ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalues estimate via %s min %g, max %g\n",((PetscObject)(cheb->kspest))->type_name,(double)cheb->emin_computed,(double)cheb->emax_computed);CHKERRQ(ierr);
+    }
+    if (cheb->kspest) {
       ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalues estimated using %s with translations  [%g %g; %g %g]\n",((PetscObject) cheb->kspest)->type_name,(double)cheb->tform[0],(double)cheb->tform[1],(double)cheb->tform[2],(double)cheb->tform[3]);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
       ierr = KSPView(cheb->kspest,viewer);CHKERRQ(ierr);
@@ -525,6 +1054,9 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
       if (cheb->usenoisy) {
         ierr = PetscViewerASCIIPrintf(viewer,"  estimating eigenvalues using noisy right hand side\n");CHKERRQ(ierr);
       }
+      if (cheb->reusertol > 0.0) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  keeping estimates for relative operator changes below %g, with %D refresh steps\n",(double)cheb->reusertol,cheb->refreshsteps);CHKERRQ(ierr);
+      }
     }
   }
   PetscFunctionReturn(0);
@@ -537,9 +1069,13 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPDestroy(&cheb->kspest);CHKERRQ(ierr);
+  ierr = VecDestroy(&cheb->vpower);CHKERRQ(ierr);
+  ierr = KSPChebyshevDeepHaloReset_Private(ksp);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetReuse_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetDeepHalo_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",NULL);CHKERRQ(ierr);
   ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -554,7 +1090,10 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (KSPChebyshevEstEigSet())
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_reuse_rtol <rtol> - keep the estimates while the norm of the operator changes by less than rtol (KSPChebyshevEstEigSetReuse())
+.   -ksp_chebyshev_esteig_refresh_steps <n> - number of power iterations used to refresh kept estimates
+-   -ksp_chebyshev_deep_halo <halo> - iterate on subdomains with halo layers of overlap, exchanging ghost values once every halo iterations (KSPChebyshevSetDeepHalo())
 
    Level: beginner
 
@@ -567,7 +1106,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
-           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy(), KSPChebyshevEstEigSetReuse(), KSPChebyshevSetDeepHalo()
            KSPRICHARDSON, KSPCG, PCMG
 
 M*/
@@ -608,6 +1147,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",KSPChebyshevSetEigenvalues_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",KSPChebyshevEstEigSet_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",KSPChebyshevEstEigSetUseNoisy_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetReuse_C",KSPChebyshevEstEigSetReuse_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetDeepHalo_C",KSPChebyshevSetDeepHalo_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",KSPChebyshevEstEigGetKSP_Chebyshev);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
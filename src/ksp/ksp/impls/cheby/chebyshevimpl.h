@@ -14,6 +14,22 @@ typedef struct {
   PetscReal        tform[4];     /* transform from Krylov estimates to Chebyshev bounds */
   PetscInt         eststeps;     /* number of kspest steps in KSP used to estimate eigenvalues */
   PetscBool        usenoisy;    /* use noisy right hand side vector to estimate eigenvalues */
+  /* For keeping the estimates when the operator changes only slightly, see KSPChebyshevEstEigSetReuse() */
+  PetscReal        reusertol;    /* keep the estimates if the Frobenius norm of Pmat changed less than this, relatively */
+  PetscInt         refreshsteps; /* number of power iterations used to refresh a kept estimate */
+  PetscReal        pmatnorm;     /* Frobenius norm of Pmat when the estimates were computed, 0 if unknown */
+  Vec              vpower;       /* current approximation of the dominant eigenvector, used by the power iterations */
+  PetscBool        estpower;     /* the current estimates come from power iterations rather than from kspest */
+  /* For smoothing on subdomains extended by a deep halo, with one exchange every halo steps, see KSPChebyshevSetDeepHalo() */
+  PetscInt         halo;         /* number of layers of overlap, 0 for the standard iteration */
+  IS               isext;        /* global indices of the extended subdomain */
+  Mat              *Aext;        /* the operator restricted to the extended subdomain */
+  VecScatter       scext[2];     /* gather global vectors onto the extended subdomain, two copies to gather two vectors at once */
+  Vec              dext;         /* the diagonal preconditioner on the extended subdomain */
+  Vec              *vext;        /* work vectors on the extended subdomain: three iterates, residual and right hand side */
+  PetscInt         ownext;       /* offset of the locally owned rows in the extended subdomain */
+  PetscObjectId    haloid;       /* operators the subdomain data were built from */
+  PetscObjectState halononzerostate,haloamatstate,halopmatstate;
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid,    pmatid;
   PetscObjectState amatstate, pmatstate;
@@ -0,0 +1,258 @@
+/*
+    One-reduction classical Gram-Schmidt with delayed reorthogonalization (DCGS-2)
+    for the orthogonalization of the Hessenberg matrix.
+
+    The new Krylov vector vv(it+1) is projected against the basis only once, and its
+    reorthogonalization and normalization are lagged to the next iteration where they are
+    merged into the global reduction of the next projection. Both the dot products and the
+    vector updates are done with fused kernels that stream each basis vector only once for
+    the two vectors being orthogonalized.
+
+    Note that for the complex numbers version, the dot products below MUST remain
+    in the order given for correct computation of inner products.
+*/
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+/* number of entries processed per sweep over the basis vectors by the fused kernels */
+#define KSPGMRES_FUSED_BLOCK 256
+
+/*
+   Computes in one pass over the n local entries of the nv basis vectors q[]
+
+     dv[i] = q[i]^H v,  dw[i] = q[i]^H w,  vvw[] = {v^H v, v^H w, w^H w}
+
+   The entries of v and w are processed in blocks so that they stay in cache while the
+   basis vectors are streamed through; each basis vector is thus read once for both v and w.
+*/
+static PetscErrorCode KSPGMRESFusedMDot_Private(PetscInt n,PetscInt nv,const PetscScalar **q,const PetscScalar *v,const PetscScalar *w,PetscScalar *dv,PetscScalar *dw,PetscScalar *vvw)
+{
+  PetscInt       i,k,k0,k1;
+  PetscScalar    sv,sw,c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<nv; i++) dv[i] = dw[i] = 0.0;
+  vvw[0] = vvw[1] = vvw[2] = 0.0;
+  for (k0=0; k0<n; k0+=KSPGMRES_FUSED_BLOCK) {
+    k1 = PetscMin(n,k0+KSPGMRES_FUSED_BLOCK);
+    for (i=0; i<nv; i++) {
+      const PetscScalar *qi = q[i];
+      sv = sw = 0.0;
+      for (k=k0; k<k1; k++) {
+        c   = PetscConj(qi[k]);
+        sv += v[k]*c;
+        sw += w[k]*c;
+      }
+      dv[i] += sv;
+      dw[i] += sw;
+    }
+    for (k=k0; k<k1; k++) {
+      c       = PetscConj(v[k]);
+      vvw[0] += v[k]*c;
+      vvw[1] += w[k]*c;
+      vvw[2] += w[k]*PetscConj(w[k]);
+    }
+  }
+  ierr = PetscLogFlops(4.0*(nv+2)*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes in one pass over the n local entries of the nv basis vectors q[]
+
+     v <- (v - sum_i a[i] q[i]) * sv,   w <- w * sw - cv * vold - sum_i z[i] q[i]
+
+   where vold is v on entry.
+*/
+static PetscErrorCode KSPGMRESFusedMAXPY_Private(PetscInt n,PetscInt nv,const PetscScalar **q,const PetscScalar *a,const PetscScalar *z,PetscScalar sv,PetscScalar sw,PetscScalar cv,PetscScalar *v,PetscScalar *w)
+{
+  PetscInt       i,k,k0,k1;
+  PetscScalar    ta[KSPGMRES_FUSED_BLOCK],tz[KSPGMRES_FUSED_BLOCK],vk;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (k0=0; k0<n; k0+=KSPGMRES_FUSED_BLOCK) {
+    k1 = PetscMin(n,k0+KSPGMRES_FUSED_BLOCK);
+    for (k=0; k<k1-k0; k++) ta[k] = tz[k] = 0.0;
+    for (i=0; i<nv; i++) {
+      const PetscScalar *qi = q[i] + k0;
+      const PetscScalar ai  = a[i],zi = z[i];
+      for (k=0; k<k1-k0; k++) {
+        ta[k] += ai*qi[k];
+        tz[k] += zi*qi[k];
+      }
+    }
+    for (k=k0; k<k1; k++) {
+      vk   = v[k];
+      v[k] = (vk - ta[k-k0])*sv;
+      w[k] = w[k]*sw - cv*vk - tz[k-k0];
+    }
+  }
+  ierr = PetscLogFlops(4.0*nv*n + 6.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+     KSPGMRESDelayedClassicalGramSchmidtOrthogonalization -  Orthogonalization routine using classical Gram-Schmidt
+                with one reorthogonalization step that is delayed to the next iteration (DCGS-2), requiring a single
+                global reduction per iteration
+
+     Collective on KSP
+
+  Input Parameters:
++   ksp - KSP object, must be associated with the GMRES Krylov method
+-   its - one less then the current GMRES restart iteration, i.e. the size of the Krylov space
+
+   Options Database Keys:
+.  -ksp_gmres_delayedclassicalgramschmidt - Activates KSPGMRESDelayedClassicalGramSchmidtOrthogonalization()
+
+   Notes:
+   At iteration its the previous Krylov vector, which was only orthogonalized once against the basis and normalized with
+   an estimated norm, is reorthogonalized and normalized while the new vector is projected. The inner products needed for
+   both operations and for the norm of the new vector are computed together and summed with one MPI reduction; the column
+   of the Hessenberg matrix from the previous iteration and its plane rotation are then corrected. The classical Gram-Schmidt
+   with refinement, KSPGMRESClassicalGramSchmidtOrthogonalization(), needs two or three reductions per iteration for the
+   same stability.
+
+   The local dot products and vector updates are each done in one streaming pass over the Krylov basis, processing the
+   two vectors at once, so the basis is read twice per iteration instead of two to four times. It is therefore mostly
+   beneficial for large restarts, say 30 to 100, where the orthogonalization dominates the cost of GMRES.
+
+   The residual norm reported at an iteration is computed with the uncorrected Hessenberg column and may differ from the
+   one of the classical Gram-Schmidt by a relative amount of the order of the loss of orthogonality.
+
+   This orthogonalization is only available with KSPGMRES since it modifies the previous Krylov vector after it has been
+   used by the Krylov method.
+
+   Level: intermediate
+
+.seealso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESModifiedGramSchmidtOrthogonalization(),
+           KSPGMRESGetOrthogonalization()
+
+@*/
+PetscErrorCode  KSPGMRESDelayedClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt it)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       i,j,n,max_k = gmres->max_k;
+  PetscScalar    *a,*b,*u,*z,*vvw,*hh,*hes,*cc,*ss,*v,*w;
+  PetscScalar    qw,eta,kappa,g,tt,t;
+  PetscReal      beta2,beta,onrm2,hnrm2,wnrm2;
+  PetscBool      isgmres;
+
+  PetscFunctionBegin;
+  if (!it) {
+    ierr = PetscObjectTypeCompare((PetscObject)ksp,KSPGMRES,&isgmres);CHKERRQ(ierr);
+    if (!isgmres) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Delayed classical Gram-Schmidt orthogonalization is not supported by KSP type %s",((PetscObject)ksp)->type_name);
+  }
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  if (!gmres->orthogfused) {
+    ierr = PetscMalloc2(4*(max_k+2),&gmres->orthogfused,max_k+1,&gmres->orthogarrays);CHKERRQ(ierr);
+  }
+  /* a = V^H v_it, b = V^H w, vvw = {v_it^H v_it, v_it^H w, w^H w} with V = [v_0 ... v_it-1], w = vv(it+1) */
+  a   = gmres->orthogfused;
+  b   = a + it;
+  vvw = b + it;
+  u   = a + 2*max_k + 3;
+  z   = u + max_k;
+
+  ierr = VecGetLocalSize(VEC_VV(it),&n);CHKERRQ(ierr);
+  for (i=0; i<it; i++) {ierr = VecGetArrayRead(VEC_VV(i),&gmres->orthogarrays[i]);CHKERRQ(ierr);}
+  ierr = VecGetArray(VEC_VV(it),&v);CHKERRQ(ierr);
+  ierr = VecGetArray(VEC_VV(it+1),&w);CHKERRQ(ierr);
+  ierr = KSPGMRESFusedMDot_Private(n,it,gmres->orthogarrays,v,w,a,b,vvw);CHKERRQ(ierr);
+  for (i=0; i<it; i++) {ierr = VecRestoreArrayRead(VEC_VV(i),&gmres->orthogarrays[i]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(VEC_VV(it),&v);CHKERRQ(ierr);
+  ierr = VecRestoreArray(VEC_VV(it+1),&w);CHKERRQ(ierr);
+  /* a, b and vvw are contiguous so a single reduction sums all of them */
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,a,2*it+3,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)ksp));CHKERRQ(ierr);
+  for (i=0; i<it; i++) {
+    KSPCheckDot(ksp,a[i]);
+    KSPCheckDot(ksp,b[i]);
+  }
+  KSPCheckDot(ksp,vvw[1]);
+
+  /* norm of v_it after its reorthogonalization */
+  beta2 = PetscRealPart(vvw[0]);
+  for (i=0; i<it; i++) beta2 -= PetscRealPart(a[i]*PetscConj(a[i]));
+  if (beta2 <= 0.0) {
+    ierr = PetscInfo1(ksp,"Breakdown in the reorthogonalization of the Krylov vector, estimated squared norm %g\n",(double)beta2);CHKERRQ(ierr);
+    ksp->reason = KSP_DIVERGED_BREAKDOWN;
+    ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  beta = PetscSqrtReal(beta2);
+
+  if (it) {
+    /* the previous column was computed with v_it before its reorthogonalization, correct it */
+    cc  = CC(it-1);
+    ss  = SS(it-1);
+    g   = *cc * *GRS(it-1) - PetscConj(*ss) * *GRS(it); /* undo the plane rotation of the right-hand-side */
+    t   = *HES(it,it-1);
+    for (i=0; i<it; i++) *HES(i,it-1) += t*a[i];
+    *HES(it,it-1) = t*beta;
+
+    /* reapply the plane rotations to the corrected column and recompute the last one */
+    hh = HH(0,it-1);
+    for (i=0; i<=it; i++) hh[i] = *HES(i,it-1);
+    for (j=0; j<it-1; j++) {
+      tt      = hh[j];
+      hh[j]   = PetscConj(*CC(j)) * tt + *SS(j) * hh[j+1];
+      hh[j+1] = *CC(j) * hh[j+1] - *SS(j) * tt;
+    }
+    tt = PetscSqrtScalar(PetscConj(hh[it-1]) * hh[it-1] + PetscConj(hh[it]) * hh[it]);
+    *cc        = hh[it-1] / tt;
+    *ss        = hh[it] / tt;
+    *GRS(it)   = -(*ss * g);
+    *GRS(it-1) = PetscConj(*cc) * g;
+    hh[it-1]   = PetscConj(*cc) * hh[it-1] + *ss * hh[it];
+
+    /* u = H(0:it-1,0:it-1) a, eta = H(it,it-1) a[it-1]; A V = V u + eta v_it */
+    for (i=0; i<it; i++) {
+      u[i] = 0.0;
+      for (j=PetscMax(i-1,0); j<it; j++) u[i] += *HES(i,j) * a[j];
+    }
+    eta = *HES(it,it-1) * a[it-1];
+  } else eta = 0.0;
+
+  /* the new column: projections of A v_it = (w - V u - eta v_it)/beta on the final basis */
+  qw = vvw[1];
+  for (i=0; i<it; i++) qw -= PetscConj(a[i]) * b[i];
+  qw   /= beta;
+  hh    = HH(0,it);
+  hes   = HES(0,it);
+  onrm2 = PetscRealPart(vvw[2]) - 2.0*PetscRealPart(PetscConj(eta)*qw) + PetscRealPart(PetscConj(eta)*eta);
+  hnrm2 = 0.0;
+  for (i=0; i<it; i++) {
+    onrm2 += PetscRealPart(PetscConj(u[i])*u[i]) - 2.0*PetscRealPart(PetscConj(u[i])*b[i]);
+    hh[i]  = hes[i] = (b[i] - u[i]) / beta;
+    hnrm2 += PetscRealPart(PetscConj(hh[i])*hh[i]);
+  }
+  hh[it]  = hes[it] = (qw - eta) / beta;
+  hnrm2  += PetscRealPart(PetscConj(hh[it])*hh[it]);
+  onrm2  /= beta2;
+  kappa   = eta / beta + hh[it];
+  for (i=0; i<it; i++) z[i] = u[i] / beta + hh[i] - kappa / beta * a[i];
+
+  /*
+     norm of the new vector from the Pythagorean theorem; it is only used when there is no significant cancellation,
+     otherwise the cycle computes it. The corresponding entry of the Hessenberg matrix is corrected in the next iteration.
+  */
+  wnrm2 = onrm2 - hnrm2;
+  for (i=0; i<it; i++) {ierr = VecGetArrayRead(VEC_VV(i),&gmres->orthogarrays[i]);CHKERRQ(ierr);}
+  ierr = VecGetArray(VEC_VV(it),&v);CHKERRQ(ierr);
+  ierr = VecGetArray(VEC_VV(it+1),&w);CHKERRQ(ierr);
+  if (wnrm2 > PETSC_SQRT_MACHINE_EPSILON*onrm2) {
+    gmres->orthognorm = PetscSqrtReal(wnrm2);
+    for (i=0; i<it; i++) z[i] /= gmres->orthognorm;
+    ierr = KSPGMRESFusedMAXPY_Private(n,it,gmres->orthogarrays,a,z,1.0/beta,1.0/(beta*gmres->orthognorm),kappa/(beta*gmres->orthognorm),v,w);CHKERRQ(ierr);
+  } else {
+    gmres->orthognorm = 0.0;
+    ierr = KSPGMRESFusedMAXPY_Private(n,it,gmres->orthogarrays,a,z,1.0/beta,1.0/beta,kappa/beta,v,w);CHKERRQ(ierr);
+  }
+  for (i=0; i<it; i++) {ierr = VecRestoreArrayRead(VEC_VV(i),&gmres->orthogarrays[i]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(VEC_VV(it),&v);CHKERRQ(ierr);
+  ierr = VecRestoreArray(VEC_VV(it+1),&w);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
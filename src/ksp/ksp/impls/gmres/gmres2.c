@@ -16,18 +16,22 @@ $   it is one minus the number of GMRES iterations since last restart;
 $    i.e. the size of Krylov space minus one
 
    Notes:
-   Two orthogonalization routines are predefined, including
+   Three orthogonalization routines are predefined, including
 
    KSPGMRESModifiedGramSchmidtOrthogonalization()
 
    KSPGMRESClassicalGramSchmidtOrthogonalization() - Default. Use KSPGMRESSetCGSRefinementType() to determine if
      iterative refinement is used to increase stability.
 
+   KSPGMRESDelayedClassicalGramSchmidtOrthogonalization() - Classical Gram-Schmidt with a refinement delayed to the next
+     iteration, requiring a single reduction per iteration. Only for KSPGMRES.
+
 
    Options Database Keys:
 
 +  -ksp_gmres_classicalgramschmidt - Activates KSPGMRESClassicalGramSchmidtOrthogonalization() (default)
--  -ksp_gmres_modifiedgramschmidt - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+.  -ksp_gmres_modifiedgramschmidt - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+-  -ksp_gmres_delayedclassicalgramschmidt - Activates KSPGMRESDelayedClassicalGramSchmidtOrthogonalization()
 
    Level: intermediate
 
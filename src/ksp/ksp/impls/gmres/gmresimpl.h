@@ -18,6 +18,9 @@
   PetscScalar *rs_origin;   /* holds the right-hand-side of the Hessenberg system */ \
                                                                         \
   PetscScalar *orthogwork; /* holds dot products computed in orthogonalization */ \
+  PetscScalar *orthogfused; /* holds dot products and coefficients of the delayed classical Gram-Schmidt */ \
+  const PetscScalar **orthogarrays; /* local arrays of the Krylov vectors used by the delayed classical Gram-Schmidt */ \
+  PetscReal   orthognorm;  /* if positive, vv(it+1) was normalized by the orthogonalization and this is its norm */ \
                                                                         \
   /* Work space for computing eigenvalues/singular values */            \
   PetscReal   *Dsvd;                                                    \
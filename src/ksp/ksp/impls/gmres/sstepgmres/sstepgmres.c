@@ -0,0 +1,468 @@
+/*
+    s-step (communication avoiding) GMRES: s basis vectors are generated with the matrix powers kernel and
+    orthogonalized against the current basis and among themselves with a single global reduction (block
+    classical Gram-Schmidt followed by Cholesky QR)
+*/
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscInt      s;                    /* number of steps per block */
+  PetscInt      restart;              /* requested restart, rounded up to a multiple of s in max_k */
+  PetscInt      max_k;
+  PetscInt      it;                   /* last column of the Hessenberg matrix in the current cycle */
+  PetscReal     haptol;
+  KSPSStepBasis basis;
+  Vec           *Q;                   /* orthonormal Krylov basis, max_k+1 vectors */
+  Vec           sol_temp;
+  PetscScalar   *H,*HR;               /* Hessenberg matrix and its triangular factor from the Givens rotations */
+  PetscScalar   *g,*cc,*ss;           /* right hand side of the least squares problem and the rotations */
+  PetscScalar   *C,*Gw,*R,*y;         /* block orthogonalization workspace */
+} KSP_SSTEPGMRES;
+
+#define H(i,j)  (sg->H[(i)+(j)*(sg->max_k+1)])
+#define HR(i,j) (sg->HR[(i)+(j)*(sg->max_k+1)])
+#define C(i,j)  (sg->C[(i)+(j)*(sg->max_k+1)])
+#define Gw(i,j) (sg->Gw[(i)+(j)*sg->s])
+#define R(i,j)  (sg->R[(i)+(j)*sg->s])
+
+static PetscErrorCode KSPSetUp_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscInt       s   = sg->s,max_k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps per block %D must be positive",s);
+  max_k     = ((PetscMax(sg->restart,s) + s - 1)/s)*s;
+  sg->max_k = max_k;
+
+  ierr = KSPSetWorkVecs(ksp,2);CHKERRQ(ierr);
+  ierr = KSPCreateVecs(ksp,max_k+1,&sg->Q,0,NULL);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,max_k+1,sg->Q);CHKERRQ(ierr);
+  ierr = PetscCalloc5((max_k+1)*max_k,&sg->H,(max_k+1)*max_k,&sg->HR,max_k+1,&sg->g,max_k,&sg->cc,max_k,&sg->ss);CHKERRQ(ierr);
+  ierr = PetscMalloc4((max_k+1)*s,&sg->C,s*s,&sg->Gw,s*s,&sg->R,2*(max_k+1),&sg->y);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(2*(max_k+1)*max_k+3*max_k+1+(max_k+1)*s+2*s*s+2*(max_k+1))*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = KSPSStepBasisSetUp_Private(&sg->basis,s);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDestroyVecs(sg->max_k+1,&sg->Q);CHKERRQ(ierr);
+  ierr = VecDestroy(&sg->sol_temp);CHKERRQ(ierr);
+  ierr = PetscFree5(sg->H,sg->HR,sg->g,sg->cc,sg->ss);CHKERRQ(ierr);
+  ierr = PetscFree4(sg->C,sg->Gw,sg->R,sg->y);CHKERRQ(ierr);
+  ierr = KSPSStepBasisReset_Private(&sg->basis);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPGMRES(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_SSTEPGMRES(ksp);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* entry (i,j) of the matrix expressing the block [w_0 ... w_s] in the orthonormal basis, w_0 = q_k */
+PETSC_STATIC_INLINE PetscScalar KSPSStepGMRESRfull_Private(KSP_SSTEPGMRES *sg,PetscInt k,PetscInt i,PetscInt j)
+{
+  if (!j)       return (i == k) ? 1.0 : 0.0;
+  if (i <= k)   return C(i,j-1);
+  if (i <= k+j) return R(i-k-1,j-1);
+  return 0.0;
+}
+
+/*
+   KSPSStepGMRESBlock_Private - Extends the orthonormal basis Q_{0:k} by up to sb vectors and computes the
+   corresponding columns k,...,k+nnew-1 of the Hessenberg matrix
+
+   The vectors w_1,...,w_sb of the matrix powers kernel are generated in place of q_{k+1},...,q_{k+sb}. With
+   W = Q Rfull and Op W_{0:sb-1} = W_{0:sb} B the new columns of H follow from
+       H_{:,k:k+sb-1} T = Rfull B - [H_{0:k,0:k-1} Rfull_{0:k-1,0:sb-1}; 0]
+   where T is the upper triangular block Rfull_{k:k+sb-1,0:sb-1}.
+*/
+static PetscErrorCode KSPSStepGMRESBlock_Private(KSP ksp,PetscInt k,PetscInt sb,PetscInt *nnew)
+{
+  KSP_SSTEPGMRES *sg    = (KSP_SSTEPGMRES*)ksp->data;
+  KSPSStepBasis  *basis = &sg->basis;
+  Vec            *Q     = sg->Q;
+  PetscScalar    *y     = sg->y,*t = sg->y + sg->max_k + 1,sum;
+  PetscReal      nrm;
+  PetscInt       i,j,l,c,n = sb;
+  PetscBLASInt   bsb,lds,info;
+  PetscBool      cholqr = PETSC_TRUE;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)ksp,&comm);CHKERRQ(ierr);
+  for (i=0; i<sb; i++) {
+    ierr = KSP_PCApplyBAorAB(ksp,Q[k+i],Q[k+i+1],ksp->work[1]);CHKERRQ(ierr);
+    ierr = KSPSStepBasisAdvance_Private(basis,i,i ? Q[k+i-1] : NULL,Q[k+i],Q[k+i+1]);CHKERRQ(ierr);
+  }
+
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  /* projections on the current basis and Gram matrix of the new vectors, in a single reduction */
+  for (j=0; j<sb; j++) {
+    ierr = VecMDotBegin(Q[k+1+j],k+1,Q,&C(0,j));CHKERRQ(ierr);
+    ierr = VecMDotBegin(Q[k+1+j],j+1,Q+k+1,&Gw(0,j));CHKERRQ(ierr);
+  }
+  ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+  for (j=0; j<sb; j++) {
+    ierr = VecMDotEnd(Q[k+1+j],k+1,Q,&C(0,j));CHKERRQ(ierr);
+    ierr = VecMDotEnd(Q[k+1+j],j+1,Q+k+1,&Gw(0,j));CHKERRQ(ierr);
+  }
+
+  /* R^H R = W^H W - C^H C */
+  for (j=0; j<sb; j++) {
+    for (i=0; i<=j; i++) {
+      sum = Gw(i,j);
+      for (l=0; l<=k; l++) sum -= PetscConj(C(l,i))*C(l,j);
+      R(i,j) = sum;
+    }
+    for (i=j+1; i<sb; i++) R(i,j) = 0.0;
+  }
+  ierr = PetscBLASIntCast(sb,&bsb);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(sg->s,&lds);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&bsb,sg->R,&lds,&info));
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (info) cholqr = PETSC_FALSE;
+  /* more than half of the digits lost in the cancellation W^H W - C^H C */
+  for (j=0; j<sb && cholqr; j++) {
+    if (!(PetscRealPart(R(j,j)) >= PetscSqrtReal(PETSC_SQRT_MACHINE_EPSILON*PetscAbsScalar(Gw(j,j))))) cholqr = PETSC_FALSE;
+  }
+
+  if (cholqr) {
+    for (j=0; j<sb; j++) {
+      for (l=0; l<=k; l++) y[l] = -C(l,j);
+      for (i=0; i<j; i++) y[k+1+i] = -R(i,j);
+      ierr = VecMAXPY(Q[k+1+j],k+1+j,y,Q);CHKERRQ(ierr);
+      ierr = VecScale(Q[k+1+j],1.0/R(j,j));CHKERRQ(ierr);
+    }
+  } else {
+    /* the block is too ill-conditioned for Cholesky QR, orthogonalize it column by column */
+    ierr = PetscInfo2(ksp,"Cholesky QR of %D basis vectors failed at iteration %D, using classical Gram-Schmidt with reorthogonalization\n",sb,ksp->its);CHKERRQ(ierr);
+    for (j=0; j<sb; j++) {
+      ierr = VecMDot(Q[k+1+j],k+1+j,Q,y);CHKERRQ(ierr);
+      for (l=0; l<k+1+j; l++) t[l] = -y[l];
+      ierr = VecMAXPY(Q[k+1+j],k+1+j,t,Q);CHKERRQ(ierr);
+      ierr = VecMDot(Q[k+1+j],k+1+j,Q,t);CHKERRQ(ierr);
+      for (l=0; l<k+1+j; l++) {
+        y[l] += t[l];
+        t[l]  = -t[l];
+      }
+      ierr = VecMAXPY(Q[k+1+j],k+1+j,t,Q);CHKERRQ(ierr);
+      ierr = VecNorm(Q[k+1+j],NORM_2,&nrm);CHKERRQ(ierr);
+      for (l=0; l<=k; l++) C(l,j) = y[l];
+      for (i=0; i<j; i++) R(i,j) = y[k+1+i];
+      R(j,j) = nrm;
+      for (i=j+1; i<sb; i++) R(i,j) = 0.0;
+      /* numerically dependent basis vector: stop the block here, the next one starts from the last valid vector */
+      if (j && nrm < PETSC_SQRT_MACHINE_EPSILON*PetscSqrtReal(PetscAbsScalar(Gw(j,j)))) {
+        ierr = PetscInfo2(ksp,"Matrix powers basis lost rank at vector %D of %D\n",j+1,sb);CHKERRQ(ierr);
+        n = j;
+        break;
+      }
+      if (nrm > 0.0) {ierr = VecScale(Q[k+1+j],1.0/nrm);CHKERRQ(ierr);}
+    }
+  }
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+
+  for (c=0; c<n; c++) {
+    for (i=0; i<=k+c+1; i++) {
+      sum = basis->theta[c]*KSPSStepGMRESRfull_Private(sg,k,i,c) + KSPSStepGMRESRfull_Private(sg,k,i,c+1)/basis->alpha[c];
+      if (c) {
+        sum += basis->sigma[c]*KSPSStepGMRESRfull_Private(sg,k,i,c-1);
+        for (l=PetscMax(i-1,0); l<k; l++) sum -= H(i,l)*C(l,c-1);
+      }
+      for (j=PetscMax(i-k-1,0); j<c; j++) sum -= H(i,k+j)*KSPSStepGMRESRfull_Private(sg,k,k+j,c);
+      H(i,k+c) = sum/KSPSStepGMRESRfull_Private(sg,k,k+c,c);
+    }
+  }
+  *nnew = n;
+  PetscFunctionReturn(0);
+}
+
+/* applies the previous Givens rotations to column it of the Hessenberg matrix and computes the next one */
+static PetscErrorCode KSPSStepGMRESUpdateHessenberg_Private(KSP ksp,PetscInt it,PetscBool hapend,PetscReal *res)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscScalar    *hh,*cc,*ss,*g = sg->g,tt;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  for (j=0; j<=it+1; j++) HR(j,it) = H(j,it);
+  hh = &HR(0,it);
+  cc = sg->cc;
+  ss = sg->ss;
+  for (j=1; j<=it; j++) {
+    tt  = *hh;
+    *hh = PetscConj(*cc) * tt + *ss * *(hh+1);
+    hh++;
+    *hh = *cc++ * *hh - (*ss++ * tt);
+  }
+  if (!hapend) {
+    tt = PetscSqrtScalar(PetscConj(*hh) * *hh + PetscConj(*(hh+1)) * *(hh+1));
+    if (tt == 0.0) {
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(0);
+    }
+    *cc     = *hh / tt;
+    *ss     = *(hh+1) / tt;
+    g[it+1] = -(*ss * g[it]);
+    g[it]   = PetscConj(*cc) * g[it];
+    *hh     = PetscConj(*cc) * *hh + *ss * *(hh+1);
+    *res    = PetscAbsScalar(g[it+1]);
+  } else *res = 0.0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepGMRESBuildSoln_Private(KSP ksp,Vec vs,Vec vdest,PetscInt it)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscScalar    *y  = sg->y,tt;
+  PetscInt       i,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (it < 0) {
+    ierr = VecCopy(vs,vdest);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=it; i>=0; i--) {
+    tt = sg->g[i];
+    for (j=i+1; j<=it; j++) tt -= HR(i,j)*y[j];
+    if (HR(i,i) == 0.0) {
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      ierr = PetscInfo1(ksp,"Likely your matrix or preconditioner is singular. HR(k,k) is identically zero; k = %D\n",i);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    y[i] = tt/HR(i,i);
+  }
+  ierr = VecSet(ksp->work[0],0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(ksp->work[0],it+1,y,sg->Q);CHKERRQ(ierr);
+  ierr = KSPUnwindPreconditioner(ksp,ksp->work[0],ksp->work[1]);CHKERRQ(ierr);
+  if (vdest != vs) {
+    ierr = VecCopy(vs,vdest);CHKERRQ(ierr);
+  }
+  ierr = VecAXPY(vdest,1.0,ksp->work[0]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepGMRESCycle_Private(KSP ksp,PetscInt *itcount)
+{
+  KSP_SSTEPGMRES *sg    = (KSP_SSTEPGMRES*)ksp->data;
+  KSPSStepBasis  *basis = &sg->basis;
+  PetscInt       max_k  = sg->max_k,k = 0,c,n,sb,it;
+  PetscReal      res,tt,hapbnd;
+  PetscBool      hapend = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *itcount = 0;
+  ierr  = VecNormalize(sg->Q[0],&res);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,res);
+  sg->g[0] = res;
+  sg->it   = -1;
+  ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->rnorm = res;
+  ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+  ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    ierr        = PetscInfo(ksp,"Converged due to zero residual norm on entry\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+
+  while (!ksp->reason && k < max_k && ksp->its < ksp->max_it) {
+    /* single vector blocks until the Ritz values for the basis are available */
+    sb   = basis->spectrum ? PetscMin(sg->s,max_k-k) : 1;
+    sb   = PetscMin(sb,ksp->max_it-ksp->its);
+    ierr = KSPSStepGMRESBlock_Private(ksp,k,sb,&n);CHKERRQ(ierr);
+    for (c=0; c<n; c++) {
+      it     = k+c;
+      tt     = PetscAbsScalar(H(it+1,it));
+      hapbnd = PetscAbsScalar(tt / sg->g[it]);
+      if (hapbnd > sg->haptol) hapbnd = sg->haptol;
+      if (tt < hapbnd) {
+        ierr   = PetscInfo2(ksp,"Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n",(double)hapbnd,(double)tt);CHKERRQ(ierr);
+        hapend = PETSC_TRUE;
+      }
+      ierr = KSPSStepGMRESUpdateHessenberg_Private(ksp,it,hapend,&res);CHKERRQ(ierr);
+      if (ksp->reason) break;
+      sg->it     = it;
+      ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->its++;
+      ksp->rnorm = res;
+      ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (hapend && !ksp->reason) {
+        if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"You reached the happy break down, but convergence was not indicated. Residual norm = %g",(double)res);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      }
+      /* the residual at a restart is monitored by the next cycle */
+      if (ksp->reason || ksp->its >= ksp->max_it || it+1 < max_k) {
+        ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+        ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+      }
+      if (ksp->reason || ksp->its >= ksp->max_it) {c++; break;}
+    }
+    k += c;
+    if (!ksp->reason && !basis->spectrum && k >= sg->s) {
+      ierr = KSPSStepBasisSetSpectrum_Private(basis,sg->s,sg->H,max_k+1);CHKERRQ(ierr);
+    }
+  }
+  *itcount = k;
+  ierr = KSPSStepGMRESBuildSoln_Private(ksp,ksp->vec_sol,ksp->vec_sol,k-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sg        = (KSP_SSTEPGMRES*)ksp->data;
+  PetscBool      guess_zero = ksp->guess_zero;
+  PetscInt       its,itcount = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr     = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  /* the operator may have changed since the last solve, recompute the basis from new Ritz values */
+  ierr        = KSPSStepBasisSetMonomial_Private(&sg->basis);CHKERRQ(ierr);
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  while (!ksp->reason) {
+    ierr     = KSPInitialResidual(ksp,ksp->vec_sol,ksp->work[0],ksp->work[1],sg->Q[0],ksp->vec_rhs);CHKERRQ(ierr);
+    ierr     = KSPSStepGMRESCycle_Private(ksp,&its);CHKERRQ(ierr);
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPBuildSolution_SSTEPGMRES(KSP ksp,Vec ptr,Vec *result)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!sg->sol_temp) {
+      ierr = VecDuplicate(ksp->vec_sol,&sg->sol_temp);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)sg->sol_temp);CHKERRQ(ierr);
+    }
+    ptr = sg->sol_temp;
+  }
+  ierr = KSPSStepGMRESBuildSoln_Private(ksp,ksp->vec_sol,ptr,sg->it);CHKERRQ(ierr);
+  if (result) *result = ptr;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_SSTEPGMRES(KSP ksp,PetscViewer viewer)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii,isstring;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERSTRING,&isstring);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, steps per block s=%D\n",sg->max_k ? sg->max_k : sg->restart,sg->s);CHKERRQ(ierr);
+    ierr = KSPSStepBasisView_Private(&sg->basis,viewer);CHKERRQ(ierr);
+  } else if (isstring) {
+    ierr = PetscViewerStringSPrintf(viewer,"restart %D s %D",sg->max_k ? sg->max_k : sg->restart,sg->s);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPGMRES(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_SSTEPGMRES *sg = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step GMRES options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_sstepgmres_s","Number of basis vectors generated per block (and global reduction)","",sg->s,&sg->s,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_sstepgmres_restart","Number of Krylov directions, rounded up to a multiple of s","",sg->restart,&sg->restart,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-ksp_sstepgmres_basis","Polynomial basis of the matrix powers kernel","",KSPSStepBasisTypes,(PetscEnum)sg->basis.type,(PetscEnum*)&sg->basis.type,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-ksp_sstepgmres_haptol","Tolerance for exact convergence (happy ending)","",sg->haptol,&sg->haptol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPSSTEPGMRES - s-step (communication avoiding) GMRES
+
+   Options Database Keys:
++   -ksp_sstepgmres_s <s> - number of Krylov basis vectors generated by each block, default 5
+.   -ksp_sstepgmres_restart <restart> - number of Krylov directions before a restart, rounded up to a multiple of s, default 30
+.   -ksp_sstepgmres_basis <newton,chebyshev,monomial> - polynomial basis used to generate the vectors, default newton
+-   -ksp_sstepgmres_haptol <tol> - tolerance for "happy ending" (exact convergence)
+
+   Level: intermediate
+
+   Notes:
+   Each block applies the (preconditioned) operator s times in a row, the matrix powers kernel, and then orthogonalizes
+   the s new vectors against the previous ones and among themselves with a single global reduction, using block
+   classical Gram-Schmidt followed by Cholesky QR. This reduces the number of global reductions by a factor of s compared
+   with KSPGMRES, which matters when the reductions dominate the run time on very many processes.
+
+   The basis vectors are generated with a Newton (Ritz values as shifts in Leja order) or Chebyshev polynomial since the
+   monomial basis quickly becomes ill-conditioned. The Ritz values are obtained from the first s iterations of each
+   KSPSolve(), which perform one reduction per iteration. If the Cholesky QR loses too much accuracy the block is
+   orthogonalized with classical Gram-Schmidt with reorthogonalization instead, at the cost of additional reductions.
+
+   Supports left preconditioning with the preconditioned norm and right preconditioning with the unpreconditioned norm.
+
+   References:
+.   1. - M. Hoemmen, Communication-avoiding Krylov subspace methods, PhD thesis, University of California Berkeley, 2010.
+
+.seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPGMRES, KSPSSTEPCG, KSPPIPEFGMRES, KSPPGMRES
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr      = PetscNewLog(ksp,&sg);CHKERRQ(ierr);
+  ksp->data = (void*)sg;
+
+  sg->s          = 5;
+  sg->restart    = 30;
+  sg->haptol     = 1.0e-30;
+  sg->basis.type = KSP_SSTEP_BASIS_NEWTON;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_RIGHT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_RIGHT,1);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_SSTEPGMRES;
+  ksp->ops->solve          = KSPSolve_SSTEPGMRES;
+  ksp->ops->reset          = KSPReset_SSTEPGMRES;
+  ksp->ops->destroy        = KSPDestroy_SSTEPGMRES;
+  ksp->ops->view           = KSPView_SSTEPGMRES;
+  ksp->ops->setfromoptions = KSPSetFromOptions_SSTEPGMRES;
+  ksp->ops->buildsolution  = KSPBuildSolution_SSTEPGMRES;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,252 @@
+/*
+    Polynomial bases for the s-step (communication avoiding) Krylov methods KSPSSTEPCG and KSPSSTEPGMRES
+*/
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+const char *const KSPSStepBasisTypes[] = {"MONOMIAL","NEWTON","CHEBYSHEV","KSPSStepBasisType","KSP_SSTEP_BASIS_",0};
+
+PetscErrorCode KSPSStepBasisSetUp_Private(KSPSStepBasis *basis,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = KSPSStepBasisReset_Private(basis);CHKERRQ(ierr);
+  basis->s = s;
+  ierr     = PetscMalloc3(s,&basis->alpha,s,&basis->theta,s,&basis->sigma);CHKERRQ(ierr);
+  ierr     = KSPSStepBasisSetMonomial_Private(basis);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode KSPSStepBasisReset_Private(KSPSStepBasis *basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(basis->alpha,basis->theta,basis->sigma);CHKERRQ(ierr);
+  basis->spectrum = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPSStepBasisSetMonomial_Private - Resets the basis to the unscaled monomial one, used until Ritz values are available
+*/
+PetscErrorCode KSPSStepBasisSetMonomial_Private(KSPSStepBasis *basis)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0; i<basis->s; i++) {
+    basis->alpha[i] = 1.0;
+    basis->theta[i] = 0.0;
+    basis->sigma[i] = 0.0;
+  }
+  basis->spectrum = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the eigenvalues of the leading n x n block of H, returns flg = PETSC_FALSE when they are not available
+*/
+static PetscErrorCode KSPSStepBasisRitz_Private(PetscInt n,const PetscScalar *H,PetscInt ldh,PetscReal *er,PetscReal *ei,PetscBool *flg)
+{
+#if defined(PETSC_HAVE_ESSL) || defined(PETSC_MISSING_LAPACK_GEEV)
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+#else
+  PetscErrorCode ierr;
+  PetscInt       i,j;
+  PetscBLASInt   bn,lwork,idummy = 1,lierr;
+  PetscScalar    *R,*work,sdummy;
+#if defined(PETSC_USE_COMPLEX)
+  PetscScalar    *eigs;
+  PetscReal      *rwork;
+#endif
+
+  PetscFunctionBegin;
+  ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(5*n,&lwork);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n*n,&R,5*n,&work);CHKERRQ(ierr);
+  for (j=0; j<n; j++) {
+    for (i=0; i<n; i++) R[i+j*n] = H[i+j*ldh];
+  }
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,R,&bn,er,ei,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,&lierr));
+#else
+  ierr = PetscMalloc2(n,&eigs,2*n,&rwork);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,R,&bn,eigs,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,rwork,&lierr));
+  for (i=0; i<n; i++) {
+    er[i] = PetscRealPart(eigs[i]);
+    ei[i] = PetscImaginaryPart(eigs[i]);
+  }
+  ierr = PetscFree2(eigs,rwork);CHKERRQ(ierr);
+#endif
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  ierr = PetscFree2(R,work);CHKERRQ(ierr);
+  *flg = lierr ? PETSC_FALSE : PETSC_TRUE;
+  for (i=0; i<n && *flg; i++) {
+    if (PetscIsInfOrNanReal(er[i]) || PetscIsInfOrNanReal(ei[i])) *flg = PETSC_FALSE;
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPSStepBasisSetSpectrum_Private - Builds the basis from the Ritz values of the leading n x n block of the
+   Hessenberg (or tridiagonal) matrix H, with leading dimension ldh, of the preconditioned operator
+
+   Notes:
+   The Newton basis uses the Ritz values as shifts in Leja order, in real arithmetic complex conjugate pairs are
+   kept adjacent so that the basis remains real. The Chebyshev basis uses the interval spanned by the real parts
+   of the Ritz values. If the Ritz values cannot be computed a monomial basis scaled by the 1-norm of H is used.
+*/
+PetscErrorCode KSPSStepBasisSetSpectrum_Private(KSPSStepBasis *basis,PetscInt n,const PetscScalar *H,PetscInt ldh)
+{
+  PetscErrorCode ierr;
+  PetscInt       s = basis->s,i,j,k,jbest;
+  PetscReal      *er,*ei,*zr,*zi,rho,c,d,rmin,rmax,val,best,dist;
+  PetscBool      *used,flg;
+
+  PetscFunctionBegin;
+  if (n < 1) PetscFunctionReturn(0);
+  ierr = PetscMalloc5(n,&er,n,&ei,s,&zr,s,&zi,n,&used);CHKERRQ(ierr);
+  ierr = KSPSStepBasisRitz_Private(n,H,ldh,er,ei,&flg);CHKERRQ(ierr);
+  ierr = KSPSStepBasisSetMonomial_Private(basis);CHKERRQ(ierr);
+  if (!flg || basis->type == KSP_SSTEP_BASIS_MONOMIAL) {
+    rho = 0.0;
+    if (flg) {
+      for (i=0; i<n; i++) rho = PetscMax(rho,PetscSqrtReal(er[i]*er[i]+ei[i]*ei[i]));
+    } else {
+      for (j=0; j<n; j++) {
+        for (val=0.0,i=0; i<=PetscMin(j+1,n-1); i++) val += PetscAbsScalar(H[i+j*ldh]);
+        rho = PetscMax(rho,val);
+      }
+    }
+    if (rho == 0.0) rho = 1.0;
+    for (i=0; i<s; i++) basis->alpha[i] = 1.0/rho;
+  } else if (basis->type == KSP_SSTEP_BASIS_CHEBYSHEV) {
+    rmin = rmax = er[0];
+    for (i=1; i<n; i++) {
+      rmin = PetscMin(rmin,er[i]);
+      rmax = PetscMax(rmax,er[i]);
+    }
+    /* the extreme Ritz values lie inside the spectrum so widen the interval a bit */
+    c = 0.5*(rmax + rmin);
+    d = 0.55*(rmax - rmin);
+    if (d <= PETSC_SQRT_MACHINE_EPSILON*PetscAbsReal(c)) d = 0.1*PetscAbsReal(c);
+    if (d == 0.0) d = 1.0;
+    for (i=0; i<s; i++) {
+      basis->theta[i] = c;
+      basis->alpha[i] = i ? 2.0/d : 1.0/d;
+      basis->sigma[i] = i ? 0.5*d : 0.0;
+    }
+  } else {
+    /* Leja ordering of the Ritz values, conjugate pairs enter through their member with positive imaginary part */
+    for (j=0; j<n; j++) used[j] = PETSC_FALSE;
+#if !defined(PETSC_USE_COMPLEX)
+    for (j=0; j<n; j++) if (ei[j] < 0.0) used[j] = PETSC_TRUE;
+#endif
+    for (i=0; i<s;) {
+      jbest = -1;
+      best  = PETSC_MIN_REAL;
+      for (j=0; j<n; j++) {
+        if (used[j]) continue;
+        if (!i) val = PetscSqrtReal(er[j]*er[j]+ei[j]*ei[j]);
+        else {
+          for (val=0.0,k=0; k<i; k++) {
+            dist = PetscSqrtReal((er[j]-zr[k])*(er[j]-zr[k])+(ei[j]-zi[k])*(ei[j]-zi[k]));
+            val += PetscLogReal(PetscMax(dist,PETSC_MACHINE_EPSILON));
+          }
+        }
+        if (val > best) {best = val; jbest = j;}
+      }
+      if (jbest < 0) {
+        /* fewer Ritz values than steps, cycle through them again */
+        for (j=0; j<n; j++) used[j] = PETSC_FALSE;
+#if !defined(PETSC_USE_COMPLEX)
+        for (j=0; j<n; j++) if (ei[j] < 0.0) used[j] = PETSC_TRUE;
+#endif
+        continue;
+      }
+      used[jbest] = PETSC_TRUE;
+      rho         = 0.0;
+      for (k=0; k<n; k++) {
+        rho = PetscMax(rho,PetscSqrtReal((er[k]-er[jbest])*(er[k]-er[jbest])+(ei[k]-ei[jbest])*(ei[k]-ei[jbest])));
+#if !defined(PETSC_USE_COMPLEX)
+        rho = PetscMax(rho,PetscSqrtReal((er[k]-er[jbest])*(er[k]-er[jbest])+(ei[k]+ei[jbest])*(ei[k]+ei[jbest])));
+#endif
+      }
+      if (rho == 0.0) rho = PetscSqrtReal(er[jbest]*er[jbest]+ei[jbest]*ei[jbest]);
+      if (rho == 0.0) rho = 1.0;
+#if !defined(PETSC_USE_COMPLEX)
+      basis->theta[i] = er[jbest];
+#else
+      basis->theta[i] = er[jbest] + PETSC_i*ei[jbest];
+#endif
+      basis->alpha[i] = 1.0/rho;
+      zr[i] = er[jbest];
+      zi[i] = ei[jbest];
+      i++;
+#if !defined(PETSC_USE_COMPLEX)
+      if (ei[jbest] > 0.0 && i < s) {
+        /* second step of the pair: w_{i+1} is proportional to ((Op - a)^2 + b^2) w_{i-1} */
+        basis->theta[i] = er[jbest];
+        basis->alpha[i] = 1.0/rho;
+        basis->sigma[i] = -basis->alpha[i-1]*ei[jbest]*ei[jbest];
+        zr[i] = er[jbest];
+        zi[i] = -ei[jbest];
+        i++;
+      }
+#endif
+    }
+  }
+  basis->spectrum = PETSC_TRUE;
+  ierr = PetscFree5(er,ei,zr,zi,used);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPSStepBasisAdvance_Private - Computes the basis vector wp = w_{i+1} from wp = Op w_i, w = w_i and wm = w_{i-1}
+*/
+PetscErrorCode KSPSStepBasisAdvance_Private(KSPSStepBasis *basis,PetscInt i,Vec wm,Vec w,Vec wp)
+{
+  PetscErrorCode ierr;
+  PetscScalar    alpha = basis->alpha[i],theta = basis->theta[i],sigma = basis->sigma[i];
+
+  PetscFunctionBegin;
+  if (i && sigma != 0.0) {
+    ierr = VecAXPBYPCZ(wp,-alpha*theta,-alpha*sigma,alpha,w,wm);CHKERRQ(ierr);
+  } else if (theta != 0.0) {
+    ierr = VecAXPBY(wp,-alpha*theta,alpha,w);CHKERRQ(ierr);
+  } else if (alpha != 1.0) {
+    ierr = VecScale(wp,alpha);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode KSPSStepBasisView_Private(KSPSStepBasis *basis,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"  %s basis\n",KSPSStepBasisTypes[basis->type]);CHKERRQ(ierr);
+  if (basis->spectrum && basis->type == KSP_SSTEP_BASIS_NEWTON) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  shifts from the last solve:");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
+    for (i=0; i<basis->s; i++) {
+#if !defined(PETSC_USE_COMPLEX)
+      ierr = PetscViewerASCIIPrintf(viewer," %g",(double)basis->theta[i]);CHKERRQ(ierr);
+#else
+      ierr = PetscViewerASCIIPrintf(viewer," %g%+gi",(double)PetscRealPart(basis->theta[i]),(double)PetscImaginaryPart(basis->theta[i]));CHKERRQ(ierr);
+#endif
+    }
+    ierr = PetscViewerASCIIPrintf(viewer,"\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
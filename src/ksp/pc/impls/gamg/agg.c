@@ -1082,6 +1082,84 @@ static PetscErrorCode PCGAMGProlongator_AGG(PC pc,Mat Amat,Mat Gmat,PetscCoarsen
   PetscFunctionReturn(0);
 }
 
+/* Estimates the largest eigenvalue of D^{-1} A, used to smooth the prolongator */
+static PetscErrorCode PCGAMGEstimateEigen_AGG(PC pc,Mat Amat,PetscReal *emax)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  KSP            eksp;
+  Vec            bb, xx;
+  PC             epc;
+  PetscReal      emin;
+  PetscRandom    random;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Amat,&comm);CHKERRQ(ierr);
+  ierr = MatCreateVecs(Amat, &bb, 0);CHKERRQ(ierr);
+  ierr = MatCreateVecs(Amat, &xx, 0);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&random);CHKERRQ(ierr);
+  ierr = VecSetRandom(bb,random);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&random);CHKERRQ(ierr);
+
+  ierr = KSPCreate(comm,&eksp);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(eksp,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT,10);CHKERRQ(ierr);
+  ierr = KSPSetNormType(eksp, KSP_NORM_NONE);CHKERRQ(ierr);
+  ierr = KSPSetErrorIfNotConverged(eksp,PETSC_FALSE);CHKERRQ(ierr);
+
+  ierr = KSPSetInitialGuessNonzero(eksp, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = KSPSetOperators(eksp, Amat, Amat);CHKERRQ(ierr);
+  ierr = KSPSetComputeSingularValues(eksp,PETSC_TRUE);CHKERRQ(ierr);
+
+  ierr = KSPGetPC(eksp, &epc);CHKERRQ(ierr);
+  ierr = PCSetType(epc, PCJACOBI);CHKERRQ(ierr);  /* smoother in smoothed agg. */
+
+  ierr = KSPSetOptionsPrefix(eksp,((PetscObject)pc)->prefix);CHKERRQ(ierr);
+  ierr = KSPAppendOptionsPrefix(eksp, "gamg_est_");CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(eksp);CHKERRQ(ierr);
+
+  /* solve - keep stuff out of logging */
+  ierr = PetscLogEventDeactivate(KSP_Solve);CHKERRQ(ierr);
+  ierr = PetscLogEventDeactivate(PC_Apply);CHKERRQ(ierr);
+  ierr = KSPSolve(eksp, bb, xx);CHKERRQ(ierr);
+  ierr = PetscLogEventActivate(KSP_Solve);CHKERRQ(ierr);
+  ierr = PetscLogEventActivate(PC_Apply);CHKERRQ(ierr);
+
+  ierr = KSPComputeExtremeSingularValues(eksp, emax, &emin);CHKERRQ(ierr);
+  ierr = PetscInfo3(pc,"Smooth P0: max eigen=%e min=%e PC=%s\n",*emax,emin,PCJACOBI);CHKERRQ(ierr);
+  ierr = VecDestroy(&xx);CHKERRQ(ierr);
+  ierr = VecDestroy(&bb);CHKERRQ(ierr);
+  ierr = KSPDestroy(&eksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Smooths P0 with one Jacobi step, P := (I - 1.4/emax D^{-1}A)P0. With MAT_REUSE_MATRIX, P must have been computed
+   from the same P0 with MAT_INITIAL_MATRIX and only its values are recomputed.
+*/
+static PetscErrorCode PCGAMGSmoothProlongator_AGG(Mat Amat,PetscReal emax,Mat P0,MatReuse scall,Mat *P)
+{
+  PetscErrorCode ierr;
+  Vec            diag;
+  PetscReal      alpha;
+
+  PetscFunctionBegin;
+#if defined PETSC_GAMG_USE_LOG
+  ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
+#endif
+  ierr  = MatMatMult(Amat, P0, scall, PETSC_DEFAULT, P);CHKERRQ(ierr);
+  ierr  = MatCreateVecs(Amat, &diag, 0);CHKERRQ(ierr);
+  ierr  = MatGetDiagonal(Amat, diag);CHKERRQ(ierr); /* effectively PCJACOBI */
+  ierr  = VecReciprocal(diag);CHKERRQ(ierr);
+  ierr  = MatDiagonalScale(*P, diag, 0);CHKERRQ(ierr);
+  ierr  = VecDestroy(&diag);CHKERRQ(ierr);
+  alpha = -1.4/emax;
+  ierr  = MatAYPX(*P, alpha, P0, SUBSET_NONZERO_PATTERN);CHKERRQ(ierr);
+#if defined PETSC_GAMG_USE_LOG
+  ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCGAMGOptProlongator_AGG
@@ -1100,84 +1178,65 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc,Mat Amat,Mat *a_P)
   PC_GAMG_AGG    *pc_gamg_agg = (PC_GAMG_AGG*)pc_gamg->subctx;
   PetscInt       jj;
   Mat            Prol  = *a_P;
-  MPI_Comm       comm;
-  KSP            eksp;
-  Vec            bb, xx;
-  PC             epc;
-  PetscReal      alpha, emax, emin;
-  PetscRandom    random;
+  PetscReal      emax = 0.0;
 
   PetscFunctionBegin;
-  ierr = PetscObjectGetComm((PetscObject)Amat,&comm);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(PC_GAMGOptProlongator_AGG,0,0,0,0);CHKERRQ(ierr);
 
   /* compute maximum value of operator to be used in smoother */
   if (0 < pc_gamg_agg->nsmooths) {
-    ierr = MatCreateVecs(Amat, &bb, 0);CHKERRQ(ierr);
-    ierr = MatCreateVecs(Amat, &xx, 0);CHKERRQ(ierr);
-    ierr = PetscRandomCreate(PETSC_COMM_SELF,&random);CHKERRQ(ierr);
-    ierr = VecSetRandom(bb,random);CHKERRQ(ierr);
-    ierr = PetscRandomDestroy(&random);CHKERRQ(ierr);
-
-    ierr = KSPCreate(comm,&eksp);CHKERRQ(ierr);
-    ierr = KSPSetTolerances(eksp,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT,10);CHKERRQ(ierr);
-    ierr = KSPSetNormType(eksp, KSP_NORM_NONE);CHKERRQ(ierr);
-    ierr = KSPSetErrorIfNotConverged(eksp,PETSC_FALSE);CHKERRQ(ierr);
-
-    ierr = KSPSetInitialGuessNonzero(eksp, PETSC_FALSE);CHKERRQ(ierr);
-    ierr = KSPSetOperators(eksp, Amat, Amat);CHKERRQ(ierr);
-    ierr = KSPSetComputeSingularValues(eksp,PETSC_TRUE);CHKERRQ(ierr);
-
-    ierr = KSPGetPC(eksp, &epc);CHKERRQ(ierr);
-    ierr = PCSetType(epc, PCJACOBI);CHKERRQ(ierr);  /* smoother in smoothed agg. */
-
-    ierr = KSPSetOptionsPrefix(eksp,((PetscObject)pc)->prefix);CHKERRQ(ierr);
-    ierr = KSPAppendOptionsPrefix(eksp, "gamg_est_");CHKERRQ(ierr);
-    ierr = KSPSetFromOptions(eksp);CHKERRQ(ierr);
-
-    /* solve - keep stuff out of logging */
-    ierr = PetscLogEventDeactivate(KSP_Solve);CHKERRQ(ierr);
-    ierr = PetscLogEventDeactivate(PC_Apply);CHKERRQ(ierr);
-    ierr = KSPSolve(eksp, bb, xx);CHKERRQ(ierr);
-    ierr = PetscLogEventActivate(KSP_Solve);CHKERRQ(ierr);
-    ierr = PetscLogEventActivate(PC_Apply);CHKERRQ(ierr);
-
-    ierr = KSPComputeExtremeSingularValues(eksp, &emax, &emin);CHKERRQ(ierr);
-    ierr = PetscInfo3(pc,"Smooth P0: max eigen=%e min=%e PC=%s\n",emax,emin,PCJACOBI);CHKERRQ(ierr);
-    ierr = VecDestroy(&xx);CHKERRQ(ierr);
-    ierr = VecDestroy(&bb);CHKERRQ(ierr);
-    ierr = KSPDestroy(&eksp);CHKERRQ(ierr);
+    ierr = PCGAMGEstimateEigen_AGG(pc,Amat,&emax);CHKERRQ(ierr);
   }
 
   /* smooth P0 */
   for (jj = 0; jj < pc_gamg_agg->nsmooths; jj++) {
-    Mat       tMat;
-    Vec       diag;
-
-#if defined PETSC_GAMG_USE_LOG
-    ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
-#endif
+    Mat tMat;
 
-    /* smooth P1 := (I - omega/lam D^{-1}A)P0 */
-    ierr  = MatMatMult(Amat, Prol, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &tMat);CHKERRQ(ierr);
-    ierr  = MatCreateVecs(Amat, &diag, 0);CHKERRQ(ierr);
-    ierr  = MatGetDiagonal(Amat, diag);CHKERRQ(ierr); /* effectively PCJACOBI */
-    ierr  = VecReciprocal(diag);CHKERRQ(ierr);
-    ierr  = MatDiagonalScale(tMat, diag, 0);CHKERRQ(ierr);
-    ierr  = VecDestroy(&diag);CHKERRQ(ierr);
-    alpha = -1.4/emax;
-    ierr  = MatAYPX(tMat, alpha, Prol, SUBSET_NONZERO_PATTERN);CHKERRQ(ierr);
-    ierr  = MatDestroy(&Prol);CHKERRQ(ierr);
-    Prol  = tMat;
-#if defined PETSC_GAMG_USE_LOG
-    ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
-#endif
+    ierr = PCGAMGSmoothProlongator_AGG(Amat,emax,Prol,MAT_INITIAL_MATRIX,&tMat);CHKERRQ(ierr);
+    ierr = MatDestroy(&Prol);CHKERRQ(ierr);
+    Prol = tMat;
   }
   ierr = PetscLogEventEnd(PC_GAMGOptProlongator_AGG,0,0,0,0);CHKERRQ(ierr);
   *a_P = Prol;
   PetscFunctionReturn(0);
 }
 
+/*
+   PCGAMGOptProlongatorNumeric_AGG - Recomputes the values of a prolongator P produced by PCGAMGOptProlongator_AGG()
+   from the tentative prolongator P0, for new values of Amat with the same nonzero structure
+*/
+static PetscErrorCode PCGAMGOptProlongatorNumeric_AGG(PC pc,Mat Amat,Mat P0,Mat P)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg          = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg     = (PC_GAMG*)mg->innerctx;
+  PC_GAMG_AGG    *pc_gamg_agg = (PC_GAMG_AGG*)pc_gamg->subctx;
+  PetscReal      emax;
+
+  PetscFunctionBegin;
+  if (!pc_gamg_agg->nsmooths) PetscFunctionReturn(0); /* P is P0 */
+  ierr = PetscLogEventBegin(PC_GAMGOptProlongator_AGG,0,0,0,0);CHKERRQ(ierr);
+  ierr = PCGAMGEstimateEigen_AGG(pc,Amat,&emax);CHKERRQ(ierr);
+  if (pc_gamg_agg->nsmooths == 1) {
+    ierr = PCGAMGSmoothProlongator_AGG(Amat,emax,P0,MAT_REUSE_MATRIX,&P);CHKERRQ(ierr);
+  } else {
+    /* the intermediate products are not kept, recompute them and copy the result */
+    Mat      Prol = P0,tMat;
+    PetscInt jj;
+
+    ierr = PetscObjectReference((PetscObject)P0);CHKERRQ(ierr);
+    for (jj = 0; jj < pc_gamg_agg->nsmooths; jj++) {
+      ierr = PCGAMGSmoothProlongator_AGG(Amat,emax,Prol,MAT_INITIAL_MATRIX,&tMat);CHKERRQ(ierr);
+      ierr = MatDestroy(&Prol);CHKERRQ(ierr);
+      Prol = tMat;
+    }
+    ierr = MatCopy(Prol,P,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatDestroy(&Prol);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(PC_GAMGOptProlongator_AGG,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCCreateGAMG_AGG
@@ -1206,6 +1265,7 @@ PetscErrorCode  PCCreateGAMG_AGG(PC pc)
   pc_gamg->ops->coarsen           = PCGAMGCoarsen_AGG;
   pc_gamg->ops->prolongator       = PCGAMGProlongator_AGG;
   pc_gamg->ops->optprolongator    = PCGAMGOptProlongator_AGG;
+  pc_gamg->ops->optprolongatornumeric = PCGAMGOptProlongatorNumeric_AGG;
   pc_gamg->ops->createdefaultdata = PCSetData_AGG;
   pc_gamg->ops->view              = PCView_GAMG_AGG;
 
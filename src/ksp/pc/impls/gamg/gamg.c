@@ -28,6 +28,24 @@ static PetscFunctionList GAMGList = 0;
 static PetscBool PCGAMGPackageInitialized;
 
 /* ----------------------------------------------------------------------------- */
+/* Frees the prolongators kept for -pc_gamg_reuse_aggregates */
+static PetscErrorCode PCGAMGResetAggregates_Private(PC pc)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  PetscInt       level;
+
+  PetscFunctionBegin;
+  for (level=0; level<PETSC_GAMG_MAXLEVELS; level++) {
+    ierr = MatDestroy(&pc_gamg->Ptent[level]);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->Psmooth[level]);CHKERRQ(ierr);
+    ierr = ISDestroy(&pc_gamg->Pcolperm[level]);CHKERRQ(ierr);
+  }
+  pc_gamg->nonzerostate = 0;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCReset_GAMG(PC pc)
 {
   PetscErrorCode ierr;
@@ -38,6 +56,34 @@ PetscErrorCode PCReset_GAMG(PC pc)
   if (pc_gamg->data) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_PLIB,"This should not happen, cleaned up in SetUp\n");
   pc_gamg->data_sz = 0;
   ierr = PetscFree(pc_gamg->orig_data);CHKERRQ(ierr);
+  ierr = PCGAMGResetAggregates_Private(pc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PCGAMGUpdateProlongator_Private - Recomputes the values of the interpolation P from level l to level l-1 (0 is the
+   finest level) for the new values of the matrix Amat of level l-1, keeping the aggregates and the nonzero structure
+   of the previous setup
+*/
+static PetscErrorCode PCGAMGUpdateProlongator_Private(PC pc,PetscInt l,Mat Amat,Mat P)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  ierr = pc_gamg->ops->optprolongatornumeric(pc,Amat,pc_gamg->Ptent[l],pc_gamg->Psmooth[l]);CHKERRQ(ierr);
+  if (pc_gamg->Pcolperm[l]) {
+    IS       findices;
+    PetscInt Istart,Iend,f_bs;
+
+    ierr = MatGetBlockSize(Amat,&f_bs);CHKERRQ(ierr);
+    ierr = MatGetOwnershipRange(P,&Istart,&Iend);CHKERRQ(ierr);
+    ierr = ISCreateStride(PetscObjectComm((PetscObject)P),Iend-Istart,Istart,1,&findices);CHKERRQ(ierr);
+    ierr = ISSetBlockSize(findices,f_bs);CHKERRQ(ierr);
+    ierr = MatCreateSubMatrix(pc_gamg->Psmooth[l],findices,pc_gamg->Pcolperm[l],MAT_REUSE_MATRIX,&P);CHKERRQ(ierr);
+    ierr = ISDestroy(&findices);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -420,7 +466,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   IS             *ASMLocalIDsArr[PETSC_GAMG_MAXLEVELS];
   PetscLogDouble nnz0=0.,nnztot=0.;
   MatInfo        info;
-  PetscBool      is_last = PETSC_FALSE;
+  PetscBool      is_last = PETSC_FALSE,keep_prol;
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
@@ -428,8 +474,15 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
 
   if (pc_gamg->setup_count++ > 0) {
-    if ((PetscBool)(!pc_gamg->reuse_prol)) {
+    PetscBool reuse = pc_gamg->reuse_prol;
+
+    if (!reuse && pc_gamg->reuse_aggs && pc_gamg->Nlevels > 1 && pc_gamg->Psmooth[1]) {
+      reuse = (PetscBool)(Pmat->nonzerostate == pc_gamg->nonzerostate);
+      if (!reuse) {ierr = PetscInfo(pc,"Nonzero structure of the matrix changed, recomputing the aggregates\n");CHKERRQ(ierr);}
+    }
+    if (!reuse) {
       /* reset everything */
+      ierr = PCGAMGResetAggregates_Private(pc);CHKERRQ(ierr);
       ierr = PCReset_MG(pc);CHKERRQ(ierr);
       pc->setupcalled = 0;
     } else {
@@ -445,8 +498,12 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         ierr = KSPSetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,dA,dB);CHKERRQ(ierr);
 
         for (level=pc_gamg->Nlevels-2; level>=0; level--) {
+          if (!pc_gamg->reuse_prol) {
+            /* new smoothed prolongator from the same aggregates, level here counts from the coarsest grid */
+            ierr = PCGAMGUpdateProlongator_Private(pc,pc_gamg->Nlevels-1-level,dB,mglevels[level+1]->interpolate);CHKERRQ(ierr);
+          }
           /* the first time through the matrix structure has changed from repartitioning */
-          if (pc_gamg->setup_count==2) {
+          if (!pc_gamg->coarse_ptap) {
             ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_INITIAL_MATRIX,1.0,&B);CHKERRQ(ierr);
             ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr);
 
@@ -458,6 +515,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
           ierr = KSPSetOperators(mglevels[level]->smoothd,B,B);CHKERRQ(ierr);
           dB   = B;
         }
+        pc_gamg->coarse_ptap = PETSC_TRUE;
       }
 
       ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
@@ -490,6 +548,14 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     pc_gamg->orig_data_cell_cols = pc_gamg->data_cell_cols;
   }
 
+  /* keep the prolongators to only recompute their values when the matrix changes, see PCGAMGSetReuseAggregates() */
+  keep_prol = (PetscBool)(pc_gamg->reuse_aggs && !pc_gamg->reuse_prol && pc_gamg->ops->optprolongatornumeric);
+  if (pc_gamg->reuse_aggs && !keep_prol && !pc_gamg->reuse_prol) {
+    ierr = PetscInfo1(pc,"GAMG type %s cannot recompute its prolongators, ignoring -pc_gamg_reuse_aggregates\n",pc_gamg->gamg_type_name);CHKERRQ(ierr);
+  }
+  pc_gamg->nonzerostate = Pmat->nonzerostate;
+  pc_gamg->coarse_ptap  = PETSC_FALSE;
+
   /* get basic dims */
   ierr = MatGetBlockSize(Pmat, &bs);CHKERRQ(ierr);
   ierr = MatGetSize(Pmat, &M, &N);CHKERRQ(ierr);
@@ -523,10 +589,18 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         /* get new block size of coarse matrices */
         ierr = MatGetBlockSizes(Prol11, NULL, &bs);CHKERRQ(ierr);
 
+        if (keep_prol) {
+          ierr = PetscObjectReference((PetscObject)Prol11);CHKERRQ(ierr);
+          pc_gamg->Ptent[level1] = Prol11;
+        }
         if (pc_gamg->ops->optprolongator) {
           /* smooth */
           ierr = pc_gamg->ops->optprolongator(pc, Aarr[level], &Prol11);CHKERRQ(ierr);
         }
+        if (keep_prol) {
+          ierr = PetscObjectReference((PetscObject)Prol11);CHKERRQ(ierr);
+          pc_gamg->Psmooth[level1] = Prol11;
+        }
 
         Parr[level1] = Prol11;
       } else Parr[level1] = NULL; /* failed to coarsen */
@@ -558,7 +632,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (is_last) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Is last ????????");
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels-1) is_last = PETSC_TRUE;
-    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last);CHKERRQ(ierr);
+    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, keep_prol ? &pc_gamg->Pcolperm[level1] : NULL, is_last);CHKERRQ(ierr);
 
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
@@ -871,6 +945,56 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetReuseAggregates - Keep the aggregates and the nonzero structure of the prolongators and coarse grid
+   operators when rebuilding the algebraic multigrid preconditioner for a matrix with the same nonzero structure
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE or PETSC_FALSE
+
+   Options Database Key:
+.  -pc_gamg_reuse_aggregates <true,false>
+
+   Level: intermediate
+
+   Notes:
+    When the preconditioner is set up again with new values of a matrix whose nonzero structure has not changed, the
+    graph, the coarsening and the tentative prolongators are not recomputed. Only the values of the smoothed
+    prolongators, with a new estimate of the largest eigenvalue of the matrix, and of the coarse grid operators, with
+    the numerical part of MatPtAP(), are recomputed. This is cheaper than a complete setup and, unlike
+    PCGAMGSetReuseInterpolation(), keeps the prolongators adapted to the new matrix.
+
+    If the nonzero structure of the matrix has changed a complete setup is done. Only PCGAMGAGG supports this,
+    the other types ignore it.
+
+   Concepts: Unstructured multigrid preconditioner
+
+.seealso: PCGAMGSetReuseInterpolation(), PCGAMGAGG
+@*/
+PetscErrorCode PCGAMGSetReuseAggregates(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,n,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetReuseAggregates_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetReuseAggregates_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->reuse_aggs = n;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGASMSetUseAggs - Have the PCGAMG smoother on each level use the aggregates defined by the coarsening process as the subdomains for the additive Schwarz preconditioner.
 
@@ -1178,6 +1302,9 @@ static PetscErrorCode PCView_GAMG(PC pc,PetscViewer viewer)
   if (pc_gamg->use_parallel_coarse_grid_solver) {
     ierr = PetscViewerASCIIPrintf(viewer,"      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n");CHKERRQ(ierr);
   }
+  if (pc_gamg->reuse_aggs && !pc_gamg->reuse_prol) {
+    ierr = PetscViewerASCIIPrintf(viewer,"      Reusing the aggregates while the nonzero structure of the matrix does not change\n");CHKERRQ(ierr);
+  }
   if (pc_gamg->ops->view) {
     ierr = (*pc_gamg->ops->view)(pc,viewer);CHKERRQ(ierr);
   }
@@ -1206,6 +1333,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
     }
     ierr = PetscOptionsBool("-pc_gamg_repartition","Repartion coarse grids","PCGAMGSetRepartition",pc_gamg->repart,&pc_gamg->repart,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_reuse_interpolation","Reuse prolongation operator","PCGAMGReuseInterpolation",pc_gamg->reuse_prol,&pc_gamg->reuse_prol,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-pc_gamg_reuse_aggregates","Reuse the aggregates and only recompute the values of the prolongation and coarse operators","PCGAMGSetReuseAggregates",pc_gamg->reuse_aggs,&pc_gamg->reuse_aggs,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_asm_use_agg","Use aggregation aggregates for ASM smoother","PCGAMGASMSetUseAggs",pc_gamg->use_aggs_in_asm,&pc_gamg->use_aggs_in_asm,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver","Use parallel coarse grid solver (otherwise put last grid on one process)","PCGAMGSetUseParallelCoarseGridSolve",pc_gamg->use_parallel_coarse_grid_solver,&pc_gamg->use_parallel_coarse_grid_solver,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsInt("-pc_gamg_process_eq_limit","Limit (goal) on number of equations per process on coarse grids","PCGAMGSetProcEqLim",pc_gamg->min_eq_proc,&pc_gamg->min_eq_proc,NULL);CHKERRQ(ierr);
@@ -1237,6 +1365,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 +   -pc_gamg_type <type> - one of agg, geo, or classical
 .   -pc_gamg_repartition  <true,default=false> - repartition the degrees of freedom accross the coarse grids as they are determined
 .   -pc_gamg_reuse_interpolation <true,default=false> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations
+.   -pc_gamg_reuse_aggregates <true,default=false> - when rebuilding the algebraic multigrid preconditioner for a matrix with the same nonzero structure reuse the aggregates and only recompute the values of the interpolations and coarse grid operators
 .   -pc_gamg_asm_use_agg <true,default=false> - use the aggregates from the coasening process to defined the subdomains on each level for the PCASM smoother
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
@@ -1267,7 +1396,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   Concepts: algebraic multigrid
 
 .seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
-           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation()
+           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetReuseAggregates()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
@@ -1308,6 +1437,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseEqLim_C",PCGAMGSetCoarseEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRepartition_C",PCGAMGSetRepartition_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseInterpolation_C",PCGAMGSetReuseInterpolation_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseAggregates_C",PCGAMGSetReuseAggregates_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGASMSetUseAggs_C",PCGAMGASMSetUseAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseParallelCoarseGridSolve_C",PCGAMGSetUseParallelCoarseGridSolve_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThreshold_C",PCGAMGSetThreshold_GAMG);CHKERRQ(ierr);
@@ -1317,6 +1447,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNlevels_C",PCGAMGSetNlevels_GAMG);CHKERRQ(ierr);
   pc_gamg->repart           = PETSC_FALSE;
   pc_gamg->reuse_prol       = PETSC_FALSE;
+  pc_gamg->reuse_aggs       = PETSC_FALSE;
   pc_gamg->use_aggs_in_asm  = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->min_eq_proc      = 50;
@@ -49,9 +49,18 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
     ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->b);CHKERRQ(ierr);
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = VecSet(mgc->x,0.0);CHKERRQ(ierr);
-    while (cycles--) {
-      ierr = PCMGMCycle_Private(pc,mglevelsin-1,reason);CHKERRQ(ierr);
+    if (mgc->agglomerate) { /* the coarser levels live on fewer processes, see PCMGSetAgglomerateEqLimit() */
+      ierr = PCApply(mgc->agglomerate,mgc->b,mgc->x);CHKERRQ(ierr);
+      while (--cycles > 0) {
+        ierr = (*mgc->residual)(mgc->A,mgc->b,mgc->x,mgc->r);CHKERRQ(ierr);
+        ierr = PCApply(mgc->agglomerate,mgc->r,mgc->aggwork);CHKERRQ(ierr);
+        ierr = VecAXPY(mgc->x,1.0,mgc->aggwork);CHKERRQ(ierr);
+      }
+    } else {
+      ierr = VecSet(mgc->x,0.0);CHKERRQ(ierr);
+      while (cycles--) {
+        ierr = PCMGMCycle_Private(pc,mglevelsin-1,reason);CHKERRQ(ierr);
+      }
     }
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
     ierr = MatInterpolateAdd(mglevels->interpolate,mgc->x,mglevels->x,mglevels->x);CHKERRQ(ierr);
@@ -162,6 +171,8 @@ PetscErrorCode PCReset_MG(PC pc)
 
     for (i=0; i<n; i++) {
       ierr = MatDestroy(&mglevels[i]->A);CHKERRQ(ierr);
+      ierr = PCDestroy(&mglevels[i]->agglomerate);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->aggwork);CHKERRQ(ierr);
       if (mglevels[i]->smoothd != mglevels[i]->smoothu) {
         ierr = KSPReset(mglevels[i]->smoothd);CHKERRQ(ierr);
       }
@@ -425,6 +436,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
   if (flg) {
     ierr = PCMGSetDistinctSmoothUp(pc);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsBool("-pc_mg_esteig_batched","Estimate the eigenvalues of the Chebyshev smoothers of all levels together","PCMGSetEstEigBatched",mg->esteigbatched,&mg->esteigbatched,NULL);CHKERRQ(ierr);
   mgtype = mg->am;
   ierr   = PetscOptionsEnum("-pc_mg_type","Multigrid type","PCMGSetType",PCMGTypes,(PetscEnum)mgtype,(PetscEnum*)&mgtype,&flg);CHKERRQ(ierr);
   if (flg) {
@@ -436,6 +448,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
       ierr = PCMGMultiplicativeSetCycles(pc,cycles);CHKERRQ(ierr);
     }
   }
+  ierr = PetscOptionsInt("-pc_mg_agglomerate_eq_limit","Agglomerate the coarse levels with fewer equations per process than this onto fewer processes","PCMGSetAgglomerateEqLimit",mg->agglomerate_eq_limit,&mg->agglomerate_eq_limit,NULL);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_log","Log times for each multigrid level","None",flg,&flg,NULL);CHKERRQ(ierr);
   if (flg) {
@@ -489,7 +502,7 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
   PC_MG          *mg        = (PC_MG*)pc->data;
   PC_MG_Levels   **mglevels = mg->levels;
   PetscErrorCode ierr;
-  PetscInt       levels = mglevels ? mglevels[0]->levels : 0,i;
+  PetscInt       levels = mglevels ? mglevels[0]->levels : 0,i,agglevel = -1;
   PetscBool      iascii,isbinary,isdraw;
 
   PetscFunctionBegin;
@@ -513,10 +526,25 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
     } else {
       ierr = PetscViewerASCIIPrintf(viewer,"    Not using Galerkin computed coarse grid matrices\n");CHKERRQ(ierr);
     }
+    if (mg->esteigbatched) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Estimating the Chebyshev smoother eigenvalues of all levels together\n");CHKERRQ(ierr);
+    }
+    if (mg->agglomerate_eq_limit) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Agglomerating the levels with fewer than %D equations per process\n",mg->agglomerate_eq_limit);CHKERRQ(ierr);
+    }
     if (mg->view){
       ierr = (*mg->view)(pc,viewer);CHKERRQ(ierr);
     }
+    for (i=0; i<levels; i++) if (mglevels[i]->agglomerate) agglevel = i;
     for (i=0; i<levels; i++) {
+      if (i < agglevel) continue;
+      if (i == agglevel) {
+        ierr = PetscViewerASCIIPrintf(viewer,"Levels 0 to %D agglomerated onto fewer processes -------------------------------\n",i);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+        ierr = PCView(mglevels[i]->agglomerate,viewer);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+        continue;
+      }
       if (!i) {
         ierr = PetscViewerASCIIPrintf(viewer,"Coarse grid solver -- level -------------------------------\n",i);CHKERRQ(ierr);
       } else {
@@ -572,6 +600,190 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
 #include <petsc/private/dmimpl.h>
 #include <petsc/private/kspimpl.h>
 
+/*
+   Determines the local size and the first index on subcomm of a vector of global size N split with PETSC_DECIDE in blocks of bs,
+   the layout PCTELESCOPE gives to its redistributed vectors; nothing is owned outside of subcomm
+*/
+static PetscErrorCode PCMGAgglomerateSplitOwnership_Private(MPI_Comm subcomm,PetscInt N,PetscInt bs,PetscInt *n,PetscInt *start)
+{
+  PetscErrorCode ierr;
+  PetscInt       nb = PETSC_DECIDE,Nb;
+
+  PetscFunctionBegin;
+  *n     = 0;
+  *start = 0;
+  if (subcomm == MPI_COMM_NULL) PetscFunctionReturn(0);
+  if (N % bs) bs = 1;
+  Nb   = N/bs;
+  ierr = PetscSplitOwnership(subcomm,&nb,&Nb);CHKERRQ(ierr);
+  *n   = nb*bs;
+  ierr = MPI_Scan(n,start,1,MPIU_INT,MPI_SUM,subcomm);CHKERRQ(ierr);
+  *start -= *n;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Gathers the matrix A onto the processes of subcomm (MPI_COMM_NULL on the other processes) with the layout of PCTELESCOPE;
+   collective on the communicator of A
+*/
+static PetscErrorCode PCMGAgglomerateMat_Private(Mat A,MPI_Comm subcomm,MatReuse reuse,Mat *Ared)
+{
+  PetscErrorCode ierr;
+  PetscInt       M,N,rbs,cbs,m,n,rstart,cstart;
+  IS             isrow,iscol;
+  Mat            B = A,*Blocal;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  ierr = MatHasOperation(A,MATOP_CREATE_SUBMATRICES,&flg);CHKERRQ(ierr);
+  if (!flg) { /* for example the MAIJ interpolations of DMDA */
+    ierr = MatConvert(A,MATAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  }
+  ierr = MatGetSize(B,&M,&N);CHKERRQ(ierr);
+  ierr = MatGetBlockSizes(B,&rbs,&cbs);CHKERRQ(ierr);
+  ierr = PCMGAgglomerateSplitOwnership_Private(subcomm,M,rbs,&m,&rstart);CHKERRQ(ierr);
+  ierr = PCMGAgglomerateSplitOwnership_Private(subcomm,N,cbs,&n,&cstart);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF,m,rstart,1,&isrow);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF,N,0,1,&iscol);CHKERRQ(ierr);
+  ierr = MatCreateSubMatrices(B,1,&isrow,&iscol,MAT_INITIAL_MATRIX,&Blocal);CHKERRQ(ierr);
+  if (subcomm != MPI_COMM_NULL) {
+    ierr = MatCreateMPIMatConcatenateSeqMat(subcomm,Blocal[0],n,reuse,Ared);CHKERRQ(ierr);
+  }
+  ierr = MatDestroySubMatrices(1,&Blocal);CHKERRQ(ierr);
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  if (B != A) {ierr = MatDestroy(&B);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+   Finds the finest level, other than the finest grid, with fewer than agglomerate_eq_limit equations per process; -1 if there is none
+   or if agglomerating does not apply, see PCMGSetAgglomerateEqLimit()
+*/
+static PetscErrorCode PCMGAgglomerateGetLevel_Private(PC pc,PetscInt *level)
+{
+  PC_MG          *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels   **mglevels = mg->levels;
+  PetscErrorCode ierr;
+  PetscInt       i,n = mglevels[0]->levels,M,N;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  *level = -1;
+  if (mg->agglomerate_eq_limit <= 0 || mg->am != PC_MG_MULTIPLICATIVE || n < 3) PetscFunctionReturn(0);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)pc),&size);CHKERRQ(ierr);
+  if (size == 1) PetscFunctionReturn(0);
+  for (i=n-2; i>0; i--) {
+    /* the interpolation may be given as the transpose of the restriction */
+    ierr = MatGetSize(mglevels[i+1]->interpolate,&M,&N);CHKERRQ(ierr);
+    if (PetscMin(M,N) < mg->agglomerate_eq_limit*size) {
+      *level = i;
+      break;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Moves the levels 0 to L onto fewer processes: a PCTELESCOPE on level L gathers its operator onto a subcommunicator and
+   solves with a PCMG built there from the gathered operators and interpolations of the levels below. PCMGMCycle_Private()
+   applies it in place of visiting these levels on all the processes.
+*/
+static PetscErrorCode PCMGAgglomerateSetUp_Private(PC pc,PetscInt L)
+{
+  PC_MG          *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels   **mglevels = mg->levels,*mgl = mglevels[L];
+  PetscErrorCode ierr;
+  MPI_Comm       comm,subcomm = MPI_COMM_NULL;
+  PetscMPIInt    size;
+  PetscInt       M,nactive,i;
+  Mat            A,B,Ared,Bred;
+  KSP            subksp,ksp;
+  PC             subpc = NULL;
+  MatReuse       reuse = MAT_REUSE_MATRIX;
+  const char     *prefix;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PCGetOptionsPrefix(pc,&prefix);CHKERRQ(ierr);
+  ierr = KSPGetOperators(mgl->smoothd,&A,&B);CHKERRQ(ierr);
+  if (!mgl->agglomerate) {
+    ierr    = MatGetSize(B,&M,NULL);CHKERRQ(ierr);
+    nactive = PetscMax(M/mg->agglomerate_eq_limit,1);
+    ierr    = PCCreate(comm,&mgl->agglomerate);CHKERRQ(ierr);
+    ierr    = PetscObjectIncrementTabLevel((PetscObject)mgl->agglomerate,(PetscObject)pc,1);CHKERRQ(ierr);
+    ierr    = PetscLogObjectParent((PetscObject)pc,(PetscObject)mgl->agglomerate);CHKERRQ(ierr);
+    ierr    = PCSetOptionsPrefix(mgl->agglomerate,prefix);CHKERRQ(ierr);
+    ierr    = PCAppendOptionsPrefix(mgl->agglomerate,"mg_agglomerate_");CHKERRQ(ierr);
+    ierr    = PCSetType(mgl->agglomerate,PCTELESCOPE);CHKERRQ(ierr);
+    ierr    = PCTelescopeSetReductionFactor(mgl->agglomerate,PetscMin(size,(size+nactive-1)/nactive));CHKERRQ(ierr);
+    ierr    = PCTelescopeSetIgnoreDM(mgl->agglomerate,PETSC_TRUE);CHKERRQ(ierr);
+    /* telescope only calls KSPSetFromOptions() on its sub-KSP if its own options were processed */
+    ierr    = PCSetFromOptions(mgl->agglomerate);CHKERRQ(ierr);
+    ierr    = VecDuplicate(mgl->b,&mgl->aggwork);CHKERRQ(ierr);
+    reuse   = MAT_INITIAL_MATRIX;
+  }
+  ierr = PCSetOperators(mgl->agglomerate,A,B);CHKERRQ(ierr);
+  ierr = PCSetUp(mgl->agglomerate);CHKERRQ(ierr);
+  ierr = PCTelescopeGetKSP(mgl->agglomerate,&subksp);CHKERRQ(ierr);
+  if (subksp) {
+    subcomm = PetscObjectComm((PetscObject)subksp);
+    ierr    = KSPGetPC(subksp,&subpc);CHKERRQ(ierr);
+    if (reuse == MAT_INITIAL_MATRIX) {
+      /* the gathered levels are configured apart from the levels they replace */
+      ierr = PCSetOptionsPrefix(subpc,prefix);CHKERRQ(ierr);
+      ierr = PCAppendOptionsPrefix(subpc,"mg_agglomerate_");CHKERRQ(ierr);
+      ierr = PCSetType(subpc,PCMG);CHKERRQ(ierr);
+      ierr = PCMGSetLevels(subpc,L+1,NULL);CHKERRQ(ierr);
+      ierr = PCMGSetType(subpc,PC_MG_MULTIPLICATIVE);CHKERRQ(ierr);
+      ierr = PCMGSetCycleType(subpc,(PCMGCycleType)mgl->cycles);CHKERRQ(ierr);
+      ierr = PCMGSetGalerkin(subpc,PC_MG_GALERKIN_EXTERNAL);CHKERRQ(ierr);
+      ierr = PCMGSetAgglomerateEqLimit(subpc,mg->agglomerate_eq_limit);CHKERRQ(ierr);
+      if (mgl->smoothu != mgl->smoothd) {ierr = PCMGSetDistinctSmoothUp(subpc);CHKERRQ(ierr);}
+    }
+  }
+  for (i=1; i<=L; i++) {
+    Mat P = NULL,R = NULL;
+
+    if (subpc && reuse == MAT_REUSE_MATRIX) {
+      ierr = PCMGGetInterpolation(subpc,i,&P);CHKERRQ(ierr);
+      ierr = PCMGGetRestriction(subpc,i,&R);CHKERRQ(ierr);
+    }
+    ierr = PCMGAgglomerateMat_Private(mglevels[i]->interpolate,subcomm,reuse,&P);CHKERRQ(ierr);
+    if (mglevels[i]->restrct != mglevels[i]->interpolate) {
+      ierr = PCMGAgglomerateMat_Private(mglevels[i]->restrct,subcomm,reuse,&R);CHKERRQ(ierr);
+    }
+    if (subpc && reuse == MAT_INITIAL_MATRIX) {
+      ierr = PCMGSetInterpolation(subpc,i,P);CHKERRQ(ierr);
+      ierr = MatDestroy(&P);CHKERRQ(ierr);
+      if (R) {
+        ierr = PCMGSetRestriction(subpc,i,R);CHKERRQ(ierr);
+        ierr = MatDestroy(&R);CHKERRQ(ierr);
+      }
+    }
+  }
+  for (i=0; i<L; i++) {
+    Ared = Bred = NULL;
+    if (subpc) {
+      ierr = PCMGGetSmoother(subpc,i,&ksp);CHKERRQ(ierr);
+      if (reuse == MAT_REUSE_MATRIX) {ierr = KSPGetOperators(ksp,&Ared,&Bred);CHKERRQ(ierr);}
+    }
+    ierr = KSPGetOperators(mglevels[i]->smoothd,&A,&B);CHKERRQ(ierr);
+    ierr = PCMGAgglomerateMat_Private(B,subcomm,reuse,&Bred);CHKERRQ(ierr);
+    if (A != B) {
+      ierr = PCMGAgglomerateMat_Private(A,subcomm,reuse,&Ared);CHKERRQ(ierr);
+    } else Ared = Bred;
+    if (subpc && reuse == MAT_INITIAL_MATRIX) {
+      ierr = KSPSetOperators(ksp,Ared,Bred);CHKERRQ(ierr);
+      if (Ared != Bred) {ierr = MatDestroy(&Ared);CHKERRQ(ierr);}
+      ierr = MatDestroy(&Bred);CHKERRQ(ierr);
+    }
+  }
+  if (subksp) {ierr = KSPSetUp(subksp);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*
     Calls setup for the KSP on each level
 */
@@ -580,7 +792,7 @@ PetscErrorCode PCSetUp_MG(PC pc)
   PC_MG          *mg        = (PC_MG*)pc->data;
   PC_MG_Levels   **mglevels = mg->levels;
   PetscErrorCode ierr;
-  PetscInt       i,n;
+  PetscInt       i,n,agglevel;
   PC             cpc;
   PetscBool      dump = PETSC_FALSE,opsset,use_amat,missinginterpolate = PETSC_FALSE;
   Mat            dA,dB;
@@ -827,6 +1039,15 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
+  /* the levels from agglevel down are solved on fewer processes; their smoothers are only set up here if the DM computes their operators */
+  ierr = PCMGAgglomerateGetLevel_Private(pc,&agglevel);CHKERRQ(ierr);
+  /* an agglomeration built by an earlier setup on another level is stale, PCMGAgglomerateSetUp_Private() rebuilds it on this one */
+  for (i=0; i<n; i++) {
+    if (i == agglevel || !mglevels[i]->agglomerate) continue;
+    ierr = PCDestroy(&mglevels[i]->agglomerate);CHKERRQ(ierr);
+    ierr = VecDestroy(&mglevels[i]->aggwork);CHKERRQ(ierr);
+  }
+
   if (pc->dm) {
     /* need to tell all the coarser levels to rebuild the matrix using the DM for that level */
     for (i=0; i<n-1; i++) {
@@ -839,12 +1060,14 @@ PetscErrorCode PCSetUp_MG(PC pc)
       /* if doing only down then initial guess is zero */
       ierr = KSPSetInitialGuessNonzero(mglevels[i]->smoothd,PETSC_TRUE);CHKERRQ(ierr);
     }
-    if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-    ierr = KSPSetUp(mglevels[i]->smoothd);CHKERRQ(ierr);
-    if (mglevels[i]->smoothd->reason == KSP_DIVERGED_PCSETUP_FAILED) {
-      pc->failedreason = PC_SUBPC_ERROR;
+    if (i > agglevel || mglevels[i]->smoothd->dmActive) {
+      if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
+      ierr = KSPSetUp(mglevels[i]->smoothd);CHKERRQ(ierr);
+      if (mglevels[i]->smoothd->reason == KSP_DIVERGED_PCSETUP_FAILED) {
+        pc->failedreason = PC_SUBPC_ERROR;
+      }
+      if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
     }
-    if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
     if (!mglevels[i]->residual) {
       Mat mat;
       ierr = KSPGetOperators(mglevels[i]->smoothd,&mat,NULL);CHKERRQ(ierr);
@@ -863,6 +1086,7 @@ PetscErrorCode PCSetUp_MG(PC pc)
       }
 
       ierr = KSPSetInitialGuessNonzero(mglevels[i]->smoothu,PETSC_TRUE);CHKERRQ(ierr);
+      if (i <= agglevel) continue;
       if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
       ierr = KSPSetUp(mglevels[i]->smoothu);CHKERRQ(ierr);
       if (mglevels[i]->smoothu->reason == KSP_DIVERGED_PCSETUP_FAILED) {
@@ -872,12 +1096,29 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
-  if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-  ierr = KSPSetUp(mglevels[0]->smoothd);CHKERRQ(ierr);
-  if (mglevels[0]->smoothd->reason == KSP_DIVERGED_PCSETUP_FAILED) {
-    pc->failedreason = PC_SUBPC_ERROR;
+  if (agglevel < 0 || mglevels[0]->smoothd->dmActive) {
+    if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
+    ierr = KSPSetUp(mglevels[0]->smoothd);CHKERRQ(ierr);
+    if (mglevels[0]->smoothd->reason == KSP_DIVERGED_PCSETUP_FAILED) {
+      pc->failedreason = PC_SUBPC_ERROR;
+    }
+    if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
+  }
+  if (agglevel > 0) {
+    ierr = PCMGAgglomerateSetUp_Private(pc,agglevel);CHKERRQ(ierr);
+  }
+
+  if (mg->esteigbatched && n > 1) {
+    KSP *ksps;
+
+    ierr = PetscMalloc1(2*(n-1),&ksps);CHKERRQ(ierr);
+    for (i=1; i<n; i++) {
+      ksps[2*(i-1)]   = i > agglevel ? mglevels[i]->smoothd : NULL;
+      ksps[2*(i-1)+1] = i > agglevel && mglevels[i]->smoothu != mglevels[i]->smoothd ? mglevels[i]->smoothu : NULL;
+    }
+    ierr = KSPChebyshevEstEigBatched_Private(2*(n-1),ksps);CHKERRQ(ierr);
+    ierr = PetscFree(ksps);CHKERRQ(ierr);
   }
-  if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
 
   /*
      Dump the interpolation/restriction matrices plus the
@@ -1230,6 +1471,86 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCMGSetEstEigBatched - Estimates the eigenvalues of the Chebyshev smoothers of all the levels together when the
+       multigrid preconditioner is set up, instead of one level at a time during the first application
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to estimate the eigenvalues of all the levels together
+
+   Options Database Key:
+.  -pc_mg_esteig_batched <true,false>
+
+   Level: advanced
+
+   Notes:
+    The estimates are computed with power iterations run on all the levels in lockstep, so each iteration needs a single
+    global reduction for the whole hierarchy instead of several reductions per level and per Krylov iteration. This lowers
+    the setup latency of deep hierarchies on many processes. Power iterations converge more slowly than the Krylov
+    estimate, so more steps (-mg_levels_ksp_chebyshev_esteig_steps) may be needed. Only smoothers whose bounds depend
+    on the maximum eigenvalue alone (the default for KSPCHEBYSHEV) are handled, the others estimate their eigenvalues as usual.
+
+.keywords: MG, smooth, Chebyshev, eigenvalues, multigrid
+
+.seealso: KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetReuse()
+@*/
+PetscErrorCode PCMGSetEstEigBatched(PC pc,PetscBool flg)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  mg->esteigbatched = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCMGSetAgglomerateEqLimit - Solves the coarse levels with fewer than a given number of equations per process on fewer
+       processes, gathering them with PCTELESCOPE
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - the number of equations per process below which the levels are agglomerated, 0 (the default) to never agglomerate
+
+   Options Database Key:
+.  -pc_mg_agglomerate_eq_limit <n>
+
+   Level: advanced
+
+   Notes:
+    The finest level other than the finest grid with fewer than n equations per process, and all the coarser levels, are
+    moved onto a subcommunicator holding about n equations per process. The operators and the interpolations of these
+    levels are gathered there and solved by a PCMG with the same cycle type, which applies the same policy again on its
+    own processes. The options of its levels use the prefix -mg_agglomerate_, for example -mg_agglomerate_mg_levels_ksp_type
+    and -mg_agglomerate_mg_coarse_pc_type. The processes left out wait for the coarse correction, so the coarse levels no
+    longer pay for global reductions and ghost exchanges among processes owning a handful of rows each.
+
+    Only the multiplicative cycle is agglomerated. The operators of the agglomerated levels are still computed (by the
+    Galerkin product or the DM) on all processes before being gathered, but their smoothers are not set up there. The
+    options of the telescoping preconditioner use the prefix -mg_agglomerate_.
+
+.keywords: MG, agglomerate, telescope, coarse, multigrid
+
+.seealso: PCTELESCOPE, PCTelescopeSetReductionFactor(), PCGAMGSetProcEqLim()
+@*/
+PetscErrorCode PCMGSetAgglomerateEqLimit(PC pc,PetscInt n)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,n,2);
+  if (n < 0) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of equations per process %D cannot be negative",n);
+  mg->agglomerate_eq_limit = n;
+  PetscFunctionReturn(0);
+}
+
 /* ----------------------------------------------------------------------------------------*/
 
 /*MC
@@ -1242,8 +1563,10 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
 .  -pc_mg_type <additive,multiplicative,full,kaskade> - multiplicative is the default
 .  -pc_mg_log - log information about time spent on each level of the solver
 .  -pc_mg_distinct_smoothup - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
+.  -pc_mg_esteig_batched - estimate the eigenvalues of the Chebyshev smoothers of all levels together (PCMGSetEstEigBatched())
 .  -pc_mg_galerkin <both,pmat,mat,none> - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
 .  -pc_mg_multiplicative_cycles - number of cycles to use as the preconditioner (defaults to 1)
+.  -pc_mg_agglomerate_eq_limit <n> - solve the coarse levels with fewer than n equations per process on fewer processes (PCMGSetAgglomerateEqLimit())
 .  -pc_mg_dump_matlab - dumps the matrices for each level and the restriction/interpolation matrices
                         to the Socket viewer for reading from MATLAB.
 -  -pc_mg_dump_binary - dumps the matrices for each level and the restriction/interpolation matrices
@@ -1259,6 +1582,10 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
        (because the residual has just been computed for the multigrid algorithm and is hence available for free) while with monitoring the
        residual is computed at the end of each cycle.
 
+       On coarse levels with little local work the ghost value exchanges of the smoother dominate; with Chebyshev/Jacobi smoothing
+       KSPChebyshevSetDeepHalo(), for example -mg_levels_1_ksp_chebyshev_deep_halo 2, does all the smoothing steps of a level with
+       one exchange at the price of some redundant computation.
+
    Level: intermediate
 
    Concepts: multigrid/multilevel
@@ -1267,7 +1594,7 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
            PCMGSetLevels(), PCMGGetLevels(), PCMGSetType(), PCMGSetCycleType(),
            PCMGSetDistinctSmoothUp(), PCMGGetCoarseSolve(), PCMGSetResidual(), PCMGSetInterpolation(),
            PCMGSetRestriction(), PCMGGetSmoother(), PCMGGetSmootherUp(), PCMGGetSmootherDown(),
-           PCMGSetCycleTypeOnLevel(), PCMGSetRhs(), PCMGSetX(), PCMGSetR()
+           PCMGSetCycleTypeOnLevel(), PCMGSetRhs(), PCMGSetX(), PCMGSetR(), PCMGSetAgglomerateEqLimit()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_MG(PC pc)
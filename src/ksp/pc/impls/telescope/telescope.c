@@ -414,8 +414,8 @@ static PetscErrorCode PCSetUp_Telescope(PC pc)
     break;
   }
 
-  /* setup */
-  if (sred->pctelescope_setup_type) {
+  /* setup, the repartitioning does not change when only the values of the operator do */
+  if (!pc->setupcalled && sred->pctelescope_setup_type) {
     ierr = sred->pctelescope_setup_type(pc,sred);CHKERRQ(ierr);
   }
   /* update */
@@ -0,0 +1,105 @@
+
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO() against MatSetValues().\n\n";
+
+#include <petscmat.h>
+
+/* Prints whether B equals alpha A */
+static PetscErrorCode CheckEqual(const char *name,Mat B,PetscScalar alpha,Mat A)
+{
+  Mat            C;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = MatAXPY(C,-alpha,A,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(C,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: %s\n",name,norm < PETSC_SMALL ? "matches MatSetValues()" : "differs from MatSetValues()");CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Each process assembles -nel elements of a periodic 1D mesh of -nel*size nodes, taking every size-th element so that
+   most entries belong to rows of other processes. Each element contributes a 2x2 block, so interior entries are listed
+   twice, and a few entries with negative indices are added that must be ignored.
+*/
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       nel = 5,M,e,k,l,n,ncoo,*coo_i,*coo_j;
+  PetscScalar    *coo_v;
+  PetscMPIInt    rank,size;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nel",&nel,NULL);CHKERRQ(ierr);
+  M    = nel*size;
+  ncoo = 4*nel + 2;
+  ierr = PetscMalloc3(ncoo,&coo_i,ncoo,&coo_j,ncoo,&coo_v);CHKERRQ(ierr);
+  for (e=0,n=0; e<nel; e++) {
+    PetscInt nodes[2];
+    nodes[0] = (e*size + rank) % M;
+    nodes[1] = (nodes[0] + 1) % M;
+    for (k=0; k<2; k++) {
+      for (l=0; l<2; l++,n++) {
+        coo_i[n] = nodes[k];
+        coo_j[n] = nodes[l];
+        coo_v[n] = (k == l ? 2.0 : -1.0) + 0.1*(PetscReal)(nodes[0]+1);
+      }
+    }
+  }
+  coo_i[n] = -1; coo_j[n] = 0; coo_v[n++] = 100.0;
+  coo_i[n] = 0; coo_j[n] = -1; coo_v[n++] = 100.0;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,M,M);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (n=0; n<ncoo; n++) {
+    ierr = MatSetValues(A,1,&coo_i[n],1,&coo_j[n],&coo_v[n],ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,M,M);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSetPreallocationCOO(B,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(B,coo_v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual("ADD_VALUES",B,1.0,A);CHKERRQ(ierr);
+
+  /* Reuse the structure with new values */
+  for (n=0; n<ncoo; n++) coo_v[n] *= 2.0;
+  ierr = MatSetValuesCOO(B,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual("INSERT_VALUES",B,2.0,A);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(B,coo_v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual("INSERT_VALUES then ADD_VALUES",B,4.0,A);CHKERRQ(ierr);
+
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      output_file: output/ex220_1.out
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex220_1.out
+
+   test:
+      suffix: basic
+      nsize: 2
+      args: -mat_type baij
+      output_file: output/ex220_1.out
+
+TEST*/
@@ -11,7 +11,7 @@ int main(int argc,char **argv)
   IS             irow,icol;
   PetscScalar    value = 1.0;
   PetscViewer    sviewer;
-  PetscBool      allA = PETSC_FALSE;
+  PetscBool      allA = PETSC_FALSE,newnz = PETSC_FALSE;
 
   ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
   ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_WORLD,PETSC_VIEWER_ASCII_COMMON);CHKERRQ(ierr);
@@ -31,6 +31,18 @@ int main(int argc,char **argv)
   ierr = PetscViewerASCIIPrintf(PETSC_VIEWER_STDOUT_WORLD,"Original matrix\n");CHKERRQ(ierr);
   ierr = MatView(mat,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
 
+  /* Test adding a new nonzero, in a row owned by the next process, after the first assembly */
+  ierr = PetscOptionsGetBool(NULL,NULL,"-test_new_nonzero",&newnz,NULL);CHKERRQ(ierr);
+  if (newnz) {
+    i     = rend % m;
+    value = 100.0 + (PetscReal)rstart;
+    ierr  = MatSetValues(mat,1,&i,1,&rstart,&value,INSERT_VALUES);CHKERRQ(ierr);
+    ierr  = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr  = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr  = PetscViewerASCIIPrintf(PETSC_VIEWER_STDOUT_WORLD,"Matrix with new nonzeros\n");CHKERRQ(ierr);
+    ierr  = MatView(mat,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  }
+
   /* Test MatCreateSubMatrix_XXX_All(), i.e., submatrix = A */
   ierr = PetscOptionsGetBool(NULL,NULL,"-test_all",&allA,NULL);CHKERRQ(ierr);
   if (allA) {
@@ -120,6 +132,23 @@ int main(int argc,char **argv)
       nsize: 3
       args: -mat_type aij
 
+   test:
+      suffix: 3_hash
+      nsize: 3
+      args: -mat_type aij -mat_mpiaij_hash_assembly
+      output_file: output/ex4_3.out
+
+   test:
+      suffix: 3_new_nonzero
+      nsize: 3
+      args: -mat_type aij -test_new_nonzero
+
+   test:
+      suffix: 3_hash_new_nonzero
+      nsize: 3
+      args: -mat_type aij -mat_mpiaij_hash_assembly -test_new_nonzero
+      output_file: output/ex4_3_new_nonzero.out
+
    test:
       suffix: 4
       nsize: 3
@@ -9,12 +9,15 @@ int main(int argc,char **args)
   Mat            C;
   Vec            s,u,w,x,y,z;
   PetscErrorCode ierr;
-  PetscInt       i,j,m = 8,n,rstart,rend,vstart,vend;
+  PetscInt       i,j,m = 8,n,nrow,rstart,rend,vstart,vend;
   PetscScalar    one = 1.0,negone = -1.0,v,alpha=0.1;
   PetscReal      norm, tol = PETSC_SQRT_MACHINE_EPSILON;
-  PetscBool      flg;
+  PetscBool      flg,ragged,testcache;
+  PetscMPIInt    rank;
+  char           dir[PETSC_MAX_PATH_LEN],cache[PETSC_MAX_PATH_LEN];
 
   ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
   ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_WORLD,PETSC_VIEWER_ASCII_COMMON);CHKERRQ(ierr);
   ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
   n    = m;
@@ -22,6 +25,18 @@ int main(int argc,char **args)
   if (flg) n += 2;
   ierr = PetscOptionsHasName(NULL,NULL,"-rectB",&flg);CHKERRQ(ierr);
   if (flg) n -= 2;
+  /* rows of different lengths, with -m 20 -rectA they run the SIMD kernels with every remainder from 2 to 6 */
+  ierr = PetscOptionsHasName(NULL,NULL,"-ragged",&ragged);CHKERRQ(ierr);
+
+  /* Record the autotuned format in a new cache, the second matrix assembled below must find it there */
+  ierr = PetscOptionsHasName(NULL,NULL,"-test_autotune_cache",&testcache);CHKERRQ(ierr);
+  if (testcache) {
+    ierr = PetscStrcpy(dir,"ex5_autotune_XXXXXX");CHKERRQ(ierr);
+    if (!rank) {ierr = PetscMkdtemp(dir);CHKERRQ(ierr);}
+    ierr = MPI_Bcast(dir,sizeof(dir),MPI_CHAR,0,PETSC_COMM_WORLD);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(cache,sizeof(cache),"%s/autotune.cache",dir);CHKERRQ(ierr);
+    ierr = PetscOptionsSetValue(NULL,"-mat_autotune_cache",cache);CHKERRQ(ierr);
+  }
 
   /* ---------- Assemble matrix and vectors ----------- */
 
@@ -46,7 +61,8 @@ int main(int argc,char **args)
   for (i=rstart; i<rend; i++) {
     v    = 100*(i+1);
     ierr = VecSetValues(z,1,&i,&v,INSERT_VALUES);CHKERRQ(ierr);
-    for (j=0; j<n; j++) {
+    nrow = ragged ? n - i%5 : n;
+    for (j=0; j<nrow; j++) {
       v    = 10*(i+1)+j+1;
       ierr = MatSetValues(C,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
     }
@@ -64,7 +80,8 @@ int main(int argc,char **args)
   /* Flush off proc Mat values and do more assembly */
   ierr = MatAssemblyBegin(C,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
   for (i=rstart; i<rend; i++) {
-    for (j=0; j<n; j++) {
+    nrow = ragged ? n - i%5 : n;
+    for (j=0; j<nrow; j++) {
       v    = 10*(i+1)+j+1;
       ierr = MatSetValues(C,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
     }
@@ -137,6 +154,32 @@ int main(int argc,char **args)
     ierr = MatDiagonalScale(C,x,y);CHKERRQ(ierr);
     ierr = MatView(C,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
   }
+  /* -------------------- Test the autotuning cache ------------------ */
+  if (testcache) {
+    Mat     D;
+    MatType ctype,dtype;
+
+    ierr = MatCreate(PETSC_COMM_WORLD,&D);CHKERRQ(ierr);
+    ierr = MatSetSizes(D,PETSC_DECIDE,PETSC_DECIDE,m,n);CHKERRQ(ierr);
+    ierr = MatSetFromOptions(D);CHKERRQ(ierr);
+    ierr = MatSetUp(D);CHKERRQ(ierr);
+    for (i=rstart; i<rend; i++) {
+      for (j=0; j<n; j++) {
+        v    = 10*(i+1)+j+1;
+        ierr = MatSetValues(D,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+    ierr = MatAssemblyBegin(D,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(D,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatGetType(C,&ctype);CHKERRQ(ierr);
+    ierr = MatGetType(D,&dtype);CHKERRQ(ierr);
+    ierr = PetscStrcmp(ctype,dtype,&flg);CHKERRQ(ierr);
+    if (!flg) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Format %s read from the autotuning cache differs from the selected format %s",dtype,ctype);
+    ierr = MatDestroy(&D);CHKERRQ(ierr);
+    ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+    if (!rank) {ierr = PetscRMTree(dir);CHKERRQ(ierr);}
+  }
+
   /* Free data structures */
   ierr = VecDestroy(&u);CHKERRQ(ierr); ierr = VecDestroy(&s);CHKERRQ(ierr);
   ierr = VecDestroy(&w);CHKERRQ(ierr); ierr = VecDestroy(&x);CHKERRQ(ierr);
@@ -255,6 +298,89 @@ int main(int argc,char **args)
       output_file: output/ex5_11_B.out
       requires: veccuda
 
+   test:
+      suffix: threads_1
+      args: -mat_type seqaij -rectA -mat_seqaij_threads 3
+      filter: grep -v type
+      output_file: output/ex5_11_A.out
+
+   test:
+      suffix: threads_2
+      nsize: 3
+      args: -mat_type mpiaij -mat_seqaij_threads 2
+      filter: grep -v type
+      output_file: output/ex5_23.out
+
+   test:
+      suffix: threads_3
+      args: -mat_type seqaijperm -rectA -mat_seqaij_threads 2
+      filter: grep -v type
+      output_file: output/ex5_11_A.out
+
+   test:
+      suffix: isa_1
+      args: -mat_type seqaijperm -rectA -mat_kernel_isa avx2
+      filter: grep -v type
+      output_file: output/ex5_11_A.out
+
+   test:
+      suffix: isa_2
+      args: -mat_type seqaij -rectA -mat_no_inode -mat_kernel_isa avx512
+      filter: grep -v type
+      output_file: output/ex5_11_A.out
+
+   test:
+      suffix: isa_3
+      args: -mat_type sell -mat_kernel_isa scalar -mat_view_kernel
+
+   testset:
+      args: -m 20 -rectA -ragged
+      filter: grep -v type
+      output_file: output/ex5_isa_ragged.out
+      test:
+        suffix: isa_ragged_scalar
+        args: -mat_type seqaij -mat_no_inode -mat_kernel_isa scalar
+      test:
+        suffix: isa_ragged_aij_avx2
+        args: -mat_type seqaij -mat_no_inode -mat_kernel_isa avx2
+      test:
+        suffix: isa_ragged_aij_avx512
+        args: -mat_type seqaij -mat_no_inode -mat_kernel_isa avx512
+      test:
+        suffix: isa_ragged_perm_avx2
+        args: -mat_type seqaijperm -mat_kernel_isa avx2
+      test:
+        suffix: isa_ragged_perm_avx512
+        args: -mat_type seqaijperm -mat_kernel_isa avx512
+      test:
+        suffix: isa_ragged_sell_avx
+        args: -mat_type seqsell -mat_kernel_isa avx
+      test:
+        suffix: isa_ragged_sell_avx2
+        args: -mat_type seqsell -mat_kernel_isa avx2
+      test:
+        suffix: isa_ragged_sell_avx512
+        args: -mat_type seqsell -mat_kernel_isa avx512
+
+   test:
+      suffix: auto_1
+      args: -mat_type auto -rectA -mat_autotune_its 2
+      filter: grep -v type
+      output_file: output/ex5_11_A.out
+
+   test:
+      suffix: auto_2
+      nsize: 3
+      args: -mat_type aij -mat_autotune -mat_autotune_types aij,sell -test_autotune_cache
+      filter: grep -v type
+      output_file: output/ex5_23.out
+
+   test:
+      suffix: auto_cache
+      nsize: 2
+      args: -mat_type aij -mat_autotune -mat_autotune_types aij,sell -test_autotune_cache -info
+      filter: grep MatAutotuneSelect_Private | sed -e "s,: [0-9.e-]* seconds for .*,: timed," -e "s,Selected format [a-z]*,Selected a format," -e "s,Using format [a-z]* recorded in .*,Using the recorded format,"
+
    test:
       suffix: sell_1
       args: -mat_type sell
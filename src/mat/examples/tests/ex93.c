@@ -237,6 +237,18 @@ PetscErrorCode testPTAPRectangular(void)
       args: -A_matptap_via scalable
       output_file: output/ex93_2.out
 
+   test:
+      suffix: allatonce
+      nsize: 2
+      args: -A_matptap_via allatonce
+      output_file: output/ex93_2.out
+
+   test:
+      suffix: allatonce_merged
+      nsize: 2
+      args: -A_matptap_via allatonce_merged
+      output_file: output/ex93_2.out
+
    test:
       suffix: btheap
       args: -B_matmatmult_via btheap
@@ -127,6 +127,7 @@ PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat mat)
     ierr = VecScatterSetType(aij->Mvctx_mpi1,VECSCATTERMPI1);CHKERRQ(ierr);
     ierr = PetscLogObjectParent((PetscObject)mat,(PetscObject)aij->Mvctx_mpi1);CHKERRQ(ierr);
   } else {
+    ierr = MatMultSplitReset_MPIAIJ(mat);CHKERRQ(ierr);
     ierr = VecScatterDestroy(&aij->Mvctx);CHKERRQ(ierr);
     ierr = VecScatterCreate(gvec,from,aij->lvec,to,&aij->Mvctx);CHKERRQ(ierr);
     ierr = PetscLogObjectParent((PetscObject)mat,(PetscObject)aij->Mvctx);CHKERRQ(ierr);
@@ -215,6 +216,149 @@ PetscErrorCode MatDisAssemble_MPIAIJ(Mat A)
 
   aij->B           = Bnew;
   A->was_assembled = PETSC_FALSE;
+  ierr = MatMultSplitReset_MPIAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultSplitReset_MPIAIJ(Mat A)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree4(aij->splitstart,aij->splitrow,aij->splitoff,aij->splitlen);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+     Cuts the rows of B into segments of consecutive entries whose ghost values are carried by the same message
+   of Mvctx, so that MatMultSplit_MPIAIJ() can apply each segment as soon as its message has arrived. Since the
+   columns of B are sorted and the ghost values are received in order of the owning process, each row with
+   entries in B has (mostly) one segment per neighbor it couples to.
+*/
+static PetscErrorCode MatMultSplitSetUp_MPIAIJ(Mat A,PetscBool *flg)
+{
+  Mat_MPIAIJ             *aij = (Mat_MPIAIJ*)A->data;
+  Mat_SeqAIJ             *b   = (Mat_SeqAIJ*)aij->B->data;
+  VecScatter_MPI_General *from;
+  PetscErrorCode         ierr;
+  PetscInt               i,j,k,nmesg,nseg,ec,*mesg,*cnt;
+
+  PetscFunctionBegin;
+  if (aij->splitstart && aij->splitstate == aij->B->nonzerostate) {
+    *flg = PETSC_TRUE;
+    PetscFunctionReturn(0);
+  }
+  ierr = MatMultSplitReset_MPIAIJ(A);CHKERRQ(ierr);
+  ierr = VecScatterEndByMessageSupported_Private(aij->Mvctx,flg);CHKERRQ(ierr);
+  if (!*flg) {
+    ierr = PetscInfo(A,"Scatter type does not allow applying the off-diagonal part a message at a time\n");CHKERRQ(ierr);
+    aij->multsplit = PETSC_FALSE;
+    PetscFunctionReturn(0);
+  }
+
+  /* message carrying each ghost value */
+  from  = (VecScatter_MPI_General*)aij->Mvctx->fromdata;
+  nmesg = from->n;
+  ierr  = VecGetSize(aij->lvec,&ec);CHKERRQ(ierr);
+  ierr  = PetscMalloc2(ec,&mesg,nmesg+1,&cnt);CHKERRQ(ierr);
+  for (j=0; j<ec; j++) mesg[j] = -1;
+  for (k=0; k<nmesg; k++) {
+    for (j=from->starts[k]; j<from->starts[k+1]; j++) mesg[from->indices[j]] = k;
+  }
+  for (j=0; j<ec; j++) {
+    if (mesg[j] < 0) {
+      ierr = PetscInfo(A,"Some ghost values are not received in a message\n");CHKERRQ(ierr);
+      ierr = PetscFree2(mesg,cnt);CHKERRQ(ierr);
+      aij->multsplit = PETSC_FALSE;
+      *flg           = PETSC_FALSE;
+      PetscFunctionReturn(0);
+    }
+  }
+
+  /* count, then fill the segments of each message */
+  ierr = PetscMemzero(cnt,(nmesg+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0,nseg=0; i<aij->B->rmap->n; i++) {
+    for (j=b->i[i]; j<b->i[i+1]; j++) {
+      if (j == b->i[i] || mesg[b->j[j]] != mesg[b->j[j-1]]) {cnt[mesg[b->j[j]]+1]++; nseg++;}
+    }
+  }
+  ierr = PetscMalloc4(nmesg+1,&aij->splitstart,nseg,&aij->splitrow,nseg,&aij->splitoff,nseg,&aij->splitlen);CHKERRQ(ierr);
+  for (k=0; k<nmesg; k++) cnt[k+1] += cnt[k];
+  ierr = PetscMemcpy(aij->splitstart,cnt,(nmesg+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<aij->B->rmap->n; i++) {
+    for (j=b->i[i]; j<b->i[i+1]; j++) {
+      k = mesg[b->j[j]];
+      if (j == b->i[i] || k != mesg[b->j[j-1]]) {
+        aij->splitrow[cnt[k]] = i;
+        aij->splitoff[cnt[k]] = j;
+        aij->splitlen[cnt[k]] = 0;
+        cnt[k]++;
+      }
+      aij->splitlen[cnt[k]-1]++;
+    }
+  }
+  ierr = PetscFree2(mesg,cnt);CHKERRQ(ierr);
+  aij->splitstate = aij->B->nonzerostate;
+  ierr = PetscInfo2(A,"Off-diagonal part applied in %D segments from %D messages\n",nseg,nmesg);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  Mat         A;
+  PetscScalar *y;
+} MatMultSplitCtx;
+
+static PetscErrorCode MatMultSplitApply_MPIAIJ(void *ctx,PetscInt k,const PetscScalar *x)
+{
+  MatMultSplitCtx   *sctx = (MatMultSplitCtx*)ctx;
+  Mat_MPIAIJ        *aij  = (Mat_MPIAIJ*)sctx->A->data;
+  Mat_SeqAIJ        *b    = (Mat_SeqAIJ*)aij->B->data;
+  PetscScalar       *y    = sctx->y,sum;
+  const PetscScalar *aa;
+  const PetscInt    *aj;
+  PetscInt          s,n,nz = 0;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  for (s=aij->splitstart[k]; s<aij->splitstart[k+1]; s++) {
+    aj   = b->j + aij->splitoff[s];
+    aa   = b->a + aij->splitoff[s];
+    n    = aij->splitlen[s];
+    sum  = 0.0;
+    PetscSparseDensePlusDot(sum,x,aa,aj,n);
+    y[aij->splitrow[s]] += sum;
+    nz  += n;
+  }
+  ierr = PetscLogFlops(2.0*nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+     MatMult_MPIAIJ() with -mat_mpiaij_mult_split: instead of waiting for all the ghost values before applying the
+   off-diagonal part B, the entries of B using the ghost values of a message are applied as soon as it arrives, so
+   that the communication with slow neighbors is overlapped with the work for the others.
+*/
+PetscErrorCode MatMultSplit_MPIAIJ(Mat A,Vec xx,Vec yy)
+{
+  Mat_MPIAIJ      *a = (Mat_MPIAIJ*)A->data;
+  MatMultSplitCtx ctx;
+  PetscErrorCode  ierr;
+  PetscBool       flg;
+
+  PetscFunctionBegin;
+  ierr = MatMultSplitSetUp_MPIAIJ(A,&flg);CHKERRQ(ierr);
+  ierr = VecScatterBegin(a->Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = (*a->A->ops->mult)(a->A,xx,yy);CHKERRQ(ierr);
+  if (flg) {
+    ctx.A = A;
+    ierr  = VecGetArray(yy,&ctx.y);CHKERRQ(ierr);
+    ierr  = VecScatterEndByMessage_Private(a->Mvctx,xx,a->lvec,MatMultSplitApply_MPIAIJ,&ctx);CHKERRQ(ierr);
+    ierr  = VecRestoreArray(yy,&ctx.y);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterEnd(a->Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = (*a->B->ops->multadd)(a->B,a->lvec,yy,yy);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -943,6 +943,10 @@ PetscErrorCode MatMult_MPIAIJ(Mat A,Vec xx,Vec yy)
   PetscFunctionBegin;
   ierr = VecGetLocalSize(xx,&nt);CHKERRQ(ierr);
   if (nt != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Incompatible partition of A (%D) and xx (%D)",A->cmap->n,nt);
+  if (a->multsplit) {
+    ierr = MatMultSplit_MPIAIJ(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
 
   ierr = VecScatterBegin(Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
   ierr = (*a->A->ops->mult)(a->A,xx,yy);CHKERRQ(ierr);
@@ -1120,6 +1124,10 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = VecDestroy(&aij->lvec);CHKERRQ(ierr);
   ierr = VecScatterDestroy(&aij->Mvctx);CHKERRQ(ierr);
   if (aij->Mvctx_mpi1) {ierr = VecScatterDestroy(&aij->Mvctx_mpi1);CHKERRQ(ierr);}
+  ierr = MatMultSplitReset_MPIAIJ(mat);CHKERRQ(ierr);
+  ierr = PetscHMapIJVDestroy(&aij->ht);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->htdnz,aij->htonz);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
@@ -1131,6 +1139,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisbaij_C",NULL);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_ELEMENTAL)
@@ -2094,12 +2104,164 @@ PetscErrorCode MatCopy_MPIAIJ(Mat A,Mat B,MatStructure str)
   PetscFunctionReturn(0);
 }
 
+/*
+   Assembly without preallocation: until the first final assembly the values set with MatSetValues() are accumulated
+   in a hash table keyed by (row,column), which also counts the distinct entries of each local row. The final assembly
+   then preallocates the diagonal and off-diagonal parts exactly and inserts each row in one call, sorted by column.
+*/
+static PetscErrorCode MatSetValues_MPIAIJ_Hash(Mat mat,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode addv)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+  PetscInt       i,j,rstart = mat->rmap->rstart,rend = mat->rmap->rend;
+  PetscInt       cstart = mat->cmap->rstart,cend = mat->cmap->rend;
+  PetscBool      roworiented = aij->roworiented,ignorezeroentries = ((Mat_SeqAIJ*)aij->A->data)->ignorezeroentries,missing;
+  PetscScalar    value;
+  PetscHashIJKey key;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    if (im[i] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+    if (im[i] >= mat->rmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",im[i],mat->rmap->N-1);
+#endif
+    if (im[i] >= rstart && im[i] < rend) {
+      key.i = im[i];
+      for (j=0; j<n; j++) {
+        if (in[j] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+        if (in[j] >= mat->cmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",in[j],mat->cmap->N-1);
+#endif
+        if (roworiented) value = v[i*n+j];
+        else             value = v[i+j*m];
+        if (ignorezeroentries && value == 0.0 && (addv == ADD_VALUES) && im[i] != in[j]) continue;
+        key.j = in[j];
+        if (addv == ADD_VALUES) {ierr = PetscHMapIJVQueryAdd(aij->ht,key,value,&missing);CHKERRQ(ierr);}
+        else                    {ierr = PetscHMapIJVQuerySet(aij->ht,key,value,&missing);CHKERRQ(ierr);}
+        if (missing) {
+          if (in[j] >= cstart && in[j] < cend) aij->htdnz[im[i]-rstart]++;
+          else                                 aij->htonz[im[i]-rstart]++;
+        }
+      }
+    } else {
+      if (mat->nooffprocentries) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Setting off process row %D even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set",im[i]);
+      if (!aij->donotstash) {
+        mat->assembled = PETSC_FALSE;
+        if (roworiented) {
+          ierr = MatStashValuesRow_Private(&mat->stash,im[i],n,in,v+i*n,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        } else {
+          ierr = MatStashValuesCol_Private(&mat->stash,im[i],n,in,v+i,m,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_MPIAIJ_Hash(Mat mat,MatAssemblyType mode)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+  PetscMPIInt    n;
+  PetscInt       i,j,rstart,ncols,flg,m = mat->rmap->n,nz,*row,*col,*rowstart,*pos,*cols;
+  PetscScalar    *val,*vals;
+  PetscHashIter  hi;
+  PetscHashIJKey key;
+  PetscBool      donotstash;
+  PetscInt       nonewA,nonewB;
+
+  PetscFunctionBegin;
+  if (!aij->donotstash && !mat->nooffprocentries) {
+    while (1) {
+      ierr = MatStashScatterGetMesg_Private(&mat->stash,&n,&row,&col,&val,&flg);CHKERRQ(ierr);
+      if (!flg) break;
+
+      for (i=0; i<n; ) {
+        /* Now identify the consecutive vals belonging to the same row */
+        for (j=i,rstart=row[j]; j<n; j++) {
+          if (row[j] != rstart) break;
+        }
+        if (j < n) ncols = j-i;
+        else       ncols = n-i;
+        ierr = MatSetValues_MPIAIJ_Hash(mat,1,row+i,ncols,col+i,val+i,mat->insertmode);CHKERRQ(ierr);
+        i = j;
+      }
+    }
+    ierr = MatStashScatterEnd_Private(&mat->stash);CHKERRQ(ierr);
+  }
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+
+  /* preallocate exactly and insert the entries row by row, sorted by column */
+  mat->ops->setvalues   = aij->htsetvalues;
+  mat->ops->assemblyend = aij->htassemblyend;
+  /* preallocating with nnz turns on MAT_NEW_NONZERO_ALLOCATION_ERR, later assemblies may still add new nonzeros */
+  nonewA = ((Mat_SeqAIJ*)aij->A->data)->nonew;
+  nonewB = ((Mat_SeqAIJ*)aij->B->data)->nonew;
+  ierr   = MatSeqAIJSetPreallocation(aij->A,0,aij->htdnz);CHKERRQ(ierr);
+  ierr   = MatSeqAIJSetPreallocation(aij->B,0,aij->htonz);CHKERRQ(ierr);
+  ((Mat_SeqAIJ*)aij->A->data)->nonew = nonewA;
+  ((Mat_SeqAIJ*)aij->B->data)->nonew = nonewB;
+  ierr = PetscHMapIJVGetSize(aij->ht,&nz);CHKERRQ(ierr);
+  ierr = PetscMalloc4(m+1,&rowstart,m,&pos,nz,&cols,nz,&vals);CHKERRQ(ierr);
+  rowstart[0] = 0;
+  for (i=0; i<m; i++) {
+    rowstart[i+1] = rowstart[i] + aij->htdnz[i] + aij->htonz[i];
+    pos[i]        = rowstart[i];
+  }
+  PetscHashIterBegin(aij->ht,hi);
+  while (!PetscHashIterAtEnd(aij->ht,hi)) {
+    PetscHashIterGetKey(aij->ht,hi,key);
+    i = key.i - mat->rmap->rstart;
+    cols[pos[i]] = key.j;
+    PetscHashIterGetVal(aij->ht,hi,vals[pos[i]]);
+    pos[i]++;
+    PetscHashIterNext(aij->ht,hi);
+  }
+  ierr = PetscHMapIJVDestroy(&aij->ht);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->htdnz,aij->htonz);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    ncols = rowstart[i+1] - rowstart[i];
+    if (!ncols) continue;
+    rstart = mat->rmap->rstart + i;
+    ierr   = PetscSortIntWithScalarArray(ncols,cols+rowstart[i],vals+rowstart[i]);CHKERRQ(ierr);
+    ierr   = (*mat->ops->setvalues)(mat,1,&rstart,ncols,cols+rowstart[i],vals+rowstart[i],INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(rowstart,pos,cols,vals);CHKERRQ(ierr);
+  ierr = PetscInfo1(mat,"Assembled %D local entries without preallocation\n",nz);CHKERRQ(ierr);
+
+  /* all the entries are local now, so the stash is not used */
+  donotstash      = aij->donotstash;
+  aij->donotstash = PETSC_TRUE;
+  ierr = (*mat->ops->assemblyend)(mat,mode);CHKERRQ(ierr);
+  aij->donotstash = donotstash;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetUp_MPIAIJ(Mat A)
 {
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)A->data;
   PetscErrorCode ierr;
+  PetscBool      hash = PETSC_FALSE;
 
   PetscFunctionBegin;
-  ierr =  MatMPIAIJSetPreallocation(A,PETSC_DEFAULT,0,PETSC_DEFAULT,0);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_mpiaij_hash_assembly",&hash,NULL);CHKERRQ(ierr);
+  if (!hash) {
+    ierr = MatMPIAIJSetPreallocation(A,PETSC_DEFAULT,0,PETSC_DEFAULT,0);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* the diagonal and off-diagonal parts are created empty so that options can be set on them, and as with the default
+     MatSetUp() new nonzeros may be added after the first assembly */
+  ierr = MatMPIAIJSetPreallocation(A,0,NULL,0,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(aij->A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSetOption(aij->B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = PetscHMapIJVCreate(&aij->ht);CHKERRQ(ierr);
+  ierr = PetscHMapIJVResize(aij->ht,5*A->rmap->n);CHKERRQ(ierr); /* as many entries as the default preallocation */
+  ierr = PetscCalloc2(A->rmap->n,&aij->htdnz,A->rmap->n,&aij->htonz);CHKERRQ(ierr);
+  aij->htsetvalues      = A->ops->setvalues;
+  aij->htassemblyend    = A->ops->assemblyend;
+  A->ops->setvalues     = MatSetValues_MPIAIJ_Hash;
+  A->ops->assemblyend   = MatAssemblyEnd_MPIAIJ_Hash;
+  ierr = PetscInfo(A,"Using a hash table for the assembly without preallocation\n");CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2443,6 +2605,7 @@ PetscErrorCode MatMPIAIJSetUseScalableIncreaseOverlap(Mat A,PetscBool sc)
 
 PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
 {
+  Mat_MPIAIJ           *a = (Mat_MPIAIJ*)A->data;
   PetscErrorCode       ierr;
   PetscBool            sc = PETSC_FALSE,flg;
 
@@ -2454,6 +2617,7 @@ PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat
   if (flg) {
     ierr = MatMPIAIJSetUseScalableIncreaseOverlap(A,sc);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsBool("-mat_mpiaij_mult_split","Apply the off-diagonal part as each message of ghost values arrives","MatMult",a->multsplit,&a->multsplit,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2761,6 +2925,7 @@ PetscErrorCode MatDuplicate_MPIAIJ(Mat matin,MatDuplicateOption cpvalues,Mat *ne
   a->rank         = oldmat->rank;
   a->donotstash   = oldmat->donotstash;
   a->roworiented  = oldmat->roworiented;
+  a->multsplit    = oldmat->multsplit;
   a->rowindices   = 0;
   a->rowvalues    = 0;
   a->getrowactive = PETSC_FALSE;
@@ -3854,6 +4019,208 @@ PetscErrorCode MatMPIAIJSetPreallocationCSR_MPIAIJ(Mat B,const PetscInt Ii[],con
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&mpiaij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree(mpiaij->coo_send);CHKERRQ(ierr);
+  ierr = PetscFree2(mpiaij->coo_sendbuf,mpiaij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree4(mpiaij->coo_jmap1,mpiaij->coo_perm1,mpiaij->coo_jmap2,mpiaij->coo_perm2);CHKERRQ(ierr);
+  mpiaij->coo_nsend = mpiaij->coo_nrecv = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The entries of rows owned by other processes are sent once with a PetscSF whose leaves are these entries and whose
+   roots are slots on the owners; the slots of each sender are reserved with a fetch-and-add on a counter owned by
+   each receiver. The local and received entries are then sorted by row and column into the diagonal (A) and
+   off-diagonal (B) blocks, the matrix is preallocated exactly with this structure, and the map from the entries to
+   the nonzeros of A and B is kept for MatSetValuesCOO_MPIAIJ().
+*/
+PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  MPI_Comm       comm;
+  PetscSF        sf;
+  PetscSFNode    *iremote;
+  PetscInt       M = mat->rmap->N,N = mat->cmap->N,m = mat->rmap->n,rstart = mat->rmap->rstart,rend = mat->rmap->rend;
+  PetscInt       cstart = mat->cmap->rstart,cend = mat->cmap->rend;
+  PetscInt       k,l,e,r,g,nloc = 0,nsend = 0,nrecv = 0,nto,n,nu,nzA,nzB,n1,n2;
+  PetscInt       *lidx,*sidx,*sowner,*tocount,*tooffset,*sendij,*recvij,*bucket,*col,*bi,*bj,*jmap,*perm,*Ii,*J;
+  PetscInt       *jmap1,*perm1,*jmap2,*perm2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (coo_i[k] >= M) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Entry %D has row %D, the matrix has %D rows",k,coo_i[k],M);
+    if (coo_j[k] >= N) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Entry %D has column %D, the matrix has %D columns",k,coo_j[k],N);
+    if (rstart <= coo_i[k] && coo_i[k] < rend) nloc++;
+    else nsend++;
+  }
+  ierr = PetscMalloc3(nloc,&lidx,nsend,&sidx,nsend,&sowner);CHKERRQ(ierr);
+  for (k=0,nloc=0,nsend=0; k<ncoo; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (rstart <= coo_i[k] && coo_i[k] < rend) lidx[nloc++] = k;
+    else {
+      ierr = PetscLayoutFindOwner(mat->rmap,coo_i[k],&sowner[nsend]);CHKERRQ(ierr);
+      sidx[nsend++] = k;
+    }
+  }
+  ierr = PetscSortIntWithArray(nsend,sowner,sidx);CHKERRQ(ierr);
+
+  /* Reserve slots for the entries sent to each owner */
+  for (l=0,nto=0; l<nsend; l++) if (!l || sowner[l] != sowner[l-1]) nto++;
+  ierr = PetscMalloc1(nto,&iremote);CHKERRQ(ierr);
+  ierr = PetscCalloc2(nto,&tocount,nto,&tooffset);CHKERRQ(ierr);
+  for (l=0,g=-1; l<nsend; l++) {
+    if (!l || sowner[l] != sowner[l-1]) {
+      g++;
+      iremote[g].rank  = sowner[l];
+      iremote[g].index = 0;
+    }
+    tocount[g]++;
+  }
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf,1,nto,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpBegin(sf,MPIU_INT,&nrecv,tocount,tooffset,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpEnd(sf,MPIU_INT,&nrecv,tocount,tooffset,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+
+  /* Send the coordinates of the entries to the reserved slots */
+  ierr = PetscMalloc1(nsend,&iremote);CHKERRQ(ierr);
+  for (l=0,g=-1,k=0; l<nsend; l++) {
+    if (!l || sowner[l] != sowner[l-1]) {g++; k = tooffset[g];}
+    iremote[l].rank  = sowner[l];
+    iremote[l].index = k++;
+  }
+  ierr = PetscFree2(tocount,tooffset);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf,nrecv,nsend,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  ierr = PetscMalloc2(2*nsend,&sendij,2*nrecv,&recvij);CHKERRQ(ierr);
+  for (l=0; l<nsend; l++) {
+    sendij[l]       = coo_i[sidx[l]];
+    sendij[nsend+l] = coo_j[sidx[l]];
+  }
+  ierr = PetscSFReduceBegin(sf,MPIU_INT,sendij,recvij,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,MPIU_INT,sendij,recvij,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf,MPIU_INT,sendij+nsend,recvij+nrecv,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,MPIU_INT,sendij+nsend,recvij+nrecv,MPIU_REPLACE);CHKERRQ(ierr);
+
+  /* Sort the local entries, then the received ones, by row of A then by row of B */
+  n    = nloc + nrecv;
+  ierr = PetscMalloc2(n,&bucket,n,&col);CHKERRQ(ierr);
+  for (e=0; e<n; e++) {
+    PetscInt i = e < nloc ? coo_i[lidx[e]] : recvij[e-nloc],j = e < nloc ? coo_j[lidx[e]] : recvij[nrecv+e-nloc];
+    bucket[e] = i - rstart + ((cstart <= j && j < cend) ? 0 : m);
+    col[e]    = j;
+  }
+  ierr = PetscFree2(sendij,recvij);CHKERRQ(ierr);
+  ierr = MatCOOSortEntries_Private(2*m,n,bucket,col,&bi,&bj,&jmap,&perm);CHKERRQ(ierr);
+  ierr = PetscFree2(bucket,col);CHKERRQ(ierr);
+
+  /* Preallocate with the merged entries, the nonzeros of each row of A and B are then in the order of bj[] */
+  nzA  = bi[m];
+  nzB  = bi[2*m] - bi[m];
+  nu   = nzA + nzB;
+  ierr = PetscMalloc2(m+1,&Ii,nu,&J);CHKERRQ(ierr);
+  for (r=0,Ii[0]=0; r<m; r++) {
+    Ii[r+1] = Ii[r];
+    for (k=bi[r]; k<bi[r+1]; k++) J[Ii[r+1]++] = bj[k];
+    for (k=bi[m+r]; k<bi[m+r+1]; k++) J[Ii[r+1]++] = bj[k];
+  }
+  ierr = MatMPIAIJSetPreallocationCSR_MPIAIJ(mat,Ii,J,NULL);CHKERRQ(ierr);
+  ierr = PetscFree2(Ii,J);CHKERRQ(ierr);
+  ierr = PetscFree(bi);CHKERRQ(ierr);
+  ierr = PetscFree(bj);CHKERRQ(ierr);
+  if (((Mat_SeqAIJ*)mpiaij->A->data)->nz != nzA || ((Mat_SeqAIJ*)mpiaij->B->data)->nz != nzB) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Assembled structure does not match the coordinates");
+
+  /* Split the entries summed into each nonzero between the local and the received ones */
+  for (k=0,n1=0; k<jmap[nu]; k++) if (perm[k] < nloc) n1++;
+  n2   = jmap[nu] - n1;
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nu+1,&jmap1,n1,&perm1,nu+1,&jmap2,n2,&perm2);CHKERRQ(ierr);
+  jmap1[0] = jmap2[0] = 0;
+  for (k=0,n1=0,n2=0; k<nu; k++) {
+    for (l=jmap[k]; l<jmap[k+1]; l++) {
+      if (perm[l] < nloc) perm1[n1++] = lidx[perm[l]];
+      else                perm2[n2++] = perm[l] - nloc;
+    }
+    jmap1[k+1] = n1;
+    jmap2[k+1] = n2;
+  }
+  ierr = PetscFree(jmap);CHKERRQ(ierr);
+  ierr = PetscFree(perm);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nsend,&mpiaij->coo_send);CHKERRQ(ierr);
+  ierr = PetscMemcpy(mpiaij->coo_send,sidx,nsend*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscFree3(lidx,sidx,sowner);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nsend,&mpiaij->coo_sendbuf,nrecv,&mpiaij->coo_recvbuf);CHKERRQ(ierr);
+  mpiaij->coo_sf           = sf;
+  mpiaij->coo_nsend        = nsend;
+  mpiaij->coo_nrecv        = nrecv;
+  mpiaij->coo_jmap1        = jmap1;
+  mpiaij->coo_perm1        = perm1;
+  mpiaij->coo_jmap2        = jmap2;
+  mpiaij->coo_perm2        = perm2;
+  mpiaij->coo_nonzerostate = mat->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+/* Sums the entries into the nonzeros of one of the blocks, with jmap[] and perm[] shifted to the first nonzero of the block */
+PETSC_STATIC_INLINE void MatSetValuesCOO_MPIAIJ_Block(PetscInt nz,const PetscInt jmap[],const PetscInt perm[],const PetscScalar v[],PetscBool insert,MatScalar aa[])
+{
+  PetscInt    k,p;
+  PetscScalar sum;
+
+  for (k=0; k<nz; k++) {
+    for (p=jmap[k],sum=0.0; p<jmap[k+1]; p++) sum += v[perm[p]];
+    aa[k] = insert ? sum : aa[k] + sum;
+  }
+}
+
+PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)mpiaij->A->data,*b = (Mat_SeqAIJ*)mpiaij->B->data;
+  PetscInt       k,nzA = a->nz,nzB = b->nz;
+  const PetscInt *send = mpiaij->coo_send,*jmap1 = mpiaij->coo_jmap1,*jmap2 = mpiaij->coo_jmap2;
+  PetscScalar    *sendbuf = mpiaij->coo_sendbuf,*recvbuf = mpiaij->coo_recvbuf;
+  PetscBool      seqaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!mpiaij->coo_sf) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  if (mat->nonzerostate != mpiaij->coo_nonzerostate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The nonzero structure changed since MatSetPreallocationCOO()");
+  for (k=0; k<mpiaij->coo_nsend; k++) sendbuf[k] = v[send[k]];
+  ierr = PetscSFReduceBegin(mpiaij->coo_sf,MPIU_SCALAR,sendbuf,recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+  MatSetValuesCOO_MPIAIJ_Block(nzA,jmap1,mpiaij->coo_perm1,v,(PetscBool)(imode == INSERT_VALUES),a->a);
+  MatSetValuesCOO_MPIAIJ_Block(nzB,jmap1+nzA,mpiaij->coo_perm1,v,(PetscBool)(imode == INSERT_VALUES),b->a);
+  ierr = PetscSFReduceEnd(mpiaij->coo_sf,MPIU_SCALAR,sendbuf,recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+  MatSetValuesCOO_MPIAIJ_Block(nzA,jmap2,mpiaij->coo_perm2,recvbuf,PETSC_FALSE,a->a);
+  MatSetValuesCOO_MPIAIJ_Block(nzB,jmap2+nzA,mpiaij->coo_perm2,recvbuf,PETSC_FALSE,b->a);
+  a->idiagvalid = a->ibdiagvalid = PETSC_FALSE;
+  b->idiagvalid = b->ibdiagvalid = PETSC_FALSE;
+  ierr = PetscLogFlops(jmap1[nzA+nzB]+jmap2[nzA+nzB]);CHKERRQ(ierr);
+  /* formats derived from MATSEQAIJ may keep their own copy of the values, which the assembly refreshes */
+  ierr = PetscObjectTypeCompare((PetscObject)mpiaij->A,MATSEQAIJ,&seqaij);CHKERRQ(ierr);
+  if (!seqaij) {
+    ierr = MatAssemblyBegin(mpiaij->A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mpiaij->A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)mpiaij->B,MATSEQAIJ,&seqaij);CHKERRQ(ierr);
+  if (!seqaij) {
+    ierr = MatAssemblyBegin(mpiaij->B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mpiaij->B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatMPIAIJSetPreallocationCSR - Allocates memory for a sparse parallel matrix in AIJ format
    (the default parallel PETSc format).
@@ -5559,6 +5926,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
@@ -3,6 +3,7 @@
 #define __MPIAIJ_H
 
 #include <../src/mat/impls/aij/seq/aij.h>
+#include <petsc/private/hashmapijv.h>
 
 typedef struct { /* used by MatCreateMPIAIJSumSeqAIJ for reusing the merged matrix */
   PetscLayout rowmap;
@@ -29,6 +30,16 @@ typedef struct { /* used by MatPtAP_MPIAIJ_MPIAIJ() and MatMatMult_MPIAIJ_MPIAIJ
   Mat         Rd,Ro,AP_loc,C_loc,C_oth;
   PetscInt    algType;         /* implementation algorithm */
 
+  /* used by the all-at-once algorithms, which form neither AP nor P^T */
+  PetscInt    *c_loci,*c_locj; /* nonzero structure of the local rows of C, global column indices */
+  PetscScalar *c_loca;
+  PetscInt    *c_othi,*c_othj; /* nonzero structure of the rows of C owned by other processes, one row per column of P->B */
+  PetscScalar *c_otha;
+  PetscSF     sf;              /* sends the entries of c_otha to the buffer c_rmta of their owners */
+  PetscInt    nrmt,*c_rmtpos;  /* number of entries received from other processes and their positions in c_locj */
+  PetscScalar *c_rmta;
+  PetscInt    apnzmax;         /* maximum number of nonzeros in a row of AP */
+
   Mat_Merge_SeqsToMPI *merge;
   PetscErrorCode (*destroy)(Mat);
   PetscErrorCode (*duplicate)(Mat,MatDuplicateOption,Mat*);
@@ -62,6 +73,29 @@ typedef struct {
   PetscBool  Mvctx_mpi1_flg;       /* if true, additional Mvctx_mpi1 is requested for mat-mat ops, default false */
   PetscBool  roworiented;          /* if true, row-oriented input, default true */
 
+  /* Used by MatMult_MPIAIJ() with -mat_mpiaij_mult_split to apply B a received message at a time */
+  PetscBool        multsplit;      /* apply the entries of B that use the ghost values of a message as soon as it arrives */
+  PetscObjectState splitstate;     /* nonzero state of B for which the segments below were built */
+  PetscInt         *splitstart;    /* [number of received messages+1] segments using the ghost values of each message */
+  PetscInt         *splitrow;      /* row of B of each segment */
+  PetscInt         *splitoff;      /* offset in the column indices and values of B of each segment */
+  PetscInt         *splitlen;      /* number of entries of each segment */
+
+  /* Used by the assembly without preallocation with -mat_mpiaij_hash_assembly, see MatSetUp_MPIAIJ() */
+  PetscHMapIJV ht;                 /* entries set before the first final assembly */
+  PetscInt     *htdnz,*htonz;      /* number of entries of the diagonal and off-diagonal parts in each local row */
+  PetscErrorCode (*htsetvalues)(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[],const PetscScalar[],InsertMode);
+  PetscErrorCode (*htassemblyend)(Mat,MatAssemblyType);
+
+  /* Used by MatSetPreallocationCOO() and MatSetValuesCOO() */
+  PetscSF          coo_sf;                        /* sends the values of off-process rows to their owners */
+  PetscInt         coo_nsend,coo_nrecv;           /* number of entries sent and received */
+  PetscInt         *coo_send;                     /* index of each sent entry in the coordinate list */
+  PetscScalar      *coo_sendbuf,*coo_recvbuf;
+  PetscInt         *coo_jmap1,*coo_perm1;         /* local entries summed into each nonzero of A, then of B */
+  PetscInt         *coo_jmap2,*coo_perm2;         /* received entries summed into each nonzero of A, then of B */
+  PetscObjectState coo_nonzerostate;              /* nonzero state of the matrix when the above were built */
+
   /* The following variables are for MatGetRow() */
   PetscInt    *rowindices;         /* column indices for row */
   PetscScalar *rowvalues;          /* nonzero values in row */
@@ -87,6 +121,11 @@ PETSC_INTERN PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat,MatAssemblyType);
 
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatMultSplit_MPIAIJ(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultSplitReset_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat,const PetscScalar[],InsertMode);
+PETSC_INTERN PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat,MatDuplicateOption,Mat*);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat,PetscInt,IS [],PetscInt);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ_Scalable(Mat,PetscInt,IS [],PetscInt);
@@ -122,6 +161,9 @@ PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(Mat,Mat,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce_merged(Mat,Mat,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat*);
 #endif
@@ -7,6 +7,9 @@
 #include <../src/mat/impls/aij/seq/aij.h>   /*I "petscmat.h" I*/
 #include <../src/mat/utils/freespace.h>
 #include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petsc/private/hashseti.h>
+#include <petsc/private/hashmapiv.h>
+#include <petscsf.h>
 #include <petscbt.h>
 #include <petsctime.h>
 
@@ -29,6 +32,10 @@ PetscErrorCode MatView_MPIAIJ_PtAP(Mat A,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"using scalable MatPtAP() implementation\n");CHKERRQ(ierr);
       } else if (ptap->algType == 1) {
         ierr = PetscViewerASCIIPrintf(viewer,"using nonscalable MatPtAP() implementation\n");CHKERRQ(ierr);
+      } else if (ptap->algType == 2) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using allatonce MatPtAP() implementation\n");CHKERRQ(ierr);
+      } else if (ptap->algType == 3) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using merged allatonce MatPtAP() implementation\n");CHKERRQ(ierr);
       }
     }
   }
@@ -65,6 +72,12 @@ PetscErrorCode MatDestroy_MPIAIJ_PtAP(Mat A)
     ierr = MatDestroy(&ptap->C_oth);CHKERRQ(ierr);
     if (ptap->apa) {ierr = PetscFree(ptap->apa);CHKERRQ(ierr);}
 
+    /* used by alg_allatonce */
+    ierr = PetscFree3(ptap->c_loci,ptap->c_locj,ptap->c_loca);CHKERRQ(ierr);
+    ierr = PetscFree3(ptap->c_othi,ptap->c_othj,ptap->c_otha);CHKERRQ(ierr);
+    ierr = PetscFree2(ptap->c_rmtpos,ptap->c_rmta);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&ptap->sf);CHKERRQ(ierr);
+
     if (merge) { /* used by alg_ptap */
       ierr = PetscFree(merge->id_r);CHKERRQ(ierr);
       ierr = PetscFree(merge->len_s);CHKERRQ(ierr);
@@ -108,11 +121,11 @@ PETSC_INTERN PetscErrorCode MatPtAP_MPIAIJ_MPIAIJ(Mat A,Mat P,MatReuse scall,Pet
   PetscBool      flg;
   MPI_Comm       comm;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char          *algTypes[2] = {"scalable","nonscalable"};
-  PetscInt            nalg=2;
+  const char          *algTypes[4] = {"scalable","nonscalable","allatonce","allatonce_merged"};
+  PetscInt            nalg=4;
 #else
-  const char          *algTypes[3] = {"scalable","nonscalable","hypre"};
-  PetscInt            nalg=3;
+  const char          *algTypes[5] = {"scalable","nonscalable","allatonce","allatonce_merged","hypre"};
+  PetscInt            nalg=5;
 #endif
   PetscInt            pN=P->cmap->N,alg=1; /* set default algorithm */
 
@@ -153,8 +166,21 @@ PETSC_INTERN PetscErrorCode MatPtAP_MPIAIJ_MPIAIJ(Mat A,Mat P,MatReuse scall,Pet
       ierr = MatPtAPSymbolic_MPIAIJ_MPIAIJ(A,P,fill,C);CHKERRQ(ierr);
       ierr = PetscLogEventEnd(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
       break;
-#if defined(PETSC_HAVE_HYPRE)
     case 2:
+    case 3:
+      /* accumulate the rows of C=P^T*A*P directly, without forming AP and P^T */
+      ierr = PetscLogEventBegin(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
+      ierr = MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(A,P,fill,C);CHKERRQ(ierr);
+      if (alg == 3) {
+        Mat_MPIAIJ *c = (Mat_MPIAIJ*)(*C)->data;
+
+        c->ptap->algType       = 3;
+        (*C)->ops->ptapnumeric = MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce_merged;
+      }
+      ierr = PetscLogEventEnd(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
+      break;
+#if defined(PETSC_HAVE_HYPRE)
+    case 4:
       /* Use boomerAMGBuildCoarseOperator */
       ierr = MatPtAPSymbolic_AIJ_AIJ_wHYPRE(A,P,fill,C);CHKERRQ(ierr);
       PetscFunctionReturn(0);
@@ -1040,3 +1066,382 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A,Mat P,Mat C)
   ptap->reuse = MAT_REUSE_MATRIX;
   PetscFunctionReturn(0);
 }
+
+/* ------------------------------------------------------------------------------------------------- */
+/*
+   The all-at-once algorithms compute C = P^T*A*P one row i of A at a time: AP[i,:] = A[i,:]*P is accumulated in a hash
+   table and P[i,r]*AP[i,:] is added to row r of C for each nonzero P[i,r]. Neither AP nor P^T is formed.
+   The rows r of C owned by other processes, the columns of P->B, are accumulated locally and sent to their owners
+   with a single PetscSF reduction.
+*/
+
+/* adds the column indices of AP[i,:] = Ad[i,:]*P_loc + Ao[i,:]*P_oth to ht */
+PETSC_STATIC_INLINE PetscErrorCode MatPtAPSymbolicAProw_MPIAIJ_allatonce(PetscInt i,Mat_SeqAIJ *ad,Mat_SeqAIJ *ao,Mat_SeqAIJ *pd,Mat_SeqAIJ *po,Mat_SeqAIJ *p_oth,PetscInt pcstart,const PetscInt *garray,PetscHSetI ht)
+{
+  PetscErrorCode ierr;
+  PetscInt       j,k,row;
+
+  PetscFunctionBeginHot;
+  for (j=ad->i[i]; j<ad->i[i+1]; j++) {
+    row = ad->j[j];
+    for (k=pd->i[row]; k<pd->i[row+1]; k++) {ierr = PetscHSetIAdd(ht,pd->j[k]+pcstart);CHKERRQ(ierr);}
+    for (k=po->i[row]; k<po->i[row+1]; k++) {ierr = PetscHSetIAdd(ht,garray[po->j[k]]);CHKERRQ(ierr);}
+  }
+  if (p_oth) {
+    for (j=ao->i[i]; j<ao->i[i+1]; j++) {
+      row = ao->j[j];
+      for (k=p_oth->i[row]; k<p_oth->i[row+1]; k++) {ierr = PetscHSetIAdd(ht,p_oth->j[k]);CHKERRQ(ierr);}
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* computes AP[i,:] = Ad[i,:]*P_loc + Ao[i,:]*P_oth, returned in (apnz,apj,apv) in no particular order */
+PETSC_STATIC_INLINE PetscErrorCode MatPtAPNumericAProw_MPIAIJ_allatonce(PetscInt i,Mat_SeqAIJ *ad,Mat_SeqAIJ *ao,Mat_SeqAIJ *pd,Mat_SeqAIJ *po,Mat_SeqAIJ *p_oth,PetscInt pcstart,const PetscInt *garray,PetscHMapIV hmap,PetscInt *apnz,PetscInt *apj,PetscScalar *apv)
+{
+  PetscErrorCode ierr;
+  PetscInt       j,k,row,off,nflops = 0;
+  PetscScalar    aval;
+
+  PetscFunctionBeginHot;
+  ierr = PetscHMapIVClear(hmap);CHKERRQ(ierr);
+  for (j=ad->i[i]; j<ad->i[i+1]; j++) {
+    row  = ad->j[j];
+    aval = ad->a[j];
+    for (k=pd->i[row]; k<pd->i[row+1]; k++) {ierr = PetscHMapIVAddValue(hmap,pd->j[k]+pcstart,aval*pd->a[k]);CHKERRQ(ierr);}
+    for (k=po->i[row]; k<po->i[row+1]; k++) {ierr = PetscHMapIVAddValue(hmap,garray[po->j[k]],aval*po->a[k]);CHKERRQ(ierr);}
+    nflops += pd->i[row+1] - pd->i[row] + po->i[row+1] - po->i[row];
+  }
+  if (p_oth) {
+    for (j=ao->i[i]; j<ao->i[i+1]; j++) {
+      row  = ao->j[j];
+      aval = ao->a[j];
+      for (k=p_oth->i[row]; k<p_oth->i[row+1]; k++) {ierr = PetscHMapIVAddValue(hmap,p_oth->j[k],aval*p_oth->a[k]);CHKERRQ(ierr);}
+      nflops += p_oth->i[row+1] - p_oth->i[row];
+    }
+  }
+  ierr = PetscLogFlops(2.0*nflops);CHKERRQ(ierr);
+  off  = 0;
+  ierr = PetscHMapIVGetKeys(hmap,&off,apj);CHKERRQ(ierr);
+  off  = 0;
+  ierr = PetscHMapIVGetVals(hmap,&off,apv);CHKERRQ(ierr);
+  *apnz = off;
+  PetscFunctionReturn(0);
+}
+
+/* adds pval*AP[i,:] to the row of C with sorted column indices cj and values ca */
+PETSC_STATIC_INLINE PetscErrorCode MatPtAPAddRow_MPIAIJ_allatonce(PetscScalar pval,PetscInt apnz,const PetscInt *apj,const PetscScalar *apv,PetscInt cnz,const PetscInt *cj,PetscScalar *ca)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,lo,hi,mid;
+
+  PetscFunctionBeginHot;
+  for (k=0; k<apnz; k++) {
+    /* bisection, inlined since this is the innermost loop */
+    lo = 0; hi = cnz;
+    while (hi - lo > 1) {
+      mid = lo + (hi - lo)/2;
+      if (apj[k] < cj[mid]) hi = mid;
+      else lo = mid;
+    }
+    if (!cnz || cj[lo] != apj[k]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Column %D of P^T*A*P is not in its symbolic product, the nonzero structure of A or P has changed",apj[k]);
+    ca[lo] += pval*apv[k];
+  }
+  ierr = PetscLogFlops(2.0*apnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,PetscReal fill,Mat *C)
+{
+  PetscErrorCode    ierr;
+  Mat_PtAPMPI       *ptap;
+  Mat_MPIAIJ        *a=(Mat_MPIAIJ*)A->data,*p=(Mat_MPIAIJ*)P->data,*c;
+  Mat_SeqAIJ        *ad=(Mat_SeqAIJ*)(a->A)->data,*ao=(Mat_SeqAIJ*)(a->B)->data;
+  Mat_SeqAIJ        *pd=(Mat_SeqAIJ*)(p->A)->data,*po=(Mat_SeqAIJ*)(p->B)->data,*p_oth=NULL;
+  MPI_Comm          comm;
+  Mat               Cmpi;
+  PetscHSetI        ht,*hta,*hto;
+  PetscSF           sf;
+  const PetscSFNode *rowremote;
+  PetscSFNode       *iremote;
+  PetscInt          am=A->rmap->n,pn=P->cmap->n,pcstart=P->cmap->rstart,pcend=P->cmap->rend,nghost=p->B->cmap->n;
+  PetscInt          i,j,k,r,s,off,nz,apnz,loc,*apj=NULL,*c_loci,*c_locj,*c_othi,*c_othj,*rmtj,*dnz,*onz;
+  PetscInt          *rootcnt,*rootstart,*leafcnt,*leafoff,*leafstart;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+
+  /* create struct Mat_PtAPMPI and attached it to C later */
+  ierr          = PetscNew(&ptap);CHKERRQ(ierr);
+  ptap->reuse   = MAT_INITIAL_MATRIX;
+  ptap->algType = 2;
+
+  /* get P_oth by taking rows of P (= non-zero cols of local A) from other processors, NULL on one process */
+  ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_INITIAL_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+  if (ptap->P_oth) p_oth = (Mat_SeqAIJ*)(ptap->P_oth)->data;
+
+  /* (1) accumulate the column indices of the local rows of C in hta and of the rows owned by other processes in hto */
+  /* --------------------------------------------------------------------------------------------------------------- */
+  ierr = PetscHSetICreate(&ht);CHKERRQ(ierr);
+  ierr = PetscMalloc2(pn,&hta,nghost,&hto);CHKERRQ(ierr);
+  for (r=0; r<pn; r++) {ierr = PetscHSetICreate(&hta[r]);CHKERRQ(ierr);}
+  for (k=0; k<nghost; k++) {ierr = PetscHSetICreate(&hto[k]);CHKERRQ(ierr);}
+  for (i=0; i<am; i++) {
+    if (pd->i[i+1] == pd->i[i] && po->i[i+1] == po->i[i]) continue; /* row i of P is empty */
+    ierr = PetscHSetIClear(ht);CHKERRQ(ierr);
+    ierr = MatPtAPSymbolicAProw_MPIAIJ_allatonce(i,ad,ao,pd,po,p_oth,pcstart,p->garray,ht);CHKERRQ(ierr);
+    ierr = PetscHSetIGetSize(ht,&apnz);CHKERRQ(ierr);
+    if (apnz > ptap->apnzmax) {
+      ierr = PetscFree(apj);CHKERRQ(ierr);
+      ierr = PetscMalloc1(apnz,&apj);CHKERRQ(ierr);
+      ptap->apnzmax = apnz;
+    }
+    off  = 0;
+    ierr = PetscHSetIGetElems(ht,&off,apj);CHKERRQ(ierr);
+    for (j=pd->i[i]; j<pd->i[i+1]; j++) {
+      for (k=0; k<apnz; k++) {ierr = PetscHSetIAdd(hta[pd->j[j]],apj[k]);CHKERRQ(ierr);}
+    }
+    for (j=po->i[i]; j<po->i[i+1]; j++) {
+      for (k=0; k<apnz; k++) {ierr = PetscHSetIAdd(hto[po->j[j]],apj[k]);CHKERRQ(ierr);}
+    }
+  }
+  ierr = PetscHSetIDestroy(&ht);CHKERRQ(ierr);
+  ierr = PetscFree(apj);CHKERRQ(ierr);
+
+  /* (2) the rows owned by other processes, with sorted column indices */
+  /* ------------------------------------------------------------------ */
+  for (k=0,nz=0; k<nghost; k++) {
+    ierr = PetscHSetIGetSize(hto[k],&s);CHKERRQ(ierr);
+    nz  += s;
+  }
+  ierr      = PetscMalloc3(nghost+1,&c_othi,nz,&c_othj,nz,&ptap->c_otha);CHKERRQ(ierr);
+  c_othi[0] = 0;
+  for (k=0; k<nghost; k++) {
+    off  = c_othi[k];
+    ierr = PetscHSetIGetElems(hto[k],&off,c_othj);CHKERRQ(ierr);
+    ierr = PetscHSetIDestroy(&hto[k]);CHKERRQ(ierr);
+    ierr = PetscSortInt(off-c_othi[k],c_othj+c_othi[k]);CHKERRQ(ierr);
+    c_othi[k+1] = off;
+  }
+  ptap->c_othi = c_othi;
+  ptap->c_othj = c_othj;
+
+  /* (3) send the column indices of the rows owned by other processes to their owners */
+  /* -------------------------------------------------------------------------------- */
+  /* the received entries of a local row r are stored contiguously in rmtj[rootstart[r]:rootstart[r+1]]; the entries
+     sent by this process for row k of c_oth start at leafstart[k]+leafoff[k] in the buffer of the owner of the row */
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf,P->cmap,nghost,NULL,PETSC_COPY_VALUES,p->garray);CHKERRQ(ierr);
+  ierr = PetscCalloc2(pn,&rootcnt,pn+1,&rootstart);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nghost,&leafcnt,nghost,&leafoff,nghost,&leafstart);CHKERRQ(ierr);
+  for (k=0; k<nghost; k++) leafcnt[k] = c_othi[k+1] - c_othi[k];
+  ierr = PetscSFFetchAndOpBegin(sf,MPIU_INT,rootcnt,leafcnt,leafoff,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpEnd(sf,MPIU_INT,rootcnt,leafcnt,leafoff,MPI_SUM);CHKERRQ(ierr);
+  for (r=0; r<pn; r++) rootstart[r+1] = rootstart[r] + rootcnt[r];
+  ierr = PetscSFBcastBegin(sf,MPIU_INT,rootstart,leafstart);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,MPIU_INT,rootstart,leafstart);CHKERRQ(ierr);
+
+  ierr = PetscSFGetGraph(sf,NULL,NULL,NULL,&rowremote);CHKERRQ(ierr);
+  ierr = PetscMalloc1(c_othi[nghost],&iremote);CHKERRQ(ierr);
+  for (k=0; k<nghost; k++) {
+    for (j=c_othi[k]; j<c_othi[k+1]; j++) {
+      iremote[j].rank  = rowremote[k].rank;
+      iremote[j].index = leafstart[k] + leafoff[k] + j - c_othi[k];
+    }
+  }
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree3(leafcnt,leafoff,leafstart);CHKERRQ(ierr);
+
+  ptap->nrmt = rootstart[pn];
+  ierr = PetscSFCreate(comm,&ptap->sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(ptap->sf,ptap->nrmt,c_othi[nghost],NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(ptap->sf);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ptap->nrmt,&ptap->c_rmtpos,ptap->nrmt,&ptap->c_rmta);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ptap->nrmt,&rmtj);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(ptap->sf,MPIU_INT,c_othj,rmtj,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(ptap->sf,MPIU_INT,c_othj,rmtj,MPIU_REPLACE);CHKERRQ(ierr);
+
+  /* (4) the local rows of C, with sorted column indices, and the preallocation of C */
+  /* ------------------------------------------------------------------------------- */
+  for (r=0,nz=0; r<pn; r++) {
+    for (s=rootstart[r]; s<rootstart[r+1]; s++) {ierr = PetscHSetIAdd(hta[r],rmtj[s]);CHKERRQ(ierr);}
+    ierr = PetscHSetIGetSize(hta[r],&j);CHKERRQ(ierr);
+    nz  += j;
+  }
+  ierr      = PetscMalloc3(pn+1,&c_loci,nz,&c_locj,nz,&ptap->c_loca);CHKERRQ(ierr);
+  c_loci[0] = 0;
+  ierr = MatPreallocateInitialize(comm,pn,pn,dnz,onz);CHKERRQ(ierr);
+  for (r=0; r<pn; r++) {
+    off  = c_loci[r];
+    ierr = PetscHSetIGetElems(hta[r],&off,c_locj);CHKERRQ(ierr);
+    ierr = PetscHSetIDestroy(&hta[r]);CHKERRQ(ierr);
+    ierr = PetscSortInt(off-c_loci[r],c_locj+c_loci[r]);CHKERRQ(ierr);
+    c_loci[r+1] = off;
+    for (j=c_loci[r]; j<c_loci[r+1]; j++) {
+      if (c_locj[j] >= pcstart && c_locj[j] < pcend) dnz[r]++;
+      else onz[r]++;
+    }
+    /* positions of the received entries in the local rows of C */
+    for (s=rootstart[r]; s<rootstart[r+1]; s++) {
+      ierr = PetscFindInt(rmtj[s],c_loci[r+1]-c_loci[r],c_locj+c_loci[r],&loc);CHKERRQ(ierr);
+      ptap->c_rmtpos[s] = c_loci[r] + loc;
+    }
+  }
+  ptap->c_loci = c_loci;
+  ptap->c_locj = c_locj;
+  ierr = PetscFree2(hta,hto);CHKERRQ(ierr);
+  ierr = PetscFree2(rootcnt,rootstart);CHKERRQ(ierr);
+  ierr = PetscFree(rmtj);CHKERRQ(ierr);
+
+  ierr = MatCreate(comm,&Cmpi);CHKERRQ(ierr);
+  ierr = MatSetType(Cmpi,MATMPIAIJ);CHKERRQ(ierr);
+  ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetBlockSizes(Cmpi,PetscAbs(P->cmap->bs),PetscAbs(P->cmap->bs));CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  ierr = MatPreallocateFinalize(dnz,onz);CHKERRQ(ierr);
+  ierr = PetscInfo4(Cmpi,"Allatonce algorithm, nonzeros: %D local, %D sent, %D received; AP row length at most %D\n",c_loci[pn],c_othi[nghost],ptap->nrmt,ptap->apnzmax);CHKERRQ(ierr);
+
+  /* attach the supporting struct to Cmpi for reuse */
+  c = (Mat_MPIAIJ*)Cmpi->data;
+  c->ptap         = ptap;
+  ptap->duplicate = Cmpi->ops->duplicate;
+  ptap->destroy   = Cmpi->ops->destroy;
+  ptap->view      = Cmpi->ops->view;
+
+  /* Cmpi is not ready for use - assembly will be done by MatPtAPNumeric() */
+  Cmpi->assembled        = PETSC_FALSE;
+  Cmpi->ops->ptapnumeric = MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce;
+  Cmpi->ops->destroy     = MatDestroy_MPIAIJ_PtAP;
+  Cmpi->ops->duplicate   = MatDuplicate_MPIAIJ_MatPtAP;
+  Cmpi->ops->view        = MatView_MPIAIJ_PtAP;
+  *C                     = Cmpi;
+  PetscFunctionReturn(0);
+}
+
+/* adds the entries received from other processes to the local rows of C and inserts them in C */
+static PetscErrorCode MatPtAPSetValues_MPIAIJ_allatonce(Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *c=(Mat_MPIAIJ*)C->data;
+  Mat_PtAPMPI    *ptap=c->ptap;
+  PetscInt       r,s,row,rstart=C->rmap->rstart,cm=C->rmap->n;
+
+  PetscFunctionBegin;
+  for (s=0; s<ptap->nrmt; s++) ptap->c_loca[ptap->c_rmtpos[s]] += ptap->c_rmta[s];
+  ierr = PetscLogFlops(ptap->nrmt);CHKERRQ(ierr);
+  for (r=0; r<cm; r++) {
+    row  = rstart + r;
+    ierr = MatSetValues(C,1,&row,ptap->c_loci[r+1]-ptap->c_loci[r],ptap->c_locj+ptap->c_loci[r],ptap->c_loca+ptap->c_loci[r],INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the rows of C owned by other processes first and sends them while the local rows are computed. AP[i,:] is
+   computed twice for the rows i of P with nonzeros in both P->A and P->B.
+*/
+PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *a=(Mat_MPIAIJ*)A->data,*p=(Mat_MPIAIJ*)P->data,*c=(Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ     *ad=(Mat_SeqAIJ*)(a->A)->data,*ao=(Mat_SeqAIJ*)(a->B)->data;
+  Mat_SeqAIJ     *pd=(Mat_SeqAIJ*)(p->A)->data,*po=(Mat_SeqAIJ*)(p->B)->data,*p_oth=NULL;
+  Mat_PtAPMPI    *ptap=c->ptap;
+  PetscHMapIV    hmap;
+  PetscInt       i,j,r,apnz,*apj,am=A->rmap->n,pn=P->cmap->n,pcstart=P->cmap->rstart,nghost=p->B->cmap->n;
+  PetscInt       *c_loci=ptap->c_loci,*c_othi=ptap->c_othi;
+  PetscScalar    *apv;
+
+  PetscFunctionBegin;
+  if (ptap->reuse == MAT_REUSE_MATRIX) {
+    /* P_oth is obtained in MatPtAPSymbolic() when reuse == MAT_INITIAL_MATRIX */
+    ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_REUSE_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+  }
+  if (ptap->P_oth) p_oth = (Mat_SeqAIJ*)(ptap->P_oth)->data;
+
+  ierr = PetscMemzero(ptap->c_loca,c_loci[pn]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(ptap->c_otha,c_othi[nghost]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscHMapIVCreate(&hmap);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ptap->apnzmax,&apj,ptap->apnzmax,&apv);CHKERRQ(ierr);
+
+  /* (1) the rows of C owned by other processes, C_oth += Po^T*AP */
+  for (i=0; i<am; i++) {
+    if (po->i[i+1] == po->i[i]) continue;
+    ierr = MatPtAPNumericAProw_MPIAIJ_allatonce(i,ad,ao,pd,po,p_oth,pcstart,p->garray,hmap,&apnz,apj,apv);CHKERRQ(ierr);
+    for (j=po->i[i]; j<po->i[i+1]; j++) {
+      r    = po->j[j];
+      ierr = MatPtAPAddRow_MPIAIJ_allatonce(po->a[j],apnz,apj,apv,c_othi[r+1]-c_othi[r],ptap->c_othj+c_othi[r],ptap->c_otha+c_othi[r]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscSFReduceBegin(ptap->sf,MPIU_SCALAR,ptap->c_otha,ptap->c_rmta,MPIU_REPLACE);CHKERRQ(ierr);
+
+  /* (2) the local rows of C, C_loc += Pd^T*AP */
+  for (i=0; i<am; i++) {
+    if (pd->i[i+1] == pd->i[i]) continue;
+    ierr = MatPtAPNumericAProw_MPIAIJ_allatonce(i,ad,ao,pd,po,p_oth,pcstart,p->garray,hmap,&apnz,apj,apv);CHKERRQ(ierr);
+    for (j=pd->i[i]; j<pd->i[i+1]; j++) {
+      r    = pd->j[j];
+      ierr = MatPtAPAddRow_MPIAIJ_allatonce(pd->a[j],apnz,apj,apv,c_loci[r+1]-c_loci[r],ptap->c_locj+c_loci[r],ptap->c_loca+c_loci[r]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscSFReduceEnd(ptap->sf,MPIU_SCALAR,ptap->c_otha,ptap->c_rmta,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscHMapIVDestroy(&hmap);CHKERRQ(ierr);
+  ierr = PetscFree2(apj,apv);CHKERRQ(ierr);
+
+  /* (3) C = C_loc + received C_oth */
+  ierr = MatPtAPSetValues_MPIAIJ_allatonce(C);CHKERRQ(ierr);
+  ptap->reuse = MAT_REUSE_MATRIX;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes AP[i,:] once for each row i and adds it to both the local rows of C and the rows owned by other processes,
+   which are sent when all of them are computed
+*/
+PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce_merged(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *a=(Mat_MPIAIJ*)A->data,*p=(Mat_MPIAIJ*)P->data,*c=(Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ     *ad=(Mat_SeqAIJ*)(a->A)->data,*ao=(Mat_SeqAIJ*)(a->B)->data;
+  Mat_SeqAIJ     *pd=(Mat_SeqAIJ*)(p->A)->data,*po=(Mat_SeqAIJ*)(p->B)->data,*p_oth=NULL;
+  Mat_PtAPMPI    *ptap=c->ptap;
+  PetscHMapIV    hmap;
+  PetscInt       i,j,r,apnz,*apj,am=A->rmap->n,pn=P->cmap->n,pcstart=P->cmap->rstart,nghost=p->B->cmap->n;
+  PetscInt       *c_loci=ptap->c_loci,*c_othi=ptap->c_othi;
+  PetscScalar    *apv;
+
+  PetscFunctionBegin;
+  if (ptap->reuse == MAT_REUSE_MATRIX) {
+    /* P_oth is obtained in MatPtAPSymbolic() when reuse == MAT_INITIAL_MATRIX */
+    ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_REUSE_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+  }
+  if (ptap->P_oth) p_oth = (Mat_SeqAIJ*)(ptap->P_oth)->data;
+
+  ierr = PetscMemzero(ptap->c_loca,c_loci[pn]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(ptap->c_otha,c_othi[nghost]*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscHMapIVCreate(&hmap);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ptap->apnzmax,&apj,ptap->apnzmax,&apv);CHKERRQ(ierr);
+
+  for (i=0; i<am; i++) {
+    if (pd->i[i+1] == pd->i[i] && po->i[i+1] == po->i[i]) continue;
+    ierr = MatPtAPNumericAProw_MPIAIJ_allatonce(i,ad,ao,pd,po,p_oth,pcstart,p->garray,hmap,&apnz,apj,apv);CHKERRQ(ierr);
+    for (j=pd->i[i]; j<pd->i[i+1]; j++) {
+      r    = pd->j[j];
+      ierr = MatPtAPAddRow_MPIAIJ_allatonce(pd->a[j],apnz,apj,apv,c_loci[r+1]-c_loci[r],ptap->c_locj+c_loci[r],ptap->c_loca+c_loci[r]);CHKERRQ(ierr);
+    }
+    for (j=po->i[i]; j<po->i[i+1]; j++) {
+      r    = po->j[j];
+      ierr = MatPtAPAddRow_MPIAIJ_allatonce(po->a[j],apnz,apj,apv,c_othi[r+1]-c_othi[r],ptap->c_othj+c_othi[r],ptap->c_otha+c_othi[r]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscHMapIVDestroy(&hmap);CHKERRQ(ierr);
+  ierr = PetscFree2(apj,apv);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(ptap->sf,MPIU_SCALAR,ptap->c_otha,ptap->c_rmta,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(ptap->sf,MPIU_SCALAR,ptap->c_otha,ptap->c_rmta,MPIU_REPLACE);CHKERRQ(ierr);
+
+  ierr = MatPtAPSetValues_MPIAIJ_allatonce(C);CHKERRQ(ierr);
+  ptap->reuse = MAT_REUSE_MATRIX;
+  PetscFunctionReturn(0);
+}
@@ -9,6 +9,7 @@
 #include <petscblaslapack.h>
 #include <petscbt.h>
 #include <petsc/private/kernels/blocktranspose.h>
+#include <petsc/private/kernels/isadispatch.h>
 
 PetscErrorCode MatSeqAIJSetTypeFromOptions(Mat A)
 {
@@ -975,6 +976,7 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
     ierr = MatView_SeqAIJ_Draw(A,viewer);CHKERRQ(ierr);
   }
   ierr = MatView_SeqAIJ_Inode(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_Threads(A,viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1038,7 +1040,34 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd_SeqAIJ_Threads(A,mode);CHKERRQ(ierr);
   ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+  if (A->ops->mult == MatMult_SeqAIJ_Threads) {
+    ierr = MatKernelISAView_Private(A,MAT_KERNEL_SCALAR,"OpenMP threaded routines");CHKERRQ(ierr);
+  } else if (a->inode.size) {
+    /* the I-node kernels are scalar, only MatMultTranspose() uses the selected instruction set */
+    ierr = MatKernelISAView_Private(A,MAT_KERNEL_SCALAR,a->kernelisa == MAT_KERNEL_AVX512 ? "I-node routines, AVX-512 MatMultTranspose()" : "I-node routines");CHKERRQ(ierr);
+  } else {
+    ierr = MatKernelISAView_Private(A,a->kernelisa,NULL);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  MatKernelISA   isa = a->kernelisa;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"SeqAIJ options");CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-mat_kernel_isa","Limit the instruction set of the matrix-vector product kernels","MatCreateSeqAIJ",MatKernelISAs,(PetscEnum)isa,(PetscEnum*)&isa,&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatGetKernelISA_Private(A,&a->kernelisa);CHKERRQ(ierr);
+    if (a->kernelisa == MAT_KERNEL_AVX) a->kernelisa = MAT_KERNEL_SCALAR; /* the AIJ kernels need the AVX2 gathers */
+  }
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1102,8 +1131,11 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISColoringDestroy(&a->coloring);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_Threads(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
 
   ierr = PetscObjectChangeTypeName((PetscObject)A,0);CHKERRQ(ierr);
@@ -1127,6 +1159,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatPtAP_is_seqaij_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1221,6 +1255,147 @@ PetscErrorCode MatGetDiagonal_SeqAIJ(Mat A,Vec v)
   PetscFunctionReturn(0);
 }
 
+/*
+    SIMD versions of the row loops of MatMult_SeqAIJ() and MatMultAdd_SeqAIJ(): z[r] = y[r] + A[r,:] x for r = ridx[i],
+  or r = i if ridx is NULL, where y == NULL stands for zero. The last entries of each row that do not fill a register
+  are handled with scalar code so nothing beyond the end of a row is ever loaded.
+*/
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+PETSC_KERNEL_TARGET_AVX512
+static void MatMultRows_SeqAIJ_AVX512(PetscInt m,const PetscInt *ii,const PetscInt *ridx,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
+{
+  const PetscInt  *idx;
+  const MatScalar *v;
+  PetscInt        i,j,n,r;
+  PetscScalar     sum;
+  __m512d         vec_x,vec_vals,vec_y,vec_x2,vec_vals2,vec_y2;
+  __m256i         vec_idx,vec_idx2;
+
+  for (i=0; i<m; i++) {
+    r      = ridx ? ridx[i] : i;
+    n      = ii[i+1] - ii[i];
+    idx    = aj + ii[i];
+    v      = aa + ii[i];
+    vec_y  = _mm512_setzero_pd();
+    vec_y2 = _mm512_setzero_pd();
+    for (j=0; j<n-15; j+=16) {
+      vec_idx   = _mm256_loadu_si256((__m256i const*)(idx+j));
+      vec_idx2  = _mm256_loadu_si256((__m256i const*)(idx+j+8));
+      vec_vals  = _mm512_loadu_pd(v+j);
+      vec_vals2 = _mm512_loadu_pd(v+j+8);
+      vec_x     = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
+      vec_x2    = _mm512_i32gather_pd(vec_idx2,x,_MM_SCALE_8);
+      vec_y     = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
+      vec_y2    = _mm512_fmadd_pd(vec_x2,vec_vals2,vec_y2);
+    }
+    if (j < n-7) {
+      vec_idx  = _mm256_loadu_si256((__m256i const*)(idx+j));
+      vec_vals = _mm512_loadu_pd(v+j);
+      vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
+      vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
+      j       += 8;
+    }
+    sum  = y ? y[r] : 0.0;
+    sum += _mm512_reduce_add_pd(_mm512_add_pd(vec_y,vec_y2));
+    for (; j<n; j++) sum += v[j]*x[idx[j]];
+    z[r] = sum;
+  }
+}
+
+/*
+    y[A[r,:] columns] += x[r] A[r,:] for the rows of MatMultTransposeAdd_SeqAIJ(); the column indices within a row
+  are distinct so the scatter never writes the same entry twice.
+*/
+PETSC_KERNEL_TARGET_AVX512
+static void MatMultTransposeRows_SeqAIJ_AVX512(PetscInt m,const PetscInt *ii,const PetscInt *ridx,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,PetscScalar *y)
+{
+  const PetscInt  *idx;
+  const MatScalar *v;
+  PetscInt        i,j,n;
+  PetscScalar     alpha;
+  __m512d         vec_alpha,vec_vals,vec_y;
+  __m256i         vec_idx;
+
+  for (i=0; i<m; i++) {
+    alpha     = ridx ? x[ridx[i]] : x[i];
+    n         = ii[i+1] - ii[i];
+    idx       = aj + ii[i];
+    v         = aa + ii[i];
+    vec_alpha = _mm512_set1_pd(alpha);
+    for (j=0; j<n-7; j+=8) {
+      vec_idx  = _mm256_loadu_si256((__m256i const*)(idx+j));
+      vec_vals = _mm512_loadu_pd(v+j);
+      vec_y    = _mm512_i32gather_pd(vec_idx,y,_MM_SCALE_8);
+      vec_y    = _mm512_fmadd_pd(vec_alpha,vec_vals,vec_y);
+      _mm512_i32scatter_pd(y,vec_idx,vec_y,_MM_SCALE_8);
+    }
+    for (; j<n; j++) y[idx[j]] += alpha*v[j];
+  }
+}
+#endif
+
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+PETSC_KERNEL_TARGET_AVX2
+static void MatMultRows_SeqAIJ_AVX2(PetscInt m,const PetscInt *ii,const PetscInt *ridx,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
+{
+  const PetscInt  *idx;
+  const MatScalar *v;
+  PetscInt        i,j,n,r;
+  PetscScalar     sum;
+  __m256d         vec_x,vec_vals,vec_y,vec_x2,vec_vals2,vec_y2;
+  __m128d         vec_sum;
+  __m128i         vec_idx,vec_idx2;
+
+  for (i=0; i<m; i++) {
+    r      = ridx ? ridx[i] : i;
+    n      = ii[i+1] - ii[i];
+    idx    = aj + ii[i];
+    v      = aa + ii[i];
+    vec_y  = _mm256_setzero_pd();
+    vec_y2 = _mm256_setzero_pd();
+    for (j=0; j<n-7; j+=8) {
+      vec_idx   = _mm_loadu_si128((__m128i const*)(idx+j));
+      vec_idx2  = _mm_loadu_si128((__m128i const*)(idx+j+4));
+      vec_vals  = _mm256_loadu_pd(v+j);
+      vec_vals2 = _mm256_loadu_pd(v+j+4);
+      vec_x     = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8);
+      vec_x2    = _mm256_i32gather_pd(x,vec_idx2,_MM_SCALE_8);
+      vec_y     = _mm256_fmadd_pd(vec_x,vec_vals,vec_y);
+      vec_y2    = _mm256_fmadd_pd(vec_x2,vec_vals2,vec_y2);
+    }
+    if (j < n-3) {
+      vec_idx  = _mm_loadu_si128((__m128i const*)(idx+j));
+      vec_vals = _mm256_loadu_pd(v+j);
+      vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8);
+      vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y);
+      j       += 4;
+    }
+    vec_y   = _mm256_add_pd(vec_y,vec_y2);
+    vec_sum = _mm_add_pd(_mm256_castpd256_pd128(vec_y),_mm256_extractf128_pd(vec_y,1));
+    vec_sum = _mm_add_sd(vec_sum,_mm_unpackhi_pd(vec_sum,vec_sum));
+    sum     = y ? y[r] : 0.0;
+    sum    += _mm_cvtsd_f64(vec_sum);
+    for (; j<n; j++) sum += v[j]*x[idx[j]];
+    z[r] = sum;
+  }
+}
+#endif
+
+/*
+    Applies the SIMD row kernel for the instruction set selected for the matrix, returns PETSC_FALSE if there is none
+  and the caller must use the scalar loop
+*/
+PETSC_STATIC_INLINE PetscBool MatMultRows_SeqAIJ_ISA(MatKernelISA isa,PetscInt m,const PetscInt *ii,const PetscInt *ridx,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
+{
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+  if (isa == MAT_KERNEL_AVX512) {MatMultRows_SeqAIJ_AVX512(m,ii,ridx,aj,aa,x,y,z); return PETSC_TRUE;}
+#endif
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+  if (isa == MAT_KERNEL_AVX2) {MatMultRows_SeqAIJ_AVX2(m,ii,ridx,aj,aa,x,y,z); return PETSC_TRUE;}
+#endif
+  return PETSC_FALSE;
+}
+
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
 PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 {
@@ -1253,16 +1428,23 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
   } else {
     ii = a->i;
   }
-  for (i=0; i<m; i++) {
-    idx = a->j + ii[i];
-    v   = a->a + ii[i];
-    n   = ii[i+1] - ii[i];
-    if (usecprow) {
-      alpha = x[ridx[i]];
-    } else {
-      alpha = x[i];
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+  if (a->kernelisa == MAT_KERNEL_AVX512) {
+    MatMultTransposeRows_SeqAIJ_AVX512(m,ii,ridx,a->j,a->a,x,y);
+  } else
+#endif
+  {
+    for (i=0; i<m; i++) {
+      idx = a->j + ii[i];
+      v   = a->a + ii[i];
+      n   = ii[i+1] - ii[i];
+      if (usecprow) {
+        alpha = x[ridx[i]];
+      } else {
+        alpha = x[i];
+      }
+      for (j=0; j<n; j++) y[idx[j]] += alpha*v[j];
     }
-    for (j=0; j<n; j++) y[idx[j]] += alpha*v[j];
   }
 #endif
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
@@ -1309,14 +1491,16 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
     m    = a->compressedrow.nrows;
     ii   = a->compressedrow.i;
     ridx = a->compressedrow.rindex;
-    for (i=0; i<m; i++) {
-      n           = ii[i+1] - ii[i];
-      aj          = a->j + ii[i];
-      aa          = a->a + ii[i];
-      sum         = 0.0;
-      PetscSparseDensePlusDot(sum,x,aa,aj,n);
-      /* for (j=0; j<n; j++) sum += (*aa++)*x[*aj++]; */
-      y[*ridx++] = sum;
+    if (!MatMultRows_SeqAIJ_ISA(a->kernelisa,m,ii,ridx,a->j,a->a,x,NULL,y)) {
+      for (i=0; i<m; i++) {
+        n           = ii[i+1] - ii[i];
+        aj          = a->j + ii[i];
+        aa          = a->a + ii[i];
+        sum         = 0.0;
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        /* for (j=0; j<n; j++) sum += (*aa++)*x[*aj++]; */
+        y[*ridx++] = sum;
+      }
     }
   } else { /* do not use compressed row format */
 #if defined(PETSC_USE_FORTRAN_KERNEL_MULTAIJ)
@@ -1324,13 +1508,15 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
     aa   = a->a;
     fortranmultaij_(&m,x,ii,aj,aa,y);
 #else
-    for (i=0; i<m; i++) {
-      n           = ii[i+1] - ii[i];
-      aj          = a->j + ii[i];
-      aa          = a->a + ii[i];
-      sum         = 0.0;
-      PetscSparseDensePlusDot(sum,x,aa,aj,n);
-      y[i] = sum;
+    if (!MatMultRows_SeqAIJ_ISA(a->kernelisa,m,ii,NULL,a->j,a->a,x,NULL,y)) {
+      for (i=0; i<m; i++) {
+        n           = ii[i+1] - ii[i];
+        aj          = a->j + ii[i];
+        aa          = a->a + ii[i];
+        sum         = 0.0;
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        y[i] = sum;
+      }
     }
 #endif
   }
@@ -1462,13 +1648,15 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
     m    = a->compressedrow.nrows;
     ii   = a->compressedrow.i;
     ridx = a->compressedrow.rindex;
-    for (i=0; i<m; i++) {
-      n   = ii[i+1] - ii[i];
-      aj  = a->j + ii[i];
-      aa  = a->a + ii[i];
-      sum = y[*ridx];
-      PetscSparseDensePlusDot(sum,x,aa,aj,n);
-      z[*ridx++] = sum;
+    if (!MatMultRows_SeqAIJ_ISA(a->kernelisa,m,ii,ridx,a->j,a->a,x,y,z)) {
+      for (i=0; i<m; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = y[*ridx];
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[*ridx++] = sum;
+      }
     }
   } else { /* do not use compressed row format */
     ii = a->i;
@@ -1477,13 +1665,15 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
     aa = a->a;
     fortranmultaddaij_(&m,x,ii,aj,aa,y,z);
 #else
-    for (i=0; i<m; i++) {
-      n   = ii[i+1] - ii[i];
-      aj  = a->j + ii[i];
-      aa  = a->a + ii[i];
-      sum = y[i];
-      PetscSparseDensePlusDot(sum,x,aa,aj,n);
-      z[i] = sum;
+    if (!MatMultRows_SeqAIJ_ISA(a->kernelisa,m,ii,NULL,a->j,a->a,x,y,z)) {
+      for (i=0; i<m; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = y[i];
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[i] = sum;
+      }
     }
 #endif
   }
@@ -1608,6 +1798,12 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
   const PetscInt    *idx,*diag;
 
   PetscFunctionBegin;
+  if (a->sormc.nthreads && !(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER))) {
+    PetscBool done;
+
+    ierr = MatSOR_SeqAIJ_Multicolor(A,bb,omega,flag,fshift,its,lits,xx,&done);CHKERRQ(ierr);
+    if (done) PetscFunctionReturn(0);
+  }
   its = its*lits;
 
   if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
@@ -3199,7 +3395,7 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         0,
                                 /* 74*/ 0,
                                         MatFDColoringApply_AIJ,
-                                        0,
+                                        MatSetFromOptions_SeqAIJ,
                                         0,
                                         0,
                                 /* 79*/ MatFindZeroDiagonals_SeqAIJ,
@@ -3491,6 +3687,8 @@ PetscErrorCode  MatRetrieveValues(Mat mat)
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
+.  -mat_kernel_isa <scalar,avx,avx2,avx512> - limits the instruction set of the matrix-vector product kernels, by default the most capable one supported by the processor is used
+.  -mat_view_kernel - prints the matrix-vector product kernels used, after each final assembly
 -  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
 
    Level: intermediate
@@ -3770,6 +3968,63 @@ PetscErrorCode  MatSeqAIJSetPreallocationCSR_SeqAIJ(Mat B,const PetscInt Ii[],co
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_SeqAIJ     *a;
+  PetscInt       m = A->rmap->n,n = A->cmap->n,k,*rows,*Ai,*Aj,*jmap,*perm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(ncoo,&rows);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] >= m) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Entry %D has row %D, the matrix has %D rows",k,coo_i[k],m);
+    if (coo_j[k] >= n) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Entry %D has column %D, the matrix has %D columns",k,coo_j[k],n);
+    rows[k] = coo_j[k] < 0 ? -1 : coo_i[k];
+  }
+  ierr = MatCOOSortEntries_Private(m,ncoo,rows,coo_j,&Ai,&Aj,&jmap,&perm);CHKERRQ(ierr);
+  ierr = PetscFree(rows);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocationCSR_SeqAIJ(A,Ai,Aj,NULL);CHKERRQ(ierr);
+  a    = (Mat_SeqAIJ*)A->data;
+  if (a->nz != Ai[m]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Assembled %D nonzeros instead of %D",a->nz,Ai[m]);
+  ierr = PetscFree(Ai);CHKERRQ(ierr);
+  ierr = PetscFree(Aj);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
+  a->coo_jmap         = jmap;
+  a->coo_perm         = perm;
+  a->coo_nonzerostate = A->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  const PetscInt *jmap = a->coo_jmap,*perm = a->coo_perm;
+  MatScalar      *aa = a->a;
+  PetscScalar    sum;
+  PetscInt       k,p,nz = a->nz;
+  PetscBool      seqaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!jmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  if (A->nonzerostate != a->coo_nonzerostate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The nonzero structure changed since MatSetPreallocationCOO()");
+  for (k=0; k<nz; k++) {
+    for (p=jmap[k],sum=0.0; p<jmap[k+1]; p++) sum += v[perm[p]];
+    aa[k] = (imode == INSERT_VALUES) ? sum : aa[k] + sum;
+  }
+  a->idiagvalid  = PETSC_FALSE;
+  a->ibdiagvalid = PETSC_FALSE;
+  ierr = PetscLogFlops(jmap[nz]);CHKERRQ(ierr);
+  /* formats derived from MATSEQAIJ may keep their own copy of the values, which the assembly refreshes */
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&seqaij);CHKERRQ(ierr);
+  if (!seqaij) {
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
@@ -4064,12 +4319,17 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaij_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaij_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaij_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaij_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
   ierr = MatCreate_SeqAIJ_Inode(B);CHKERRQ(ierr);
+  ierr = MatCreate_SeqAIJ_Threads(B);CHKERRQ(ierr);
+  ierr = MatGetKernelISA_Private(B,&b->kernelisa);CHKERRQ(ierr);
+  if (b->kernelisa == MAT_KERNEL_AVX) b->kernelisa = MAT_KERNEL_SCALAR; /* the AIJ kernels need the AVX2 gathers */
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = MatSeqAIJSetTypeFromOptions(B);CHKERRQ(ierr);  /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(0);
@@ -4161,8 +4421,10 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   }
   c->nonzerorowcnt = a->nonzerorowcnt;
   C->nonzerostate  = A->nonzerostate;
+  c->kernelisa     = a->kernelisa;
 
   ierr = MatDuplicate_SeqAIJ_Inode(A,cpvalues,&C);CHKERRQ(ierr);
+  ierr = MatDuplicate_SeqAIJ_Threads(A,cpvalues,&C);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
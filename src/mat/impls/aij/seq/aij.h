@@ -107,9 +107,38 @@ PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat,Mat,MatDuplicateOpti
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
 
+/* Info about the thread-parallel matrix-vector products helper class for SeqAIJ */
+typedef struct {
+  PetscInt         nthreads;                       /* number of row partitions, partition t is always applied by thread t */
+  PetscInt         *rstart;                        /* first row of each partition, length nthreads+1 */
+  PetscInt         *cstart,*cend;                  /* range of columns referenced by each partition, used by MatMultTranspose() */
+  PetscScalar      *work;                          /* per-thread accumulation buffers for MatMultTranspose(), length nthreads*n */
+  PetscInt         nz;                             /* number of nonzeros when the partition was computed */
+  PetscObjectState mat_nonzerostate;               /* non-zero state when the partition was computed */
+  PetscErrorCode   (*mult)(Mat,Vec,Vec);           /* the products that were installed before the threaded ones, restored */
+  PetscErrorCode   (*multadd)(Mat,Vec,Vec,Vec);    /* when the number of threads is set back to one */
+  PetscErrorCode   (*multtranspose)(Mat,Vec,Vec);
+  PetscErrorCode   (*multtransposeadd)(Mat,Vec,Vec,Vec);
+} Mat_SeqAIJ_Threads;
+
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Threads(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Threads(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Threads(Mat,MatDuplicateOption,Mat*);
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Threads(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ_Threads(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatFactorSetUpThreads_SeqAIJ(Mat,PetscInt);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec,PetscBool*);
+
 typedef struct {
   SEQAIJHEADER(MatScalar);
-  Mat_SeqAIJ_Inode inode;
+  Mat_SeqAIJ_Inode   inode;
+  Mat_SeqAIJ_Threads threads;
+  MatSORMulticolor   sormc;                   /* multicolor ordering for thread-parallel MatSOR() */
+  MatKernelISA       kernelisa;               /* instruction set used by the matrix-vector product kernels */
   MatScalar        *saved_values;             /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag,*mdiag,*ssor_work;       /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
@@ -126,6 +155,11 @@ typedef struct {
   Mat_RARt            *rart;               /* used by MatRARt() */
   Mat_MatMatTransMult *abt;                /* used by MatMatTransposeMult() */
   Mat_MatTransMatMult *atb;                /* used by MatTransposeMatMult() */
+
+  /* Used by MatSetPreallocationCOO() and MatSetValuesCOO() */
+  PetscInt            *coo_jmap;           /* entries coo_perm[coo_jmap[k]:coo_jmap[k+1]] are summed into nonzero k */
+  PetscInt            *coo_perm;           /* indices of the coordinate entries */
+  PetscObjectState    coo_nonzerostate;    /* nonzero state of the matrix when the above were built */
 } Mat_SeqAIJ;
 
 /*
@@ -213,6 +247,8 @@ PETSC_STATIC_INLINE PetscErrorCode MatSeqXAIJFreeAIJ(Mat AA,MatScalar **a,PetscI
   } \
 
 PETSC_INTERN PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat,PetscInt,const PetscInt*);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_inplace(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat,Mat,IS,IS,const MatFactorInfo*);
@@ -234,6 +270,7 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
 
@@ -330,6 +367,7 @@ PETSC_INTERN PetscErrorCode MatRestoreColumnIJ_SeqAIJ_Color(Mat,PetscInt,PetscBo
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatSetUp_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems*,Mat);
 
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal_Inode(Mat);
@@ -11,17 +11,7 @@
 */
 
 #include <../src/mat/impls/aij/seq/aij.h>
-
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-#include <immintrin.h>
-
-#if !defined(_MM_SCALE_8)
-#define _MM_SCALE_8    8
-#endif
-#if !defined(_MM_SCALE_4)
-#define _MM_SCALE_4    4
-#endif
-#endif
+#include <petsc/private/kernels/isadispatch.h>
 
 #define NDIM 512
 /* NDIM specifies how many rows at a time we should work with when
@@ -290,6 +280,149 @@ PetscErrorCode MatAssemblyEnd_SeqAIJPERM(Mat A, MatAssemblyType mode)
   PetscFunctionReturn(0);
 }
 
+/*
+    Computes yp[i] += A[iperm[istart+i],:] x for a chunk of isize rows with nz nonzeros each, ip[i] is the
+  position in aa and aj where the ith row of the chunk begins.
+
+    If the number of nonzeros per row exceeds the number of rows in the chunk, we vectorize along nz, that
+  is, perform the mat-vec one row at a time as in the usual CSR case. Otherwise, there are enough rows in
+  the chunk to make it worthwhile to vectorize across the rows, that is, to do the matvec by operating
+  with "columns" of the chunk.
+*/
+static void MatMultChunk_SeqAIJPERM_Scalar(PetscInt nz,PetscInt isize,const PetscInt *ip,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,PetscScalar *yp)
+{
+  PetscInt i,j,ipos;
+
+  if (nz > isize) {
+#if defined(PETSC_HAVE_CRAY_VECTOR)
+#pragma _CRI preferstream
+#endif
+    for (i=0; i<isize; i++) {
+#if defined(PETSC_HAVE_CRAY_VECTOR)
+#pragma _CRI prefervector
+#endif
+      for (j=0; j<nz; j++) {
+        ipos   = ip[i] + j;
+        yp[i] += aa[ipos] * x[aj[ipos]];
+      }
+    }
+  } else {
+    for (j=0; j<nz; j++) {
+      for (i=0; i<isize; i++) {
+        ipos   = ip[i] + j;
+        yp[i] += aa[ipos] * x[aj[ipos]];
+      }
+    }
+  }
+}
+
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+PETSC_KERNEL_TARGET_AVX512
+static void MatMultChunk_SeqAIJPERM_AVX512(PetscInt nz,PetscInt isize,const PetscInt *ip,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,PetscScalar *yp)
+{
+  PetscInt i,j,ipos;
+  __m512d  vec_x,vec_y,vec_vals;
+  __m256i  vec_idx,vec_ipos,vec_j;
+  __mmask8 mask;
+
+  if (nz > isize) {
+    for (i=0; i<isize; i++) {
+      vec_y = _mm512_setzero_pd();
+      ipos  = ip[i];
+      for (j=0; j<nz-7; j+=8) {
+        vec_idx  = _mm256_loadu_si256((__m256i const*)&aj[ipos+j]);
+        vec_vals = _mm512_loadu_pd(&aa[ipos+j]);
+        vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
+        vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
+      }
+      if (j < nz) { /* masked loads so nothing beyond the row is read */
+        mask     = (__mmask8)(0xff >> (8-(nz-j)));
+        vec_idx  = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32((__mmask16)mask,&aj[ipos+j]));
+        vec_vals = _mm512_maskz_loadu_pd(mask,&aa[ipos+j]);
+        vec_x    = _mm512_mask_i32gather_pd(_mm512_setzero_pd(),mask,vec_idx,x,_MM_SCALE_8);
+        vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
+      }
+      yp[i] += _mm512_reduce_add_pd(vec_y);
+    }
+  } else {
+    for (j=0; j<nz; j++) {
+      vec_j = _mm256_set1_epi32(j);
+      for (i=0; i<isize-7; i+=8) {
+        vec_y    = _mm512_loadu_pd(&yp[i]);
+        vec_ipos = _mm256_loadu_si256((__m256i const*)&ip[i]);
+        vec_ipos = _mm256_add_epi32(vec_ipos,vec_j);
+        vec_idx  = _mm256_i32gather_epi32(aj,vec_ipos,_MM_SCALE_4);
+        vec_vals = _mm512_i32gather_pd(vec_ipos,aa,_MM_SCALE_8);
+        vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
+        vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
+        _mm512_storeu_pd(&yp[i],vec_y);
+      }
+      for (; i<isize; i++) {
+        ipos   = ip[i] + j;
+        yp[i] += aa[ipos] * x[aj[ipos]];
+      }
+    }
+  }
+}
+#endif
+
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+PETSC_KERNEL_TARGET_AVX2
+static void MatMultChunk_SeqAIJPERM_AVX2(PetscInt nz,PetscInt isize,const PetscInt *ip,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,PetscScalar *yp)
+{
+  PetscInt i,j,ipos;
+  __m256d  vec_x,vec_y,vec_vals;
+  __m128d  vec_sum;
+  __m128i  vec_idx,vec_ipos,vec_j;
+
+  if (nz > isize) {
+    for (i=0; i<isize; i++) {
+      vec_y = _mm256_setzero_pd();
+      ipos  = ip[i];
+      for (j=0; j<nz-3; j+=4) {
+        vec_idx  = _mm_loadu_si128((__m128i const*)&aj[ipos+j]);
+        vec_vals = _mm256_loadu_pd(&aa[ipos+j]);
+        vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8);
+        vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y);
+      }
+      vec_sum = _mm_add_pd(_mm256_castpd256_pd128(vec_y),_mm256_extractf128_pd(vec_y,1));
+      vec_sum = _mm_add_sd(vec_sum,_mm_unpackhi_pd(vec_sum,vec_sum));
+      yp[i]  += _mm_cvtsd_f64(vec_sum);
+      for (; j<nz; j++) yp[i] += aa[ipos+j] * x[aj[ipos+j]];
+    }
+  } else {
+    for (j=0; j<nz; j++) {
+      vec_j = _mm_set1_epi32(j);
+      for (i=0; i<isize-3; i+=4) {
+        vec_y    = _mm256_loadu_pd(&yp[i]);
+        vec_ipos = _mm_loadu_si128((__m128i const*)&ip[i]);
+        vec_ipos = _mm_add_epi32(vec_ipos,vec_j);
+        vec_idx  = _mm_i32gather_epi32(aj,vec_ipos,_MM_SCALE_4);
+        vec_vals = _mm256_i32gather_pd(aa,vec_ipos,_MM_SCALE_8);
+        vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8);
+        vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y);
+        _mm256_storeu_pd(&yp[i],vec_y);
+      }
+      for (; i<isize; i++) {
+        ipos   = ip[i] + j;
+        yp[i] += aa[ipos] * x[aj[ipos]];
+      }
+    }
+  }
+}
+#endif
+
+PETSC_STATIC_INLINE void MatMultChunk_SeqAIJPERM(MatKernelISA isa,PetscInt nz,PetscInt isize,const PetscInt *ip,const PetscInt *aj,const MatScalar *aa,const PetscScalar *x,PetscScalar *yp)
+{
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+  if (isa == MAT_KERNEL_AVX512) {MatMultChunk_SeqAIJPERM_AVX512(nz,isize,ip,aj,aa,x,yp); return;}
+#endif
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+  if (isa == MAT_KERNEL_AVX2) {MatMultChunk_SeqAIJPERM_AVX2(nz,isize,ip,aj,aa,x,yp); return;}
+#endif
+  MatMultChunk_SeqAIJPERM_Scalar(nz,isize,ip,aj,aa,x,yp);
+}
+
 PetscErrorCode MatMult_SeqAIJPERM(Mat A,Vec xx,Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -299,12 +432,7 @@ PetscErrorCode MatMult_SeqAIJPERM(Mat A,Vec xx,Vec yy)
   PetscErrorCode    ierr;
   const PetscInt    *aj,*ai;
 #if !(defined(PETSC_USE_FORTRAN_KERNEL_MULTAIJPERM) && defined(notworking))
-  PetscInt          i,j;
-#endif
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m512d           vec_x,vec_y,vec_vals;
-  __m256i           vec_idx,vec_ipos,vec_j;
-  __mmask8           mask;
+  PetscInt          i;
 #endif
 
   /* Variables that don't appear in MatMult_SeqAIJ. */
@@ -389,77 +517,7 @@ PetscErrorCode MatMult_SeqAIJPERM(Mat A,Vec xx,Vec yy)
           yp[i] = (PetscScalar) 0.0;
         }
 
-        /* If the number of zeros per row exceeds the number of rows in
-         * the chunk, we should vectorize along nz, that is, perform the
-         * mat-vec one row at a time as in the usual CSR case. */
-        if (nz > isize) {
-#if defined(PETSC_HAVE_CRAY_VECTOR)
-#pragma _CRI preferstream
-#endif
-          for (i=0; i<isize; i++) {
-#if defined(PETSC_HAVE_CRAY_VECTOR)
-#pragma _CRI prefervector
-#endif
-
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-            vec_y = _mm512_setzero_pd();
-            ipos = ip[i];
-            for (j=0; j<(nz>>3); j++) {
-              vec_idx  = _mm256_loadu_si256((__m256i const*)&aj[ipos]);
-              vec_vals = _mm512_loadu_pd(&aa[ipos]);
-              vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
-              vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
-              ipos += 8;
-            }
-            if ((nz&0x07)>2) {
-              mask     = (__mmask8)(0xff >> (8-(nz&0x07)));
-              vec_idx  = _mm256_loadu_si256((__m256i const*)&aj[ipos]);
-              vec_vals = _mm512_loadu_pd(&aa[ipos]);
-              vec_x    = _mm512_mask_i32gather_pd(vec_x,mask,vec_idx,x,_MM_SCALE_8);
-              vec_y    = _mm512_mask3_fmadd_pd(vec_x,vec_vals,vec_y,mask);
-            } else if ((nz&0x07)==2) {
-              yp[i] += aa[ipos]*x[aj[ipos]];
-              yp[i] += aa[ipos+1]*x[aj[ipos+1]];
-            } else if ((nz&0x07)==1) {
-              yp[i] += aa[ipos]*x[aj[ipos]];
-            }
-            yp[i] += _mm512_reduce_add_pd(vec_y);
-#else
-            for (j=0; j<nz; j++) {
-              ipos   = ip[i] + j;
-              yp[i] += aa[ipos] * x[aj[ipos]];
-            }
-#endif
-          }
-        } else {
-          /* Otherwise, there are enough rows in the chunk to make it
-           * worthwhile to vectorize across the rows, that is, to do the
-           * matvec by operating with "columns" of the chunk. */
-          for (j=0; j<nz; j++) {
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-            vec_j = _mm256_set1_epi32(j);
-            for (i=0; i<((isize>>3)<<3); i+=8) {
-              vec_y    = _mm512_loadu_pd(&yp[i]);
-              vec_ipos = _mm256_loadu_si256((__m256i const*)&ip[i]);
-              vec_ipos = _mm256_add_epi32(vec_ipos,vec_j);
-              vec_idx  = _mm256_i32gather_epi32(aj,vec_ipos,_MM_SCALE_4);
-              vec_vals = _mm512_i32gather_pd(vec_ipos,aa,_MM_SCALE_8);
-              vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
-              vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
-              _mm512_storeu_pd(&yp[i],vec_y);
-            }
-            for (i=isize-(isize&0x07); i<isize; i++) {
-              ipos = ip[i]+j;
-              yp[i] += aa[ipos]*x[aj[ipos]];
-            }
-#else
-            for (i=0; i<isize; i++) {
-              ipos   = ip[i] + j;
-              yp[i] += aa[ipos] * x[aj[ipos]];
-            }
-#endif
-          }
-        }
+        MatMultChunk_SeqAIJPERM(a->kernelisa,nz,isize,ip,aj,aa,x,yp);
 
 #if defined(PETSC_HAVE_CRAY_VECTOR)
 #pragma _CRI ivdep
@@ -483,9 +541,6 @@ PetscErrorCode MatMult_SeqAIJPERM(Mat A,Vec xx,Vec yy)
  * Note that the names I used to designate the vectors differs from that
  * used in MatMultAdd_SeqAIJ().  I did this to keep my notation consistent
  * with the MatMult_SeqAIJPERM() routine, which is very similar to this one. */
-/*
-    I hate having virtually identical code for the mult and the multadd!!!
-*/
 PetscErrorCode MatMultAdd_SeqAIJPERM(Mat A,Vec xx,Vec ww,Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -495,7 +550,7 @@ PetscErrorCode MatMultAdd_SeqAIJPERM(Mat A,Vec xx,Vec ww,Vec yy)
   PetscErrorCode    ierr;
   const PetscInt    *aj,*ai;
 #if !defined(PETSC_USE_FORTRAN_KERNEL_MULTADDAIJPERM)
-  PetscInt i,j;
+  PetscInt i;
 #endif
 
   /* Variables that don't appear in MatMultAdd_SeqAIJ. */
@@ -587,34 +642,7 @@ PetscErrorCode MatMultAdd_SeqAIJPERM(Mat A,Vec xx,Vec ww,Vec yy)
           yp[i] = w[iold];
         }
 
-        /* If the number of zeros per row exceeds the number of rows in
-         * the chunk, we should vectorize along nz, that is, perform the
-         * mat-vec one row at a time as in the usual CSR case. */
-        if (nz > isize) {
-#if defined(PETSC_HAVE_CRAY_VECTOR)
-#pragma _CRI preferstream
-#endif
-          for (i=0; i<isize; i++) {
-#if defined(PETSC_HAVE_CRAY_VECTOR)
-#pragma _CRI prefervector
-#endif
-            for (j=0; j<nz; j++) {
-              ipos   = ip[i] + j;
-              yp[i] += aa[ipos] * x[aj[ipos]];
-            }
-          }
-        }
-        /* Otherwise, there are enough rows in the chunk to make it
-         * worthwhile to vectorize across the rows, that is, to do the
-         * matvec by operating with "columns" of the chunk. */
-        else {
-          for (j=0; j<nz; j++) {
-            for (i=0; i<isize; i++) {
-              ipos   = ip[i] + j;
-              yp[i] += aa[ipos] * x[aj[ipos]];
-            }
-          }
-        }
+        MatMultChunk_SeqAIJPERM(a->kernelisa,nz,isize,ip,aj,aa,x,yp);
 
 #if defined(PETSC_HAVE_CRAY_VECTOR)
 #pragma _CRI ivdep
@@ -707,6 +735,10 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat A,MatType type,MatR
    Output Parameter:
 .  A - the matrix
 
+   Options Database Keys:
++  -mat_kernel_isa <scalar,avx,avx2,avx512> - limits the instruction set of the matrix-vector product kernels, by default the most capable one supported by the processor is used
+-  -mat_view_kernel - prints the matrix-vector product kernels used, after each final assembly
+
    Notes:
    If nnz is given then nz is ignored
 
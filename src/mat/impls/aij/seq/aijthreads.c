@@ -0,0 +1,861 @@
+/*
+    Thread-parallel matrix-vector products for the SeqAIJ format, multicolor SOR sweeps, and
+  triangular solves with the LU and ICC factors of such matrices.
+
+    The rows are split into nthreads contiguous partitions containing roughly the same amount of
+  work (nonzeros plus one unit per row). Partition t is always processed by OpenMP thread t
+  (a static schedule with chunk size one), and MatAssemblyEnd_SeqAIJ_Threads() copies the i, j
+  and a arrays with that same schedule so that each page is first touched, and therefore placed,
+  on the NUMA domain of the thread that later streams it. Bind the threads with OMP_PROC_BIND
+  (or the MPI launcher) for the placement to be effective.
+
+    If PETSc is not configured with OpenMP the partitions are applied one after the other, which
+  gives the same results as the threaded code.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>          /*I "petscmat.h" I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/*
+   Splits the rows into a->threads.nthreads partitions and determines the columns each partition
+   references. Returns PETSC_TRUE in changed if the partition had to be (re)computed.
+*/
+static PetscErrorCode MatSeqAIJThreadsSetUp_Private(Mat A,PetscBool *changed)
+{
+  Mat_SeqAIJ     *a  = (Mat_SeqAIJ*)A->data;
+  PetscInt       nt  = a->threads.nthreads,m = A->rmap->n,n = A->cmap->n,t,r = 0,k,cmin,cmax;
+  const PetscInt *ai = a->i,*aj = a->j;
+  PetscInt64     total,target;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (changed) *changed = PETSC_FALSE;
+  if (a->threads.rstart && a->threads.mat_nonzerostate == A->nonzerostate && a->threads.nz == a->nz) PetscFunctionReturn(0);
+  if (!a->threads.rstart) {
+    ierr = PetscMalloc3(nt+1,&a->threads.rstart,nt,&a->threads.cstart,nt,&a->threads.cend);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(3*nt+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  }
+
+  /* balance the nonzeros plus one unit of work per row so that empty rows are not free */
+  total                = (PetscInt64)ai[m] + m;
+  a->threads.rstart[0] = 0;
+  for (t=1; t<nt; t++) {
+    target = (total*t)/nt;
+    while (r < m && (PetscInt64)ai[r] + r < target) r++;
+    a->threads.rstart[t] = r;
+  }
+  a->threads.rstart[nt] = m;
+
+  for (t=0; t<nt; t++) {
+    cmin = n; cmax = 0;
+    for (k=ai[a->threads.rstart[t]]; k<ai[a->threads.rstart[t+1]]; k++) {
+      cmin = PetscMin(cmin,aj[k]);
+      cmax = PetscMax(cmax,aj[k]+1);
+    }
+    if (cmin >= cmax) cmin = cmax = 0;
+    a->threads.cstart[t] = cmin;
+    a->threads.cend[t]   = cmax;
+  }
+  a->threads.nz               = a->nz;
+  a->threads.mat_nonzerostate = A->nonzerostate;
+  if (changed) *changed = PETSC_TRUE;
+  ierr = PetscInfo3(A,"Split %D rows into %D partitions for %D nonzeros\n",m,nt,a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Replaces the i, j and a arrays with copies made by the threads that will use them, so each
+   partition's pages are placed by the operating system near the thread that processes them
+*/
+static PetscErrorCode MatSeqAIJThreadsFirstTouch_Private(Mat A)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data;
+  PetscInt        nt = a->threads.nthreads,m = A->rmap->n,nz = a->nz,t;
+  const PetscInt  *rstart = a->threads.rstart,*ai = a->i,*aj = a->j;
+  const MatScalar *aa = a->a;
+  PetscInt        *new_i,*new_j;
+  MatScalar       *new_a;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  /* only arrays owned by this matrix in a single allocation can be moved */
+  if (!a->singlemalloc || !a->free_a || !a->free_ij || a->parent) PetscFunctionReturn(0);
+  ierr = PetscMalloc3(nz,&new_a,nz,&new_j,m+1,&new_i);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt r,k;
+    for (r=rstart[t]; r<rstart[t+1]; r++) new_i[r] = ai[r];
+    for (k=ai[rstart[t]]; k<ai[rstart[t+1]]; k++) {
+      new_j[k] = aj[k];
+      new_a[k] = aa[k];
+    }
+  }
+  new_i[m] = ai[m];
+  ierr     = MatSeqXAIJFreeAIJ(A,&a->a,&a->j,&a->i);CHKERRQ(ierr);
+  a->a     = new_a;
+  a->j     = new_j;
+  a->i     = new_i;
+  a->maxnz = nz;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJ_Threads(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const PetscInt    *rstart,*ii = a->i;
+  PetscInt          nt = a->threads.nthreads,t;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr   = MatSeqAIJThreadsSetUp_Private(A,NULL);CHKERRQ(ierr);
+  rstart = a->threads.rstart;
+  ierr   = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr   = VecGetArray(yy,&y);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    const PetscInt  *aj;
+    const MatScalar *aa;
+    PetscScalar     sum;
+    PetscInt        i,n;
+
+    for (i=rstart[t]; i<rstart[t+1]; i++) {
+      n   = ii[i+1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = a->a + ii[i];
+      sum = 0.0;
+      PetscSparseDensePlusDot(sum,x,aa,aj,n);
+      y[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  const PetscInt    *rstart,*ii = a->i;
+  PetscInt          nt = a->threads.nthreads,t;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr   = MatSeqAIJThreadsSetUp_Private(A,NULL);CHKERRQ(ierr);
+  rstart = a->threads.rstart;
+  ierr   = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr   = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    const PetscInt  *aj;
+    const MatScalar *aa;
+    PetscScalar     sum;
+    PetscInt        i,n;
+
+    for (i=rstart[t]; i<rstart[t+1]; i++) {
+      n   = ii[i+1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = a->a + ii[i];
+      sum = y[i];
+      PetscSparseDensePlusDot(sum,x,aa,aj,n);
+      z[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Each thread accumulates its rows' contributions into a private buffer restricted to the columns
+   its partition references; the buffers are then summed in the fixed order t = 0,1,... so the
+   result does not depend on thread timing.
+*/
+PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,*work;
+  const PetscScalar *x;
+  const PetscInt    *rstart,*cstart,*cend,*ii = a->i;
+  PetscInt          nt = a->threads.nthreads,n = A->cmap->n,t,c;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJThreadsSetUp_Private(A,NULL);CHKERRQ(ierr);
+  if (!a->threads.work) {
+    ierr = PetscMalloc1(nt*n,&a->threads.work);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,nt*n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  rstart = a->threads.rstart;
+  cstart = a->threads.cstart;
+  cend   = a->threads.cend;
+  work   = a->threads.work;
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(nt)
+#endif
+  {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static,1)
+#endif
+    for (t=0; t<nt; t++) {
+      PetscScalar     *w = work + t*n,alpha;
+      const PetscInt  *idx;
+      const MatScalar *v;
+      PetscInt        i,j,nz;
+
+      for (j=cstart[t]; j<cend[t]; j++) w[j] = 0.0;
+      for (i=rstart[t]; i<rstart[t+1]; i++) {
+        idx   = a->j + ii[i];
+        v     = a->a + ii[i];
+        nz    = ii[i+1] - ii[i];
+        alpha = x[i];
+        for (j=0; j<nz; j++) w[idx[j]] += alpha*v[j];
+      }
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (c=0; c<n; c++) {
+      PetscInt s;
+      for (s=0; s<nt; s++) {
+        if (c >= cstart[s] && c < cend[s]) y[c] += work[s*n+c];
+      }
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultTranspose_SeqAIJ_Threads(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(yy,0.0);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd_SeqAIJ_Threads(A,xx,yy,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Level-scheduled triangular solves with the factors of MATSEQAIJ matrices
+
+   Row i of a lower (upper) triangular factor can be computed once all the rows it references are, so the rows are
+   grouped into levels: level(i) = 1 + max level(j) over the columns j of row i. The rows of a level are independent
+   and are split among the threads, with a barrier between levels. Copies of the factors are kept with the rows of
+   each level contiguous in memory, written by the threads that later read them, in the form
+
+     x[row[p]] = (x[row[p]] - sum_k a[k] x[j[k]]) * d[p]
+
+   so that the forward and backward solves of LU (and of ICC) and of their transposes all use the same kernel. The
+   copies are rebuilt when the factor changes, the transposed ones only when MatSolveTranspose() is used.
+*/
+typedef struct {
+  PetscInt  nlevels;
+  PetscInt  *lstart;                               /* positions of the rows of level l are lstart[l] to lstart[l+1]-1 */
+  PetscInt  *row;                                  /* row at each position */
+  PetscInt  *i,*j;                                 /* entries of the row at position p are i[p] to i[p+1]-1 */
+  MatScalar *a;
+  MatScalar *d;                                    /* scaling of the row at each position, NULL for one */
+} Mat_SeqAIJ_LevelSolve;
+
+typedef struct {
+  PetscInt              nthreads;
+  PetscObjectState      state,tstate;              /* state of the factor when the copies were built */
+  Mat_SeqAIJ_LevelSolve lower,upper;               /* the factors, in the order they are applied by MatSolve() */
+  Mat_SeqAIJ_LevelSolve tlower,tupper;             /* the transposed factors, in the order of MatSolveTranspose() */
+} Mat_SeqAIJ_LevelSolves;
+
+static PetscErrorCode MatSeqAIJLevelSolveReset_Private(Mat_SeqAIJ_LevelSolve *T)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(T->lstart,T->row,T->i);CHKERRQ(ierr);
+  ierr = PetscFree2(T->j,T->a);CHKERRQ(ierr);
+  ierr = PetscFree(T->d);CHKERRQ(ierr);
+  T->nlevels = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJLevelSolvesDestroy_Private(void *ptr)
+{
+  Mat_SeqAIJ_LevelSolves *ls = (Mat_SeqAIJ_LevelSolves*)ptr;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJLevelSolveReset_Private(&ls->lower);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelSolveReset_Private(&ls->upper);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelSolveReset_Private(&ls->tlower);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelSolveReset_Private(&ls->tupper);CHKERRQ(ierr);
+  ierr = PetscFree(ls);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Builds the level-ordered copy of a triangular matrix of n rows, where row r has the entries rs[r] to re[r]-1 of
+   aj[] and alpha*aa[], and is scaled by d[r] (if d is not NULL)
+*/
+static PetscErrorCode MatSeqAIJLevelSolveSetUp_Private(PetscInt n,PetscBool lower,const PetscInt rs[],const PetscInt re[],const PetscInt aj[],const MatScalar aa[],PetscScalar alpha,const MatScalar d[],PetscInt nt,Mat_SeqAIJ_LevelSolve *T)
+{
+  PetscInt       *level,*pos,r,k,l,p,nlevels = 0,nz = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJLevelSolveReset_Private(T);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&level);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    r        = lower ? k : n-1-k;
+    level[r] = 0;
+    for (p=rs[r]; p<re[r]; p++) level[r] = PetscMax(level[r],level[aj[p]]+1);
+    nlevels  = PetscMax(nlevels,level[r]+1);
+    nz      += re[r] - rs[r];
+  }
+  ierr = PetscMalloc3(nlevels+1,&T->lstart,n,&T->row,n+1,&T->i);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nz,&T->j,nz,&T->a);CHKERRQ(ierr);
+  if (d) {ierr = PetscMalloc1(n,&T->d);CHKERRQ(ierr);}
+  T->nlevels = nlevels;
+  ierr = PetscCalloc1(nlevels+1,&pos);CHKERRQ(ierr);
+  for (r=0; r<n; r++) pos[level[r]+1]++;
+  for (l=0; l<nlevels; l++) pos[l+1] += pos[l];
+  ierr = PetscMemcpy(T->lstart,pos,(nlevels+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (r=0; r<n; r++) T->row[pos[level[r]]++] = r;
+  T->i[0] = 0;
+  for (p=0; p<n; p++) T->i[p+1] = T->i[p] + re[T->row[p]] - rs[T->row[p]];
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+  ierr = PetscFree(level);CHKERRQ(ierr);
+
+  /* copy the entries with the schedule of the solves so that they are placed near the threads that use them */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(nt) private(l)
+#endif
+  for (l=0; l<nlevels; l++) {
+    PetscInt q,k,row;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (q=T->lstart[l]; q<T->lstart[l+1]; q++) {
+      row = T->row[q];
+      for (k=0; k<T->i[q+1]-T->i[q]; k++) {
+        T->j[T->i[q]+k] = aj[rs[row]+k];
+        T->a[T->i[q]+k] = alpha*aa[rs[row]+k];
+      }
+      if (d) T->d[q] = d[row];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Transposes the n rows of a triangular matrix given as in MatSeqAIJLevelSolveSetUp_Private(), multiplying the
+   entries of row r by alpha*s[r] (or alpha if s is NULL)
+*/
+static PetscErrorCode MatSeqAIJLevelSolveTranspose_Private(PetscInt n,const PetscInt rs[],const PetscInt re[],const PetscInt aj[],const MatScalar aa[],PetscScalar alpha,const MatScalar s[],PetscInt **ti,PetscInt **tj,MatScalar **ta)
+{
+  PetscInt       *Ti,*Tj,*pos,r,p,k;
+  MatScalar      *Ta;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(n+1,&Ti);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&pos);CHKERRQ(ierr);
+  for (r=0; r<n; r++) {
+    for (p=rs[r]; p<re[r]; p++) Ti[aj[p]+1]++;
+  }
+  for (r=0; r<n; r++) {
+    Ti[r+1] += Ti[r];
+    pos[r]   = Ti[r];
+  }
+  ierr = PetscMalloc2(Ti[n],&Tj,Ti[n],&Ta);CHKERRQ(ierr);
+  for (r=0; r<n; r++) {
+    for (p=rs[r]; p<re[r]; p++) {
+      k     = pos[aj[p]]++;
+      Tj[k] = r;
+      Ta[k] = s ? alpha*s[r]*aa[p] : alpha*aa[p];
+    }
+  }
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+  *ti = Ti; *tj = Tj; *ta = Ta;
+  PetscFunctionReturn(0);
+}
+
+/* Solves in place with a level-ordered triangular matrix, called by all the threads of a parallel region */
+PETSC_STATIC_INLINE void MatSeqAIJLevelSolveApply_Private(const Mat_SeqAIJ_LevelSolve *T,PetscScalar x[])
+{
+  const PetscInt  *row = T->row,*ti = T->i,*tj = T->j;
+  const MatScalar *ta = T->a,*td = T->d;
+  PetscScalar     sum;
+  PetscInt        l,p,nz;
+
+  for (l=0; l<T->nlevels; l++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (p=T->lstart[l]; p<T->lstart[l+1]; p++) {
+      const PetscInt  *vi = tj + ti[p];
+      const MatScalar *v  = ta + ti[p];
+      nz  = ti[p+1] - ti[p];
+      sum = x[row[p]];
+      PetscSparseDenseMinusDot(sum,x,v,vi,nz);
+      x[row[p]] = td ? sum*td[p] : sum;
+    }
+  }
+}
+
+/*
+   Returns the level-ordered copies of the factor, (re)building those needed by MatSolve(), or by MatSolveTranspose()
+   if transpose is set, when the factor has changed since they were built
+*/
+static PetscErrorCode MatSeqAIJGetLevelSolves_Private(Mat B,PetscBool transpose,Mat_SeqAIJ_LevelSolves **levels)
+{
+  Mat_SeqAIJ             *b = (Mat_SeqAIJ*)B->data;  /* also the layout of the Mat_SeqSBAIJ used for ICC factors */
+  PetscInt               n = B->rmap->n,*ai = b->i,*aj = b->j,*adiag = b->diag,*rs,*re,*ti,*tj,r;
+  MatScalar              *aa = b->a,*d,*ta;
+  PetscObjectState       state;
+  PetscContainer         container;
+  Mat_SeqAIJ_LevelSolves *ls;
+  PetscBool              icc = (PetscBool)(B->factortype == MAT_FACTOR_ICC || B->factortype == MAT_FACTOR_CHOLESKY);
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)B,"MatSeqAIJLevelSolves",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Factor has no thread-parallel triangular solves");
+  ierr = PetscContainerGetPointer(container,(void**)&ls);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)B,&state);CHKERRQ(ierr);
+  *levels = ls;
+  if (transpose ? ls->tstate == state : ls->state == state) PetscFunctionReturn(0);
+
+  /* rows of the strictly triangular parts, and the inverses of the diagonal */
+  ierr = PetscMalloc3(n,&rs,n,&re,n,&d);CHKERRQ(ierr);
+  for (r=0; r<n; r++) {
+    if (icc) {
+      rs[r] = ai[r];
+      re[r] = ai[r+1]-1;
+      d[r]  = aa[ai[r+1]-1];
+    } else {
+      rs[r] = adiag[r+1]+1;
+      re[r] = adiag[r];
+      d[r]  = aa[adiag[r]];
+    }
+  }
+  if (!transpose) {
+    if (icc) {
+      /* U^T D y = b with U^T scattered, that is row r of U^T is column r of U, on the unscaled y[i]/d[i] */
+      for (r=0; r<n; r++) d[r] = 1.0/d[r];
+      ierr = MatSeqAIJLevelSolveTranspose_Private(n,rs,re,aj,aa,-1.0,d,&ti,&tj,&ta);CHKERRQ(ierr);
+      for (r=0; r<n; r++) d[r] = 1.0/d[r];
+      ierr = MatSeqAIJLevelSolveSetUp_Private(n,PETSC_TRUE,ti,ti+1,tj,ta,1.0,d,ls->nthreads,&ls->lower);CHKERRQ(ierr);
+      ierr = PetscFree(ti);CHKERRQ(ierr);
+      ierr = PetscFree2(tj,ta);CHKERRQ(ierr);
+      /* U x = y, the off-diagonal entries of ICC factors are stored negated */
+      ierr = MatSeqAIJLevelSolveSetUp_Private(n,PETSC_FALSE,rs,re,aj,aa,-1.0,NULL,ls->nthreads,&ls->upper);CHKERRQ(ierr);
+    } else {
+      ierr = MatSeqAIJLevelSolveSetUp_Private(n,PETSC_TRUE,ai,ai+1,aj,aa,1.0,NULL,ls->nthreads,&ls->lower);CHKERRQ(ierr);
+      ierr = MatSeqAIJLevelSolveSetUp_Private(n,PETSC_FALSE,rs,re,aj,aa,1.0,d,ls->nthreads,&ls->upper);CHKERRQ(ierr);
+    }
+    ls->state = state;
+  } else {
+    /* U^T y = b then L^T x = y, only needed for LU since ICC factors are symmetric */
+    ierr = MatSeqAIJLevelSolveTranspose_Private(n,rs,re,aj,aa,1.0,NULL,&ti,&tj,&ta);CHKERRQ(ierr);
+    ierr = MatSeqAIJLevelSolveSetUp_Private(n,PETSC_TRUE,ti,ti+1,tj,ta,1.0,d,ls->nthreads,&ls->tlower);CHKERRQ(ierr);
+    ierr = PetscFree(ti);CHKERRQ(ierr);
+    ierr = PetscFree2(tj,ta);CHKERRQ(ierr);
+    ierr = MatSeqAIJLevelSolveTranspose_Private(n,ai,ai+1,aj,aa,1.0,NULL,&ti,&tj,&ta);CHKERRQ(ierr);
+    ierr = MatSeqAIJLevelSolveSetUp_Private(n,PETSC_FALSE,ti,ti+1,tj,ta,1.0,NULL,ls->nthreads,&ls->tupper);CHKERRQ(ierr);
+    ierr = PetscFree(ti);CHKERRQ(ierr);
+    ierr = PetscFree2(tj,ta);CHKERRQ(ierr);
+    ls->tstate = state;
+  }
+  ierr = PetscFree3(rs,re,d);CHKERRQ(ierr);
+  ierr = PetscInfo4(B,"%D rows in %D levels for the forward solve and %D levels for the backward solve with %D threads\n",n,transpose ? ls->tlower.nlevels : ls->lower.nlevels,transpose ? ls->tupper.nlevels : ls->upper.nlevels,ls->nthreads);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Computes x[outperm[i]] = inv(upper) inv(lower) b[inperm[i]] */
+static PetscErrorCode MatSolve_SeqAIJ_Levels_Private(Mat B,const Mat_SeqAIJ_LevelSolve *lower,const Mat_SeqAIJ_LevelSolve *upper,PetscInt nt,IS inperm,IS outperm,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *b = (Mat_SeqAIJ*)B->data;
+  PetscInt          n = B->rmap->n,i;
+  const PetscInt    *ip,*op;
+  PetscScalar       *x,*t = b->solve_work;
+  const PetscScalar *bv;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&bv);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(inperm,&ip);CHKERRQ(ierr);
+  ierr = ISGetIndices(outperm,&op);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(nt)
+#endif
+  {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) t[i] = bv[ip[i]];
+    MatSeqAIJLevelSolveApply_Private(lower,t);
+    MatSeqAIJLevelSolveApply_Private(upper,t);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) x[op[i]] = t[i];
+  }
+  ierr = ISRestoreIndices(inperm,&ip);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(outperm,&op);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&bv);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*(lower->i[n]+upper->i[n]) + (lower->d ? n : 0) + (upper->d ? n : 0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_Levels(Mat B,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ             *b = (Mat_SeqAIJ*)B->data;
+  Mat_SeqAIJ_LevelSolves *ls;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetLevelSolves_Private(B,PETSC_FALSE,&ls);CHKERRQ(ierr);
+  if (B->factortype == MAT_FACTOR_ICC || B->factortype == MAT_FACTOR_CHOLESKY) {
+    /* ICC factors are stored in a Mat_SeqSBAIJ, with the symmetric permutation in row */
+    ierr = MatSolve_SeqAIJ_Levels_Private(B,&ls->lower,&ls->upper,ls->nthreads,b->row,b->row,bb,xx);CHKERRQ(ierr);
+  } else {
+    ierr = MatSolve_SeqAIJ_Levels_Private(B,&ls->lower,&ls->upper,ls->nthreads,b->row,b->col,bb,xx);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolveTranspose_SeqAIJ_Levels(Mat B,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ             *b = (Mat_SeqAIJ*)B->data;
+  Mat_SeqAIJ_LevelSolves *ls;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetLevelSolves_Private(B,PETSC_TRUE,&ls);CHKERRQ(ierr);
+  ierr = MatSolve_SeqAIJ_Levels_Private(B,&ls->tlower,&ls->tupper,ls->nthreads,b->col,b->row,bb,xx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatFactorSetUpThreads_SeqAIJ - Called at the end of the numeric factorization into B; if nthreads is larger than one,
+   usually the number of threads of the products of the factored matrix, the solves with B use that many threads
+*/
+PetscErrorCode MatFactorSetUpThreads_SeqAIJ(Mat B,PetscInt nthreads)
+{
+  PetscContainer         container;
+  Mat_SeqAIJ_LevelSolves *ls;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) PetscFunctionReturn(0);
+  ierr = PetscObjectQuery((PetscObject)B,"MatSeqAIJLevelSolves",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) {
+    ierr = PetscNew(&ls);CHKERRQ(ierr);
+    ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(container,ls);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(container,MatSeqAIJLevelSolvesDestroy_Private);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject)B,"MatSeqAIJLevelSolves",(PetscObject)container);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  } else {
+    ierr = PetscContainerGetPointer(container,(void**)&ls);CHKERRQ(ierr);
+  }
+  ls->nthreads = nthreads;
+  ls->state    = ls->tstate = -1;
+  if (B->factortype == MAT_FACTOR_ICC || B->factortype == MAT_FACTOR_CHOLESKY) {
+    B->ops->solve          = MatSolve_SeqAIJ_Levels;
+    B->ops->solvetranspose = MatSolve_SeqAIJ_Levels;
+  } else {
+    B->ops->solve          = MatSolve_SeqAIJ_Levels;
+    B->ops->solvetranspose = MatSolveTranspose_SeqAIJ_Levels;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Multicolor SOR sweeps, see MatSORSetMulticolor(). Sets done to PETSC_FALSE, without doing anything, if the
+   coloring does not separate the coupled rows so that the caller falls back to the sequential sweeps.
+*/
+PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx,PetscBool *done)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *b;
+  PetscScalar       *x;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  ierr  = MatSORMulticolorSetUp_Private(A,1,A->rmap->n,a->i,a->j,a->a,&a->sormc);CHKERRQ(ierr);
+  if (!a->sormc.valid) PetscFunctionReturn(0);
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = MatSORMulticolorApply_Private(&a->sormc,omega,flag,its*lits,a->idiag,b,x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSORSetMulticolor_SeqAIJ(Mat A,PetscInt nthreads)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSORMulticolorSetNumThreads_Private(A,nthreads,&a->sormc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJThreadsReset_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(a->threads.rstart,a->threads.cstart,a->threads.cend);CHKERRQ(ierr);
+  ierr = PetscFree(a->threads.work);CHKERRQ(ierr);
+  a->threads.nz               = 0;
+  a->threads.mat_nonzerostate = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Installs the threaded products, once, saving the ones they replace. Subtypes such as MATSEQAIJPERM call
+   MatAssemblyEnd_SeqAIJ() and install their own products, those are kept.
+*/
+static PetscErrorCode MatSeqAIJThreadsSetOps_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscBool      isseqaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (A->ops->mult == MatMult_SeqAIJ_Threads) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij) {
+    ierr = PetscInfo1(A,"Keeping the matrix-vector products of type %s\n",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  a->threads.mult             = A->ops->mult;
+  a->threads.multadd          = A->ops->multadd;
+  a->threads.multtranspose    = A->ops->multtranspose;
+  a->threads.multtransposeadd = A->ops->multtransposeadd;
+  A->ops->mult                = MatMult_SeqAIJ_Threads;
+  A->ops->multadd             = MatMultAdd_SeqAIJ_Threads;
+  A->ops->multtranspose       = MatMultTranspose_SeqAIJ_Threads;
+  A->ops->multtransposeadd    = MatMultTransposeAdd_SeqAIJ_Threads;
+  PetscFunctionReturn(0);
+}
+
+/* puts back the products saved by MatSeqAIJThreadsSetOps_Private() */
+static PetscErrorCode MatSeqAIJThreadsRestoreOps_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data;
+
+  PetscFunctionBegin;
+  if (A->ops->mult != MatMult_SeqAIJ_Threads) PetscFunctionReturn(0);
+  A->ops->mult             = a->threads.mult;
+  A->ops->multadd          = a->threads.multadd;
+  A->ops->multtranspose    = a->threads.multtranspose;
+  A->ops->multtransposeadd = a->threads.multtransposeadd;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJ_Threads(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscBool      changed;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (a->threads.nthreads < 2 || A->factortype || A->structure_only) PetscFunctionReturn(0);
+  ierr = MatSeqAIJThreadsSetUp_Private(A,&changed);CHKERRQ(ierr);
+  if (changed) {
+    ierr = MatSeqAIJThreadsFirstTouch_Private(A);CHKERRQ(ierr);
+  }
+  ierr = MatSeqAIJThreadsSetOps_Private(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_Threads(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (a->threads.nthreads < 2) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL || format == PETSC_VIEWER_ASCII_INFO) {
+      ierr = PetscViewerASCIIPrintf(viewer,"using %D threads for matrix-vector products\n",a->threads.nthreads);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJ_Threads(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJThreadsReset_Private(A);CHKERRQ(ierr);
+  ierr = MatSORMulticolorReset_Private(&a->sormc);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetNumThreads_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSORSetMulticolor_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDuplicate_SeqAIJ_Threads(Mat A,MatDuplicateOption cpvalues,Mat *C)
+{
+  Mat            B  = *C;
+  Mat_SeqAIJ     *c = (Mat_SeqAIJ*)B->data,*a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJThreadsReset_Private(B);CHKERRQ(ierr);
+  c->threads.nthreads = a->threads.nthreads;
+  ierr = MatSORMulticolorSetNumThreads_Private(B,a->sormc.nthreads,&c->sormc);CHKERRQ(ierr);
+  if (c->threads.nthreads > 1 && !B->factortype) {
+    ierr = MatSeqAIJThreadsSetOps_Private(B);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJSetNumThreads_SeqAIJ(Mat A,PetscInt nthreads)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nthreads == PETSC_DEFAULT || nthreads == PETSC_DECIDE) {
+#if defined(PETSC_HAVE_OPENMP)
+    nthreads = omp_get_max_threads();
+#else
+    nthreads = 1;
+#endif
+  }
+  if (nthreads < 1) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",nthreads);
+  if (nthreads == a->threads.nthreads) PetscFunctionReturn(0);
+  ierr = MatSeqAIJThreadsReset_Private(A);CHKERRQ(ierr);
+  a->threads.nthreads = nthreads;
+#if !defined(PETSC_HAVE_OPENMP)
+  if (nthreads > 1) {
+    ierr = PetscInfo1(A,"PETSc was not configured with OpenMP, the %D partitions are applied sequentially\n",nthreads);CHKERRQ(ierr);
+  }
+#endif
+  if (A->assembled) {
+    if (nthreads > 1) {
+      ierr = MatAssemblyEnd_SeqAIJ_Threads(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    } else if (!A->factortype) {
+      ierr = MatSeqAIJThreadsRestoreOps_Private(A);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSeqAIJSetNumThreads - Sets the number of threads used by the matrix-vector products of a MATSEQAIJ matrix
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+-  nthreads - the number of threads, or PETSC_DECIDE to use the OpenMP default
+
+   Options Database Keys:
+.  -mat_seqaij_threads <nthreads> - sets the number of threads
+
+   Level: intermediate
+
+   Notes:
+   The rows are split into nthreads contiguous partitions with about the same number of nonzeros. MatMult(),
+   MatMultAdd(), MatMultTranspose() and MatMultTransposeAdd() apply each partition with its own OpenMP thread, and
+   MatAssemblyEnd() copies the matrix entries with the same threads so they are placed in the memory nearest to them
+   (first-touch placement). Threads should be bound to cores, for example with OMP_PROC_BIND=close, for this to help.
+
+   MatMultTranspose() uses one work vector of the length of the number of columns per thread, its reduction is done
+   in a fixed order so the results are reproducible from run to run with the same number of threads.
+
+   The LU, ILU, Cholesky and ICC factors computed from the matrix use the same number of threads in MatSolve() and
+   MatSolveTranspose(). The rows of each triangular factor are grouped into levels of rows that do not depend on each
+   other, the threads share each level and synchronize between levels, so the speedup depends on the number of rows
+   per level; the number of levels is reported with -info.
+
+   If PETSc was not configured with OpenMP the partitions are processed sequentially.
+
+.seealso: MatCreateSeqAIJ(), MatMult(), MatMultTranspose(), MatSolve()
+@*/
+PetscErrorCode MatSeqAIJSetNumThreads(Mat A,PetscInt nthreads)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveInt(A,nthreads,2);
+  ierr = PetscTryMethod(A,"MatSeqAIJSetNumThreads_C",(Mat,PetscInt),(A,nthreads));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatCreate_SeqAIJ_Threads is a helper for the MATSEQAIJ class, like MatCreate_SeqAIJ_Inode() */
+PetscErrorCode MatCreate_SeqAIJ_Threads(Mat B)
+{
+  Mat_SeqAIJ     *b = (Mat_SeqAIJ*)B->data;
+  PetscInt       nthreads = 1,sorthreads = 0;
+  PetscBool      flg,sorflg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  b->threads.nthreads         = 1;
+  b->threads.rstart           = NULL;
+  b->threads.cstart           = NULL;
+  b->threads.cend             = NULL;
+  b->threads.work             = NULL;
+  b->threads.nz               = 0;
+  b->threads.mat_nonzerostate = 0;
+  b->threads.mult             = NULL;
+  b->threads.multadd          = NULL;
+  b->threads.multtranspose    = NULL;
+  b->threads.multtransposeadd = NULL;
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetNumThreads_C",MatSeqAIJSetNumThreads_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSORSetMulticolor_C",MatSORSetMulticolor_SeqAIJ);CHKERRQ(ierr);
+
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"Options for SEQAIJ matrix","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_seqaij_threads","Number of threads used by the matrix-vector products","MatSeqAIJSetNumThreads",nthreads,&nthreads,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_sor_multicolor","Number of threads of the multicolor SOR sweeps","MatSORSetMulticolor",sorthreads,&sorthreads,&sorflg);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatSeqAIJSetNumThreads_SeqAIJ(B,nthreads);CHKERRQ(ierr);
+  }
+  if (sorflg) {
+    ierr = MatSORMulticolorSetNumThreads_Private(B,sorthreads,&b->sormc);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
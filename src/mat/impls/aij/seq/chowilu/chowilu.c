@@ -0,0 +1,552 @@
+
+/*
+   Fine-grained iterative ILU factorization of SeqAIJ matrices by the fixed-point sweeps of
+
+     E. Chow and A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput. 37 (2015)
+
+   with the triangular solves approximated by Jacobi iterations, so that both the factorization and its application
+   are loops over independent entries or rows that are split among OpenMP threads.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/*MC
+  MATSOLVERCHOWILU - Iterative, thread-parallel ILU(k) factorization of MATSEQAIJ matrices
+
+  The nonzero pattern of the factors is that of the PETSc ILU(k) factorization, but their entries are computed by a few
+  fixed-point sweeps in which every entry of L and U is updated independently from the previous iterate, and each
+  triangular solve in MatSolve() is replaced by a few Jacobi iterations. Both are split among OpenMP threads, so the
+  setup and application of PCILU scale with the number of cores, and a refactorization with the same nonzero pattern
+  only costs the sweeps.
+
+  Options Database Keys:
++ -pc_factor_levels <k> - number of levels of fill
+. -mat_chowilu_factor_sweeps <3> - number of fixed-point sweeps of the factorization
+. -mat_chowilu_solve_sweeps <3> - number of Jacobi iterations of each triangular solve, 0 solves exactly
+- -mat_chowilu_threads <n> - number of OpenMP threads of the factorization and solves, by default that of -mat_seqaij_threads
+
+  Level: intermediate
+
+  Notes:
+    Use it with -pc_type ilu -pc_factor_mat_solver_type chowilu, also as a subdomain solver of PCBJACOBI and PCASM.
+    The factors converge to those of MATSOLVERPETSC as the number of sweeps grows, and the iterates do not depend on
+    the number of threads. Since the Jacobi iterations make MatSolve() only an approximation of the solve with the
+    computed factors, MatSolveTranspose() applies the same iterations to the transposed factors, which is the transpose of
+    MatSolve() as required by KSPBICG, and -mat_chowilu_solve_sweeps 0 makes both exact. Diagonal shifts are not supported; orderings that make
+    the matrix more diagonally dominant, and a diagonal scaling of the matrix, speed up the convergence of the sweeps.
+
+.seealso: PCFactorSetMatSolverType(), MatSolverType, PCFactorSetLevels(), PCILU, PCCHOWILUVIENNACL
+M*/
+
+typedef struct {
+  PetscInt    factor_sweeps,solve_sweeps,nthreads;
+  PetscBool   nthreadsset;         /* -mat_chowilu_threads was given, otherwise the threads of the matrix are used */
+  PetscInt    nzl,nzu;             /* entries of L without its unit diagonal, entries of U with its diagonal */
+  PetscInt    *ui,*uj;             /* U by columns, the rows of column j are uj[ui[j]] to uj[ui[j+1]-1], the diagonal last */
+  PetscInt    *upos;               /* position in the factor of each entry of U by columns */
+  PetscInt    *li,*lj,*lpos;       /* L by columns, for MatSolveTranspose() */
+  PetscInt    *apos;               /* position in av[] of each entry of the matrix */
+  MatScalar   *av;                 /* the permuted matrix on the pattern of the factors, L by rows then U by columns */
+  MatScalar   *f[2];               /* the iterates of the factors, laid out as av[] */
+  PetscScalar *work;               /* two vectors for the Jacobi iterations */
+} Mat_SeqAIJ_ChowILU;
+
+static PetscErrorCode MatChowILUReset_Private(Mat_SeqAIJ_ChowILU *chow)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(chow->ui,chow->uj,chow->upos);CHKERRQ(ierr);
+  ierr = PetscFree3(chow->li,chow->lj,chow->lpos);CHKERRQ(ierr);
+  ierr = PetscFree(chow->apos);CHKERRQ(ierr);
+  ierr = PetscFree3(chow->av,chow->f[0],chow->f[1]);CHKERRQ(ierr);
+  ierr = PetscFree(chow->work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatChowILUDestroy_Private(void *ptr)
+{
+  Mat_SeqAIJ_ChowILU *chow = (Mat_SeqAIJ_ChowILU*)ptr;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatChowILUReset_Private(chow);CHKERRQ(ierr);
+  ierr = PetscFree(chow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatChowILUGetContext_Private(Mat B,Mat_SeqAIJ_ChowILU **chow)
+{
+  PetscContainer container;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)B,"MatChowILU",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Factor was not created by MatGetFactor() with MATSOLVERCHOWILU");
+  ierr = PetscContainerGetPointer(container,(void**)chow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Sum of lv[k]*uv[l] over the pairs with lj[k] == uj[l], both lists being sorted */
+PETSC_STATIC_INLINE PetscScalar MatChowILUSparseDot_Private(PetscInt nl,const PetscInt *lj,const MatScalar *lv,PetscInt nu,const PetscInt *uj,const MatScalar *uv,PetscLogDouble *flops)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    k = 0,l = 0;
+
+  while (k < nl && l < nu) {
+    if (lj[k] < uj[l]) k++;
+    else if (lj[k] > uj[l]) l++;
+    else {
+      sum    += lv[k++]*uv[l++];
+      *flops += 2.0;
+    }
+  }
+  return sum;
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_ChowILU(Mat B,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ         *b = (Mat_SeqAIJ*)B->data;
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscInt           n = B->rmap->n,sweeps,nt;
+  const PetscInt     *bi = b->i,*bj = b->j,*adiag = b->diag,*r,*c;
+  const MatScalar    *aa = b->a;
+  PetscScalar        *t = b->solve_work,*x;
+  const PetscScalar  *bv;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr   = MatChowILUGetContext_Private(B,&chow);CHKERRQ(ierr);
+  sweeps = chow->solve_sweeps;
+  nt     = chow->nthreads;
+  ierr   = VecGetArrayRead(bb,&bv);CHKERRQ(ierr);
+  ierr   = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr   = ISGetIndices(b->row,&r);CHKERRQ(ierr);
+  ierr   = ISGetIndices(b->col,&c);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(nt)
+#endif
+  {
+    PetscScalar     *y = chow->work,*ynew = chow->work + n,*tmp,sum;
+    const MatScalar *v;
+    const PetscInt  *vi;
+    PetscInt        i,s,nz;
+
+    /* L y = b by Jacobi iterations y <- b - (L - I) y starting from y = b */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) t[i] = y[i] = bv[r[i]];
+    for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        v   = aa + bi[i];
+        vi  = bj + bi[i];
+        nz  = bi[i+1] - bi[i];
+        sum = t[i];
+        PetscSparseDenseMinusDot(sum,y,v,vi,nz);
+        ynew[i] = sum;
+      }
+      tmp = y; y = ynew; ynew = tmp;
+    }
+
+    /* U x = y by Jacobi iterations x <- D^{-1} (y - (U - D) x) starting from x = D^{-1} y */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) {
+      t[i]    = y[i];
+      ynew[i] = aa[adiag[i]]*y[i];
+    }
+    tmp = y; y = ynew; ynew = tmp;
+    for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        v   = aa + adiag[i+1] + 1;
+        vi  = bj + adiag[i+1] + 1;
+        nz  = adiag[i] - adiag[i+1] - 1;
+        sum = t[i];
+        PetscSparseDenseMinusDot(sum,y,v,vi,nz);
+        ynew[i] = aa[adiag[i]]*sum;
+      }
+      tmp = y; y = ynew; ynew = tmp;
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) x[c[i]] = y[i];
+  }
+  ierr = ISRestoreIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&bv);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(sweeps*(2.0*(chow->nzl + chow->nzu - n) + n) + n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The transpose of MatSolve_SeqAIJ_ChowILU(): Jacobi iterations with U^T and then L^T, accessed by rows through the
+   factors by columns
+*/
+static PetscErrorCode MatSolveTranspose_SeqAIJ_ChowILU(Mat B,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ         *b = (Mat_SeqAIJ*)B->data;
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscInt           n = B->rmap->n,sweeps,nt;
+  const PetscInt     *adiag = b->diag,*r,*c;
+  const MatScalar    *aa = b->a;
+  PetscScalar        *t = b->solve_work,*x;
+  const PetscScalar  *bv;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr   = MatChowILUGetContext_Private(B,&chow);CHKERRQ(ierr);
+  sweeps = chow->solve_sweeps;
+  nt     = chow->nthreads;
+  ierr   = VecGetArrayRead(bb,&bv);CHKERRQ(ierr);
+  ierr   = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr   = ISGetIndices(b->row,&r);CHKERRQ(ierr);
+  ierr   = ISGetIndices(b->col,&c);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(nt)
+#endif
+  {
+    const PetscInt *ui = chow->ui,*uj = chow->uj,*upos = chow->upos,*li = chow->li,*lj = chow->lj,*lpos = chow->lpos;
+    PetscScalar    *y = chow->work,*ynew = chow->work + n,*tmp,sum;
+    PetscInt       i,q,s;
+
+    /* U^T y = b by Jacobi iterations y <- D^{-1} (b - (U - D)^T y) starting from y = D^{-1} b */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) {
+      t[i] = bv[c[i]];
+      y[i] = aa[adiag[i]]*t[i];
+    }
+    for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        sum = t[i];
+        for (q=ui[i]; q<ui[i+1]-1; q++) sum -= aa[upos[q]]*y[uj[q]];
+        ynew[i] = aa[adiag[i]]*sum;
+      }
+      tmp = y; y = ynew; ynew = tmp;
+    }
+
+    /* L^T x = y by Jacobi iterations x <- y - (L - I)^T x starting from x = y */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) t[i] = y[i];
+    for (s=0; s<sweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        sum = t[i];
+        for (q=li[i]; q<li[i+1]; q++) sum -= aa[lpos[q]]*y[lj[q]];
+        ynew[i] = sum;
+      }
+      tmp = y; y = ynew; ynew = tmp;
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) x[r[i]] = y[i];
+  }
+  ierr = ISRestoreIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&bv);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(sweeps*(2.0*(chow->nzl + chow->nzu - n) + n) + n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqAIJ_ChowILU(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscInt           n = A->rmap->n,nzl,nt,sweeps,j,zerorow = -1;
+  const PetscInt     *bi = b->i,*bj = b->j,*adiag = b->diag,*ui,*uj,*apos;
+  const MatScalar    *aa = a->a;
+  MatScalar          *av,**f,*ba = b->a,d = 0.0;
+  PetscLogDouble     flops = 0.0;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr   = MatChowILUGetContext_Private(B,&chow);CHKERRQ(ierr);
+  if (!chow->nthreadsset) chow->nthreads = PetscMax(a->threads.nthreads,1);
+  nzl    = chow->nzl;
+  nt     = chow->nthreads;
+  sweeps = chow->factor_sweeps;
+  ui     = chow->ui;
+  uj     = chow->uj;
+  apos   = chow->apos;
+  av     = chow->av;
+  f      = chow->f;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(nt) reduction(+:flops)
+#endif
+  {
+    const MatScalar *fo;
+    MatScalar       *fn;
+    PetscInt        i,j,p,q,s;
+
+    /* gather the matrix on the pattern and start from its lower part scaled by the diagonal and its upper part */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (p=0; p<nzl+chow->nzu; p++) av[p] = 0.0;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (p=0; p<a->i[n]; p++) {
+      if (apos[p] >= 0) av[apos[p]] = aa[p];
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (i=0; i<n; i++) {
+      for (p=bi[i]; p<bi[i+1]; p++) f[0][p] = av[p]/av[nzl+ui[bj[p]+1]-1];
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (j=0; j<n; j++) {
+      for (q=ui[j]; q<ui[j+1]; q++) f[0][nzl+q] = av[nzl+q];
+    }
+
+    /* each sweep updates all the entries from the previous iterate, which makes them independent */
+    for (s=0; s<sweeps; s++) {
+      fo = f[s%2];
+      fn = f[(s+1)%2];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+      for (i=0; i<n; i++) {
+        for (p=bi[i]; p<bi[i+1]; p++) {
+          /* l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj */
+          j     = bj[p];
+          fn[p] = (av[p] - MatChowILUSparseDot_Private(p-bi[i],bj+bi[i],fo+bi[i],ui[j+1]-1-ui[j],uj+ui[j],fo+nzl+ui[j],&flops))/fo[nzl+ui[j+1]-1];
+        }
+      }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (j=0; j<n; j++) {
+        for (q=ui[j]; q<ui[j+1]; q++) {
+          /* u_ij = a_ij - sum_{k<i} l_ik u_kj */
+          i         = uj[q];
+          fn[nzl+q] = av[nzl+q] - MatChowILUSparseDot_Private(bi[i+1]-bi[i],bj+bi[i],fo+bi[i],q-ui[j],uj+ui[j],fo+nzl+ui[j],&flops);
+        }
+      }
+    }
+
+    /* copy the last iterate into the factor, with the inverses of the diagonal */
+    fo = f[sweeps%2];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+    for (p=0; p<nzl; p++) ba[p] = fo[p];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (j=0; j<n; j++) {
+      for (q=ui[j]; q<ui[j+1]-1; q++) ba[chow->upos[q]] = fo[nzl+q];
+      ba[adiag[j]] = 1.0/fo[nzl+ui[j+1]-1];
+    }
+  }
+  for (j=0; j<n; j++) {
+    d = f[sweeps%2][nzl+ui[j+1]-1];
+    if (PetscAbsScalar(d) <= info->zeropivot) {zerorow = j; break;}
+  }
+  if (zerorow >= 0) {
+    ierr = PetscInfo2(A,"Zero pivot in row %D, value %g\n",zerorow,(double)PetscAbsScalar(d));CHKERRQ(ierr);
+    B->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+    B->factorerror_zeropivot_value = PetscAbsScalar(d);
+    B->factorerror_zeropivot_row   = zerorow;
+  } else B->factorerrortype = MAT_FACTOR_NOERROR;
+
+  if (chow->solve_sweeps) {
+    B->ops->solve    = MatSolve_SeqAIJ_ChowILU;
+    B->ops->matsolve = NULL;
+  } else {
+    B->ops->solve    = MatSolve_SeqAIJ;
+    B->ops->matsolve = MatMatSolve_SeqAIJ;
+  }
+  B->ops->solveadd          = NULL;
+  B->ops->solvetranspose    = chow->solve_sweeps ? MatSolveTranspose_SeqAIJ_ChowILU : MatSolveTranspose_SeqAIJ;
+  B->ops->solvetransposeadd = NULL;
+  if (!chow->solve_sweeps) {
+    ierr = MatFactorSetUpThreads_SeqAIJ(B,chow->nthreads);CHKERRQ(ierr);
+  }
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+  ierr = PetscLogFlops(flops + nzl + n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ChowILU(Mat B,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data,*b;
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscInt           n = A->rmap->n,i,j,p,q,k,*bi,*bj,*adiag,*pos;
+  const PetscInt     *r,*ic;
+  IS                 isicol;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatChowILUGetContext_Private(B,&chow);CHKERRQ(ierr);
+  ierr = MatChowILUReset_Private(chow);CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic_SeqAIJ(B,A,isrow,iscol,info);CHKERRQ(ierr);
+  B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_ChowILU;
+
+  /* U by columns, the rows of each column come in increasing order and end with the diagonal */
+  b          = (Mat_SeqAIJ*)B->data;
+  bi         = b->i;
+  bj         = b->j;
+  adiag      = b->diag;
+  chow->nzl  = bi[n];
+  chow->nzu  = adiag[0] - adiag[n];
+  ierr = PetscMalloc3(n+1,&chow->ui,chow->nzu,&chow->uj,chow->nzu,&chow->upos);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n+1,&pos);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (p=adiag[i+1]+1; p<=adiag[i]; p++) pos[bj[p]+1]++;
+  }
+  chow->ui[0] = 0;
+  for (j=0; j<n; j++) {
+    chow->ui[j+1] = chow->ui[j] + pos[j+1];
+    pos[j]        = chow->ui[j];
+  }
+  for (i=0; i<n; i++) {
+    for (p=adiag[i+1]+1; p<=adiag[i]; p++) {
+      q             = pos[bj[p]]++;
+      chow->uj[q]   = i;
+      chow->upos[q] = p;
+    }
+  }
+
+  /* L by columns, likewise */
+  ierr = PetscMalloc3(n+1,&chow->li,chow->nzl,&chow->lj,chow->nzl,&chow->lpos);CHKERRQ(ierr);
+  ierr = PetscMemzero(pos,(n+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (p=0; p<chow->nzl; p++) pos[bj[p]+1]++;
+  chow->li[0] = 0;
+  for (j=0; j<n; j++) {
+    chow->li[j+1] = chow->li[j] + pos[j+1];
+    pos[j]        = chow->li[j];
+  }
+  for (i=0; i<n; i++) {
+    for (p=bi[i]; p<bi[i+1]; p++) {
+      q             = pos[bj[p]]++;
+      chow->lj[q]   = i;
+      chow->lpos[q] = p;
+    }
+  }
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+
+  /* position of each entry of the matrix on the pattern of the factors */
+  ierr = PetscMalloc1(a->i[n],&chow->apos);CHKERRQ(ierr);
+  ierr = ISInvertPermutation(iscol,PETSC_DECIDE,&isicol);CHKERRQ(ierr);
+  ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(isicol,&ic);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (p=a->i[r[i]]; p<a->i[r[i]+1]; p++) {
+      j = ic[a->j[p]];
+      if (j < i) {
+        ierr = PetscFindInt(j,bi[i+1]-bi[i],bj+bi[i],&k);CHKERRQ(ierr);
+        chow->apos[p] = k >= 0 ? bi[i] + k : -1;
+      } else {
+        ierr = PetscFindInt(i,chow->ui[j+1]-chow->ui[j],chow->uj+chow->ui[j],&k);CHKERRQ(ierr);
+        chow->apos[p] = k >= 0 ? chow->nzl + chow->ui[j] + k : -1;
+      }
+    }
+  }
+  ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(isicol,&ic);CHKERRQ(ierr);
+  ierr = ISDestroy(&isicol);CHKERRQ(ierr);
+
+  ierr = PetscMalloc3(chow->nzl+chow->nzu,&chow->av,chow->nzl+chow->nzu,&chow->f[0],chow->nzl+chow->nzu,&chow->f[1]);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*n,&chow->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)B,(2*n+2+2*chow->nzu+2*chow->nzl+a->i[n])*sizeof(PetscInt)+3*(chow->nzl+chow->nzu)*sizeof(MatScalar)+2*n*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_SeqAIJ_ChowILU(Mat B,PetscViewer viewer)
+{
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscBool          iascii;
+  PetscViewerFormat  format;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatView_SeqAIJ(B,viewer);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+    if (format == PETSC_VIEWER_ASCII_INFO) {
+      ierr = MatChowILUGetContext_Private(B,&chow);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"ChowILU: %D factorization sweeps, %D Jacobi iterations per triangular solve, %D threads\n",chow->factor_sweeps,chow->solve_sweeps,chow->nthreads);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatFactorGetSolverType_seqaij_chowilu(Mat A,MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERCHOWILU;
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_chowilu(Mat A,MatFactorType ftype,Mat *B)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data;
+  PetscInt           n = A->rmap->n;
+  Mat_SeqAIJ_ChowILU *chow;
+  PetscContainer     container;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_ILU) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported");
+  ierr = PetscNew(&chow);CHKERRQ(ierr);
+  chow->factor_sweeps = 3;
+  chow->solve_sweeps  = 3;
+  chow->nthreads      = PetscMax(a->threads.nthreads,1);
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)A),((PetscObject)A)->prefix,"ChowILU Options","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_chowilu_factor_sweeps","Number of fixed-point sweeps of the factorization","None",chow->factor_sweeps,&chow->factor_sweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_chowilu_solve_sweeps","Number of Jacobi iterations of each triangular solve, 0 for exact solves","None",chow->solve_sweeps,&chow->solve_sweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_chowilu_threads","Number of OpenMP threads","MatSeqAIJSetNumThreads",chow->nthreads,&chow->nthreads,&chow->nthreadsset);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (chow->factor_sweeps < 0 || chow->solve_sweeps < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Numbers of sweeps %D and %D cannot be negative",chow->factor_sweeps,chow->solve_sweeps);
+  if (chow->nthreads < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",chow->nthreads);
+
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),B);CHKERRQ(ierr);
+  ierr = MatSetSizes(*B,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*B,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(*B,A,A);CHKERRQ(ierr);
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,chow);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatChowILUDestroy_Private);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)*B,"MatChowILU",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJ_ChowILU;
+  (*B)->ops->view              = MatView_SeqAIJ_ChowILU;
+  ierr = PetscObjectComposeFunction((PetscObject)*B,"MatFactorGetSolverType_C",MatFactorGetSolverType_seqaij_chowilu);CHKERRQ(ierr);
+  (*B)->factortype = ftype;
+
+  ierr = PetscFree((*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERCHOWILU,&(*B)->solvertype);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -133,6 +133,39 @@ PetscErrorCode MatInvertBlockDiagonal_SeqBAIJ(Mat A,const PetscScalar **values)
   PetscFunctionReturn(0);
 }
 
+/* Multicolor SOR sweeps, see MatSORSetMulticolor(), sets done if the coloring separates the coupled block rows */
+static PetscErrorCode MatSOR_SeqBAIJ_Multicolor(Mat A,Vec bb,MatSORType flag,PetscInt its,Vec xx,PetscBool *done)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  const PetscScalar *b;
+  PetscScalar       *x;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  ierr  = MatSORMulticolorSetUp_Private(A,A->rmap->bs,a->mbs,a->i,a->j,a->a,&a->sormc);CHKERRQ(ierr);
+  if (!a->sormc.valid) PetscFunctionReturn(0);
+  if (!a->idiagvalid) {ierr = MatInvertBlockDiagonal(A,NULL);CHKERRQ(ierr);}
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = MatSORMulticolorApply_Private(&a->sormc,1.0,flag,its,a->idiag,b,x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSORSetMulticolor_SeqBAIJ(Mat A,PetscInt nthreads)
+{
+  Mat_SeqBAIJ    *a = (Mat_SeqBAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSORMulticolorSetNumThreads_Private(A,nthreads,&a->sormc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSOR_SeqBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
@@ -152,6 +185,12 @@ PetscErrorCode MatSOR_SeqBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
   if (omega != 1.0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Sorry, no support for non-trivial relaxation factor");
   if ((flag & SOR_APPLY_UPPER) || (flag & SOR_APPLY_LOWER)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Sorry, no support for applying upper or lower triangular parts");
 
+  if (a->sormc.nthreads) {
+    PetscBool done;
+
+    ierr = MatSOR_SeqBAIJ_Multicolor(A,bb,flag,its,xx,&done);CHKERRQ(ierr);
+    if (done) PetscFunctionReturn(0);
+  }
   if (!a->idiagvalid) {ierr = MatInvertBlockDiagonal(A,NULL);CHKERRQ(ierr);}
 
   if (!m) PetscFunctionReturn(0);
@@ -1205,6 +1244,7 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
+  ierr = MatSORMulticolorReset_Private(&a->sormc);CHKERRQ(ierr);
 
   ierr = MatDestroy(&a->sbaijMat);CHKERRQ(ierr);
   ierr = MatDestroy(&a->parent);CHKERRQ(ierr);
@@ -1226,6 +1266,7 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
 #endif
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqbaij_is_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatPtAP_is_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSORSetMulticolor_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -3014,6 +3055,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqBAIJ(Mat B)
   PetscErrorCode ierr;
   PetscMPIInt    size;
   Mat_SeqBAIJ    *b;
+  PetscInt       sorthreads = 0;
+  PetscBool      flg;
 
   PetscFunctionBegin;
   ierr = MPI_Comm_size(PetscObjectComm((PetscObject)B),&size);CHKERRQ(ierr);
@@ -3050,7 +3093,15 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqBAIJ(Mat B)
 #endif
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqbaij_is_C",MatConvert_XAIJ_IS);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqbaij_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSORSetMulticolor_C",MatSORSetMulticolor_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQBAIJ);CHKERRQ(ierr);
+
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"Options for SEQBAIJ matrix","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_sor_multicolor","Number of threads of the multicolor SOR sweeps","MatSORSetMulticolor",sorthreads,&sorthreads,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatSORMulticolorSetNumThreads_Private(B,sorthreads,&b->sormc);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -3062,6 +3113,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqBAIJ(Mat C,Mat A,MatDuplicateOption cpval
 
   PetscFunctionBegin;
   if (a->i[mbs] != nz) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Corrupt matrix");
+  ierr = MatSORMulticolorSetNumThreads_Private(C,a->sormc.nthreads,&c->sormc);CHKERRQ(ierr);
 
   if (cpvalues == MAT_SHARE_NONZERO_PATTERN) {
     c->imax           = a->imax;
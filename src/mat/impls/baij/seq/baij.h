@@ -28,6 +28,7 @@
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
+  MatSORMulticolor sormc;               /* multicolor ordering for thread-parallel MatSOR() */
 } Mat_SeqBAIJ;
 
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz,PetscInt *nnz);
@@ -15,7 +15,9 @@
   the above preallocation routines for simplicity.
 
    Options Database Keys:
-. -mat_type sell - sets the matrix type to "sell" during a call to MatSetFromOptions()
++ -mat_type sell - sets the matrix type to "sell" during a call to MatSetFromOptions()
+. -mat_kernel_isa <scalar,avx,avx2,avx512> - limits the instruction set of the MatMult() and MatMultAdd() kernels, by default the most capable one supported by the processor is used
+- -mat_view_kernel - prints the matrix-vector product kernels used, after each final assembly
 
   Developer Notes:
     Subclasses include MATSELLCUSP, MATSELLCUSPARSE, MATSELLPERM, MATSELLCRL, and also automatically switches over to use inodes when
@@ -1734,6 +1736,7 @@ PetscErrorCode MatConvert_MPISELL_MPIAIJ(Mat A,MatType newtype,MatReuse reuse,Ma
     ierr = MatDestroy(&b->A);CHKERRQ(ierr);
     ierr = MatDestroy(&b->B);CHKERRQ(ierr);
     ierr = MatDisAssemble_MPISELL(A);CHKERRQ(ierr);
+    A->assembled = PETSC_FALSE;
     ierr = MatConvert_SeqSELL_SeqAIJ(a->A, MATSEQAIJ, MAT_INITIAL_MATRIX, &b->A);CHKERRQ(ierr);
     ierr = MatConvert_SeqSELL_SeqAIJ(a->B, MATSEQAIJ, MAT_INITIAL_MATRIX, &b->B);CHKERRQ(ierr);
     ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
@@ -1767,8 +1770,8 @@ PetscErrorCode MatConvert_MPIAIJ_MPISELL(Mat A,MatType newtype,MatReuse reuse,Ma
     ierr = MatSetType(B,MATMPISELL);CHKERRQ(ierr);
     ierr = MatSetSizes(B,A->rmap->n,A->cmap->n,A->rmap->N,A->cmap->N);CHKERRQ(ierr);
     ierr = MatSetBlockSizes(B,A->rmap->bs,A->cmap->bs);CHKERRQ(ierr);
-    ierr = MatSeqAIJSetPreallocation(B,0,NULL);CHKERRQ(ierr);
-    ierr = MatMPIAIJSetPreallocation(B,0,NULL,0,NULL);CHKERRQ(ierr);
+    ierr = MatSeqSELLSetPreallocation(B,0,NULL);CHKERRQ(ierr);
+    ierr = MatMPISELLSetPreallocation(B,0,NULL,0,NULL);CHKERRQ(ierr);
   }
   b    = (Mat_MPISELL*) B->data;
 
@@ -1779,6 +1782,11 @@ PetscErrorCode MatConvert_MPIAIJ_MPISELL(Mat A,MatType newtype,MatReuse reuse,Ma
     ierr = MatDestroy(&b->A);CHKERRQ(ierr);
     ierr = MatDestroy(&b->B);CHKERRQ(ierr);
     ierr = MatDisAssemble_MPIAIJ(A);CHKERRQ(ierr);
+    /* the off-diagonal block with global column indices is left unassembled, but MatConvert_SeqAIJ_SeqSELL() uses MatGetRow() */
+    ierr = MatAssemblyBegin(a->B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(a->B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    /* so that the assembly of A below sets up the matrix-vector product again */
+    A->assembled = PETSC_FALSE;
     ierr = MatConvert_SeqAIJ_SeqSELL(a->A, MATSEQSELL, MAT_INITIAL_MATRIX, &b->A);CHKERRQ(ierr);
     ierr = MatConvert_SeqAIJ_SeqSELL(a->B, MATSEQSELL, MAT_INITIAL_MATRIX, &b->B);CHKERRQ(ierr);
     ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
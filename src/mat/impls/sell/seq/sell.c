@@ -5,33 +5,27 @@
 #include <../src/mat/impls/sell/seq/sell.h>  /*I   "petscmat.h"  I*/
 #include <petscblaslapack.h>
 #include <petsc/private/kernels/blocktranspose.h>
-#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX__)) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+#include <petsc/private/kernels/isadispatch.h>
 
-  #include <immintrin.h>
-
-  #if !defined(_MM_SCALE_8)
-  #define _MM_SCALE_8    8
-  #endif
-
-  #if defined(__AVX512F__)
+#if defined(PETSC_HAVE_KERNEL_AVX512)
   /* these do not work
    vec_idx  = _mm512_loadunpackhi_epi32(vec_idx,acolidx);
    vec_vals = _mm512_loadunpackhi_pd(vec_vals,aval);
   */
-    #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
-    vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
-    vec_vals = _mm512_loadu_pd(aval); \
-    vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
-    vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
-  #elif defined(__AVX2__) && defined(__FMA__)
-    #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    vec_vals = _mm256_loadu_pd(aval); \
-    vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
-    vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
-    vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
-  #endif
-#endif  /* PETSC_HAVE_IMMINTRIN_H */
+  #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
+  /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
+  vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
+  vec_vals = _mm512_loadu_pd(aval); \
+  vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
+  vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
+#endif
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+  #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
+  vec_vals = _mm256_loadu_pd(aval); \
+  vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
+  vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
+  vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
+#endif
 
 /*@C
  MatSeqSELLSetPreallocation - For good matrix assembly performance
@@ -292,44 +286,78 @@ PetscErrorCode MatConvert_SeqAIJ_SeqSELL(Mat A,MatType newtype,MatReuse reuse,Ma
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+/*
+    Kernels for MatMult_SeqSELL() and MatMultAdd_SeqSELL() for the instruction sets selected with MatGetKernelISA_Private(),
+  m is the number of rows of the matrix. Rows are stored in slices of 8, the unused slots of each slice column hold the
+  last valid column index and a zero value so that the kernels can use unmasked loads.
+*/
+static void MatMult_SeqSELL_Scalar(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,PetscScalar *y)
 {
-  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscScalar       *y;
-  const PetscScalar *x;
-  const MatScalar   *aval=a->val;
-  PetscInt          totalslices=a->totalslices;
-  const PetscInt    *acolidx=a->colidx;
-  PetscInt          i,j;
-  PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m512d           vec_x,vec_y,vec_vals;
-  __m256i           vec_idx;
-  __mmask8          mask;
-  __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
-  __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128i           vec_idx;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  PetscScalar     sum[8];
 
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-#pragma disjoint(*x,*y,*aval)
-#endif
+  for (i=0; i<totalslices; i++) { /* loop over slices */
+    for (j=0; j<8; j++) sum[j] = 0.0;
+    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
+      sum[0] += aval[j] * x[acolidx[j]];
+      sum[1] += aval[j+1] * x[acolidx[j+1]];
+      sum[2] += aval[j+2] * x[acolidx[j+2]];
+      sum[3] += aval[j+3] * x[acolidx[j+3]];
+      sum[4] += aval[j+4] * x[acolidx[j+4]];
+      sum[5] += aval[j+5] * x[acolidx[j+5]];
+      sum[6] += aval[j+6] * x[acolidx[j+6]];
+      sum[7] += aval[j+7] * x[acolidx[j+7]];
+    }
+    if (i == totalslices-1 && (m & 0x07)) { /* if last slice has padding rows */
+      for(j=0; j<(m & 0x07); j++) y[8*i+j] = sum[j];
+    } else {
+      for(j=0; j<8; j++) y[8*i+j] = sum[j];
+    }
+  }
+}
+
+static void MatMultAdd_SeqSELL_Scalar(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
+{
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  PetscScalar     sum[8];
+
+  for (i=0; i<totalslices; i++) { /* loop over slices */
+    for (j=0; j<8; j++) sum[j] = 0.0;
+    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
+      sum[0] += aval[j] * x[acolidx[j]];
+      sum[1] += aval[j+1] * x[acolidx[j+1]];
+      sum[2] += aval[j+2] * x[acolidx[j+2]];
+      sum[3] += aval[j+3] * x[acolidx[j+3]];
+      sum[4] += aval[j+4] * x[acolidx[j+4]];
+      sum[5] += aval[j+5] * x[acolidx[j+5]];
+      sum[6] += aval[j+6] * x[acolidx[j+6]];
+      sum[7] += aval[j+7] * x[acolidx[j+7]];
+    }
+    if (i == totalslices-1 && (m & 0x07)) {
+      for (j=0; j<(m & 0x07); j++) z[8*i+j] = y[8*i+j] + sum[j];
+    } else {
+      for (j=0; j<8; j++) z[8*i+j] = y[8*i+j] + sum[j];
+    }
+  }
+}
+
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+PETSC_KERNEL_TARGET_AVX512
+static void MatMult_SeqSELL_AVX512(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,PetscScalar *y)
+{
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  __m512d         vec_x,vec_y,vec_vals;
+  __m256i         vec_idx;
+  __mmask8        mask;
+  __m512d         vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
+  __m256i         vec_idx2,vec_idx3,vec_idx4;
 
-  PetscFunctionBegin;
-  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   for (i=0; i<totalslices; i++) { /* loop over slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -378,21 +406,108 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     vec_y = _mm512_add_pd(vec_y,vec_y2);
     vec_y = _mm512_add_pd(vec_y,vec_y3);
     vec_y = _mm512_add_pd(vec_y,vec_y4);
-    if (i == totalslices-1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      mask = (__mmask8)(0xff >> (8-(A->rmap->n & 0x07)));
+    if (i == totalslices-1 && m & 0x07) { /* if last slice has padding rows */
+      mask = (__mmask8)(0xff >> (8-(m & 0x07)));
       _mm512_mask_storeu_pd(&y[8*i],mask,vec_y);
     } else {
       _mm512_storeu_pd(&y[8*i],vec_y);
     }
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+}
+
+PETSC_KERNEL_TARGET_AVX512
+static void MatMultAdd_SeqSELL_AVX512(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
+{
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  __m512d         vec_x,vec_y,vec_vals;
+  __m256i         vec_idx;
+  __mmask8        mask=0xff;
+  __m512d         vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
+  __m256i         vec_idx2,vec_idx3,vec_idx4;
+
+  for (i=0; i<totalslices; i++) { /* loop over slices */
+    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
+    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
+
+    if (i == totalslices-1 && m & 0x07) { /* if last slice has padding rows */
+      mask   = (__mmask8)(0xff >> (8-(m & 0x07)));
+      vec_y  = _mm512_maskz_loadu_pd(mask,&y[8*i]);
+    } else {
+      vec_y  = _mm512_loadu_pd(&y[8*i]);
+    }
+    vec_y2 = _mm512_setzero_pd();
+    vec_y3 = _mm512_setzero_pd();
+    vec_y4 = _mm512_setzero_pd();
+
+    j = a->sliidx[i]>>3; /* 8 bytes are read at each time, corresponding to a slice columnn */
+    switch ((a->sliidx[i+1]-a->sliidx[i])/8 & 3) {
+    case 3:
+      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
+      acolidx += 8; aval += 8;
+      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
+      acolidx += 8; aval += 8;
+      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
+      acolidx += 8; aval += 8;
+      j += 3;
+      break;
+    case 2:
+      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
+      acolidx += 8; aval += 8;
+      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
+      acolidx += 8; aval += 8;
+      j += 2;
+      break;
+    case 1:
+      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
+      acolidx += 8; aval += 8;
+      j += 1;
+      break;
+    }
+    #pragma novector
+    for (; j<(a->sliidx[i+1]>>3); j+=4) {
+      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
+      acolidx += 8; aval += 8;
+      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
+      acolidx += 8; aval += 8;
+      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
+      acolidx += 8; aval += 8;
+      AVX512_Mult_Private(vec_idx4,vec_x4,vec_vals4,vec_y4);
+      acolidx += 8; aval += 8;
+    }
+
+    vec_y = _mm512_add_pd(vec_y,vec_y2);
+    vec_y = _mm512_add_pd(vec_y,vec_y3);
+    vec_y = _mm512_add_pd(vec_y,vec_y4);
+    if (i == totalslices-1 && m & 0x07) { /* if last slice has padding rows */
+      _mm512_mask_storeu_pd(&z[8*i],mask,vec_y);
+    } else {
+      _mm512_storeu_pd(&z[8*i],vec_y);
+    }
+  }
+}
+#endif
+
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+PETSC_KERNEL_TARGET_AVX2
+static void MatMult_SeqSELL_AVX2(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,PetscScalar *y)
+{
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  __m128i         vec_idx;
+  __m256d         vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar       yval;
+  PetscInt        r,rows_left,row,nnz_in_row;
+
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
 
     /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      rows_left = A->rmap->n - 8*i;
+    if (i == totalslices-1 && (m & 0x07)) {
+      rows_left = m - 8*i;
       for (r=0; r<rows_left; ++r) {
         yval = (MatScalar)0;
         row = 8*i + r;
@@ -419,7 +534,23 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     _mm256_storeu_pd(y+i*8,vec_y);
     _mm256_storeu_pd(y+i*8+4,vec_y2);
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+}
+#endif
+
+#if defined(PETSC_HAVE_KERNEL_AVX)
+PETSC_KERNEL_TARGET_AVX
+static void MatMult_SeqSELL_AVX(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,PetscScalar *y)
+{
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  __m128d         vec_x_tmp;
+  __m256d         vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar       yval;
+  PetscInt        r,rows_left,row,nnz_in_row;
+
+  vec_x_tmp = _mm_setzero_pd();
+  vec_x     = _mm256_setzero_pd();
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -428,8 +559,8 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     vec_y2 = _mm256_setzero_pd();
 
     /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      rows_left = A->rmap->n - 8*i;
+    if (i == totalslices-1 && (m & 0x07)) {
+      rows_left = m - 8*i;
       for (r=0; r<rows_left; ++r) {
         yval = (MatScalar)0;
         row = 8*i + r;
@@ -468,134 +599,29 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     _mm256_storeu_pd(y + i*8,     vec_y);
     _mm256_storeu_pd(y + i*8 + 4, vec_y2);
   }
-#else
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=0; j<8; j++) sum[j] = 0.0;
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      sum[0] += aval[j] * x[acolidx[j]];
-      sum[1] += aval[j+1] * x[acolidx[j+1]];
-      sum[2] += aval[j+2] * x[acolidx[j+2]];
-      sum[3] += aval[j+3] * x[acolidx[j+3]];
-      sum[4] += aval[j+4] * x[acolidx[j+4]];
-      sum[5] += aval[j+5] * x[acolidx[j+5]];
-      sum[6] += aval[j+6] * x[acolidx[j+6]];
-      sum[7] += aval[j+7] * x[acolidx[j+7]];
-    }
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) { /* if last slice has padding rows */
-      for(j=0; j<(A->rmap->n & 0x07); j++) y[8*i+j] = sum[j];
-    } else {
-      for(j=0; j<8; j++) y[8*i+j] = sum[j];
-    }
-  }
-#endif
-
-  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
-  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
-  PetscFunctionReturn(0);
 }
 
-#include <../src/mat/impls/aij/seq/ftn-kernels/fmultadd.h>
-PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+/* also used for AVX2, there is no AVX2 specific MatMultAdd() kernel */
+PETSC_KERNEL_TARGET_AVX
+static void MatMultAdd_SeqSELL_AVX(const Mat_SeqSELL *a,PetscInt m,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
 {
-  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
-  PetscScalar       *y,*z;
-  const PetscScalar *x;
-  const MatScalar   *aval=a->val;
-  PetscInt          totalslices=a->totalslices;
-  const PetscInt    *acolidx=a->colidx;
-  PetscInt          i,j;
-  PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m512d           vec_x,vec_y,vec_vals;
-  __m256i           vec_idx;
-  __mmask8          mask;
-  __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
-  __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
-
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-#pragma disjoint(*x,*y,*aval)
-#endif
-
-  PetscFunctionBegin;
-  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
-
-    if (i == totalslices-1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      mask   = (__mmask8)(0xff >> (8-(A->rmap->n & 0x07)));
-      vec_y  = _mm512_mask_loadu_pd(vec_y,mask,&y[8*i]);
-    } else {
-      vec_y  = _mm512_loadu_pd(&y[8*i]);
-    }
-    vec_y2 = _mm512_setzero_pd();
-    vec_y3 = _mm512_setzero_pd();
-    vec_y4 = _mm512_setzero_pd();
-
-    j = a->sliidx[i]>>3; /* 8 bytes are read at each time, corresponding to a slice columnn */
-    switch ((a->sliidx[i+1]-a->sliidx[i])/8 & 3) {
-    case 3:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
-      acolidx += 8; aval += 8;
-      j += 3;
-      break;
-    case 2:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      j += 2;
-      break;
-    case 1:
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      j += 1;
-      break;
-    }
-    #pragma novector
-    for (; j<(a->sliidx[i+1]>>3); j+=4) {
-      AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx2,vec_x2,vec_vals2,vec_y2);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx3,vec_x3,vec_vals3,vec_y3);
-      acolidx += 8; aval += 8;
-      AVX512_Mult_Private(vec_idx4,vec_x4,vec_vals4,vec_y4);
-      acolidx += 8; aval += 8;
-    }
-
-    vec_y = _mm512_add_pd(vec_y,vec_y2);
-    vec_y = _mm512_add_pd(vec_y,vec_y3);
-    vec_y = _mm512_add_pd(vec_y,vec_y4);
-    if (i == totalslices-1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      _mm512_mask_storeu_pd(&z[8*i],mask,vec_y);
-    } else {
-      _mm512_storeu_pd(&z[8*i],vec_y);
-    }
-  }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  const MatScalar *aval=a->val;
+  const PetscInt  *acolidx=a->colidx;
+  PetscInt        i,j,totalslices=a->totalslices;
+  __m128d         vec_x_tmp;
+  __m256d         vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar       yval;
+  PetscInt        r,row,nnz_in_row;
+
+  vec_x_tmp = _mm_setzero_pd();
+  vec_x     = _mm256_setzero_pd();
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
 
     /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      for (r=0; r<(A->rmap->n & 0x07); ++r) {
+    if (i == totalslices-1 && (m & 0x07)) {
+      for (r=0; r<(m & 0x07); ++r) {
         row        = 8*i + r;
         yval       = (MatScalar)0.0;
         nnz_in_row = a->rlen[row];
@@ -634,27 +660,69 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
     _mm256_storeu_pd(z+i*8,vec_y);
     _mm256_storeu_pd(z+i*8+4,vec_y2);
   }
-#else
-  for (i=0; i<totalslices; i++) { /* loop over slices */
-    for (j=0; j<8; j++) sum[j] = 0.0;
-    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
-      sum[0] += aval[j] * x[acolidx[j]];
-      sum[1] += aval[j+1] * x[acolidx[j+1]];
-      sum[2] += aval[j+2] * x[acolidx[j+2]];
-      sum[3] += aval[j+3] * x[acolidx[j+3]];
-      sum[4] += aval[j+4] * x[acolidx[j+4]];
-      sum[5] += aval[j+5] * x[acolidx[j+5]];
-      sum[6] += aval[j+6] * x[acolidx[j+6]];
-      sum[7] += aval[j+7] * x[acolidx[j+7]];
-    }
-    if (i == totalslices-1 && (A->rmap->n & 0x07)) {
-      for (j=0; j<(A->rmap->n & 0x07); j++) z[8*i+j] = y[8*i+j] + sum[j];
-    } else {
-      for (j=0; j<8; j++) z[8*i+j] = y[8*i+j] + sum[j];
-    }
-  }
+}
 #endif
 
+PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  switch (a->kernelisa) {
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+  case MAT_KERNEL_AVX512:
+    MatMult_SeqSELL_AVX512(a,A->rmap->n,x,y);
+    break;
+#endif
+#if defined(PETSC_HAVE_KERNEL_AVX2)
+  case MAT_KERNEL_AVX2:
+    MatMult_SeqSELL_AVX2(a,A->rmap->n,x,y);
+    break;
+#endif
+#if defined(PETSC_HAVE_KERNEL_AVX)
+  case MAT_KERNEL_AVX:
+    MatMult_SeqSELL_AVX(a,A->rmap->n,x,y);
+    break;
+#endif
+  default:
+    MatMult_SeqSELL_Scalar(a,A->rmap->n,x,y);
+  }
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  switch (a->kernelisa) {
+#if defined(PETSC_HAVE_KERNEL_AVX512)
+  case MAT_KERNEL_AVX512:
+    MatMultAdd_SeqSELL_AVX512(a,A->rmap->n,x,y,z);
+    break;
+#endif
+#if defined(PETSC_HAVE_KERNEL_AVX)
+  case MAT_KERNEL_AVX2:
+  case MAT_KERNEL_AVX:
+    MatMultAdd_SeqSELL_AVX(a,A->rmap->n,x,y,z);
+    break;
+#endif
+  default:
+    MatMultAdd_SeqSELL_Scalar(a,A->rmap->n,x,y,z);
+  }
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
@@ -688,7 +756,7 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
       for (r=0; r<(A->rmap->n & 0x07); ++r) {
         row        = 8*i + r;
         nnz_in_row = a->rlen[row];
-        for (j=0; j<nnz_in_row; ++j) y[acolidx[8*j+r]] += aval[8*j+r] * x[row];
+        for (j=0; j<nnz_in_row; ++j) y[acolidx[a->sliidx[i]+8*j+r]] += aval[a->sliidx[i]+8*j+r] * x[row];
       }
       break;
     }
@@ -1429,6 +1497,7 @@ PetscErrorCode MatAssemblyEnd_SeqSELL(Mat A,MatAssemblyType mode)
   a->reallocs      = 0;
 
   ierr = MatSeqSELLInvalidateDiagonal(A);CHKERRQ(ierr);
+  ierr = MatKernelISAView_Private(A,a->kernelisa,NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1967,6 +2036,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqSELL(Mat B)
   b->idiagvalid         = PETSC_FALSE;
   b->keepnonzeropattern = PETSC_FALSE;
 
+  ierr = MatGetKernelISA_Private(B,&b->kernelisa);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQSELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqSELLGetArray_C",MatSeqSELLGetArray_SeqSELL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqSELLRestoreArray_C",MatSeqSELLRestoreArray_SeqSELL);CHKERRQ(ierr);
@@ -2053,6 +2123,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat C,Mat A,MatDuplicateOption cpval
 
   c->nonzerorowcnt = a->nonzerorowcnt;
   C->nonzerostate  = A->nonzerostate;
+  c->kernelisa     = a->kernelisa;
 
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -47,6 +47,7 @@ typedef struct {
   PetscBool   idiagvalid;                /* current idiag[] and mdiag[] are valid */
   PetscScalar fshift,omega;              /* last used omega and fshift */
   ISColoring  coloring;                  /* set with MatADSetColoring() used by MatADSetValues() */
+  MatKernelISA kernelisa;                /* instruction set used by MatMult() and MatMultAdd() */
 } Mat_SeqSELL;
 
 /*
@@ -79,10 +80,10 @@ ierr = PetscMalloc2(BS2*new_size,&new_val,BS2*new_size,&new_colidx);CHKERRQ(ierr
 /* copy over old data into new slots by two steps: one step for data before the current slice and the other for the rest */ \
 ierr = PetscMemcpy(new_val,VAL,SIDX[SID+1]*sizeof(datatype));CHKERRQ(ierr); \
 ierr = PetscMemcpy(new_colidx,COLIDX,SIDX[SID+1]*sizeof(PetscInt));CHKERRQ(ierr); \
-ierr = PetscMemcpy(new_val+SIDX[SID+1]+8,VAL+SIDX[SID+1],(SIDX[AM>>3]-SIDX[SID+1])*sizeof(datatype));CHKERRQ(ierr); \
-ierr = PetscMemcpy(new_colidx+SIDX[SID+1]+8,COLIDX+SIDX[SID+1],(SIDX[AM>>3]-SIDX[SID+1])*sizeof(PetscInt));CHKERRQ(ierr); \
-/* update slice_idx */ \
-for (ii=SID+1;ii<=AM>>3;ii++) { SIDX[ii] += 8; } \
+ierr = PetscMemcpy(new_val+SIDX[SID+1]+8,VAL+SIDX[SID+1],(SIDX[Ain->totalslices]-SIDX[SID+1])*sizeof(datatype));CHKERRQ(ierr); \
+ierr = PetscMemcpy(new_colidx+SIDX[SID+1]+8,COLIDX+SIDX[SID+1],(SIDX[Ain->totalslices]-SIDX[SID+1])*sizeof(PetscInt));CHKERRQ(ierr); \
+/* update slice_idx, the last slice is partial when the number of rows is not a multiple of 8 */ \
+for (ii=SID+1;ii<=Ain->totalslices;ii++) { SIDX[ii] += 8; } \
 /* update pointers. Notice that they point to the FIRST postion of the row */ \
 CP = new_colidx+SIDX[SID]+(ROW & 0x07); \
 VP = new_val+SIDX[SID]+(ROW & 0x07); \
@@ -21,6 +21,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAdj(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_Shell(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_Composite(Mat);
 
+PETSC_EXTERN PetscErrorCode MatCreate_Auto(Mat);
+
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJPERM(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 
@@ -157,6 +159,7 @@ PetscErrorCode  MatRegisterAll(void)
 
   ierr = MatRegister(MATPREALLOCATOR,   MatCreate_Preallocator);CHKERRQ(ierr);
   ierr = MatRegister(MATDUMMY,          MatCreate_Dummy);CHKERRQ(ierr);
+  ierr = MatRegister(MATAUTO,           MatCreate_Auto);CHKERRQ(ierr);
 
 #if defined PETSC_HAVE_HYPRE
   ierr = MatRegister(MATHYPRE,          MatCreate_HYPRE);CHKERRQ(ierr);
@@ -32,7 +32,7 @@ PetscLogEvent MAT_Getsymtranspose, MAT_Getsymtransreduced, MAT_Transpose_SeqAIJ,
 PetscLogEvent MAT_GetBrowsOfAocols, MAT_Getlocalmat, MAT_Getlocalmatcondensed, MAT_Seqstompi, MAT_Seqstompinum, MAT_Seqstompisym;
 PetscLogEvent MAT_Applypapt, MAT_Applypapt_numeric, MAT_Applypapt_symbolic, MAT_GetSequentialNonzeroStructure;
 PetscLogEvent MAT_GetMultiProcBlock;
-PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch;
+PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch, MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
 PetscLogEvent MATCOLORING_Apply,MATCOLORING_Comm,MATCOLORING_Local,MATCOLORING_ISCreate,MATCOLORING_SetUp,MATCOLORING_Weights;
@@ -938,6 +938,7 @@ PetscErrorCode MatSetUp(Mat A)
 .  -mat_view ::ascii_info_detail - Prints more detailed info
 .  -mat_view - Prints matrix in ASCII format
 .  -mat_view ::ascii_matlab - Prints matrix in Matlab format
+.  -mat_autotune - Converts the matrix to the format with the fastest MatMult() at the conclusion of the first MatEndAssembly(), see MatSetAutotune()
 .  -mat_view draw - PetscDraws nonzero structure of matrix, using MatView() and PetscDrawOpenX().
 .  -display <name> - Sets display name (default is host)
 .  -draw_pause <sec> - Sets number of seconds to pause after display
@@ -1970,6 +1971,100 @@ PetscErrorCode MatSetValuesBatch(Mat mat, PetscInt nb, PetscInt bs, PetscInt row
   PetscFunctionReturn(0);
 }
 
+/*@
+   MatSetPreallocationCOO - Sets the nonzero structure of a matrix from a list of coordinates (COO format) and
+   prepares the matrix for MatSetValuesCOO()
+
+   Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+.  ncoo - the number of entries
+.  coo_i - the global row index of each entry
+-  coo_j - the global column index of each entry
+
+   Notes:
+   Entries may be listed more than once, their values are then summed by MatSetValuesCOO(). Entries with a negative
+   row or column index are ignored. Any process may list entries of rows owned by other processes.
+
+   The list is analyzed once: the entries are sorted and merged, the matrix is preallocated exactly and its nonzero
+   structure is assembled with zero values. For MATSEQAIJ and MATMPIAIJ the permutation from the list to the nonzeros
+   of the matrix and the communication of the entries of rows owned by other processes (a PetscSF) are kept, so
+   each later MatSetValuesCOO() is a gather and sum of the values, with no search in the rows and no stash. Other
+   matrix types fall back to MatSetValues().
+
+   The arrays may be freed after the call.
+
+   Level: beginner
+
+   Concepts: matrices^preallocation
+   Concepts: matrices^putting entries in
+
+.seealso: MatSetValuesCOO(), MatSeqAIJSetPreallocation(), MatMPIAIJSetPreallocation(), MatSetValues(), MATPREALLOCATOR
+@*/
+PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr,(*f)(Mat,PetscInt,const PetscInt[],const PetscInt[]) = NULL;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (ncoo) PetscValidIntPointer(coo_i,3);
+  if (ncoo) PetscValidIntPointer(coo_j,4);
+  if (ncoo < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of entries %D cannot be negative",ncoo);
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetPreallocationCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetPreallocationCOO_Basic(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSetValuesCOO - Sets the values of a matrix whose nonzero structure was given with MatSetPreallocationCOO()
+
+   Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+.  coo_v - the value of each entry, in the order of the coordinates given to MatSetPreallocationCOO()
+-  imode - INSERT_VALUES to replace the values of the matrix or ADD_VALUES to add to them
+
+   Notes:
+   The values of entries listed more than once are summed. The matrix is assembled on return, there is no need to call
+   MatAssemblyBegin() and MatAssemblyEnd().
+
+   Level: beginner
+
+   Concepts: matrices^putting entries in
+
+.seealso: MatSetPreallocationCOO(), MatSetValues(), InsertMode, INSERT_VALUES, ADD_VALUES
+@*/
+PetscErrorCode MatSetValuesCOO(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscErrorCode ierr,(*f)(Mat,const PetscScalar[],InsertMode) = NULL;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (imode != INSERT_VALUES && imode != ADD_VALUES) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Only INSERT_VALUES and ADD_VALUES are supported");
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetValuesCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,coo_v,imode);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetValuesCOO_Basic(A,coo_v,imode);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatSetLocalToGlobalMapping - Sets a local-to-global numbering for use by
    the routine MatSetValuesLocal() to allow users to insert matrix entries
@@ -3881,6 +3976,8 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat,Vec b,Vec y,Vec x)
    Notes:
     for BAIJ, SBAIJ, and AIJ matrices with Inodes this does a block SOR smoothing, otherwise it does a pointwise smoothing
 
+    MatSORSetMulticolor() makes AIJ and BAIJ matrices sweep the rows by colors with several threads
+
    Notes for Advanced Users:
    The flags are implemented as bitwise inclusive or operations.
    For example, use (SOR_ZERO_INITIAL_GUESS | SOR_SYMMETRIC_SWEEP)
@@ -5356,6 +5453,9 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
   }
 #endif
   if (inassm == 1 && type != MAT_FLUSH_ASSEMBLY) {
+    if (mat->autotune) {
+      ierr = MatAutotune_Private(mat);CHKERRQ(ierr);
+    }
     ierr = MatViewFromOptions(mat,NULL,"-mat_view");CHKERRQ(ierr);
 
     if (mat->checksymmetryonassembly) {
@@ -9215,6 +9315,10 @@ PetscErrorCode MatFactorFactorizeSchurComplement(Mat F)
    Output Parameters:
 .  C - the product matrix
 
+   Options Database Keys:
+.  -matptap_via <scalable,nonscalable,allatonce,allatonce_merged> - the algorithm for MPIAIJ matrices. The allatonce algorithms add
+   the rows of A*P to C as they are computed, without storing A*P or P^T, which reduces the memory needed
+
    Notes:
    C will be created and must be destroyed by the user with MatDestroy().
 
@@ -0,0 +1,298 @@
+
+/*
+   Selection of the fastest storage format for MatMult() by timing the candidates on the assembled matrix
+*/
+#include <petsc/private/matimpl.h>   /*I "petscmat.h" I*/
+#include <petsctime.h>
+
+#define MAT_AUTOTUNE_MAX_TYPES 16
+
+static PetscBool MatAutotune_InUse = PETSC_FALSE;
+
+/*
+   MatAutotuneSignature_Private - Computes a string identifying the nonzero structure and parallel layout of a matrix
+
+   Notes:
+   The string contains the global sizes, block size, number of nonzeros and number of processes, and a
+   hash of the column indices of the locally owned rows of each process. Processes with identical local
+   structure contribute differently to the hash since the rank seeds each local hash.
+*/
+static PetscErrorCode MatAutotuneSignature_Private(Mat A,char sig[],size_t len)
+{
+  PetscErrorCode     ierr;
+  MPI_Comm           comm;
+  PetscMPIInt        size,rank;
+  PetscInt           M,N,bs,rstart,rend,row,ncols,j,nz = 0,gnz;
+  const PetscInt     *cols;
+  unsigned long long h,gh;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&M,&N);CHKERRQ(ierr);
+  ierr = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+
+  /* FNV-1a */
+  h = 14695981039346656037ULL ^ (unsigned long long)rank;
+  for (row=rstart; row<rend; row++) {
+    ierr = MatGetRow(A,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+    h    = (h ^ (unsigned long long)ncols)*1099511628211ULL;
+    for (j=0; j<ncols; j++) h = (h ^ (unsigned long long)cols[j])*1099511628211ULL;
+    nz  += ncols;
+    ierr = MatRestoreRow(A,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(&nz,&gnz,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&h,&gh,1,MPI_UNSIGNED_LONG_LONG,MPI_BXOR,comm);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(sig,len,"%D:%D:%D:%D:%d:%016llx",M,N,bs,gnz,size,gh);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatAutotuneCacheLookup_Private - Finds the format recorded for a signature in the cache file, type[0] is 0 if there is none
+
+   Collective on comm, the first process reads the file
+*/
+static PetscErrorCode MatAutotuneCacheLookup_Private(MPI_Comm comm,const char file[],const char sig[],char type[],size_t len)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscBool      flg,match;
+  FILE           *fd;
+  char           line[PETSC_MAX_PATH_LEN],lsig[PETSC_MAX_PATH_LEN],ltype[256];
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(type,len);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscTestFile(file,'r',&flg);CHKERRQ(ierr);
+    if (flg) {
+      ierr = PetscFOpen(PETSC_COMM_SELF,file,"r",&fd);CHKERRQ(ierr);
+      while (fgets(line,sizeof(line),fd)) {
+        if (sscanf(line,"%4095s %255s",lsig,ltype) != 2) continue;
+        ierr = PetscStrcmp(lsig,sig,&match);CHKERRQ(ierr);
+        if (match) {ierr = PetscStrncpy(type,ltype,len);CHKERRQ(ierr);}
+      }
+      ierr = PetscFClose(PETSC_COMM_SELF,fd);CHKERRQ(ierr);
+    }
+  }
+  ierr = MPI_Bcast(type,(PetscMPIInt)len,MPI_CHAR,0,comm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatAutotuneReplace_Private - Replaces A by B, keeping the name, options prefix, composed objects and null spaces of A
+*/
+static PetscErrorCode MatAutotuneReplace_Private(Mat A,Mat *B)
+{
+  PetscErrorCode  ierr;
+  PetscObject     a = (PetscObject)A,b = (PetscObject)*B;
+  PetscObjectList olist;
+  MatNullSpace    sp;
+  char            *str;
+
+  PetscFunctionBegin;
+  /* MatHeaderReplace() gives A the complete header of B, so move the parts of A that describe the object rather than the format to B */
+  str = a->name;   a->name   = b->name;   b->name   = str;
+  str = a->prefix; a->prefix = b->prefix; b->prefix = str;
+  olist = a->olist; a->olist = b->olist; b->olist = olist;
+  sp = A->nullsp;      A->nullsp      = (*B)->nullsp;      (*B)->nullsp      = sp;
+  sp = A->transnullsp; A->transnullsp = (*B)->transnullsp; (*B)->transnullsp = sp;
+  sp = A->nearnullsp;  A->nearnullsp  = (*B)->nearnullsp;  (*B)->nearnullsp  = sp;
+  (*B)->symmetric_eternal = A->symmetric_eternal;
+  (*B)->spd               = A->spd;
+  (*B)->spd_set           = A->spd_set;
+  ierr = MatHeaderReplace(A,B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* times the candidate formats, or looks the matrix up in the cache, and converts A to the selected one */
+static PetscErrorCode MatAutotuneSelect_Private(Mat A)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    size,rank;
+  PetscInt       ntypes = MAT_AUTOTUNE_MAX_TYPES,its = 10,i,k,bs;
+  char           *types[MAT_AUTOTUNE_MAX_TYPES],cache[PETSC_MAX_PATH_LEN],sig[PETSC_MAX_PATH_LEN],best[256],fulltype[256];
+  PetscBool      flg,usecache,same;
+  PetscLogDouble t0,t1,t,tbest = 0.0;
+  Vec            x,y;
+  Mat            B;
+  FILE           *fd;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+
+  ierr = PetscOptionsGetStringArray(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_autotune_types",types,&ntypes,&flg);CHKERRQ(ierr);
+  if (!flg) {
+    ntypes = 0;
+    ierr = PetscStrallocpy(MATAIJ,&types[ntypes++]);CHKERRQ(ierr);
+    ierr = PetscStrallocpy(MATAIJPERM,&types[ntypes++]);CHKERRQ(ierr);
+    ierr = PetscStrallocpy(MATSELL,&types[ntypes++]);CHKERRQ(ierr);
+    if (bs > 1) {ierr = PetscStrallocpy(MATBAIJ,&types[ntypes++]);CHKERRQ(ierr);}
+  }
+  /* the base names such as aij only resolve in MatSetType(), so compare against the full name of the format */
+  for (i=0; i<ntypes; i++) {
+    ierr = PetscStrbeginswith(types[i],size > 1 ? "mpi" : "seq",&flg);CHKERRQ(ierr);
+    if (flg) continue;
+    ierr = PetscSNPrintf(fulltype,sizeof(fulltype),"%s%s",size > 1 ? "mpi" : "seq",types[i]);CHKERRQ(ierr);
+    ierr = PetscFree(types[i]);CHKERRQ(ierr);
+    ierr = PetscStrallocpy(fulltype,&types[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsGetInt(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_autotune_its",&its,NULL);CHKERRQ(ierr);
+  its  = PetscMax(its,1);
+  ierr = PetscOptionsGetString(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_autotune_cache",cache,sizeof(cache),&usecache);CHKERRQ(ierr);
+
+  best[0] = 0;
+  if (usecache) {
+    ierr = MatAutotuneSignature_Private(A,sig,sizeof(sig));CHKERRQ(ierr);
+    ierr = MatAutotuneCacheLookup_Private(comm,cache,sig,best,sizeof(best));CHKERRQ(ierr);
+    if (best[0]) {ierr = PetscInfo2(A,"Using format %s recorded in %s\n",best,cache);CHKERRQ(ierr);}
+  }
+
+  if (!best[0] && ntypes) {
+    ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+    ierr = VecSet(x,1.0);CHKERRQ(ierr);
+    for (i=0; i<ntypes; i++) {
+      ierr = PetscObjectTypeCompare((PetscObject)A,types[i],&same);CHKERRQ(ierr);
+      if (same) B = A;
+      else {ierr = MatConvert(A,types[i],MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);}
+      ierr = MatMult(B,x,y);CHKERRQ(ierr);
+      ierr = MPI_Barrier(comm);CHKERRQ(ierr);
+      ierr = PetscTime(&t0);CHKERRQ(ierr);
+      for (k=0; k<its; k++) {ierr = MatMult(B,x,y);CHKERRQ(ierr);}
+      ierr = PetscTime(&t1);CHKERRQ(ierr);
+      t    = t1 - t0;
+      ierr = MPIU_Allreduce(&t,&t1,1,MPI_DOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+      ierr = PetscInfo3(A,"Format %s: %g seconds for %D MatMult()\n",types[i],t1,its);CHKERRQ(ierr);
+      if (!i || t1 < tbest) {
+        ierr  = PetscStrncpy(best,types[i],sizeof(best));CHKERRQ(ierr);
+        tbest = t1;
+      }
+      if (B != A) {ierr = MatDestroy(&B);CHKERRQ(ierr);}
+    }
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+    ierr = PetscInfo1(A,"Selected format %s\n",best);CHKERRQ(ierr);
+    if (usecache && !rank) {
+      ierr = PetscFOpen(PETSC_COMM_SELF,cache,"a",&fd);CHKERRQ(ierr);
+      ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"%s %s\n",sig,best);CHKERRQ(ierr);
+      ierr = PetscFClose(PETSC_COMM_SELF,fd);CHKERRQ(ierr);
+    }
+  }
+  for (i=0; i<ntypes; i++) {ierr = PetscFree(types[i]);CHKERRQ(ierr);}
+
+  if (best[0]) {
+    ierr = PetscObjectTypeCompare((PetscObject)A,best,&same);CHKERRQ(ierr);
+    if (!same) {
+      ierr = MatConvert(A,best,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+      ierr = MatAutotuneReplace_Private(A,&B);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+
+/*
+   MatAutotune_Private - Converts a matrix to the storage format with the fastest MatMult() among a set of candidates
+
+   Collective on Mat
+
+   Input Parameter:
+.  A - the assembled matrix, converted in place
+
+   Options Database Keys:
++  -mat_autotune_types <aij,aijperm,sell> - the candidate formats, the default includes baij if the block size is larger than one
+.  -mat_autotune_its <10> - number of MatMult() timed for each candidate
+-  -mat_autotune_cache <file> - file recording the format selected for each nonzero structure, matrices found in it are not timed
+
+   Notes:
+   Called by MatAssemblyEnd() for the first final assembly after MatSetAutotune(). The times are maximized over
+   the processes so that all processes select the same format.
+
+   MATAIJCRL is not a default candidate since it keeps a copy of the values that operations changing the values
+   without an assembly, such as MatScale(), do not update.
+*/
+PetscErrorCode MatAutotune_Private(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  A->autotune = PETSC_FALSE;
+  /* the candidates are assembled by MatConvert(), they must not be tuned themselves */
+  if (MatAutotune_InUse) PetscFunctionReturn(0);
+  MatAutotune_InUse = PETSC_TRUE;
+  ierr = MatAutotuneSelect_Private(A);
+  MatAutotune_InUse = PETSC_FALSE;
+  CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSetAutotune - Requests that the storage format of a matrix be replaced, after its first assembly, by the
+   format with the fastest MatMult() for its nonzero structure
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+-  flg - PETSC_TRUE to select the format at the next final assembly
+
+   Options Database Keys:
++  -mat_autotune - calls MatSetAutotune() from MatSetFromOptions()
+.  -mat_autotune_types <aij,aijperm,sell> - the candidate formats, the default includes baij if the block size is larger than one
+.  -mat_autotune_its <10> - number of MatMult() timed for each candidate
+-  -mat_autotune_cache <file> - file recording the format selected for each nonzero structure; later runs use the
+                                recorded format for matrices with the same structure instead of timing the candidates
+
+   Notes:
+   The candidates are created with MatConvert() and timed on the assembled matrix, the winner then replaces the
+   matrix in place, keeping its name, options prefix, composed objects and null spaces. Later assemblies keep the
+   selected format. Run with -info to see the time of each candidate. MATAIJCRL is only tried if it is listed
+   with -mat_autotune_types, since operations such as MatScale() do not update its copy of the values.
+   Restrict the candidates with -mat_autotune_types when the matrix is used with solvers or preconditioners that
+   do not support all the formats.
+
+   The cache file is keyed by the sizes, block size, number of nonzeros, number of processes and a hash of the
+   column indices of the matrix, so it should be removed when the machine or the PETSc build changes.
+
+   Level: intermediate
+
+.seealso: MatConvert(), MatSetType(), MATAUTO
+@*/
+PetscErrorCode MatSetAutotune(Mat A,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveBool(A,flg,2);
+  A->autotune = flg;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATAUTO - MATAUTO = "auto" - A matrix that is created as MATAIJ and, after its first assembly, is converted to
+   the format with the fastest MatMult(), see MatSetAutotune()
+
+   Options Database Keys:
++  -mat_type auto - sets the matrix type to "auto" during a call to MatSetFromOptions()
+.  -mat_autotune_types <aij,aijperm,sell> - the candidate formats
+.  -mat_autotune_its <10> - number of MatMult() timed for each candidate
+-  -mat_autotune_cache <file> - file recording the format selected for each nonzero structure
+
+   Level: intermediate
+
+.seealso: MatSetAutotune(), MatCreateAIJ(), MATAIJPERM, MATSELL, MATBAIJ
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_Auto(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetAutotune(A,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,149 @@
+
+/*
+   Helpers for the assembly of matrices from coordinate (COO) lists, see MatSetPreallocationCOO()
+*/
+#include <petsc/private/matimpl.h>   /*I "petscmat.h" I*/
+
+/*
+   MatCOOSortEntries_Private - Groups coordinate entries by bucket (usually a local row) and column, merging repeated ones
+
+   Input Parameters:
++  nb     - number of buckets
+.  n      - number of entries
+.  bucket - bucket of each entry, entries with a negative bucket are ignored
+-  col    - column of each entry
+
+   Output Parameters:
++  bi   - offsets in bj[] of the merged entries of each bucket, of length nb+1
+.  bj   - sorted columns of the merged entries of each bucket
+.  jmap - offsets in perm[] of the entries merged into each merged entry, of length bi[nb]+1
+-  perm - indices of the entries merged into each merged entry, of length jmap[bi[nb]]
+
+   Notes:
+   The sort is a counting sort on the buckets followed by a sort of the columns of each bucket, so the cost is linear in
+   n and nb up to the sort of the longest bucket. Free the outputs with PetscFree().
+*/
+PetscErrorCode MatCOOSortEntries_Private(PetscInt nb,PetscInt n,const PetscInt bucket[],const PetscInt col[],PetscInt **bi,PetscInt **bj,PetscInt **jmap,PetscInt **perm)
+{
+  PetscErrorCode ierr;
+  PetscInt       *off,*pos,*cols,*p,*Bi,*Bj,*Jmap,b,e,k,nu;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc2(nb+1,&off,nb,&pos);CHKERRQ(ierr);
+  for (e=0; e<n; e++) {
+    if (bucket[e] >= 0) off[bucket[e]+1]++;
+  }
+  for (b=0; b<nb; b++) {
+    off[b+1] += off[b];
+    pos[b]    = off[b];
+  }
+  ierr = PetscMalloc1(off[nb],&cols);CHKERRQ(ierr);
+  ierr = PetscMalloc1(off[nb],&p);CHKERRQ(ierr);
+  for (e=0; e<n; e++) {
+    if (bucket[e] < 0) continue;
+    k       = pos[bucket[e]]++;
+    cols[k] = col[e];
+    p[k]    = e;
+  }
+  for (b=0,nu=0; b<nb; b++) {
+    ierr = PetscSortIntWithArray(off[b+1]-off[b],cols+off[b],p+off[b]);CHKERRQ(ierr);
+    for (k=off[b]; k<off[b+1]; k++) {
+      if (k == off[b] || cols[k] != cols[k-1]) nu++;
+    }
+  }
+  ierr = PetscMalloc1(nb+1,&Bi);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nu,&Bj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nu+1,&Jmap);CHKERRQ(ierr);
+  Bi[0] = Jmap[0] = 0;
+  for (b=0,nu=0; b<nb; b++) {
+    for (k=off[b]; k<off[b+1]; k++) {
+      if (k == off[b] || cols[k] != cols[k-1]) Bj[nu++] = cols[k];
+      Jmap[nu] = k+1;
+    }
+    Bi[b+1] = nu;
+  }
+  ierr = PetscFree(cols);CHKERRQ(ierr);
+  ierr = PetscFree2(off,pos);CHKERRQ(ierr);
+  *bi = Bi; *bj = Bj; *jmap = Jmap; *perm = p;
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  PetscInt n,*i,*j;   /* the coordinates given to MatSetPreallocationCOO() */
+} MatCOO_Basic;
+
+static PetscErrorCode MatCOODestroy_Basic(void *ptr)
+{
+  MatCOO_Basic   *coo = (MatCOO_Basic*)ptr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(coo->i,coo->j);CHKERRQ(ierr);
+  ierr = PetscFree(coo);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSetPreallocationCOO_Basic - Preallocates a matrix of any type through MATPREALLOCATOR and keeps a copy of the
+   coordinates for MatSetValuesCOO_Basic(), which inserts the values with MatSetValues()
+*/
+PetscErrorCode MatSetPreallocationCOO_Basic(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr;
+  Mat            preallocator;
+  PetscContainer container;
+  MatCOO_Basic   *coo;
+  PetscInt       n;
+  PetscScalar    zero = 0.0;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),&preallocator);CHKERRQ(ierr);
+  ierr = MatSetType(preallocator,MATPREALLOCATOR);CHKERRQ(ierr);
+  ierr = MatSetSizes(preallocator,A->rmap->n,A->cmap->n,A->rmap->N,A->cmap->N);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(preallocator,A,A);CHKERRQ(ierr);
+  ierr = MatSetUp(preallocator);CHKERRQ(ierr);
+  for (n=0; n<ncoo; n++) {
+    if (coo_i[n] < 0 || coo_j[n] < 0) continue;
+    ierr = MatSetValues(preallocator,1,coo_i+n,1,coo_j+n,&zero,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr); /* for the types that MatXAIJSetPreallocation() ignores */
+  ierr = MatPreallocatorPreallocate(preallocator,PETSC_TRUE,A);CHKERRQ(ierr);
+  ierr = MatDestroy(&preallocator);CHKERRQ(ierr);
+
+  ierr = PetscNew(&coo);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ncoo,&coo->i,ncoo,&coo->j);CHKERRQ(ierr);
+  ierr = PetscMemcpy(coo->i,coo_i,ncoo*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMemcpy(coo->j,coo_j,ncoo*sizeof(PetscInt));CHKERRQ(ierr);
+  coo->n = ncoo;
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,coo);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatCOODestroy_Basic);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_MatCOO_Basic",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO_Basic(A,NULL,ADD_VALUES);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_Basic(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscErrorCode ierr;
+  PetscContainer container;
+  MatCOO_Basic   *coo;
+  PetscInt       n;
+  PetscScalar    zero = 0.0;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_MatCOO_Basic",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  ierr = PetscContainerGetPointer(container,(void**)&coo);CHKERRQ(ierr);
+  if (imode == INSERT_VALUES) {ierr = MatZeroEntries(A);CHKERRQ(ierr);}
+  for (n=0; n<coo->n; n++) {
+    if (coo->i[n] < 0 || coo->j[n] < 0) continue;
+    ierr = MatSetValues(A,1,coo->i+n,1,coo->j+n,coo_v ? coo_v+n : &zero,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
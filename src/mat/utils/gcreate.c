@@ -53,7 +53,9 @@ PETSC_INTERN PetscErrorCode MatShift_Basic(Mat Y,PetscScalar a)
 .    -mat_type seqdense - dense type, uses MatCreateSeqDense()
 .    -mat_type mpidense - dense type, uses MatCreateDense()
 .    -mat_type seqbaij  - block AIJ type, uses MatCreateSeqBAIJ()
--    -mat_type mpibaij  - block AIJ type, uses MatCreateBAIJ()
+.    -mat_type mpibaij  - block AIJ type, uses MatCreateBAIJ()
+.    -mat_type auto     - AIJ type converted to the format with the fastest MatMult() after assembly, see MatSetAutotune()
+-    -mat_autotune      - select the format with the fastest MatMult() after assembly for any type, see MatSetAutotune()
 
    Even More Options Database Keys:
    See the manpages for particular formats (e.g., MatCreateSeqAIJ())
@@ -234,6 +236,7 @@ PetscErrorCode  MatSetFromOptions(Mat B)
   ierr = PetscOptionsName("-mat_is_symmetric","Checks if mat is symmetric on MatAssemblyEnd()","MatIsSymmetric",&B->checksymmetryonassembly);CHKERRQ(ierr);
   ierr = PetscOptionsReal("-mat_is_symmetric","Checks if mat is symmetric on MatAssemblyEnd()","MatIsSymmetric",B->checksymmetrytol,&B->checksymmetrytol,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-mat_null_space_test","Checks if provided null space is correct in MatAssemblyEnd()","MatSetNullSpaceTest",B->checknullspaceonassembly,&B->checknullspaceonassembly,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_autotune","Select the format with the fastest MatMult() in MatAssemblyEnd()","MatSetAutotune",B->autotune,&B->autotune,NULL);CHKERRQ(ierr);
 
   if (B->ops->setfromoptions) {
     ierr = (*B->ops->setfromoptions)(PetscOptionsObject,B);CHKERRQ(ierr);
@@ -0,0 +1,100 @@
+
+/*
+   Run-time selection of the instruction set used by the matrix-vector product kernels of MATSEQAIJ,
+   MATSEQAIJPERM and MATSEQSELL
+*/
+#include <petsc/private/matimpl.h>   /*I "petscmat.h" I*/
+#include <petsc/private/kernels/isadispatch.h>
+
+const char *const MatKernelISAs[] = {"scalar","avx","avx2","avx512","MatKernelISA","MAT_KERNEL_",0};
+
+static const char *const MatKernelISANames[] = {"scalar","AVX","AVX2+FMA","AVX-512"};
+
+static PetscBool    MatKernelISADetected = PETSC_FALSE;
+static MatKernelISA MatKernelISAMax      = MAT_KERNEL_SCALAR;
+
+/*
+   MatKernelISADetect_Private - Determines the most capable instruction set that both this build of PETSc and the processor support
+*/
+static MatKernelISA MatKernelISADetect_Private(void)
+{
+#if defined(PETSC_HAVE_KERNEL_ISA_RUNTIME_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return MAT_KERNEL_AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return MAT_KERNEL_AVX2;
+  if (__builtin_cpu_supports("avx")) return MAT_KERNEL_AVX;
+  return MAT_KERNEL_SCALAR;
+#elif defined(PETSC_HAVE_KERNEL_AVX512)
+  return MAT_KERNEL_AVX512;
+#elif defined(PETSC_HAVE_KERNEL_AVX2)
+  return MAT_KERNEL_AVX2;
+#elif defined(PETSC_HAVE_KERNEL_AVX)
+  return MAT_KERNEL_AVX;
+#else
+  return MAT_KERNEL_SCALAR;
+#endif
+}
+
+/*
+   MatGetKernelISA_Private - Selects the instruction set for the matrix-vector product kernels of a sequential matrix
+
+   Input Parameter:
+.  A - the matrix, its options prefix is used
+
+   Output Parameter:
+.  isa - the most capable instruction set available, or the one requested with -mat_kernel_isa if that is less capable
+
+   Options Database Key:
+.  -mat_kernel_isa <scalar,avx,avx2,avx512> - limits the instruction set used by the kernels
+
+   Notes:
+   Formats that do not have kernels for the selected instruction set use the next less capable one they have.
+*/
+PetscErrorCode MatGetKernelISA_Private(Mat A,MatKernelISA *isa)
+{
+  PetscErrorCode ierr;
+  MatKernelISA   req;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  if (!MatKernelISADetected) {
+    MatKernelISAMax      = MatKernelISADetect_Private();
+    MatKernelISADetected = PETSC_TRUE;
+    ierr = PetscInfo1(NULL,"Matrix-vector product kernels can use %s instructions\n",MatKernelISANames[MatKernelISAMax]);CHKERRQ(ierr);
+  }
+  *isa = MatKernelISAMax;
+  ierr = PetscOptionsGetEnum(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_kernel_isa",MatKernelISAs,(PetscEnum*)&req,&flg);CHKERRQ(ierr);
+  if (flg) {
+    if (req > MatKernelISAMax) {
+      ierr = PetscInfo2(A,"%s kernels are not supported by this processor or build of PETSc, using %s kernels\n",MatKernelISANames[req],MatKernelISANames[MatKernelISAMax]);CHKERRQ(ierr);
+    } else *isa = req;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatKernelISAView_Private - Reports which matrix-vector product kernels a sequential matrix uses, if -mat_view_kernel is given
+
+   Input Parameters:
++  A - the matrix
+.  isa - the instruction set of the kernels
+-  note - additional information, for example about operations that use other kernels, or NULL
+
+   Notes:
+   Called at the end of each final assembly, like the -mat_view option.
+*/
+PetscErrorCode MatKernelISAView_Private(Mat A,MatKernelISA isa,const char note[])
+{
+  PetscErrorCode ierr;
+  PetscBool      flg;
+  PetscViewer    viewer;
+  const char     *prefix;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHasName(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_view_kernel",&flg);CHKERRQ(ierr);
+  if (!flg) PetscFunctionReturn(0);
+  ierr = PetscObjectGetOptionsPrefix((PetscObject)A,&prefix);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIGetStdout(PETSC_COMM_SELF,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Mat Object (%s) type %s: %D rows, %s matrix-vector product kernels%s%s\n",prefix ? prefix : "no prefix",((PetscObject)A)->type_name,A->rmap->n,MatKernelISANames[isa],note ? ", " : "",note ? note : "");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,341 @@
+
+/*
+    Multicolor ordering of the (block) rows for thread-parallel MatSOR() sweeps, see MatSORSetMulticolor()
+
+    The rows are colored so that no two coupled rows share a color, then the rows of one color are relaxed
+  simultaneously by the threads, one color after the other. The off-diagonal entries are copied, color by color
+  and with the schedule of the sweeps, into arrays ordered by color so that each thread streams contiguous memory
+  that it touched first.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>   /*I "petscmat.h" I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+PetscErrorCode MatSORMulticolorReset_Private(MatSORMulticolor *mc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(mc->cstart,mc->rows);CHKERRQ(ierr);
+  ierr = PetscFree(mc->i);CHKERRQ(ierr);
+  ierr = PetscFree(mc->j);CHKERRQ(ierr);
+  ierr = PetscFree(mc->a);CHKERRQ(ierr);
+  ierr = PetscFree(mc->work);CHKERRQ(ierr);
+  mc->valid        = PETSC_FALSE;
+  mc->ncolors      = 0;
+  mc->nonzerostate = 0;
+  mc->state        = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Colors the graph of the (block) rows, made symmetric since MatSOR() uses both triangular parts */
+static PetscErrorCode MatSORMulticolorColor_Private(Mat A,PetscInt m,const PetscInt ai[],const PetscInt aj[],MatSORMulticolor *mc)
+{
+  Mat            G,Gt;
+  MatScalar      *zeros;
+  MatColoring    coloring;
+  ISColoring     iscoloring;
+  IS             *is;
+  const PetscInt *idx;
+  const char     *prefix;
+  PetscInt       nc,c,n,r,k,*color;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(ai[m],&zeros);CHKERRQ(ierr);
+  ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF,m,m,(PetscInt*)ai,(PetscInt*)aj,zeros,&G);CHKERRQ(ierr);
+  ierr = MatTranspose(G,MAT_INITIAL_MATRIX,&Gt);CHKERRQ(ierr);
+  ierr = MatAXPY(Gt,1.0,G,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  ierr = PetscFree(zeros);CHKERRQ(ierr);
+
+  ierr = MatColoringCreate(Gt,&coloring);CHKERRQ(ierr);
+  ierr = PetscObjectGetOptionsPrefix((PetscObject)A,&prefix);CHKERRQ(ierr);
+  ierr = PetscObjectSetOptionsPrefix((PetscObject)coloring,prefix);CHKERRQ(ierr);
+  ierr = PetscObjectAppendOptionsPrefix((PetscObject)coloring,"mat_sor_");CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(coloring,1);CHKERRQ(ierr);
+  ierr = MatColoringSetType(coloring,MATCOLORINGGREEDY);CHKERRQ(ierr);
+  ierr = MatColoringSetWeightType(coloring,MAT_COLORING_WEIGHT_LEXICAL);CHKERRQ(ierr);
+  ierr = MatColoringSetFromOptions(coloring);CHKERRQ(ierr);
+  ierr = MatColoringApply(coloring,&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&coloring);CHKERRQ(ierr);
+  ierr = MatDestroy(&Gt);CHKERRQ(ierr);
+
+  /* rows are sorted within each color so that the sweeps stream the vectors in increasing order */
+  ierr = ISColoringGetIS(iscoloring,&nc,&is);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nc+1,&mc->cstart,m,&mc->rows);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m,&color);CHKERRQ(ierr);
+  mc->cstart[0] = 0;
+  for (c=0; c<nc; c++) {
+    ierr = ISGetLocalSize(is[c],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is[c],&idx);CHKERRQ(ierr);
+    for (k=0; k<n; k++) {
+      mc->rows[mc->cstart[c]+k] = idx[k];
+      color[idx[k]]             = c;
+    }
+    ierr = ISRestoreIndices(is[c],&idx);CHKERRQ(ierr);
+    ierr = PetscSortInt(n,mc->rows+mc->cstart[c]);CHKERRQ(ierr);
+    mc->cstart[c+1] = mc->cstart[c] + n;
+  }
+  ierr = ISColoringRestoreIS(iscoloring,&is);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+  mc->ncolors = nc;
+
+  mc->valid = (PetscBool)(mc->cstart[nc] == m);
+  for (r=0; r<m && mc->valid; r++) {
+    for (k=ai[r]; k<ai[r+1]; k++) {
+      if (aj[k] != r && color[aj[k]] == color[r]) {mc->valid = PETSC_FALSE; break;}
+    }
+  }
+  ierr = PetscFree(color);CHKERRQ(ierr);
+  if (mc->valid) {
+    ierr = PetscInfo2(A,"Colored %D rows with %D colors for multicolor SOR\n",m,nc);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo(A,"The coloring does not separate the coupled rows, using the sequential SOR sweeps\n");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Copies the off-diagonal entries in the order of the colors, with the schedule of the sweeps */
+static void MatSORMulticolorCopy_Private(MatSORMulticolor *mc,const PetscInt ai[],const PetscInt aj[],const MatScalar aa[],PetscBool structure)
+{
+  PetscInt bs2 = mc->bs*mc->bs;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(mc->nthreads)
+#endif
+  {
+    PetscInt c,p,r,k,l,q;
+
+    for (c=0; c<mc->ncolors; c++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static) nowait
+#endif
+      for (p=mc->cstart[c]; p<mc->cstart[c+1]; p++) {
+        r = mc->rows[p];
+        q = mc->i[p];
+        for (k=ai[r]; k<ai[r+1]; k++) {
+          if (aj[k] == r) continue;
+          if (structure) mc->j[q] = aj[k];
+          for (l=0; l<bs2; l++) mc->a[bs2*q+l] = aa[bs2*k+l];
+          q++;
+        }
+      }
+    }
+  }
+}
+
+/*
+   MatSORMulticolorSetUp_Private - Colors the (block) rows of a matrix, if its nonzero pattern changed since the last
+   call, and copies its off-diagonal entries in the order of the colors, if the matrix changed since the last call
+
+   Input Parameters:
++  A  - the matrix
+.  bs - the block size
+.  m  - the number of (block) rows
+-  ai, aj, aa - the (block) compressed row storage of the matrix, with blocks stored by columns
+
+   Output Parameter:
+.  mc - the multicolor ordering, mc->valid is PETSC_FALSE if the coloring failed to separate the coupled rows
+*/
+PetscErrorCode MatSORMulticolorSetUp_Private(Mat A,PetscInt bs,PetscInt m,const PetscInt ai[],const PetscInt aj[],const MatScalar aa[],MatSORMulticolor *mc)
+{
+  PetscObjectState state;
+  PetscBool        structure = PETSC_FALSE;
+  PetscInt         p,r,k,nthreads = mc->nthreads;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (!mc->rows || mc->nonzerostate != A->nonzerostate || mc->bs != bs) {
+    ierr = MatSORMulticolorReset_Private(mc);CHKERRQ(ierr);
+    ierr = MatSORMulticolorColor_Private(A,m,ai,aj,mc);CHKERRQ(ierr);
+    mc->nonzerostate = A->nonzerostate;
+    mc->bs           = bs;
+    if (!mc->valid) PetscFunctionReturn(0);
+    ierr = PetscMalloc1(m+1,&mc->i);CHKERRQ(ierr);
+    mc->i[0] = 0;
+    for (p=0; p<m; p++) {
+      r          = mc->rows[p];
+      mc->i[p+1] = mc->i[p];
+      for (k=ai[r]; k<ai[r+1]; k++) {
+        if (aj[k] != r) mc->i[p+1]++;
+      }
+    }
+    ierr = PetscMalloc1(mc->i[m],&mc->j);CHKERRQ(ierr);
+    ierr = PetscMalloc1(bs*bs*mc->i[m],&mc->a);CHKERRQ(ierr);
+    ierr = PetscMalloc1(bs*nthreads,&mc->work);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(2*m+mc->ncolors+2+mc->i[m])*sizeof(PetscInt)+(bs*bs*mc->i[m]+bs*nthreads)*sizeof(PetscScalar));CHKERRQ(ierr);
+    structure = PETSC_TRUE;
+  }
+  if (!mc->valid) PetscFunctionReturn(0);
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (structure || mc->state != state) {
+    MatSORMulticolorCopy_Private(mc,ai,aj,aa,structure);
+    mc->state = state;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Relaxes the rows of color c, called by all the threads of a parallel region */
+PETSC_STATIC_INLINE void MatSORMulticolorRelax_Private(const MatSORMulticolor *mc,PetscInt c,PetscReal omega,const MatScalar idiag[],const PetscScalar b[],PetscScalar x[])
+{
+  const PetscInt  *rows = mc->rows,*ci = mc->i,*cj = mc->j,bs = mc->bs,bs2 = bs*bs;
+  const MatScalar *ca = mc->a;
+  PetscInt        p,r,k,l,q,n;
+
+  if (bs == 1) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (p=mc->cstart[c]; p<mc->cstart[c+1]; p++) {
+      const PetscInt  *vi = cj + ci[p];
+      const MatScalar *v  = ca + ci[p];
+      PetscScalar     sum;
+
+      r   = rows[p];
+      n   = ci[p+1] - ci[p];
+      sum = b[r];
+      PetscSparseDenseMinusDot(sum,x,v,vi,n);
+      x[r] = (1.0-omega)*x[r] + sum*idiag[r];
+    }
+  } else {
+    PetscScalar *s = mc->work;
+
+#if defined(PETSC_HAVE_OPENMP)
+    s += bs*omp_get_thread_num();
+#pragma omp for schedule(static)
+#endif
+    for (p=mc->cstart[c]; p<mc->cstart[c+1]; p++) {
+      const MatScalar *v,*d;
+      PetscScalar     *xr,t;
+
+      r = rows[p];
+      for (l=0; l<bs; l++) s[l] = b[bs*r+l];
+      for (k=ci[p]; k<ci[p+1]; k++) {
+        v  = ca + bs2*k;
+        xr = x + bs*cj[k];
+        for (q=0; q<bs; q++) {
+          for (l=0; l<bs; l++) s[l] -= v[l+bs*q]*xr[q];
+        }
+      }
+      d  = idiag + bs2*r;
+      xr = x + bs*r;
+      for (l=0; l<bs; l++) {
+        t = 0.0;
+        for (q=0; q<bs; q++) t += d[l+bs*q]*s[q];
+        xr[l] = (1.0-omega)*xr[l] + t;
+      }
+    }
+  }
+}
+
+/*
+   MatSORMulticolorApply_Private - Performs its multicolor SOR sweeps, forward sweeps visit the colors in increasing
+   order and backward sweeps in decreasing order
+
+   Input Parameters:
++  mc    - the multicolor ordering, set up with MatSORMulticolorSetUp_Private()
+.  omega - the relaxation factor
+.  flag  - the sweeps, SOR_EISENSTAT, SOR_APPLY_UPPER and SOR_APPLY_LOWER are not supported
+.  its   - the number of iterations
+.  idiag - the inverses of the (block) diagonal entries, already multiplied by omega
+-  b     - the right-hand side
+
+   Output Parameter:
+.  x - the solution, which is also the initial guess unless SOR_ZERO_INITIAL_GUESS is set
+*/
+PetscErrorCode MatSORMulticolorApply_Private(const MatSORMulticolor *mc,PetscReal omega,MatSORType flag,PetscInt its,const MatScalar idiag[],const PetscScalar b[],PetscScalar x[])
+{
+  PetscInt       m = mc->cstart[mc->ncolors]*mc->bs;
+  PetscBool      forward  = (PetscBool)!!(flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP));
+  PetscBool      backward = (PetscBool)!!(flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP));
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    ierr = PetscMemzero(x,m*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads(mc->nthreads)
+#endif
+  {
+    PetscInt it,c;
+
+    for (it=0; it<its; it++) {
+      if (forward) {
+        for (c=0; c<mc->ncolors; c++) MatSORMulticolorRelax_Private(mc,c,omega,idiag,b,x);
+      }
+      if (backward) {
+        for (c=mc->ncolors-1; c>=0; c--) MatSORMulticolorRelax_Private(mc,c,omega,idiag,b,x);
+      }
+    }
+  }
+  ierr = PetscLogFlops(its*((forward ? 1 : 0) + (backward ? 1 : 0))*(2.0*mc->bs*mc->bs*(mc->i[mc->cstart[mc->ncolors]] + mc->cstart[mc->ncolors])));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSORSetMulticolor - Makes MatSOR() sweep the rows of a matrix by colors, the rows of each color being relaxed
+   in parallel by OpenMP threads
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A - the matrix
+-  nthreads - the number of threads, PETSC_DECIDE to use the OpenMP default, or 0 to sweep the rows in their natural order
+
+   Options Database Keys:
++  -mat_sor_multicolor <nthreads> - sets the number of threads of the multicolor sweeps
+-  -mat_sor_mat_coloring_type <greedy,jp,...> - the coloring used, see MatColoringSetFromOptions()
+
+   Level: intermediate
+
+   Notes:
+   The rows are colored once for each nonzero pattern, with a distance one MatColoring of the graph of A + A^T, so
+   that rows of the same color do not depend on each other. Forward sweeps then relax the colors in increasing order
+   and backward sweeps in decreasing order, all the threads sharing the rows of each color. The off-diagonal entries
+   are copied into arrays ordered by color, by the threads that use them, whenever the matrix changes.
+
+   This is a different ordering than that of the rows, so the results differ from the sequential sweeps, but they do
+   not depend on the number of threads. With few colors, such as the two colors of a five point stencil, each sweep
+   propagates information less far than a sequential sweep, and more iterations may be needed.
+
+   Supported by MATSEQAIJ and MATSEQBAIJ, and therefore by the diagonal blocks used by the local sweeps of MATMPIAIJ and
+   MATMPIBAIJ, which read -mat_sor_multicolor when they are created. MATSEQBAIJ only uses the multicolor sweeps with
+   omega equal to one and no shift. SOR_EISENSTAT, SOR_APPLY_UPPER and SOR_APPLY_LOWER always use the sequential code.
+
+.seealso: MatSOR(), PCSOR, MatColoringCreate(), MatSeqAIJSetNumThreads()
+@*/
+PetscErrorCode MatSORSetMulticolor(Mat A,PetscInt nthreads)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveInt(A,nthreads,2);
+  ierr = PetscTryMethod(A,"MatSORSetMulticolor_C",(Mat,PetscInt),(A,nthreads));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSORMulticolorSetNumThreads_Private - Implementation of MatSORSetMulticolor() shared by the sequential formats
+*/
+PetscErrorCode MatSORMulticolorSetNumThreads_Private(Mat A,PetscInt nthreads,MatSORMulticolor *mc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nthreads == PETSC_DEFAULT || nthreads == PETSC_DECIDE) {
+#if defined(PETSC_HAVE_OPENMP)
+    nthreads = omp_get_max_threads();
+#else
+    nthreads = 1;
+#endif
+  }
+  if (nthreads < 0) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D cannot be negative",nthreads);
+  if (nthreads == mc->nthreads) PetscFunctionReturn(0);
+  ierr = MatSORMulticolorReset_Private(mc);CHKERRQ(ierr);
+  mc->nthreads = nthreads;
+  PetscFunctionReturn(0);
+}
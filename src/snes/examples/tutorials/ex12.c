@@ -42,6 +42,7 @@ typedef struct {
   /* Problem definition */
   BCType         bcType;
   CoeffType      variableCoefficient;
+  PetscBool      vectorKernels;     /* Use pointwise functions which evaluate a block of points at once */
   PetscErrorCode (**exactFuncs)(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx);
   PetscBool      fieldBC;
   void           (**exactFields)(PetscInt, PetscInt, PetscInt,
@@ -190,6 +191,34 @@ static void g3_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
   for (d = 0; d < dim; ++d) g3[d*dim+d] = 1.0;
 }
 
+/* The same functions evaluated on Ne points at once, where entry i for point e is stored at i*Ne+e */
+static void f0_u_vec(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Ne,
+                     const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                     const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                     PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt e;
+  for (e = 0; e < Ne; ++e) f0[e] = 4.0;
+}
+
+static void f1_u_vec(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Ne,
+                     const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                     const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                     PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt d, e;
+  for (d = 0; d < dim; ++d) for (e = 0; e < Ne; ++e) f1[d*Ne+e] = u_x[(uOff_x[0]+d)*Ne+e];
+}
+
+static void g3_uu_vec(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Ne,
+                      const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                      const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                      PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt d, e;
+  for (d = 0; d < dim; ++d) for (e = 0; e < Ne; ++e) g3[(d*dim+d)*Ne+e] = 1.0;
+}
+
 /*
   In 2D for x periodicity and y Dirichlet conditions, we use exact solution:
 
@@ -418,6 +447,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->refinementLimit     = 0.0;
   options->bcType              = DIRICHLET;
   options->variableCoefficient = COEFF_NONE;
+  options->vectorKernels       = PETSC_FALSE;
   options->fieldBC             = PETSC_FALSE;
   options->jacobianMF          = PETSC_FALSE;
   options->showInitial         = PETSC_FALSE;
@@ -458,6 +488,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   ierr = PetscOptionsEList("-variable_coefficient","Type of variable coefficent","ex12.c",coeffTypes,6,coeffTypes[options->variableCoefficient],&coeff,NULL);CHKERRQ(ierr);
   options->variableCoefficient = (CoeffType) coeff;
 
+  ierr = PetscOptionsBool("-vector_kernels", "Use pointwise functions which evaluate a block of points at once", "ex12.c", options->vectorKernels, &options->vectorKernels, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-field_bc", "Use a field representation for the BC", "ex12.c", options->fieldBC, &options->fieldBC, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-jacobian_mf", "Calculate the action of the Jacobian on the fly", "ex12.c", options->jacobianMF, &options->jacobianMF, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-show_initial", "Output the initial guess for verification", "ex12.c", options->showInitial, &options->showInitial, NULL);CHKERRQ(ierr);
@@ -624,6 +655,9 @@ static PetscErrorCode SetupProblem(PetscDS prob, AppCtx *user)
         ierr = PetscDSSetResidual(prob, 0, f0_xtrig_u,  f1_u);CHKERRQ(ierr);
         ierr = PetscDSSetJacobian(prob, 0, 0, NULL, NULL, NULL, g3_uu);CHKERRQ(ierr);
       }
+    } else if (user->vectorKernels) {
+      ierr = PetscDSSetResidualVec(prob, 0, f0_u_vec, f1_u_vec);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobianVec(prob, 0, 0, NULL, NULL, NULL, g3_uu_vec);CHKERRQ(ierr);
     } else {
       ierr = PetscDSSetResidual(prob, 0, f0_u, f1_u);CHKERRQ(ierr);
       ierr = PetscDSSetJacobian(prob, 0, 0, NULL, NULL, NULL, g3_uu);CHKERRQ(ierr);
@@ -946,7 +980,6 @@ int main(int argc, char **argv)
   Mat            A,J;         /* Jacobian matrix */
   MatNullSpace   nullSpace;   /* May be necessary for Neumann conditions */
   AppCtx         user;        /* user-defined work context */
-  JacActionCtx   userJ;       /* context for Jacobian MF action */
   PetscReal      error = 0.0; /* L_2 error in the solution */
   PetscBool      isFAS;
   PetscErrorCode ierr;
@@ -964,31 +997,9 @@ int main(int argc, char **argv)
   ierr = DMCreateGlobalVector(dm, &u);CHKERRQ(ierr);
   ierr = PetscObjectSetName((PetscObject) u, "potential");CHKERRQ(ierr);
 
-  ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);
-  if (user.jacobianMF) {
-    PetscInt M, m, N, n;
-
-    ierr = MatGetSize(J, &M, &N);CHKERRQ(ierr);
-    ierr = MatGetLocalSize(J, &m, &n);CHKERRQ(ierr);
-    ierr = MatCreate(PETSC_COMM_WORLD, &A);CHKERRQ(ierr);
-    ierr = MatSetSizes(A, m, n, M, N);CHKERRQ(ierr);
-    ierr = MatSetType(A, MATSHELL);CHKERRQ(ierr);
-    ierr = MatSetUp(A);CHKERRQ(ierr);
-#if 0
-    ierr = MatShellSetOperation(A, MATOP_MULT, (void (*)(void))FormJacobianAction);CHKERRQ(ierr);
-#endif
-
-    userJ.dm   = dm;
-    userJ.J    = J;
-    userJ.user = &user;
-
-    ierr = DMCreateLocalVector(dm, &userJ.u);CHKERRQ(ierr);
-    if (user.fieldBC) {ierr = DMProjectFieldLocal(dm, 0.0, userJ.u, user.exactFields, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);}
-    else              {ierr = DMProjectFunctionLocal(dm, 0.0, user.exactFuncs, NULL, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);}
-    ierr = MatShellSetContext(A, &userJ);CHKERRQ(ierr);
-  } else {
-    A = J;
-  }
+  if (user.jacobianMF) {ierr = DMPlexSNESCreateJacobianMF(dm, &J);CHKERRQ(ierr);}
+  else                 {ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);}
+  A = J;
   if (user.bcType == NEUMANN) {
     ierr = MatNullSpaceCreate(PetscObjectComm((PetscObject) dm), PETSC_TRUE, 0, NULL, &nullSpace);CHKERRQ(ierr);
     ierr = MatSetNullSpace(A, nullSpace);CHKERRQ(ierr);
@@ -1121,7 +1132,6 @@ int main(int argc, char **argv)
   ierr = VecViewFromOptions(u, NULL, "-vec_view");CHKERRQ(ierr);
 
   if (user.bcType == NEUMANN) {ierr = MatNullSpaceDestroy(&nullSpace);CHKERRQ(ierr);}
-  if (user.jacobianMF) {ierr = VecDestroy(&userJ.u);CHKERRQ(ierr);}
   if (A != J) {ierr = MatDestroy(&A);CHKERRQ(ierr);}
   ierr = MatDestroy(&J);CHKERRQ(ierr);
   ierr = VecDestroy(&u);CHKERRQ(ierr);
@@ -1757,6 +1767,29 @@ int main(int argc, char **argv)
     args: -quiet -run_type test -interpolate 1 -petscspace_order 1 -simplex 0 -petscspace_poly_tensor -dm_plex_convert_type p4est -dm_forest_minimum_refinement 5 -dm_forest_initial_refinement 5 -dm_forest_maximum_refinement 7 -dm_p4est_refine_pattern hash
     timeoutfactor: 5
 
+  # Batched integration over blocks of cells
+  test:
+    suffix: batch_0
+    args: -quiet -run_type test -simplex 0 -interpolate 1 -bc_type dirichlet -petscspace_order 2 -cells 3,3 -petscfe_type batch -petscfe_batch_cells 4 -check -ch_petscspace_order 2
+  test:
+    suffix: batch_1
+    args: -quiet -run_type test -dim 3 -simplex 0 -interpolate 1 -variable_coefficient field -petscspace_order 2 -mat_petscspace_order 1 -cells 2,2,3 -petscfe_type batch -petscfe_batch_cells 5 -check -ch_petscspace_order 2
+  test:
+    suffix: batch_vec
+    args: -run_type full -simplex 0 -interpolate 1 -bc_type dirichlet -petscspace_order 2 -cells 3,3 -petscfe_type batch -petscfe_batch_cells 4 -vector_kernels -pc_type lu -snes_monitor_short -snes_converged_reason
+
+  # Matrix-free Jacobian with sum factorization on tensor cells
+  test:
+    suffix: mf_0
+    args: -quiet -run_type test -simplex 0 -interpolate 1 -bc_type dirichlet -petscspace_order 3 -cells 3,3 -jacobian_mf
+  test:
+    suffix: mf_1
+    nsize: 2
+    args: -run_type full -simplex 0 -interpolate 1 -bc_type dirichlet -petscspace_order 3 -cells 4,4 -jacobian_mf -ksp_type cg -pc_type jacobi -ksp_rtol 1.0e-13 -snes_monitor_short -snes_converged_reason
+  test:
+    suffix: mf_2
+    args: -run_type full -dim 3 -simplex 0 -interpolate 1 -variable_coefficient field -petscspace_order 2 -mat_petscspace_order 1 -cells 2,2,2 -jacobian_mf -ksp_type cg -pc_type jacobi -ksp_rtol 1.0e-13 -snes_monitor_short -snes_converged_reason
+
   # Serial tests with GLVis visualization
   test:
     suffix: glvis_2d_tet_p1
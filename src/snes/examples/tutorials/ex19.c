@@ -684,6 +684,19 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       args: -snes_monitor_short -pc_type mg -dm_mat_type baij -mg_coarse_pc_type bjacobi -da_refine 3 -ksp_type fgmres
       requires: !single
 
+   test:
+      suffix: mult_split
+      nsize: 4
+      args: -da_refine 3 -snes_monitor_short -pc_type mg -ksp_type fgmres -pc_mg_type full -mat_mpiaij_mult_split
+      requires: !single
+
+   test:
+      suffix: mult_split_merge
+      nsize: 4
+      args: -da_refine 3 -snes_monitor_short -pc_type mg -ksp_type fgmres -pc_mg_type full -mat_mpiaij_mult_split -vecscatter_merge
+      requires: !single
+      output_file: output/ex19_mult_split.out
+
    test:
       suffix: 14_ds
       nsize: 4
@@ -896,6 +909,45 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       args: -pc_type fieldsplit -pc_fieldsplit_block_size 4 -pc_fieldsplit_type SCHUR -pc_fieldsplit_0_fields 0,1,2 -pc_fieldsplit_1_fields 3 -fieldsplit_0_pc_type lu -fieldsplit_1_pc_type lu -snes_monitor_short -ksp_monitor_short -fieldsplit_0_pc_factor_mat_solver_type mumps -fieldsplit_1_pc_factor_mat_solver_type mumps
       output_file: output/ex19_fieldsplit_5.out
 
+   test:
+      suffix: gamg_reuse_aggregates
+      nsize: 3
+      args: -da_grid_x 33 -da_grid_y 33 -snes_monitor_short -ksp_converged_reason -pc_type gamg -pc_gamg_process_eq_limit 400 -pc_gamg_reuse_aggregates
+      requires: !single
+
+   test:
+      suffix: gamg_esteig_batched
+      nsize: 3
+      args: -da_grid_x 33 -da_grid_y 33 -grashof 1e2 -snes_monitor_short -ksp_converged_reason -pc_type gamg -pc_gamg_process_eq_limit 400 -pc_gamg_reuse_aggregates -pc_mg_esteig_batched -mg_levels_ksp_chebyshev_esteig_reuse_rtol 0.1 -mg_levels_ksp_chebyshev_esteig_refresh_steps 2 -info
+      filter: grep -E "SNES Function|Linear solve converged|^.0. KSPChebyshevEst" | sed -e "s,operator norm [0-9.e-]*,operator norm," -e "s,power iterations [0-9.e-]*,power iterations," -e "s,estimate [0-9][0-9.e-]*,estimate," -e "s,previously [0-9.e-]*,previously,"
+      requires: !single
+
+   test:
+      suffix: gamg_esteig_batched_keep
+      nsize: 3
+      args: -da_grid_x 33 -da_grid_y 33 -grashof 1e2 -snes_monitor_short -ksp_converged_reason -pc_type gamg -pc_gamg_process_eq_limit 400 -pc_gamg_reuse_aggregates -pc_mg_esteig_batched -mg_levels_ksp_chebyshev_esteig_reuse_rtol 0.1 -info
+      filter: grep -E "SNES Function|Linear solve converged|^.0. KSPChebyshevEst" | sed -e "s,operator norm [0-9.e-]*,operator norm," -e "s,power iterations [0-9.e-]*,power iterations," -e "s,estimate [0-9][0-9.e-]*,estimate," -e "s,previously [0-9.e-]*,previously,"
+      requires: !single
+
+   test:
+      suffix: mg_deep_halo
+      nsize: 4
+      args: -da_refine 3 -snes_monitor_short -ksp_converged_reason -pc_type mg -mg_levels_pc_type jacobi -mg_levels_ksp_max_it 2 -mg_levels_ksp_chebyshev_deep_halo 2
+      requires: !single
+
+   test:
+      suffix: mg_agglomerate
+      nsize: 4
+      args: -da_refine 4 -snes_monitor_short -ksp_converged_reason -pc_type mg -pc_mg_galerkin pmat -pc_mg_cycle_type w -mg_levels_pc_type jacobi -pc_mg_agglomerate_eq_limit 300 -mg_agglomerate_mg_levels_pc_type jacobi
+      requires: !single
+
+   test:
+      suffix: mg_agglomerate_options
+      nsize: 4
+      args: -da_refine 4 -pc_type mg -pc_mg_galerkin pmat -pc_mg_cycle_type w -mg_levels_pc_type jacobi -pc_mg_agglomerate_eq_limit 300 -mg_agglomerate_pc_telescope_reduction_factor 4 -mg_agglomerate_mg_levels_pc_type jacobi -snes_view
+      filter: grep -E "subcomm_size|Object: .mg_agglomerate_(telescope_|mg_levels_[0-9]_)"
+      requires: !single
+
    test:
       suffix: greedy_coloring
       nsize: 2
@@ -982,6 +1034,11 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       requires: parms
       args: -pc_type parms -ksp_monitor_short -snes_view
 
+   test:
+      suffix: sor_multicolor
+      nsize: 2
+      args: -da_refine 1 -snes_monitor_short -ksp_converged_reason -dm_mat_type baij -pc_type bjacobi -sub_pc_type sor -sub_pc_sor_symmetric -mat_sor_multicolor 2
+
    test:
       suffix: superlu
       requires: superlu
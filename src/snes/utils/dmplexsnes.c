@@ -2300,6 +2300,793 @@ PetscErrorCode DMPlexComputeBdJacobian_Internal(DM dm, Vec locX, Vec locX_t, Pet
   PetscFunctionReturn(0);
 }
 
+/********************* Matrix-free Jacobian **************************/
+
+/*
+  The matrix-free Jacobian applies J(u) y one cell at a time without forming element matrices. Each Jacobian evaluation
+  stores the pointwise Jacobian g0-g3 at every quadrature point, pulled back to the reference cell and weighted exactly as
+  PetscFEIntegrateJacobian_Basic() does. On quadrilaterals and hexahedra the Lagrange basis is the tensor product of a 1D
+  basis, and the quadrature is the tensor product of a 1D rule, so interpolation to the quadrature points and integration
+  against the test functions are sum factorized over the 1D tabulation, one direction at a time. With k 1D dofs and n 1D
+  points this costs O(dim n k^dim) per cell instead of O(n^dim k^{2 dim}) for the element matrix.
+*/
+typedef struct {
+  PetscInt   Nc;            /* Number of components */
+  PetscInt   Nb;            /* Number of dofs on a cell */
+  PetscInt   k;             /* Number of 1D basis functions */
+  PetscReal *B, *D;         /* 1D tabulation and its derivative at the 1D quadrature points, n x k */
+  PetscReal *BB, *BD, *DD;  /* Pointwise products of the 1D tabulations, for the diagonal */
+  PetscInt  *closure;       /* Tensor dof c k^dim + lexicographic index -> closure dof */
+} DMPlexJacMFField;
+
+typedef struct {
+  DM                dm;
+  PetscInt          dim, Nf, totDim;
+  PetscInt          n, Nq;    /* Number of 1D quadrature points, and n^dim */
+  PetscInt         *qMap;     /* Lexicographic tensor quadrature point -> point of the PetscFE quadrature */
+  DMPlexJacMFField *fields;
+  PetscBool        *hasG;     /* Whether g0-g3 are present for each field pair */
+  PetscInt         *gOff;     /* Offset of each field pair in the storage of a quadrature point, or -1 */
+  PetscInt          gSize;    /* Storage for a quadrature point */
+  PetscInt          numCells;
+  PetscScalar      *g;        /* Pointwise Jacobian, numCells x Nq x gSize */
+  PetscScalar      *uq, *uq_x, *f0, *f1, *y, *U, *Z, *w0, *w1;
+  PetscBool         setup;
+} DMPlexJacMF;
+
+/* Apply the tensor product of the n x k matrices A[d] to in, or of their transposes, one direction at a time */
+static void DMPlexJacMFContract_Static(PetscInt dim, PetscInt n, PetscInt k, PetscReal *A[], PetscBool transpose, const PetscScalar in[], PetscScalar out[], PetscScalar w0[], PetscScalar w1[])
+{
+  const PetscInt     m = transpose ? k : n, l = transpose ? n : k;
+  const PetscScalar *src = in;
+  PetscInt           pre = 1, post = 1, a, c, d, i, j;
+
+  for (d = 1; d < dim; ++d) post *= l;
+  for (d = 0; d < dim; ++d) {
+    PetscScalar     *dst = d == dim-1 ? out : (d%2 ? w1 : w0);
+    const PetscReal *Ad  = A[d];
+
+    for (a = 0; a < pre; ++a) {
+      for (j = 0; j < m; ++j) {
+        PetscScalar *dj = &dst[(a*m+j)*post];
+
+        for (c = 0; c < post; ++c) dj[c] = 0.0;
+        for (i = 0; i < l; ++i) {
+          const PetscReal    aji = transpose ? Ad[i*k+j] : Ad[j*k+i];
+          const PetscScalar *si  = &src[(a*l+i)*post];
+
+          for (c = 0; c < post; ++c) dj[c] += aji*si[c];
+        }
+      }
+    }
+    src   = dst;
+    pre  *= m;
+    post /= l;
+  }
+}
+
+/* Values and reference gradients of all fields at the tensor quadrature points, uq[comp][q] and uq_x[comp][d][q] */
+static void DMPlexJacMFInterpolate_Static(DMPlexJacMF *ctx, const PetscScalar coef[], PetscScalar uq[], PetscScalar uq_x[])
+{
+  const PetscInt dim = ctx->dim, n = ctx->n, Nq = ctx->Nq;
+  PetscInt       off = 0, cOff = 0, f, c, d, e, i;
+
+  for (f = 0; f < ctx->Nf; ++f) {
+    DMPlexJacMFField *fld = &ctx->fields[f];
+    PetscReal        *A[3];
+    PetscInt          K = 1;
+
+    for (d = 0; d < dim; ++d) K *= fld->k;
+    for (c = 0; c < fld->Nc; ++c) {
+      for (i = 0; i < K; ++i) ctx->U[i] = coef[off+fld->closure[c*K+i]];
+      for (d = 0; d < dim; ++d) A[d] = fld->B;
+      DMPlexJacMFContract_Static(dim, n, fld->k, A, PETSC_FALSE, ctx->U, &uq[(cOff+c)*Nq], ctx->w0, ctx->w1);
+      for (e = 0; e < dim; ++e) {
+        A[e] = fld->D;
+        DMPlexJacMFContract_Static(dim, n, fld->k, A, PETSC_FALSE, ctx->U, &uq_x[((cOff+c)*dim+e)*Nq], ctx->w0, ctx->w1);
+        A[e] = fld->B;
+      }
+    }
+    off  += fld->Nb;
+    cOff += fld->Nc;
+  }
+}
+
+/* Integrate f0[comp][q] against the test functions and f1[comp][d][q] against their reference gradients */
+static void DMPlexJacMFIntegrate_Static(DMPlexJacMF *ctx, const PetscScalar f0[], const PetscScalar f1[], PetscScalar z[])
+{
+  const PetscInt dim = ctx->dim, n = ctx->n, Nq = ctx->Nq;
+  PetscInt       off = 0, cOff = 0, f, c, d, e, i;
+
+  for (f = 0; f < ctx->Nf; ++f) {
+    DMPlexJacMFField *fld = &ctx->fields[f];
+    PetscReal        *A[3];
+    PetscInt          K = 1;
+
+    for (d = 0; d < dim; ++d) K *= fld->k;
+    for (c = 0; c < fld->Nc; ++c) {
+      for (d = 0; d < dim; ++d) A[d] = fld->B;
+      DMPlexJacMFContract_Static(dim, n, fld->k, A, PETSC_TRUE, &f0[(cOff+c)*Nq], ctx->Z, ctx->w0, ctx->w1);
+      for (e = 0; e < dim; ++e) {
+        A[e] = fld->D;
+        DMPlexJacMFContract_Static(dim, n, fld->k, A, PETSC_TRUE, &f1[((cOff+c)*dim+e)*Nq], ctx->U, ctx->w0, ctx->w1);
+        for (i = 0; i < K; ++i) ctx->Z[i] += ctx->U[i];
+        A[e] = fld->B;
+      }
+      for (i = 0; i < K; ++i) z[off+fld->closure[c*K+i]] = ctx->Z[i];
+    }
+    off  += fld->Nb;
+    cOff += fld->Nc;
+  }
+}
+
+static PetscErrorCode DMPlexJacMFCreate1DElement_Static(PetscInt order, PetscBool continuous, PetscFE *fe)
+{
+  PetscSpace     P;
+  PetscDualSpace Q;
+  DM             K;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSpaceCreate(PETSC_COMM_SELF, &P);CHKERRQ(ierr);
+  ierr = PetscSpaceSetType(P, PETSCSPACEPOLYNOMIAL);CHKERRQ(ierr);
+  ierr = PetscSpaceSetNumComponents(P, 1);CHKERRQ(ierr);
+  ierr = PetscSpaceSetNumVariables(P, 1);CHKERRQ(ierr);
+  ierr = PetscSpaceSetOrder(P, order);CHKERRQ(ierr);
+  ierr = PetscSpaceSetUp(P);CHKERRQ(ierr);
+  ierr = PetscDualSpaceCreate(PETSC_COMM_SELF, &Q);CHKERRQ(ierr);
+  ierr = PetscDualSpaceSetType(Q, PETSCDUALSPACELAGRANGE);CHKERRQ(ierr);
+  ierr = PetscDualSpaceCreateReferenceCell(Q, 1, PETSC_FALSE, &K);CHKERRQ(ierr);
+  ierr = PetscDualSpaceSetDM(Q, K);CHKERRQ(ierr);
+  ierr = DMDestroy(&K);CHKERRQ(ierr);
+  ierr = PetscDualSpaceSetNumComponents(Q, 1);CHKERRQ(ierr);
+  ierr = PetscDualSpaceSetOrder(Q, order);CHKERRQ(ierr);
+  ierr = PetscDualSpaceLagrangeSetTensor(Q, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscDualSpaceLagrangeSetContinuity(Q, continuous);CHKERRQ(ierr);
+  ierr = PetscDualSpaceSetUp(Q);CHKERRQ(ierr);
+  ierr = PetscFECreate(PETSC_COMM_SELF, fe);CHKERRQ(ierr);
+  ierr = PetscFESetType(*fe, PETSCFEBASIC);CHKERRQ(ierr);
+  ierr = PetscFESetBasisSpace(*fe, P);CHKERRQ(ierr);
+  ierr = PetscFESetDualSpace(*fe, Q);CHKERRQ(ierr);
+  ierr = PetscFESetNumComponents(*fe, 1);CHKERRQ(ierr);
+  ierr = PetscFESetUp(*fe);CHKERRQ(ierr);
+  ierr = PetscSpaceDestroy(&P);CHKERRQ(ierr);
+  ierr = PetscDualSpaceDestroy(&Q);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Factor the basis of fe over the 1D points x1, checking the factorization against the full tabulation */
+static PetscErrorCode DMPlexJacMFFieldSetUp_Static(PetscFE fe, PetscInt f, PetscInt dim, PetscInt n, const PetscReal x1[], const PetscInt qIdx[], DMPlexJacMFField *fld)
+{
+  const PetscReal tol = PetscSqrtReal(PETSC_SMALL);
+  PetscSpace      sp;
+  PetscDualSpace  Q, Q1;
+  PetscFE         fe1;
+  PetscReal      *B1, *D1, *Bf, *Df, *node1;
+  PetscInt       *idx, order, Nq, K = 1, b, c, d, e, i, q;
+  PetscBool       isPoly, tensor = PETSC_FALSE, continuous;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetBasisSpace(fe, &sp);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject) sp, PETSCSPACEPOLYNOMIAL, &isPoly);CHKERRQ(ierr);
+  if (isPoly) {ierr = PetscSpacePolynomialGetTensor(sp, &tensor);CHKERRQ(ierr);}
+  if (!tensor) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Field %D does not use a tensor product space, the matrix-free Jacobian requires tensor product cells", f);
+  ierr = PetscSpaceGetOrder(sp, &order);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fe, &Q);CHKERRQ(ierr);
+  ierr = PetscDualSpaceLagrangeGetContinuity(Q, &continuous);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &fld->Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fe, &fld->Nb);CHKERRQ(ierr);
+  fld->k = order+1;
+  for (d = 0; d < dim; ++d) K *= fld->k;
+  if (fld->Nb != fld->Nc*K) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_SUP, "Field %D has %D dofs, not the %D x %D of a tensor product element", f, fld->Nb, fld->Nc, K);
+  for (d = 0, Nq = 1; d < dim; ++d) Nq *= n;
+  ierr = PetscMalloc5(n*fld->k, &fld->B, n*fld->k, &fld->D, n*fld->k, &fld->BB, n*fld->k, &fld->BD, n*fld->k, &fld->DD);CHKERRQ(ierr);
+  ierr = PetscMalloc1(fld->Nb, &fld->closure);CHKERRQ(ierr);
+  ierr = PetscMalloc2(fld->k, &node1, fld->Nb*dim, &idx);CHKERRQ(ierr);
+  /* 1D tabulation */
+  ierr = DMPlexJacMFCreate1DElement_Static(order, continuous, &fe1);CHKERRQ(ierr);
+  ierr = PetscFEGetTabulation(fe1, n, x1, &B1, &D1, NULL);CHKERRQ(ierr);
+  for (i = 0; i < n*fld->k; ++i) {
+    fld->B[i]  = B1[i];
+    fld->D[i]  = D1[i];
+    fld->BB[i] = B1[i]*B1[i];
+    fld->BD[i] = B1[i]*D1[i];
+    fld->DD[i] = D1[i]*D1[i];
+  }
+  ierr = PetscFERestoreTabulation(fe1, n, x1, &B1, &D1, NULL);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fe1, &Q1);CHKERRQ(ierr);
+  for (i = 0; i < fld->k; ++i) {
+    PetscQuadrature  fn;
+    const PetscReal *points;
+
+    ierr = PetscDualSpaceGetFunctional(Q1, i, &fn);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(fn, NULL, NULL, NULL, &points, NULL);CHKERRQ(ierr);
+    node1[i] = points[0];
+  }
+  ierr = PetscFEDestroy(&fe1);CHKERRQ(ierr);
+  /* Match each nodal functional to a 1D node in each direction */
+  for (i = 0; i < fld->Nb; ++i) fld->closure[i] = -1;
+  for (b = 0; b < fld->Nb; ++b) {
+    PetscQuadrature  fn;
+    const PetscReal *points, *weights;
+    PetscInt         Np, fNc, t = 0;
+
+    ierr = PetscDualSpaceGetFunctional(Q, b, &fn);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(fn, NULL, &fNc, &Np, &points, &weights);CHKERRQ(ierr);
+    if (Np != 1) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Field %D is not a nodal Lagrange element", f);
+    for (c = 0; c < fNc; ++c) if (weights[c] != 0.0) break;
+    for (d = 0; d < dim; ++d) {
+      for (i = 0; i < fld->k; ++i) if (PetscAbsReal(points[d] - node1[i]) < tol) break;
+      if (i == fld->k) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "The nodes of field %D do not form a tensor product grid", f);
+      idx[b*dim+d] = i;
+      t = t*fld->k + i;
+    }
+    if (c == fNc || fld->closure[c*K+t] >= 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "The nodes of field %D do not form a tensor product grid", f);
+    fld->closure[c*K+t] = b;
+  }
+  /* Check the factorization against the tabulation of the full element */
+  ierr = PetscFEGetDefaultTabulation(fe, &Bf, &Df, NULL);CHKERRQ(ierr);
+  for (q = 0; q < Nq; ++q) {
+    for (c = 0; c < fld->Nc; ++c) {
+      for (i = 0; i < K; ++i) {
+        const PetscInt b = fld->closure[c*K+i];
+
+        for (e = -1; e < dim; ++e) {
+          const PetscReal val = e < 0 ? Bf[(q*fld->Nb+b)*fld->Nc+c] : Df[((q*fld->Nb+b)*fld->Nc+c)*dim+e];
+          PetscReal       ex  = 1.0;
+
+          for (d = 0; d < dim; ++d) ex *= (d == e ? fld->D : fld->B)[qIdx[q*dim+d]*fld->k+idx[b*dim+d]];
+          if (PetscAbsReal(val - ex) > tol*PetscMax(1.0, PetscAbsReal(ex))) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "The basis of field %D is not a tensor product of the 1D Lagrange basis", f);
+        }
+      }
+    }
+  }
+  ierr = PetscFree2(node1, idx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Evaluate the pointwise Jacobian at the base state X on every quadrature point */
+static PetscErrorCode DMPlexJacMFSetUp_Static(Mat Jac, Vec X)
+{
+  DMPlexJacMF       *ctx;
+  DM                 dm, plex, dmAux, plexAux = NULL;
+  Vec                A;
+  PetscDS            prob, probAux = NULL;
+  PetscSection       section, sectionAux = NULL;
+  PetscQuadrature    quad;
+  PetscFE            fe;
+  PetscFEGeom       *geom;
+  DMField            coordField;
+  IS                 cellIS;
+  PetscScalar       *u, *u_x, *a = NULL, *a_x = NULL, *refSpaceDer, *refSpaceDerAux = NULL, *coefAux = NULL;
+  PetscReal         *x, **BAux = NULL, **DAux = NULL;
+  const PetscScalar *constants;
+  const PetscReal   *quadPoints, *quadWeights;
+  const PetscInt    *cells;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL, *Nc, *NbAux = NULL, *NcAux = NULL;
+  PetscInt           dim, Nf, Nq, NfAux = 0, totDimAux = 0, numConstants;
+  PetscInt           depth, cStart, cEnd, numCells, fieldI, fieldJ, c, Lq, i, dE, Np;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(Jac, (void **) &ctx);CHKERRQ(ierr);
+  dm = ctx->dm; dim = ctx->dim; Nf = ctx->Nf; Nq = ctx->Nq;
+  ierr = PetscLogEventBegin(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
+  ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
+  if (!cellIS) {ierr = DMGetStratumIS(plex, "depth", depth, &cellIS);CHKERRQ(ierr);}
+  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = PetscDSGetComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetEvaluationArrays(prob, &u, NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetRefCoordArrays(prob, &x, &refSpaceDer);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(prob, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) dm, "dmAux", (PetscObject *) &dmAux);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) dm, "A", (PetscObject *) &A);CHKERRQ(ierr);
+  if (dmAux) {
+    ierr = DMConvert(dmAux, DMPLEX, &plexAux);CHKERRQ(ierr);
+    ierr = DMGetDefaultSection(plexAux, &sectionAux);CHKERRQ(ierr);
+    ierr = DMGetDS(dmAux, &probAux);CHKERRQ(ierr);
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetDimensions(probAux, &NbAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetRefCoordArrays(probAux, NULL, &refSpaceDerAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(probAux, &BAux, &DAux);CHKERRQ(ierr);
+    ierr = PetscMalloc1(totDimAux, &coefAux);CHKERRQ(ierr);
+  }
+  /* Layout of the pointwise Jacobian at a quadrature point */
+  ctx->gSize = 0;
+  for (fieldI = 0; fieldI < Nf; ++fieldI) {
+    for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+      const PetscInt    p = fieldI*Nf+fieldJ;
+      PetscPointJac     g[4];
+      PetscPointJacVec  gv[4];
+      PetscBool         has = PETSC_FALSE;
+
+      ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g[0], &g[1], &g[2], &g[3]);CHKERRQ(ierr);
+      ierr = PetscDSGetJacobianVec(prob, fieldI, fieldJ, &gv[0], &gv[1], &gv[2], &gv[3]);CHKERRQ(ierr);
+      for (i = 0; i < 4; ++i) {ctx->hasG[p*4+i] = g[i] || gv[i] ? PETSC_TRUE : PETSC_FALSE; has = has || ctx->hasG[p*4+i] ? PETSC_TRUE : PETSC_FALSE;}
+      ctx->gOff[p] = has ? ctx->gSize : -1;
+      if (has) ctx->gSize += Nc[fieldI]*Nc[fieldJ]*(1+dim)*(1+dim);
+    }
+  }
+  ierr = ISGetLocalSize(cellIS, &numCells);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->g);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numCells*Nq*ctx->gSize, &ctx->g);CHKERRQ(ierr);
+  ctx->numCells = numCells;
+  /* Geometry on the quadrature of the first field, which all fields share */
+  ierr = PetscDSGetDiscretization(prob, 0, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, NULL, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
+  ierr = DMSNESGetFEGeom(coordField, cellIS, quad, PETSC_FALSE, &geom);CHKERRQ(ierr);
+  Np = geom->numPoints;
+  dE = geom->dimEmbed;
+  if (dE != dim) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_SUP, "The matrix-free Jacobian does not support embedded cells, dimension %D in %D", dim, dE);
+  ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt   cell = cells ? cells[c] : c;
+    const PetscInt   cind = c - cStart;
+    const PetscReal *v0   = &geom->v[cind*Np*dE];
+    const PetscReal *J    = &geom->J[cind*Np*dE*dE];
+    PetscScalar     *xc   = NULL;
+
+    ierr = DMPlexVecGetClosure(plex, section, X, cell, NULL, &xc);CHKERRQ(ierr);
+    DMPlexJacMFInterpolate_Static(ctx, xc, ctx->uq, ctx->uq_x);
+    ierr = DMPlexVecRestoreClosure(plex, section, X, cell, NULL, &xc);CHKERRQ(ierr);
+    if (dmAux) {
+      ierr = DMPlexVecGetClosure(plexAux, sectionAux, A, cell, NULL, &xc);CHKERRQ(ierr);
+      for (i = 0; i < totDimAux; ++i) coefAux[i] = xc[i];
+      ierr = DMPlexVecRestoreClosure(plexAux, sectionAux, A, cell, NULL, &xc);CHKERRQ(ierr);
+    }
+    for (Lq = 0; Lq < Nq; ++Lq) {
+      const PetscInt   q = ctx->qMap[Lq];
+      const PetscReal *v, *invJ;
+      PetscReal        detJ, w;
+      PetscInt         f, fc, gc, d, d2, dp, d3;
+
+      if (geom->isAffine) {
+        CoordinatesRefToReal(dE, dim, geom->xi, v0, J, &quadPoints[q*dim], x);
+        v    = x;
+        invJ = &geom->invJ[cind*dE*dE];
+        detJ = geom->detJ[cind];
+      } else {
+        v    = &v0[q*dE];
+        invJ = &geom->invJ[(cind*Np+q)*dE*dE];
+        detJ = geom->detJ[cind*Np+q];
+      }
+      w = detJ*quadWeights[q];
+      for (f = 0; f < Nf; ++f) {
+        for (fc = 0; fc < Nc[f]; ++fc) {
+          const PetscInt cc = uOff[f]+fc;
+
+          u[cc] = ctx->uq[cc*Nq+Lq];
+          for (d = 0; d < dim; ++d) for (d2 = 0, u_x[cc*dim+d] = 0.0; d2 < dim; ++d2) u_x[cc*dim+d] += invJ[d2*dim+d]*ctx->uq_x[(cc*dim+d2)*Nq+Lq];
+        }
+      }
+      if (probAux) EvaluateFieldJets(dim, NfAux, NbAux, NcAux, q, BAux, DAux, refSpaceDerAux, invJ, coefAux, NULL, a, a_x, NULL);
+      for (fieldI = 0; fieldI < Nf; ++fieldI) {
+        for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+          const PetscInt    p   = fieldI*Nf+fieldJ;
+          const PetscInt    NcI = Nc[fieldI], NcJ = Nc[fieldJ];
+          PetscPointJac     g0_func, g1_func, g2_func, g3_func;
+          PetscPointJacVec  g0_vec, g1_vec, g2_vec, g3_vec;
+          PetscScalar      *g0, *g1, *g2, *g3;
+
+          if (ctx->gOff[p] < 0) continue;
+          g0 = &ctx->g[(cind*Nq+Lq)*ctx->gSize+ctx->gOff[p]];
+          g1 = &g0[NcI*NcJ];
+          g2 = &g1[NcI*NcJ*dim];
+          g3 = &g2[NcI*NcJ*dim];
+          ierr = PetscMemzero(g0, NcI*NcJ*(1+dim)*(1+dim) * sizeof(PetscScalar));CHKERRQ(ierr);
+          ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+          ierr = PetscDSGetJacobianVec(prob, fieldI, fieldJ, &g0_vec, &g1_vec, &g2_vec, &g3_vec);CHKERRQ(ierr);
+          if (g0_func || g0_vec) {
+            if (g0_func) g0_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, g0);
+            else         g0_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, g0);
+            for (i = 0; i < NcI*NcJ; ++i) g0[i] *= w;
+          }
+          if (g1_func || g1_vec) {
+            ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+            if (g1_func) g1_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, refSpaceDer);
+            else         g1_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, refSpaceDer);
+            for (fc = 0; fc < NcI; ++fc) {
+              for (gc = 0; gc < NcJ; ++gc) {
+                for (d = 0; d < dim; ++d) {
+                  for (d2 = 0; d2 < dim; ++d2) g1[(fc*NcJ+gc)*dim+d] += invJ[d*dim+d2]*refSpaceDer[(fc*NcJ+gc)*dim+d2];
+                  g1[(fc*NcJ+gc)*dim+d] *= w;
+                }
+              }
+            }
+          }
+          if (g2_func || g2_vec) {
+            ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+            if (g2_func) g2_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, refSpaceDer);
+            else         g2_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, refSpaceDer);
+            for (fc = 0; fc < NcI; ++fc) {
+              for (gc = 0; gc < NcJ; ++gc) {
+                for (d = 0; d < dim; ++d) {
+                  for (d2 = 0; d2 < dim; ++d2) g2[(fc*NcJ+gc)*dim+d] += invJ[d*dim+d2]*refSpaceDer[(fc*NcJ+gc)*dim+d2];
+                  g2[(fc*NcJ+gc)*dim+d] *= w;
+                }
+              }
+            }
+          }
+          if (g3_func || g3_vec) {
+            ierr = PetscMemzero(refSpaceDer, NcI*NcJ*dim*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+            if (g3_func) g3_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, refSpaceDer);
+            else         g3_vec(dim, Nf, NfAux, 1, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, v, numConstants, constants, refSpaceDer);
+            for (fc = 0; fc < NcI; ++fc) {
+              for (gc = 0; gc < NcJ; ++gc) {
+                for (d = 0; d < dim; ++d) {
+                  for (dp = 0; dp < dim; ++dp) {
+                    PetscScalar *g3e = &g3[((fc*NcJ+gc)*dim+d)*dim+dp];
+
+                    for (d2 = 0; d2 < dim; ++d2) {
+                      for (d3 = 0; d3 < dim; ++d3) *g3e += invJ[d*dim+d2]*refSpaceDer[((fc*NcJ+gc)*dim+d2)*dim+d3]*invJ[dp*dim+d3];
+                    }
+                    *g3e *= w;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = DMSNESRestoreFEGeom(coordField, cellIS, quad, PETSC_FALSE, &geom);CHKERRQ(ierr);
+  ierr = PetscFree(coefAux);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
+  ierr = DMDestroy(&plexAux);CHKERRQ(ierr);
+  ierr = DMDestroy(&plex);CHKERRQ(ierr);
+  ctx->setup = PETSC_TRUE;
+  /* The operator changed, so that a preconditioner built from it is set up again */
+  ierr = PetscObjectStateIncrease((PetscObject) Jac);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_DMPlexJacMF(Mat J, Vec X, Vec Y)
+{
+  DMPlexJacMF    *ctx;
+  DM              dm, plex;
+  PetscSection    section;
+  IS              cellIS;
+  Vec             locX, locY;
+  const PetscInt *cells;
+  PetscInt        dim, Nf, Nq, depth, cStart, cEnd, c, Lq, i;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  if (!ctx->setup) SETERRQ(PetscObjectComm((PetscObject) J), PETSC_ERR_ARG_WRONGSTATE, "The Jacobian has not been computed, call DMPlexSNESComputeJacobianFEM() first");
+  dm = ctx->dm; dim = ctx->dim; Nf = ctx->Nf; Nq = ctx->Nq;
+  ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
+  ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
+  if (!cellIS) {ierr = DMGetStratumIS(plex, "depth", depth, &cellIS);CHKERRQ(ierr);}
+  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locY);CHKERRQ(ierr);
+  ierr = VecSet(locX, 0.0);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = VecSet(locY, 0.0);CHKERRQ(ierr);
+  ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt cell = cells ? cells[c] : c;
+    const PetscInt cind = c - cStart;
+    PetscScalar   *xc   = NULL;
+    PetscInt       fieldI, fieldJ;
+
+    ierr = DMPlexVecGetClosure(plex, section, locX, cell, NULL, &xc);CHKERRQ(ierr);
+    DMPlexJacMFInterpolate_Static(ctx, xc, ctx->uq, ctx->uq_x);
+    ierr = DMPlexVecRestoreClosure(plex, section, locX, cell, NULL, &xc);CHKERRQ(ierr);
+    for (fieldI = 0, i = 0; fieldI < Nf; ++fieldI) i += ctx->fields[fieldI].Nc;
+    ierr = PetscMemzero(ctx->f0, i*Nq * sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMemzero(ctx->f1, i*dim*Nq * sizeof(PetscScalar));CHKERRQ(ierr);
+    for (fieldI = 0; fieldI < Nf; ++fieldI) {
+      const PetscInt NcI  = ctx->fields[fieldI].Nc;
+      PetscInt       offI = 0;
+
+      for (i = 0; i < fieldI; ++i) offI += ctx->fields[i].Nc;
+      for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+        const PetscInt   p   = fieldI*Nf+fieldJ;
+        const PetscInt   NcJ = ctx->fields[fieldJ].Nc;
+        const PetscBool *hasG = &ctx->hasG[p*4];
+        PetscInt         offJ = 0;
+
+        if (ctx->gOff[p] < 0) continue;
+        for (i = 0; i < fieldJ; ++i) offJ += ctx->fields[i].Nc;
+        for (Lq = 0; Lq < Nq; ++Lq) {
+          const PetscScalar *g0 = &ctx->g[(cind*Nq+Lq)*ctx->gSize+ctx->gOff[p]];
+          const PetscScalar *g1 = &g0[NcI*NcJ], *g2 = &g1[NcI*NcJ*dim], *g3 = &g2[NcI*NcJ*dim];
+          PetscInt           fc, gc, d, d2;
+
+          for (fc = 0; fc < NcI; ++fc) {
+            PetscScalar *f0 = &ctx->f0[(offI+fc)*Nq+Lq];
+
+            for (gc = 0; gc < NcJ; ++gc) {
+              const PetscScalar  val  = ctx->uq[(offJ+gc)*Nq+Lq];
+              const PetscScalar *grad = &ctx->uq_x[(offJ+gc)*dim*Nq+Lq];
+
+              if (hasG[0]) *f0 += g0[fc*NcJ+gc]*val;
+              if (hasG[1]) for (d = 0; d < dim; ++d) *f0 += g1[(fc*NcJ+gc)*dim+d]*grad[d*Nq];
+              for (d = 0; d < dim; ++d) {
+                PetscScalar *f1 = &ctx->f1[((offI+fc)*dim+d)*Nq+Lq];
+
+                if (hasG[2]) *f1 += g2[(fc*NcJ+gc)*dim+d]*val;
+                if (hasG[3]) for (d2 = 0; d2 < dim; ++d2) *f1 += g3[((fc*NcJ+gc)*dim+d)*dim+d2]*grad[d2*Nq];
+              }
+            }
+          }
+        }
+      }
+    }
+    DMPlexJacMFIntegrate_Static(ctx, ctx->f0, ctx->f1, ctx->y);
+    ierr = DMPlexVecSetClosure(plex, section, locY, cell, ctx->y, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = VecSet(Y, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locY, ADD_VALUES, Y);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locY, ADD_VALUES, Y);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locX);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locY);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
+  ierr = DMDestroy(&plex);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The diagonal of the cell operator is the integral of g against the squares and products of the 1D tabulations */
+static PetscErrorCode MatGetDiagonal_DMPlexJacMF(Mat J, Vec D)
+{
+  DMPlexJacMF    *ctx;
+  DM              dm, plex;
+  PetscSection    section;
+  IS              cellIS;
+  Vec             locD;
+  const PetscInt *cells;
+  PetscInt        dim, Nf, Nq, depth, cStart, cEnd, c, i;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  if (!ctx->setup) SETERRQ(PetscObjectComm((PetscObject) J), PETSC_ERR_ARG_WRONGSTATE, "The Jacobian has not been computed, call DMPlexSNESComputeJacobianFEM() first");
+  dm = ctx->dm; dim = ctx->dim; Nf = ctx->Nf; Nq = ctx->Nq;
+  ierr = DMSNESConvertPlex(dm, &plex, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
+  ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
+  if (!cellIS) {ierr = DMGetStratumIS(plex, "depth", depth, &cellIS);CHKERRQ(ierr);}
+  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &locD);CHKERRQ(ierr);
+  ierr = VecSet(locD, 0.0);CHKERRQ(ierr);
+  ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt cell = cells ? cells[c] : c;
+    const PetscInt cind = c - cStart;
+    PetscInt       f, off = 0;
+
+    ierr = PetscMemzero(ctx->y, ctx->totDim * sizeof(PetscScalar));CHKERRQ(ierr);
+    for (f = 0; f < Nf; ++f) {
+      DMPlexJacMFField *fld  = &ctx->fields[f];
+      const PetscInt    p    = f*Nf+f, Ncf = fld->Nc;
+      const PetscBool  *hasG = &ctx->hasG[p*4];
+      PetscInt          K = 1, fc, s, t, d, Lq;
+
+      for (d = 0; d < dim; ++d) K *= fld->k;
+      if (ctx->gOff[p] < 0) {off += fld->Nb; continue;}
+      for (fc = 0; fc < Ncf; ++fc) {
+        for (i = 0; i < K; ++i) ctx->Z[i] = 0.0;
+        /* Term (s, t) pairs the test value (s = 0) or reference derivative s-1 with the trial value or derivative t-1 */
+        for (s = 0; s <= dim; ++s) {
+          for (t = 0; t <= dim; ++t) {
+            const PetscInt gi = !s ? (!t ? 0 : 1) : (!t ? 2 : 3);
+            PetscReal     *A[3];
+
+            if (!hasG[gi]) continue;
+            for (Lq = 0; Lq < Nq; ++Lq) {
+              const PetscScalar *g0 = &ctx->g[(cind*Nq+Lq)*ctx->gSize+ctx->gOff[p]];
+              const PetscInt     cc = fc*Ncf+fc;
+
+              switch (gi) {
+              case 0: ctx->uq[Lq] = g0[cc];break;
+              case 1: ctx->uq[Lq] = g0[Ncf*Ncf + cc*dim+t-1];break;
+              case 2: ctx->uq[Lq] = g0[Ncf*Ncf*(1+dim) + cc*dim+s-1];break;
+              case 3: ctx->uq[Lq] = g0[Ncf*Ncf*(1+2*dim) + (cc*dim+s-1)*dim+t-1];break;
+              }
+            }
+            for (d = 0; d < dim; ++d) A[d] = d == s-1 ? (d == t-1 ? fld->DD : fld->BD) : (d == t-1 ? fld->BD : fld->BB);
+            DMPlexJacMFContract_Static(dim, ctx->n, fld->k, A, PETSC_TRUE, ctx->uq, ctx->U, ctx->w0, ctx->w1);
+            for (i = 0; i < K; ++i) ctx->Z[i] += ctx->U[i];
+          }
+        }
+        for (i = 0; i < K; ++i) ctx->y[off+fld->closure[fc*K+i]] = ctx->Z[i];
+      }
+      off += fld->Nb;
+    }
+    ierr = DMPlexVecSetClosure(plex, section, locD, cell, ctx->y, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+  ierr = VecSet(D, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &locD);CHKERRQ(ierr);
+  ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
+  ierr = DMDestroy(&plex);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMPlexJacMF(Mat J)
+{
+  DMPlexJacMF    *ctx;
+  PetscInt        f;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, (void **) &ctx);CHKERRQ(ierr);
+  for (f = 0; f < ctx->Nf; ++f) {
+    ierr = PetscFree5(ctx->fields[f].B, ctx->fields[f].D, ctx->fields[f].BB, ctx->fields[f].BD, ctx->fields[f].DD);CHKERRQ(ierr);
+    ierr = PetscFree(ctx->fields[f].closure);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(ctx->fields, ctx->qMap, ctx->hasG, ctx->gOff);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->g);CHKERRQ(ierr);
+  ierr = PetscFree5(ctx->uq, ctx->uq_x, ctx->f0, ctx->f1, ctx->y);CHKERRQ(ierr);
+  ierr = PetscFree4(ctx->U, ctx->Z, ctx->w0, ctx->w1);CHKERRQ(ierr);
+  ierr = DMDestroy(&ctx->dm);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexIsJacobianMF_Static(Mat J, PetscBool *isMF)
+{
+  void         (*mult)(void);
+  PetscBool      isShell;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *isMF = PETSC_FALSE;
+  ierr = PetscObjectTypeCompare((PetscObject) J, MATSHELL, &isShell);CHKERRQ(ierr);
+  if (!isShell) PetscFunctionReturn(0);
+  ierr = MatShellGetOperation(J, MATOP_MULT, &mult);CHKERRQ(ierr);
+  if (mult == (void (*)(void)) MatMult_DMPlexJacMF) *isMF = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexSNESCreateJacobianMF - Create a matrix-free Jacobian for a finite element discretization on tensor product cells
+
+  Collective on DM
+
+  Input Parameter:
+. dm - The DM, whose fields are all PetscFE
+
+  Output Parameter:
+. J - The MATSHELL Jacobian
+
+  Notes:
+  DMPlexSNESComputeJacobianFEM() does not assemble this matrix, but evaluates the pointwise Jacobian from PetscDSSetJacobian()
+  at each quadrature point and stores it. MatMult() then interpolates the input to the quadrature points and integrates against
+  the test functions cell by cell. Since the basis on quadrilaterals and hexahedra is a tensor product of a 1D basis, both steps
+  are sum factorized over the 1D tabulation, costing O(d k^{d+1}) per cell for k 1D dofs in dimension d rather than the O(k^{2d})
+  of applying an element matrix, and far less memory than an assembled matrix at high order. MatGetDiagonal() is also provided,
+  so the matrix may be used as its own preconditioning matrix with PCJACOBI or Chebyshev smoothing.
+
+  All fields must use tensor product Lagrange elements (PetscSpacePolynomialSetTensor()) and share a tensor quadrature. Boundary
+  Jacobian terms, separate preconditioner pointwise functions, and time dependent Jacobians are not applied by the matrix.
+
+  Level: intermediate
+
+.seealso: DMPlexSNESComputeJacobianFEM(), DMPlexComputeJacobianAction(), SNESSetJacobian()
+@*/
+PetscErrorCode DMPlexSNESCreateJacobianMF(DM dm, Mat *J)
+{
+  DMPlexJacMF     *ctx;
+  PetscDS          prob;
+  PetscFE          fe0;
+  PetscQuadrature  quad;
+  Vec              u;
+  const PetscReal *points;
+  PetscReal       *x1;
+  PetscInt        *qIdx;
+  PetscInt         dim, Nf, totDim, qdim, Nq, n = 0, m, M, kmax = 0, tmax = 1, Nc = 0, f, q, d, i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(J, 2);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  if (dim < 1 || dim > 3) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The matrix-free Jacobian does not support dimension %D", dim);
+  for (f = 0; f < Nf; ++f) {
+    PetscObject  obj;
+    PetscClassId id;
+
+    ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFE_CLASSID) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Field %D is not a PetscFE, the matrix-free Jacobian only supports finite elements", f);
+  }
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  ctx->dm     = dm;
+  ctx->dim    = dim;
+  ctx->Nf     = Nf;
+  ctx->totDim = totDim;
+  /* The quadrature must be a tensor product of the 1D points x1 */
+  ierr = PetscDSGetDiscretization(prob, 0, (PetscObject *) &fe0);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe0, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, &qdim, NULL, &Nq, &points, NULL);CHKERRQ(ierr);
+  if (qdim != dim) SETERRQ2(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Quadrature dimension %D does not match the cell dimension %D", qdim, dim);
+  ierr = PetscMalloc2(Nq, &x1, Nq*dim, &qIdx);CHKERRQ(ierr);
+  for (q = 0; q < Nq; ++q) {
+    for (i = 0; i < n; ++i) if (PetscAbsReal(points[q*dim] - x1[i]) < PETSC_SMALL) break;
+    if (i == n) x1[n++] = points[q*dim];
+  }
+  ierr = PetscSortReal(n, x1);CHKERRQ(ierr);
+  for (d = 0, m = 1; d < dim; ++d) m *= n;
+  if (m != Nq) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The quadrature is not a tensor product rule, the matrix-free Jacobian requires tensor product cells");
+  ctx->n  = n;
+  ctx->Nq = Nq;
+  ierr = PetscMalloc4(Nf, &ctx->fields, Nq, &ctx->qMap, Nf*Nf*4, &ctx->hasG, Nf*Nf, &ctx->gOff);CHKERRQ(ierr);
+  for (q = 0; q < Nq; ++q) ctx->qMap[q] = -1;
+  for (q = 0; q < Nq; ++q) {
+    PetscInt Lq = 0;
+
+    for (d = 0; d < dim; ++d) {
+      for (i = 0; i < n; ++i) if (PetscAbsReal(points[q*dim+d] - x1[i]) < PETSC_SMALL) break;
+      if (i == n) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The quadrature is not a tensor product rule, the matrix-free Jacobian requires tensor product cells");
+      qIdx[q*dim+d] = i;
+      Lq = Lq*n + i;
+    }
+    if (ctx->qMap[Lq] >= 0) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The quadrature is not a tensor product rule, the matrix-free Jacobian requires tensor product cells");
+    ctx->qMap[Lq] = q;
+  }
+  for (f = 0; f < Nf; ++f) {
+    PetscFE          fe;
+    PetscQuadrature  fquad;
+    const PetscReal *fpoints;
+    PetscInt         fNq, K = 1;
+
+    ierr = PetscDSGetDiscretization(prob, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEGetQuadrature(fe, &fquad);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(fquad, NULL, NULL, &fNq, &fpoints, NULL);CHKERRQ(ierr);
+    if (fNq != Nq) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Field %D does not use the quadrature of field 0", f);
+    for (q = 0; q < Nq*dim; ++q) if (PetscAbsReal(fpoints[q] - points[q]) > PETSC_SMALL) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Field %D does not use the quadrature of field 0", f);
+    ierr = DMPlexJacMFFieldSetUp_Static(fe, f, dim, n, x1, qIdx, &ctx->fields[f]);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) K *= ctx->fields[f].k;
+    kmax  = PetscMax(kmax, K);
+    Nc   += ctx->fields[f].Nc;
+  }
+  /* Intermediate tensors of the contractions have at most max(n, k)^dim entries */
+  for (d = 0; d < dim; ++d) tmax *= n;
+  tmax = PetscMax(tmax, kmax);
+  ierr = PetscMalloc5(Nc*Nq, &ctx->uq, Nc*dim*Nq, &ctx->uq_x, Nc*Nq, &ctx->f0, Nc*dim*Nq, &ctx->f1, totDim, &ctx->y);CHKERRQ(ierr);
+  ierr = PetscMalloc4(tmax, &ctx->U, tmax, &ctx->Z, tmax, &ctx->w0, tmax, &ctx->w1);CHKERRQ(ierr);
+  ierr = PetscFree2(x1, qIdx);CHKERRQ(ierr);
+  /* The shell has the layout of the global vector */
+  ierr = DMGetGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(u, &m);CHKERRQ(ierr);
+  ierr = VecGetSize(u, &M);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm, &u);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject) dm), m, m, M, M, ctx, J);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_MULT, (void (*)(void)) MatMult_DMPlexJacMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_GET_DIAGONAL, (void (*)(void)) MatGetDiagonal_DMPlexJacMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_DESTROY, (void (*)(void)) MatDestroy_DMPlexJacMF);CHKERRQ(ierr);
+  ierr = MatSetDM(*J, dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Mat Jac, Mat JacP,void *user)
 {
   DM_Plex        *mesh  = (DM_Plex *) dm->data;
@@ -2313,11 +3100,12 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   const PetscInt *cells;
   PetscInt        Nf, fieldI, fieldJ;
   PetscInt        totDim, totDimAux, cStart, cEnd, numCells, c;
-  PetscBool       isMatIS, isMatISP, isShell, hasJac, hasPrec, hasDyn, hasFV = PETSC_FALSE;
+  PetscBool       isMatIS, isMatISP, isShell, isMF, hasJac, hasPrec, hasDyn, hasFV = PETSC_FALSE;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMPlexIsJacobianMF_Static(Jac, &isMF);CHKERRQ(ierr);
   ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject) JacP, MATIS, &isMatISP);CHKERRQ(ierr);
   ierr = DMGetDefaultGlobalSection(dm, &globalSection);CHKERRQ(ierr);
@@ -2328,6 +3116,8 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
   ierr = PetscDSHasJacobian(prob, &hasJac);CHKERRQ(ierr);
   ierr = PetscDSHasJacobianPreconditioner(prob, &hasPrec);CHKERRQ(ierr);
+  /* A matrix-free Jacobian is not assembled, only the preconditioner */
+  if (isMF && hasPrec) hasJac = PETSC_FALSE;
   ierr = PetscDSHasDynamicJacobian(prob, &hasDyn);CHKERRQ(ierr);
   hasDyn = hasDyn && (X_tShift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
   ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
@@ -2517,7 +3307,7 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   }
   ierr = PetscLogEventEnd(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject) Jac, MATSHELL, &isShell);CHKERRQ(ierr);
-  if (isShell) {
+  if (isShell && !isMF) {
     JacActionCtx *jctx;
 
     ierr = MatShellGetContext(Jac, &jctx);CHKERRQ(ierr);
@@ -2714,22 +3504,30 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
 
   Note:
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
-  like a GPU, or vectorize on a multicore machine.
+  like a GPU, or vectorize on a multicore machine. A matrix from DMPlexSNESCreateJacobianMF() is not assembled,
+  but stores the pointwise Jacobian at X for its action.
 
   Level: developer
 
-.seealso: FormFunctionLocal()
+.seealso: FormFunctionLocal(), DMPlexSNESCreateJacobianMF()
 @*/
 PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void *user)
 {
   DM             plex;
   PetscDS        prob;
   IS             cellIS;
-  PetscBool      hasJac, hasPrec;
+  PetscBool      hasJac, hasPrec, isMF, isMFP;
   PetscInt       depth;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = DMPlexIsJacobianMF_Static(Jac, &isMF);CHKERRQ(ierr);
+  ierr = DMPlexIsJacobianMF_Static(JacP, &isMFP);CHKERRQ(ierr);
+  if (isMF) {ierr = DMPlexJacMFSetUp_Static(Jac, X);CHKERRQ(ierr);}
+  if (isMFP) {
+    if (JacP != Jac) {ierr = DMPlexJacMFSetUp_Static(JacP, X);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
   ierr = DMSNESConvertPlex(dm,&plex,PETSC_TRUE);CHKERRQ(ierr);
   ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
   ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
@@ -2737,7 +3535,7 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
   ierr = PetscDSHasJacobian(prob, &hasJac);CHKERRQ(ierr);
   ierr = PetscDSHasJacobianPreconditioner(prob, &hasPrec);CHKERRQ(ierr);
-  if (hasJac && hasPrec) {ierr = MatZeroEntries(Jac);CHKERRQ(ierr);}
+  if (hasJac && hasPrec && !isMF) {ierr = MatZeroEntries(Jac);CHKERRQ(ierr);}
   ierr = MatZeroEntries(JacP);CHKERRQ(ierr);
   ierr = DMPlexComputeJacobian_Internal(plex, cellIS, 0.0, 0.0, X, NULL, Jac, JacP, user);CHKERRQ(ierr);
   ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
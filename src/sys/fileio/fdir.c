@@ -43,6 +43,37 @@ PetscErrorCode PetscMkdir(const char dir[])
   PetscFunctionReturn(0);
 }
 
+/*
+   PetscMkdtemp - Creates a directory with a unique name, dir is a template ending in XXXXXX that is replaced by the name
+*/
+PetscErrorCode PetscMkdtemp(char dir[])
+{
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_WINDOWS_H) && defined(PETSC_HAVE_IO_H) && defined(PETSC_HAVE__MKDIR) && defined(PETSC_HAVE_DIRECT_H)
+  {
+    int            err = 1;
+    char           name[PETSC_MAX_PATH_LEN];
+    PetscInt       i = 0,max_retry = 26;
+    size_t         len;
+    PetscErrorCode ierr;
+
+    while (err && i < max_retry) {
+      ierr = PetscStrncpy(name,dir,sizeof(name));CHKERRQ(ierr);
+      ierr = PetscStrlen(name,&len);CHKERRQ(ierr);
+      err  = _mktemp_s(name,len+1);
+      if (err) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Could not generate a unique name from the template: %s",dir);
+      err  = _mkdir(name);
+      i++;
+    }
+    if (err) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Could not create a dir from the template: %s",dir);
+    ierr = PetscStrncpy(dir,name,len+1);CHKERRQ(ierr);
+  }
+#else
+  if (!mkdtemp(dir)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Could not create a dir from the template: %s",dir);
+#endif
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_HAVE_DIRECT_H)
 PetscErrorCode PetscRMTree(const char dir[])
 {
@@ -17,11 +17,11 @@ T*/
 int main(int argc,char **argv)
 {
   PetscErrorCode ierr;
-  PetscInt       i,nroots,nrootsalloc,nleaves,nleavesalloc,*mine,stride;
+  PetscInt       i,nroots,nrootsalloc,nleaves,nleavesalloc,*mine,stride,bs;
   PetscSFNode    *remote;
   PetscMPIInt    rank,size;
   PetscSF        sf;
-  PetscBool      test_bcast,test_reduce,test_degree,test_fetchandop,test_gather,test_scatter,test_embed,test_invert,test_sf_distribute;
+  PetscBool      test_bcast,test_bcast_overlap,test_reduce,test_degree,test_fetchandop,test_gather,test_scatter,test_embed,test_invert,test_sf_distribute;
   MPI_Op         mop=MPI_OP_NULL; /* initialize to prevent compiler warnings with cxx_quad build */
   char           opstring[256];
   PetscBool      strflg;
@@ -33,6 +33,8 @@ int main(int argc,char **argv)
   ierr            = PetscOptionsBegin(PETSC_COMM_WORLD,"","PetscSF Test Options","none");CHKERRQ(ierr);
   test_bcast      = PETSC_FALSE;
   ierr            = PetscOptionsBool("-test_bcast","Test broadcast","",test_bcast,&test_bcast,NULL);CHKERRQ(ierr);
+  test_bcast_overlap = PETSC_FALSE;
+  ierr            = PetscOptionsBool("-test_bcast_overlap","Test broadcast into leafdata overlapping rootdata","",test_bcast_overlap,&test_bcast_overlap,NULL);CHKERRQ(ierr);
   test_reduce     = PETSC_FALSE;
   ierr            = PetscOptionsBool("-test_reduce","Test reduction","",test_reduce,&test_reduce,NULL);CHKERRQ(ierr);
   mop             = MPI_SUM;
@@ -92,6 +94,8 @@ int main(int argc,char **argv)
   ierr            = PetscOptionsBool("-test_invert","Test point invert","",test_invert,&test_invert,NULL);CHKERRQ(ierr);
   stride          = 1;
   ierr            = PetscOptionsInt("-stride","Stride for leaf and root data","",stride,&stride,NULL);CHKERRQ(ierr);
+  bs              = 1;
+  ierr            = PetscOptionsInt("-bs","Number of integers in each root and leaf for -test_bcast_overlap","",bs,&bs,NULL);CHKERRQ(ierr);
   test_sf_distribute = PETSC_FALSE;
   ierr            = PetscOptionsBool("-test_sf_distribute","Create an SF that 'distributes' to each process, like an alltoall","",test_sf_distribute,&test_sf_distribute,NULL);CHKERRQ(ierr);
   ierr            = PetscOptionsEnd();CHKERRQ(ierr);
@@ -166,6 +170,34 @@ int main(int argc,char **argv)
     ierr = PetscFree2(rootdata,leafdata);CHKERRQ(ierr);
   }
 
+  if (test_bcast_overlap) {     /* broadcast rootdata into leafdata starting one unit after rootdata in the same array */
+    /* with large units (-bs) MPI does not buffer the sends, so received leaves would overwrite roots still being sent */
+    PetscInt     *rootdata,*leafdata,*data,k;
+    PetscBool    same;
+    MPI_Datatype unit;
+
+    ierr = MPI_Type_contiguous((PetscMPIInt)bs,MPIU_INT,&unit);CHKERRQ(ierr);
+    ierr = MPI_Type_commit(&unit);CHKERRQ(ierr);
+    ierr = PetscMalloc3(nrootsalloc*bs,&rootdata,nleavesalloc*bs,&leafdata,(nrootsalloc+nleavesalloc)*bs,&data);CHKERRQ(ierr);
+    for (i=0; i<nrootsalloc*bs; i++) rootdata[i] = -1;
+    for (i=0; i<nroots; i++) for (k=0; k<bs; k++) rootdata[i*stride*bs+k] = 100*(rank+1) + i;
+    for (i=0; i<nleavesalloc*bs; i++) leafdata[i] = -1;
+    /* Reference broadcast between separate arrays */
+    ierr = PetscSFBcastBegin(sf,unit,rootdata,leafdata);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,unit,rootdata,leafdata);CHKERRQ(ierr);
+    ierr = PetscMemcpy(data,rootdata,nrootsalloc*bs*sizeof(PetscInt));CHKERRQ(ierr);
+    for (i=nrootsalloc*bs; i<(nrootsalloc+nleavesalloc)*bs; i++) data[i] = -1;
+    ierr = PetscSFBcastBegin(sf,unit,data,data+bs);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,unit,data,data+bs);CHKERRQ(ierr);
+    for (i=0, same=PETSC_TRUE; i<nleaves; i++) for (k=0; k<bs; k++) if (data[bs+i*stride*bs+k] != leafdata[i*stride*bs+k]) same = PETSC_FALSE;
+    if (!same) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"[%d] Broadcast into leafdata overlapping rootdata differs from the broadcast between separate arrays",rank);
+    for (i=0; i<nleavesalloc; i++) leafdata[i] = data[bs+i*bs];
+    ierr = PetscViewerASCIIPrintf(PETSC_VIEWER_STDOUT_WORLD,"## Bcast Overlapping Leafdata\n");CHKERRQ(ierr);
+    ierr = PetscIntView(nleavesalloc,leafdata,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+    ierr = PetscFree3(rootdata,leafdata,data);CHKERRQ(ierr);
+    ierr = MPI_Type_free(&unit);CHKERRQ(ierr);
+  }
+
   if (test_reduce) {            /* Reduce leafdata into rootdata */
     PetscInt *rootdata,*leafdata;
     ierr = PetscMalloc2(nrootsalloc,&rootdata,nleavesalloc,&leafdata);CHKERRQ(ierr);
@@ -375,6 +407,46 @@ int main(int argc,char **argv)
       args: -test_bcast -sf_type basic
       output_file: output/ex1_1_basic.out
 
+   test:
+      suffix: basic_nopersistent
+      nsize: 4
+      args: -test_bcast -sf_type basic -sf_basic_persistent 0 -sf_basic_zerocopy 0
+      output_file: output/ex1_1_basic.out
+
+   test:
+      suffix: bcast_overlap
+      nsize: 4
+      args: -test_bcast_overlap -sf_type basic -bs 20000
+
+   test:
+      suffix: bcast_overlap_nozerocopy
+      nsize: 4
+      args: -test_bcast_overlap -sf_type basic -bs 20000 -sf_basic_zerocopy 0
+      output_file: output/ex1_bcast_overlap.out
+
+   test:
+      suffix: bcast_overlap_stride
+      nsize: 4
+      args: -test_bcast_overlap -sf_type basic -bs 20000 -stride 2
+
+   test:
+      suffix: 2_basic_nozerocopy
+      nsize: 4
+      args: -test_reduce -sf_type basic -sf_basic_zerocopy 0
+      output_file: output/ex1_2_basic.out
+
+   test:
+      suffix: neighbor
+      nsize: 4
+      args: -test_bcast -sf_type neighbor
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+   test:
+      suffix: 2_neighbor
+      nsize: 4
+      args: -test_reduce -test_fetchandop -sf_type neighbor
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
    test:
       suffix: 8
       nsize: 3
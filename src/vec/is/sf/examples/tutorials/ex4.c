@@ -0,0 +1,118 @@
+static const char help[] = "Benchmarks PetscSF types on the same halo exchange graph.\n\n\
+Each process owns -n roots and has -m leaves referencing strided roots of each of its -neighbors nearest processes on\n\
+either side, plus -m leaves referencing its own roots. Every type listed in -sf_types is set up on this graph, checked\n\
+against the first one, and timed over -its broadcasts and reductions.\n\n";
+
+#include <petscsf.h>
+#include <petsctime.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscSF        sf;
+  PetscMPIInt    rank,size;
+  PetscInt       n = 1000,m = 100,k = 2,its = 100,nleaves,nroots,i,j,d,l,t,ntypes = 4,nwrong;
+  PetscInt       *rootdata,*leafdata,*reduced,*refreduced = NULL;
+  PetscSFNode    *iremote;
+  char           *types[4];
+  PetscLogDouble tbcast,treduce,tmp;
+  PetscBool      flg;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"PetscSF benchmark options","none");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","Number of roots on each process","ex4.c",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-m","Number of leaves referencing each neighbor","ex4.c",m,&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-neighbors","Number of neighbors on either side of each process","ex4.c",k,&k,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-its","Number of timed operations","ex4.c",its,&its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsStringArray("-sf_types","PetscSF types to compare","PetscSFSetType",types,&ntypes,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (!flg) {
+    ierr   = PetscStrallocpy(PETSCSFBASIC,&types[0]);CHKERRQ(ierr);
+    ntypes = 1;
+  }
+  if (m > n) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"Number of leaves per neighbor %D cannot exceed the number of roots %D",m,n);
+  k = PetscMin(k,(size-1)/2);
+
+  /* Leaves reference every third root (modulo n) so that the roots sent to each process are not contiguous */
+  nroots  = n;
+  nleaves = (2*k+1)*m;
+  ierr    = PetscMalloc1(nleaves,&iremote);CHKERRQ(ierr);
+  for (d=-k,l=0; d<=k; d++) {
+    for (j=0; j<m; j++,l++) {
+      iremote[l].rank  = (rank+d+size)%size;
+      iremote[l].index = (3*j+rank)%n;
+    }
+  }
+  ierr = PetscMalloc4(nroots,&rootdata,nleaves,&leafdata,nroots,&reduced,nroots,&refreduced);CHKERRQ(ierr);
+  for (i=0; i<nroots; i++) rootdata[i] = rank*n+i;
+
+  for (t=0; t<ntypes; t++) {
+    ierr = PetscSFCreate(PETSC_COMM_WORLD,&sf);CHKERRQ(ierr);
+    ierr = PetscSFSetType(sf,types[t]);CHKERRQ(ierr);
+    ierr = PetscSFSetFromOptions(sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sf,nroots,nleaves,NULL,PETSC_COPY_VALUES,iremote,PETSC_COPY_VALUES);CHKERRQ(ierr);
+    ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+
+    /* Check the broadcast against the graph and the reduction against the first type */
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,rootdata,leafdata);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,rootdata,leafdata);CHKERRQ(ierr);
+    for (l=0,nwrong=0; l<nleaves; l++) {
+      if (leafdata[l] != iremote[l].rank*n+iremote[l].index) nwrong++;
+    }
+    ierr = PetscMemzero(reduced,nroots*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(sf,MPIU_INT,leafdata,reduced,MPIU_SUM);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(sf,MPIU_INT,leafdata,reduced,MPIU_SUM);CHKERRQ(ierr);
+    if (!t) {ierr = PetscMemcpy(refreduced,reduced,nroots*sizeof(PetscInt));CHKERRQ(ierr);}
+    for (i=0; i<nroots; i++) {
+      if (reduced[i] != refreduced[i]) nwrong++;
+    }
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,&nwrong,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+
+    ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+    ierr = PetscTime(&tbcast);CHKERRQ(ierr);
+    for (i=0; i<its; i++) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT,rootdata,leafdata);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT,rootdata,leafdata);CHKERRQ(ierr);
+    }
+    ierr = PetscTime(&tmp);CHKERRQ(ierr);
+    tbcast = tmp - tbcast;
+    ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+    ierr = PetscTime(&treduce);CHKERRQ(ierr);
+    for (i=0; i<its; i++) {
+      ierr = PetscSFReduceBegin(sf,MPIU_INT,leafdata,reduced,MPIU_SUM);CHKERRQ(ierr);
+      ierr = PetscSFReduceEnd(sf,MPIU_INT,leafdata,reduced,MPIU_SUM);CHKERRQ(ierr);
+    }
+    ierr = PetscTime(&tmp);CHKERRQ(ierr);
+    treduce = tmp - treduce;
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,&tbcast,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,&treduce,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"PetscSF %s: %s\n",types[t],nwrong ? "wrong results" : "results verified");CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  time per operation: Bcast %g us, Reduce %g us\n",its ? 1.e6*tbcast/its : 0.,its ? 1.e6*treduce/its : 0.);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    ierr = PetscFree(types[t]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(iremote);CHKERRQ(ierr);
+  ierr = PetscFree4(rootdata,leafdata,reduced,refreduced);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: basic
+      nsize: 4
+      args: -n 50 -m 20 -its 5
+      filter: grep -v "time per"
+
+   test:
+      suffix: neighbor
+      nsize: 5
+      args: -n 50 -m 20 -its 5 -sf_types basic,neighbor
+      filter: grep -v "time per"
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+TEST*/
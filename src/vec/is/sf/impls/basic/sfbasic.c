@@ -1,57 +1,5 @@
 
-#include <petsc/private/sfimpl.h> /*I "petscsf.h" I*/
-
-typedef struct _n_PetscSFBasicPack *PetscSFBasicPack;
-struct _n_PetscSFBasicPack {
-  void (*Pack)(PetscInt,PetscInt,const PetscInt*,const void*,void*);
-  void (*UnpackInsert)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackAdd)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMin)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMax)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMinloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMult)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*FetchAndInsert)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndAdd)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMin)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMax)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMinloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMult)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-
-  MPI_Datatype     unit;
-  size_t           unitbytes;   /* Number of bytes in a unit */
-  PetscInt         bs;          /* Number of basic units in a unit */
-  const void       *key;        /* Array used as key for operation */
-  char             **root;      /* Packed root data, indexed by leaf rank */
-  char             **leaf;      /* Packed leaf data, indexed by root rank */
-  MPI_Request      *requests;   /* Array of root requests followed by leaf requests */
-  PetscSFBasicPack next;
-};
-
-typedef struct {
-  PetscMPIInt      tag;
-  PetscMPIInt      niranks;     /* Number of incoming ranks (ranks accessing my roots) */
-  PetscMPIInt      ndiranks;    /* Number of incoming ranks (ranks accessing my roots) in distinguished set */
-  PetscMPIInt      *iranks;     /* Array of ranks that reference my roots */
-  PetscInt         itotal;      /* Total number of graph edges referencing my roots */
-  PetscInt         *ioffset;    /* Array of length niranks+1 holding offset in irootloc[] for each rank */
-  PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */
-  PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */
-  PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */
-} PetscSF_Basic;
+#include <../src/vec/is/sf/impls/basic/sfbasic.h> /*I "petscsf.h" I*/
 
 #if !defined(PETSC_HAVE_MPI_TYPE_DUP)
 PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype)
@@ -531,7 +479,25 @@ DEF_Block(int,6)
 DEF_Block(int,7)
 DEF_Block(int,8)
 
-static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
+/*
+   PetscSFBasicFindContiguous_Private - For each rank, sets start[i] to the first entry of loc[offset[i]:offset[i+1]] if these
+   entries are consecutive, otherwise to -1
+*/
+static PetscErrorCode PetscSFBasicFindContiguous_Private(PetscInt n,const PetscInt *offset,const PetscInt *loc,PetscInt *start)
+{
+  PetscInt i,j;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    start[i] = offset[i+1] > offset[i] ? loc[offset[i]] : -1;
+    for (j=offset[i]+1; j<offset[i+1]; j++) {
+      if (loc[j] != loc[j-1]+1) {start[i] = -1; break;}
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
@@ -598,6 +564,11 @@ static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   ierr = MPI_Waitall(bas->niranks-bas->ndiranks,rootreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = MPI_Waitall(sf->nranks-sf->ndranks,leafreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = PetscFree2(rootreqs,leafreqs);CHKERRQ(ierr);
+
+  /* Find the ranks whose roots or leaves are contiguous, they can be communicated without packing */
+  ierr = PetscMalloc2(bas->niranks,&bas->irootstart,sf->nranks,&bas->leafstart);CHKERRQ(ierr);
+  ierr = PetscSFBasicFindContiguous_Private(bas->niranks,bas->ioffset,bas->irootloc,bas->irootstart);CHKERRQ(ierr);
+  ierr = PetscSFBasicFindContiguous_Private(sf->nranks,sf->roffset,sf->rmine,bas->leafstart);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -702,7 +673,7 @@ static PetscErrorCode PetscSFBasicPackGetUnpackOp(PetscSF sf,PetscSFBasicPack li
   else *UnpackOp = NULL;
   PetscFunctionReturn(0);
 }
-static PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF sf,PetscSFBasicPack link,MPI_Op op,void (**FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*))
+PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF sf,PetscSFBasicPack link,MPI_Op op,void (**FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*))
 {
   PetscFunctionBegin;
   *FetchAndOp = NULL;
@@ -723,16 +694,6 @@ static PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF sf,PetscSFBasicPack
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicPackGetReqs(PetscSF sf,PetscSFBasicPack link,MPI_Request **rootreqs,MPI_Request **leafreqs)
-{
-  PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
-
-  PetscFunctionBegin;
-  if (rootreqs) *rootreqs = link->requests;
-  if (leafreqs) *leafreqs = link->requests + (bas->niranks - bas->ndiranks);
-  PetscFunctionReturn(0);
-}
-
 static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link)
 {
   PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
@@ -743,7 +704,7 @@ static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link)
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,PetscInt *ndrootranks,const PetscMPIInt **rootranks,const PetscInt **rootoffset,const PetscInt **rootloc)
+PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,PetscInt *ndrootranks,const PetscMPIInt **rootranks,const PetscInt **rootoffset,const PetscInt **rootloc)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
 
@@ -756,7 +717,7 @@ static PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,Pe
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,PetscInt *ndleafranks,const PetscMPIInt **leafranks,const PetscInt **leafoffset,const PetscInt **leafloc)
+PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,PetscInt *ndleafranks,const PetscMPIInt **leafranks,const PetscInt **leafoffset,const PetscInt **leafloc)
 {
   PetscFunctionBegin;
   if (nleafranks)  *nleafranks  = sf->nranks;
@@ -767,7 +728,119 @@ static PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,Pe
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
+/*
+   PetscSFBasicGetZeroCopy - Determines whether an operation communicates directly with the user root and leaf arrays for the
+   ranks whose roots or leaves are contiguous
+
+   Input Arguments:
++  sf - the star forest
+.  link - pack of the operation, gives the size of a unit
+.  dir - PETSCSF_BASIC_ROOT2LEAF for roots sending to leaves, PETSCSF_BASIC_LEAF2ROOT for leaves sending to roots
+.  rootdata - user root array
+-  leafdata - user leaf array
+
+   Output Arguments:
++  rootdirect - whether the roots are sent from, or received into, rootdata (optional)
+-  leafdirect - whether the leaves are sent from, or received into, leafdata (optional)
+
+   Notes:
+   Sending directly from the user array is always possible. Receiving directly is only safe if the part of the receiving
+   array the leaves (roots) can reach does not overlap the part of the sending array, since the received values would
+   otherwise overwrite values still being sent. Roots are never received directly since they have to be reduced.
+*/
+static PetscErrorCode PetscSFBasicGetZeroCopy(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection dir,const void *rootdata,const void *leafdata,PetscBool *rootdirect,PetscBool *leafdirect)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
+  PetscBool     disjoint = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  if (dir == PETSCSF_BASIC_ROOT2LEAF && bas->zerocopy && sf->nleaves) {
+    const char *rbegin = (const char*)rootdata,*rend = rbegin + sf->nroots*link->unitbytes;
+    const char *lbegin = (const char*)leafdata + sf->minleaf*link->unitbytes,*lend = (const char*)leafdata + (sf->maxleaf+1)*link->unitbytes;
+    disjoint = (rend <= lbegin || lend <= rbegin) ? PETSC_TRUE : PETSC_FALSE;
+  }
+  if (rootdirect) *rootdirect = (bas->zerocopy && dir == PETSCSF_BASIC_ROOT2LEAF) ? PETSC_TRUE : PETSC_FALSE;
+  if (leafdirect) *leafdirect = (bas->zerocopy && disjoint) ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscSFBasicPackStart - Starts the messages of an operation between non-distinguished ranks
+
+   Input Arguments:
++  sf - the star forest
+.  link - pack holding the buffers and requests
+.  dir - PETSCSF_BASIC_ROOT2LEAF for roots sending to leaves, PETSCSF_BASIC_LEAF2ROOT for leaves sending to roots
+.  rootdata - user root array used instead of the pack buffer for ranks with contiguous roots, or NULL to always use the pack buffers
+-  leafdata - user leaf array used instead of the pack buffer for ranks with contiguous leaves, or NULL to always use the pack buffers
+
+   Notes:
+   Persistent requests are created the first time a direction is used on a link and then restarted, they are recreated
+   if the user arrays differ from the ones they were created with.
+*/
+static PetscErrorCode PetscSFBasicPackStart(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection dir,const void *rootdata,const void *leafdata)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  MPI_Comm          comm;
+  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks,nreqs;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Datatype      unit = link->unit;
+  MPI_Request       *reqs,*rootreqs,*leafreqs;
+  PetscBool         post = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  ierr  = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr  = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr  = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  nreqs = (nrootranks-ndrootranks) + (nleafranks-ndleafranks);
+  if (bas->persistent) {
+    reqs = link->persistent[dir];
+    if (!reqs) {
+      ierr = PetscMalloc1(nreqs,&link->persistent[dir]);CHKERRQ(ierr);
+      reqs = link->persistent[dir];
+    } else if (link->rootbuf[dir] != rootdata || link->leafbuf[dir] != leafdata) {
+      for (i=0; i<nreqs; i++) {ierr = MPI_Request_free(&reqs[i]);CHKERRQ(ierr);}
+    } else post = PETSC_FALSE;
+    link->rootbuf[dir] = rootdata;
+    link->leafbuf[dir] = leafdata;
+  } else reqs = link->onetime;
+  rootreqs = reqs;
+  leafreqs = reqs + (nrootranks-ndrootranks);
+
+  if (post) {
+    for (i=ndrootranks; i<nrootranks; i++) {
+      PetscMPIInt n    = rootoffset[i+1] - rootoffset[i];
+      void        *buf = (rootdata && bas->irootstart[i] >= 0) ? (void*)((char*)rootdata + bas->irootstart[i]*link->unitbytes) : (void*)link->root[i];
+      MPI_Request *req = &rootreqs[i-ndrootranks];
+      if (dir == PETSCSF_BASIC_ROOT2LEAF) {
+        if (bas->persistent) {ierr = MPI_Send_init(buf,n,unit,rootranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+        else {ierr = MPI_Isend(buf,n,unit,rootranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+      } else {
+        if (bas->persistent) {ierr = MPI_Recv_init(buf,n,unit,rootranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+        else {ierr = MPI_Irecv(buf,n,unit,rootranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+      }
+    }
+    for (i=ndleafranks; i<nleafranks; i++) {
+      PetscMPIInt n    = leafoffset[i+1] - leafoffset[i];
+      void        *buf = (leafdata && bas->leafstart[i] >= 0) ? (void*)((char*)leafdata + bas->leafstart[i]*link->unitbytes) : (void*)link->leaf[i];
+      MPI_Request *req = &leafreqs[i-ndleafranks];
+      if (dir == PETSCSF_BASIC_ROOT2LEAF) {
+        if (bas->persistent) {ierr = MPI_Recv_init(buf,n,unit,leafranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+        else {ierr = MPI_Irecv(buf,n,unit,leafranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+      } else {
+        if (bas->persistent) {ierr = MPI_Send_init(buf,n,unit,leafranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+        else {ierr = MPI_Isend(buf,n,unit,leafranks[i],bas->tag,comm,req);CHKERRQ(ierr);}
+      }
+    }
+  }
+  if (bas->persistent && nreqs) {ierr = MPI_Startall((PetscMPIInt)nreqs,reqs);CHKERRQ(ierr);}
+  link->requests = reqs;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -792,18 +865,19 @@ static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const voi
   ierr = PetscNew(&link);CHKERRQ(ierr);
   ierr = PetscSFBasicPackTypeSetup(link,unit);CHKERRQ(ierr);
   ierr = PetscMalloc2(nrootranks,&link->root,nleafranks,&link->leaf);CHKERRQ(ierr);
-  for (i=0; i<nrootranks; i++) {
-    ierr = PetscMalloc((rootoffset[i+1]-rootoffset[i])*link->unitbytes,&link->root[i]);CHKERRQ(ierr);
-  }
+  /* The buffers of all ranks share contiguous storage so they can also be communicated with a single neighborhood collective */
+  ierr = PetscMalloc(rootoffset[nrootranks]*link->unitbytes,&link->rootpack);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) link->root[i] = link->rootpack + rootoffset[i]*link->unitbytes;
+  ierr = PetscMalloc((leafoffset[nleafranks]-leafoffset[ndleafranks])*link->unitbytes,&link->leafpack);CHKERRQ(ierr);
   for (i=0; i<nleafranks; i++) {
     if (i < ndleafranks) {      /* Leaf buffers for distinguished ranks are pointers directly into root buffers */
       if (ndrootranks != 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Cannot match distinguished ranks");
       link->leaf[i] = link->root[0];
       continue;
     }
-    ierr = PetscMalloc((leafoffset[i+1]-leafoffset[i])*link->unitbytes,&link->leaf[i]);CHKERRQ(ierr);
+    link->leaf[i] = link->leafpack + (leafoffset[i]-leafoffset[ndleafranks])*link->unitbytes;
   }
-  ierr = PetscCalloc1(nrootranks+nleafranks,&link->requests);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nrootranks+nleafranks,&link->onetime);CHKERRQ(ierr);
 
 found:
   link->key  = key;
@@ -814,7 +888,7 @@ found:
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscCopyMode cmode,PetscSFBasicPack *mylink)
+PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscCopyMode cmode,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -839,7 +913,7 @@ static PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,cons
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
+PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
 
@@ -853,15 +927,18 @@ static PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
 
 static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,PetscSF sf)
 {
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Basic options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_basic_persistent","Use persistent MPI requests, reused by operations with the same data type","PetscSFSetType",bas->persistent,&bas->persistent,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_basic_zerocopy","Send and receive directly from and to the user arrays for ranks with contiguous roots or leaves","PetscSFSetType",bas->zerocopy,&bas->zerocopy,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFReset_Basic(PetscSF sf)
+PetscErrorCode PetscSFReset_Basic(PetscSF sf)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -871,14 +948,20 @@ static PetscErrorCode PetscSFReset_Basic(PetscSF sf)
   if (bas->inuse) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
   ierr = PetscFree2(bas->iranks,bas->ioffset);CHKERRQ(ierr);
   ierr = PetscFree(bas->irootloc);CHKERRQ(ierr);
+  ierr = PetscFree2(bas->irootstart,bas->leafstart);CHKERRQ(ierr);
   for (link=bas->avail; link; link=next) {
-    PetscInt i;
+    PetscInt i,d,nreqs = (bas->niranks-bas->ndiranks) + (sf->nranks-sf->ndranks);
     next = link->next;
+    for (d=0; d<2; d++) {
+      if (!link->persistent[d]) continue;
+      for (i=0; i<nreqs; i++) {ierr = MPI_Request_free(&link->persistent[d][i]);CHKERRQ(ierr);}
+      ierr = PetscFree(link->persistent[d]);CHKERRQ(ierr);
+    }
     ierr = MPI_Type_free(&link->unit);CHKERRQ(ierr);
-    for (i=0; i<bas->niranks; i++) {ierr = PetscFree(link->root[i]);CHKERRQ(ierr);}
-    for (i=sf->ndranks; i<sf->nranks; i++) {ierr = PetscFree(link->leaf[i]);CHKERRQ(ierr);} /* Free only non-distinguished leaf buffers */
+    ierr = PetscFree(link->rootpack);CHKERRQ(ierr);
+    ierr = PetscFree(link->leafpack);CHKERRQ(ierr);
     ierr = PetscFree2(link->root,link->leaf);CHKERRQ(ierr);
-    ierr = PetscFree(link->requests);CHKERRQ(ierr);
+    ierr = PetscFree(link->onetime);CHKERRQ(ierr);
     ierr = PetscFree(link);CHKERRQ(ierr);
   }
   bas->avail = NULL;
@@ -895,7 +978,7 @@ static PetscErrorCode PetscSFDestroy_Basic(PetscSF sf)
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
+PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
 {
   /* PetscSF_Basic *bas = (PetscSF_Basic*)sf->data; */
   PetscErrorCode ierr;
@@ -915,47 +998,44 @@ static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf,MPI_Datatype unit,const
   PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode    ierr;
   PetscSFBasicPack  link;
-  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
-  const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
-  const PetscMPIInt *rootranks,*leafranks;
-  MPI_Request       *rootreqs,*leafreqs;
+  PetscInt          i,nrootranks,ndrootranks;
+  const PetscInt    *rootoffset,*rootloc;
+  PetscBool         rootdirect,leafdirect;
 
   PetscFunctionBegin;
-  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
-  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetZeroCopy(sf,link,PETSCSF_BASIC_ROOT2LEAF,rootdata,leafdata,&rootdirect,&leafdirect);CHKERRQ(ierr);
 
-  ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
-  /* Eagerly post leaf receives, but only from non-distinguished ranks -- distinguished ranks will receive via shared memory */
-  for (i=ndleafranks; i<nleafranks; i++) {
-    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
-    ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
-  }
-  /* Pack and send root data */
+  /* Pack root data, ranks with contiguous roots are sent directly from rootdata, distinguished ranks communicate via shared memory */
   for (i=0; i<nrootranks; i++) {
-    PetscMPIInt n          = rootoffset[i+1] - rootoffset[i];
-    void        *packstart = link->root[i];
-    (*link->Pack)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
-    if (i < ndrootranks) continue; /* shared memory */
-    ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    if (i >= ndrootranks && rootdirect && bas->irootstart[i] >= 0) continue;
+    (*link->Pack)(n,link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
   }
+  /* Post leaf receives and root sends for non-distinguished ranks */
+  ierr = PetscSFBasicPackStart(sf,link,PETSCSF_BASIC_ROOT2LEAF,rootdirect ? rootdata : NULL,leafdirect ? leafdata : NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 PetscErrorCode PetscSFBcastEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
 {
+  PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
   PetscSFBasicPack link;
   PetscInt         i,nleafranks,ndleafranks;
   const PetscInt   *leafoffset,*leafloc;
+  PetscBool        leafdirect;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
   ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
   ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetZeroCopy(sf,link,PETSCSF_BASIC_ROOT2LEAF,rootdata,leafdata,NULL,&leafdirect);CHKERRQ(ierr);
   for (i=0; i<nleafranks; i++) {
     PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
     const void  *packstart = link->leaf[i];
+    if (i >= ndleafranks && leafdirect && bas->leafstart[i] >= 0) continue; /* received directly into leafdata */
     (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
   }
   ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
@@ -968,46 +1048,39 @@ PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void
   PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
   PetscSFBasicPack  link;
   PetscErrorCode    ierr;
-  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
-  const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
-  const PetscMPIInt *rootranks,*leafranks;
-  MPI_Request       *rootreqs,*leafreqs;
+  PetscInt          i,nleafranks,ndleafranks;
+  const PetscInt    *leafoffset,*leafloc;
+  PetscBool         leafdirect;
 
   PetscFunctionBegin;
-  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
-  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  /* Roots are always received into the pack buffers since they have to be reduced */
+  ierr = PetscSFBasicGetZeroCopy(sf,link,PETSCSF_BASIC_LEAF2ROOT,rootdata,leafdata,NULL,&leafdirect);CHKERRQ(ierr);
 
-  ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
-  /* Eagerly post root receives for non-distinguished ranks */
-  for (i=ndrootranks; i<nrootranks; i++) {
-    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
-    ierr = MPI_Irecv(link->root[i],n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
-  }
-  /* Pack and send leaf data */
+  /* Pack leaf data, ranks with contiguous leaves are sent directly from leafdata */
   for (i=0; i<nleafranks; i++) {
-    PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
-    void        *packstart = link->leaf[i];
-    (*link->Pack)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
-    if (i < ndleafranks) continue; /* shared memory */
-    ierr = MPI_Isend(packstart,n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+    if (i >= ndleafranks && leafdirect && bas->leafstart[i] >= 0) continue;
+    (*link->Pack)(n,link->bs,leafloc+leafoffset[i],leafdata,link->leaf[i]);
   }
+  /* Post root receives and leaf sends for non-distinguished ranks */
+  ierr = PetscSFBasicPackStart(sf,link,PETSCSF_BASIC_LEAF2ROOT,NULL,leafdirect ? leafdata : NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+/*
+   PetscSFBasicUnpackReduce - Reduces the received root buffers of a pack into rootdata
+*/
+PetscErrorCode PetscSFBasicUnpackReduce(PetscSF sf,PetscSFBasicPack link,MPI_Datatype unit,void *rootdata,MPI_Op op)
 {
   void             (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
   PetscErrorCode   ierr;
-  PetscSFBasicPack link;
   PetscInt         i,nrootranks;
   PetscMPIInt      typesize = -1;
   const PetscInt   *rootoffset,*rootloc;
 
   PetscFunctionBegin;
-  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
-  /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
-  ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
   ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
   ierr = PetscSFBasicPackGetUnpackOp(sf,link,op,&UnpackOp);CHKERRQ(ierr);
   if (UnpackOp) {
@@ -1037,6 +1110,19 @@ static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const
     }
 #endif
   }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
+  ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
+  ierr = PetscSFBasicUnpackReduce(sf,link,unit,rootdata,op);CHKERRQ(ierr);
   ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1052,37 +1138,26 @@ static PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,
 
 static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
 {
-  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
   void              (*FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*);
   PetscErrorCode    ierr;
   PetscSFBasicPack  link;
-  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  PetscInt          i,nrootranks,nleafranks;
   const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
-  const PetscMPIInt *rootranks,*leafranks;
-  MPI_Request       *rootreqs,*leafreqs;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
   /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
-  ierr      = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
-  ierr      = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
-  ierr      = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
-  ierr      = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
-  /* Post leaf receives */
-  for (i=ndleafranks; i<nleafranks; i++) {
-    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
-    ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
-  }
-  /* Process local fetch-and-op, post root sends */
+  ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  /* Process local fetch-and-op */
   ierr = PetscSFBasicPackGetFetchAndOp(sf,link,op,&FetchAndOp);CHKERRQ(ierr);
   for (i=0; i<nrootranks; i++) {
-    PetscMPIInt n          = rootoffset[i+1] - rootoffset[i];
-    void        *packstart = link->root[i];
-
-    (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
-    if (i < ndrootranks) continue; /* shared memory */
-    ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
   }
+  /* Post leaf receives and root sends of the fetched values through the pack buffers */
+  ierr = PetscSFBasicPackStart(sf,link,PETSCSF_BASIC_ROOT2LEAF,NULL,NULL);CHKERRQ(ierr);
   ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
   for (i=0; i<nleafranks; i++) {
     PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
@@ -1112,6 +1187,8 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Basic;
 
   ierr = PetscNewLog(sf,&bas);CHKERRQ(ierr);
+  bas->persistent = PETSC_TRUE;
+  bas->zerocopy   = PETSC_TRUE;
   sf->data = (void*)bas;
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,81 @@
+#if !defined(__SFBASIC_H)
+#define __SFBASIC_H
+
+#include <petsc/private/sfimpl.h>
+
+typedef struct _n_PetscSFBasicPack *PetscSFBasicPack;
+struct _n_PetscSFBasicPack {
+  void (*Pack)(PetscInt,PetscInt,const PetscInt*,const void*,void*);
+  void (*UnpackInsert)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackAdd)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMin)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMax)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMinloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMult)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*FetchAndInsert)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndAdd)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMin)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMax)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMinloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMult)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+
+  MPI_Datatype     unit;
+  size_t           unitbytes;   /* Number of bytes in a unit */
+  PetscInt         bs;          /* Number of basic units in a unit */
+  const void       *key;        /* Array used as key for operation */
+  char             **root;      /* Packed root data, indexed by leaf rank */
+  char             **leaf;      /* Packed leaf data, indexed by root rank */
+  char             *rootpack;   /* Contiguous storage of the root buffers, root[0] */
+  char             *leafpack;   /* Contiguous storage of the leaf buffers of non-distinguished ranks, leaf[ndleafranks] */
+  MPI_Request      request;     /* Request of a neighborhood collective in progress */
+  MPI_Request      *requests;   /* Requests of the operation in progress, root requests followed by leaf requests */
+  MPI_Request      *onetime;    /* Requests posted with MPI_Isend() and MPI_Irecv() when persistent requests are not used */
+  MPI_Request      *persistent[2]; /* Persistent requests for each PetscSFBasicDirection, created on first use */
+  const void       *rootbuf[2]; /* User root array the persistent requests of each direction communicate directly with, or NULL */
+  const void       *leafbuf[2]; /* User leaf array the persistent requests of each direction communicate directly with, or NULL */
+  PetscSFBasicPack next;
+};
+
+typedef enum {PETSCSF_BASIC_ROOT2LEAF=0,PETSCSF_BASIC_LEAF2ROOT=1} PetscSFBasicDirection;
+
+typedef struct {
+  PetscMPIInt      tag;
+  PetscMPIInt      niranks;     /* Number of incoming ranks (ranks accessing my roots) */
+  PetscMPIInt      ndiranks;    /* Number of incoming ranks (ranks accessing my roots) in distinguished set */
+  PetscMPIInt      *iranks;     /* Array of ranks that reference my roots */
+  PetscInt         itotal;      /* Total number of graph edges referencing my roots */
+  PetscInt         *ioffset;    /* Array of length niranks+1 holding offset in irootloc[] for each rank */
+  PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */
+  PetscInt         *irootstart; /* First root referenced by each incoming rank if these roots are contiguous, otherwise -1 */
+  PetscInt         *leafstart;  /* First leaf of each outgoing rank if its leaves are contiguous, otherwise -1 */
+  PetscBool        persistent;  /* Use persistent requests cached on the pack links */
+  PetscBool        zerocopy;    /* Communicate directly with the user arrays for ranks whose roots or leaves are contiguous */
+  PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */
+  PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */
+} PetscSF_Basic;
+
+PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF,PetscViewer);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetRootInfo(PetscSF,PetscInt*,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF,PetscInt*,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetPack(PetscSF,MPI_Datatype,const void*,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetPackInUse(PetscSF,MPI_Datatype,const void*,PetscCopyMode,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicReclaimPack(PetscSF,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicPackGetFetchAndOp(PetscSF,PetscSFBasicPack,MPI_Op,void (**)(PetscInt,PetscInt,const PetscInt*,void*,void*));
+PETSC_INTERN PetscErrorCode PetscSFBasicUnpackReduce(PetscSF,PetscSFBasicPack,MPI_Datatype,void*,MPI_Op);
+#endif
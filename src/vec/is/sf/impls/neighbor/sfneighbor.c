@@ -0,0 +1,223 @@
+#include <../src/vec/is/sf/impls/basic/sfbasic.h> /*I "petscsf.h" I*/
+
+/*
+   PETSCSFNEIGHBOR uses the same pack buffers and communication pattern as PETSCSFBASIC, but all messages of an operation are
+   exchanged with a single MPI_Ineighbor_alltoallv() on a distributed graph communicator instead of individual sends and receives
+*/
+typedef struct {
+  PetscSF_Basic bas;            /* Must be first, the PETSCSFBASIC routines operate on it */
+  MPI_Comm      distcomm[2];    /* Distributed graph communicators for each PetscSFBasicDirection */
+  PetscMPIInt   *rootcounts;    /* Number of units exchanged with each non-distinguished incoming rank */
+  PetscMPIInt   *rootdispls;    /* Offsets of these units in the root buffers of the non-distinguished ranks */
+  PetscMPIInt   *leafcounts;    /* Number of units exchanged with each non-distinguished outgoing rank */
+  PetscMPIInt   *leafdispls;    /* Offsets of these units in the leaf buffers of the non-distinguished ranks */
+} PetscSF_Neighbor;
+
+static PetscErrorCode PetscSFSetUp_Neighbor(PetscSF sf)
+{
+  PetscSF_Neighbor  *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode    ierr;
+  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  ierr = PetscSFSetUp_Basic(sf);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+
+  ierr = PetscMalloc4(nrootranks-ndrootranks,&dat->rootcounts,nrootranks-ndrootranks,&dat->rootdispls,nleafranks-ndleafranks,&dat->leafcounts,nleafranks-ndleafranks,&dat->leafdispls);CHKERRQ(ierr);
+  for (i=ndrootranks; i<nrootranks; i++) {
+    ierr = PetscMPIIntCast(rootoffset[i+1]-rootoffset[i],&dat->rootcounts[i-ndrootranks]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(rootoffset[i]-rootoffset[ndrootranks],&dat->rootdispls[i-ndrootranks]);CHKERRQ(ierr);
+  }
+  for (i=ndleafranks; i<nleafranks; i++) {
+    ierr = PetscMPIIntCast(leafoffset[i+1]-leafoffset[i],&dat->leafcounts[i-ndleafranks]);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(leafoffset[i]-leafoffset[ndleafranks],&dat->leafdispls[i-ndleafranks]);CHKERRQ(ierr);
+  }
+
+  /* Roots send to the ranks referencing them in a broadcast and receive from them in a reduction; distinguished ranks communicate via shared memory.
+     The edges are weighted by the number of units exchanged, which MPI may use to place the ranks and is the same on both ends of an edge. */
+  ierr = MPI_Dist_graph_create_adjacent(comm,nleafranks-ndleafranks,leafranks+ndleafranks,nleafranks > ndleafranks ? dat->leafcounts : MPI_WEIGHTS_EMPTY,nrootranks-ndrootranks,rootranks+ndrootranks,nrootranks > ndrootranks ? dat->rootcounts : MPI_WEIGHTS_EMPTY,MPI_INFO_NULL,0,&dat->distcomm[PETSCSF_BASIC_ROOT2LEAF]);CHKERRQ(ierr);
+  ierr = MPI_Dist_graph_create_adjacent(comm,nrootranks-ndrootranks,rootranks+ndrootranks,nrootranks > ndrootranks ? dat->rootcounts : MPI_WEIGHTS_EMPTY,nleafranks-ndleafranks,leafranks+ndleafranks,nleafranks > ndleafranks ? dat->leafcounts : MPI_WEIGHTS_EMPTY,MPI_INFO_NULL,0,&dat->distcomm[PETSCSF_BASIC_LEAF2ROOT]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode   ierr;
+  PetscInt         i;
+
+  PetscFunctionBegin;
+  for (i=0; i<2; i++) {
+    if (dat->distcomm[i] != MPI_COMM_NULL) {ierr = MPI_Comm_free(&dat->distcomm[i]);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree4(dat->rootcounts,dat->rootdispls,dat->leafcounts,dat->leafdispls);CHKERRQ(ierr);
+  ierr = PetscSFReset_Basic(sf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFDestroy_Neighbor(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReset_Neighbor(sf);CHKERRQ(ierr);
+  ierr = PetscFree(sf->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscSFNeighborStart - Starts the exchange of the root and leaf buffers of non-distinguished ranks in the given direction
+*/
+static PetscErrorCode PetscSFNeighborStart(PetscSF sf,PetscSFBasicPack link,PetscSFBasicDirection dir)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+  PetscErrorCode   ierr;
+  PetscInt         ndrootranks;
+  const PetscInt   *rootoffset;
+  char             *rootbuf;
+
+  PetscFunctionBegin;
+  ierr    = PetscSFBasicGetRootInfo(sf,NULL,&ndrootranks,NULL,&rootoffset,NULL);CHKERRQ(ierr);
+  rootbuf = link->rootpack + rootoffset[ndrootranks]*link->unitbytes;
+  if (dir == PETSCSF_BASIC_ROOT2LEAF) {
+    ierr = MPI_Ineighbor_alltoallv(rootbuf,dat->rootcounts,dat->rootdispls,link->unit,link->leafpack,dat->leafcounts,dat->leafdispls,link->unit,dat->distcomm[dir],&link->request);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Ineighbor_alltoallv(link->leafpack,dat->leafcounts,dat->leafdispls,link->unit,rootbuf,dat->rootcounts,dat->rootdispls,link->unit,dat->distcomm[dir],&link->request);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nrootranks;
+  const PetscInt   *rootoffset,*rootloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) {
+    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    (*link->Pack)(n,link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
+  }
+  ierr = PetscSFNeighborStart(sf,link,PETSCSF_BASIC_ROOT2LEAF);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Neighbor(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nleafranks;
+  const PetscInt   *leafoffset,*leafloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+    (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafdata,link->leaf[i]);
+  }
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Neighbor(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nleafranks;
+  const PetscInt   *leafoffset,*leafloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+    (*link->Pack)(n,link->bs,leafloc+leafoffset[i],leafdata,link->leaf[i]);
+  }
+  ierr = PetscSFNeighborStart(sf,link,PETSCSF_BASIC_LEAF2ROOT);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Neighbor(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicUnpackReduce(sf,link,unit,rootdata,op);CHKERRQ(ierr);
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFFetchAndOpBegin_Neighbor(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReduceBegin_Neighbor(sf,unit,leafdata,rootdata,op);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFFetchAndOpEnd_Neighbor(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+{
+  void             (*FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscInt         i,nrootranks,nleafranks;
+  const PetscInt   *rootoffset,*leafoffset,*rootloc,*leafloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackGetFetchAndOp(sf,link,op,&FetchAndOp);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) {
+    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
+  }
+  /* Return the fetched values to the leaves */
+  ierr = PetscSFNeighborStart(sf,link,PETSCSF_BASIC_ROOT2LEAF);CHKERRQ(ierr);
+  ierr = MPI_Wait(&link->request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+    (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafupdate,link->leaf[i]);
+  }
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
+{
+  PetscSF_Neighbor *dat;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  sf->ops->SetUp           = PetscSFSetUp_Neighbor;
+  sf->ops->Reset           = PetscSFReset_Neighbor;
+  sf->ops->Destroy         = PetscSFDestroy_Neighbor;
+  sf->ops->View            = PetscSFView_Basic;
+  sf->ops->BcastBegin      = PetscSFBcastBegin_Neighbor;
+  sf->ops->BcastEnd        = PetscSFBcastEnd_Neighbor;
+  sf->ops->ReduceBegin     = PetscSFReduceBegin_Neighbor;
+  sf->ops->ReduceEnd       = PetscSFReduceEnd_Neighbor;
+  sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Neighbor;
+  sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Neighbor;
+
+  ierr = PetscNewLog(sf,&dat);CHKERRQ(ierr);
+  dat->distcomm[PETSCSF_BASIC_ROOT2LEAF] = MPI_COMM_NULL;
+  dat->distcomm[PETSCSF_BASIC_LEAF2ROOT] = MPI_COMM_NULL;
+  sf->data = (void*)dat;
+  PetscFunctionReturn(0);
+}
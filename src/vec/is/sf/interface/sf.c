@@ -107,7 +107,8 @@ PetscErrorCode PetscSFReset(PetscSF sf)
    Notes:
    See "include/petscsf.h" for available methods (for instance)
 +    PETSCSFWINDOW - MPI-2/3 one-sided
--    PETSCSFBASIC - basic implementation using MPI-1 two-sided
+.    PETSCSFBASIC - basic implementation using MPI-1 two-sided
+-    PETSCSFNEIGHBOR - MPI-3 neighborhood collectives
 
   Level: intermediate
 
@@ -175,6 +175,17 @@ int main(int argc,char **argv)
       nsize: 2
       output_file: output/ex1_1.out
 
+   test:
+      suffix: threads
+      args: -vec_threads 3 -vec_threads_min_size 1
+      output_file: output/ex1_1.out
+
+   test:
+      suffix: threads_2
+      nsize: 2
+      args: -vec_threads 3 -vec_threads_min_size 1
+      output_file: output/ex1_1.out
+
    test:
       suffix: 2_cuda
       nsize: 2
@@ -54,4 +54,18 @@ PETSC_INTERN PetscErrorCode VecPointwiseDivide_Seq(Vec,Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec);
 PETSC_INTERN PetscErrorCode VecCreate_Seq_Private(Vec,const PetscScalar[]);
 
+/* thread-parallel kernels, see dvecthreads.c */
+PETSC_INTERN PetscInt VecSeqNumThreads;
+PETSC_INTERN PetscInt VecSeqThreadsMinSize;
+#define VecSeqUseThreads(n) (VecSeqNumThreads > 1 && (n) >= VecSeqThreadsMinSize)
+PETSC_INTERN PetscErrorCode VecSeqThreadsZero_Private(PetscScalar*,PetscInt);
+PETSC_INTERN PetscErrorCode VecSet_Seq_Threads(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecAXPY_Seq_Threads(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecMAXPY_Seq_Threads(Vec,PetscInt,const PetscScalar*,Vec*);
+PETSC_INTERN PetscErrorCode VecDot_Seq_Threads(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMDot_Seq_Threads(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMTDot_Seq_Threads(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecNorm_Seq_Threads(Vec,NormType,PetscReal*);
+PETSC_INTERN PetscErrorCode VecNormLocal_Seq_Threads(Vec,NormType,PetscReal*);
+
 #endif
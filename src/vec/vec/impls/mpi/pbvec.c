@@ -499,7 +499,7 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
     PetscInt n = v->map->n+nghost;
     ierr               = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
     ierr               = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
-    ierr               = PetscMemzero(s->array,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr               = VecSeqThreadsZero_Private(s->array,n);CHKERRQ(ierr);
     s->array_allocated = s->array;
   }
 
@@ -527,7 +527,9 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
    VECMPI - VECMPI = "mpi" - The basic parallel vector
 
    Options Database Keys:
-. -vec_type mpi - sets the vector type to VECMPI during a call to VecSetFromOptions()
++ -vec_type mpi - sets the vector type to VECMPI during a call to VecSetFromOptions()
+. -vec_threads <nt> - number of OpenMP threads used by VecAXPY(), VecMAXPY(), VecDot(), VecMDot(), VecNorm() and VecSet() (PETSC_DECIDE uses all available threads)
+- -vec_threads_min_size <n> - local length below which the vector kernels run on a single thread
 
   Level: beginner
 
@@ -51,12 +51,17 @@ PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
   if (type == NORM_2 || type == NORM_FROBENIUS) {
-    ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
-    work = PetscRealPart(BLASdot_(&bn,xx,&one,xx,&one));
-    ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+    /* Find the local sum of squares */
+    if (VecSeqUseThreads(n)) {
+      ierr = VecNormLocal_Seq_Threads(xin,NORM_2,&work);CHKERRQ(ierr);
+    } else {
+      ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+      work = PetscRealPart(BLASdot_(&bn,xx,&one,xx,&one));
+      ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+      ierr = PetscLogFlops(2.0*xin->map->n);CHKERRQ(ierr);
+    }
     ierr = MPIU_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
     *z   = PetscSqrtReal(sum);
-    ierr = PetscLogFlops(2.0*xin->map->n);CHKERRQ(ierr);
   } else if (type == NORM_1) {
     /* Find the local part */
     ierr = VecNorm_Seq(xin,NORM_1,&work);CHKERRQ(ierr);
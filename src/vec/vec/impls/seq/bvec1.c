@@ -14,6 +14,10 @@ PetscErrorCode VecDot_Seq(Vec xin,Vec yin,PetscScalar *z)
   PetscErrorCode    ierr;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(xin->map->n)) {
+    ierr = VecDot_Seq_Threads(xin,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscBLASIntCast(xin->map->n,&bn);CHKERRQ(ierr);
   ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
@@ -75,7 +79,9 @@ PetscErrorCode VecAXPY_Seq(Vec yin,PetscScalar alpha,Vec xin)
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(yin->map->n,&bn);CHKERRQ(ierr);
   /* assume that the BLAS handles alpha == 1.0 efficiently since we have no fast code for it */
-  if (alpha != (PetscScalar)0.0) {
+  if (alpha != (PetscScalar)0.0 && VecSeqUseThreads(yin->map->n)) {
+    ierr = VecAXPY_Seq_Threads(yin,alpha,xin);CHKERRQ(ierr);
+  } else if (alpha != (PetscScalar)0.0) {
     ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
     ierr = VecGetArray(yin,&yarray);CHKERRQ(ierr);
     PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&bn,&alpha,xarray,&one,yarray,&one));
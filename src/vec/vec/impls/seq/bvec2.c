@@ -219,6 +219,10 @@ PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
   PetscBLASInt      one = 1, bn;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(n)) {
+    ierr = VecNorm_Seq_Threads(xin,type,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
   if (type == NORM_2 || type == NORM_FROBENIUS) {
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
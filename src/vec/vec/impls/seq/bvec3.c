@@ -8,7 +8,9 @@
    VECSEQ - VECSEQ = "seq" - The basic sequential vector
 
    Options Database Keys:
-. -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
++ -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
+. -vec_threads <nt> - number of OpenMP threads used by VecAXPY(), VecMAXPY(), VecDot(), VecMDot(), VecNorm() and VecSet() (PETSC_DECIDE uses all available threads)
+- -vec_threads_min_size <n> - local length below which the vector kernels run on a single thread
 
   Level: beginner
 
@@ -19,6 +19,10 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(xin->map->n)) {
+    ierr = VecMDot_Seq_Threads(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   sum0 = 0.0;
   sum1 = 0.0;
   sum2 = 0.0;
@@ -100,6 +104,10 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(n)) {
+    ierr = VecMDot_Seq_Threads(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   sum0 = 0.;
   sum1 = 0.;
   sum2 = 0.;
@@ -300,6 +308,10 @@ PetscErrorCode VecMTDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(n)) {
+    ierr = VecMTDot_Seq_Threads(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   sum0 = 0.;
   sum1 = 0.;
   sum2 = 0.;
@@ -543,6 +555,10 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(n)) {
+    ierr = VecSet_Seq_Threads(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   if (alpha == (PetscScalar)0.0) {
     ierr = PetscMemzero(xx,n*sizeof(PetscScalar));CHKERRQ(ierr);
@@ -565,6 +581,10 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
 #endif
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads(n)) {
+    ierr = VecMAXPY_Seq_Threads(xin,nv,alpha,y);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   switch (j_rem=nv&0x3) {
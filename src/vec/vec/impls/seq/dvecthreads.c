@@ -0,0 +1,334 @@
+/*
+    OpenMP thread-parallel versions of the sequential vector kernels most used by the Krylov
+  methods; they are also used for the local part of VECMPI vectors.
+
+    A vector of length n is always split the same way, into nthreads contiguous chunks whose
+  boundaries are multiples of VEC_SEQ_THREADS_ALIGN entries, and chunk t is always handled by
+  thread t (a static schedule with chunk size one). Since VecCreate_Seq() and VecCreate_MPI()
+  zero their arrays with the same split, each page is first touched by the thread that later
+  works on it. Reductions compute one partial result per chunk and add the partial results in
+  chunk order, so the results are identical from run to run with the same number of threads.
+*/
+#include <../src/vec/vec/impls/dvecimpl.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#define VEC_SEQ_THREADS_ALIGN 512
+
+PetscInt VecSeqNumThreads     = 1;
+PetscInt VecSeqThreadsMinSize = 10000;
+
+PETSC_STATIC_INLINE void VecSeqThreadsGetRange_Private(PetscInt n,PetscInt nt,PetscInt t,PetscInt *start,PetscInt *end)
+{
+  PetscInt64 s = ((PetscInt64)n*t)/nt,e = ((PetscInt64)n*(t+1))/nt;
+
+  s      = ((s + VEC_SEQ_THREADS_ALIGN - 1)/VEC_SEQ_THREADS_ALIGN)*VEC_SEQ_THREADS_ALIGN;
+  e      = (t == nt-1) ? n : ((e + VEC_SEQ_THREADS_ALIGN - 1)/VEC_SEQ_THREADS_ALIGN)*VEC_SEQ_THREADS_ALIGN;
+  *start = (PetscInt)PetscMin(s,n);
+  *end   = (PetscInt)PetscMin(e,n);
+}
+
+/*
+   VecSeqThreadsInitialize_Private - Processes -vec_threads and -vec_threads_min_size, called from VecInitializePackage()
+*/
+PetscErrorCode VecSeqThreadsInitialize_Private(void)
+{
+  PetscErrorCode ierr;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-vec_threads",&VecSeqNumThreads,&flg);CHKERRQ(ierr);
+  if (flg && (VecSeqNumThreads == PETSC_DECIDE || VecSeqNumThreads == PETSC_DEFAULT)) {
+#if defined(PETSC_HAVE_OPENMP)
+    VecSeqNumThreads = omp_get_max_threads();
+#else
+    VecSeqNumThreads = 1;
+#endif
+  }
+  if (VecSeqNumThreads < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"-vec_threads %D must be positive",VecSeqNumThreads);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-vec_threads_min_size",&VecSeqThreadsMinSize,NULL);CHKERRQ(ierr);
+#if !defined(PETSC_HAVE_OPENMP)
+  if (VecSeqNumThreads > 1) {
+    ierr = PetscInfo1(NULL,"PETSc was not configured with OpenMP, the %D vector chunks are processed sequentially\n",VecSeqNumThreads);CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecSeqThreadsZero_Private - Zeros a newly allocated array with the same split as the kernels so its pages are first touched by the threads that use them
+*/
+PetscErrorCode VecSeqThreadsZero_Private(PetscScalar *x,PetscInt n)
+{
+  PetscInt       nt = VecSeqNumThreads,t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecSeqUseThreads(n)) {
+    ierr = PetscMemzero(x,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt i,start,end;
+
+    VecSeqThreadsGetRange_Private(n,nt,t,&start,&end);
+    for (i=start; i<end; i++) x[i] = 0.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSet_Seq_Threads(Vec xin,PetscScalar alpha)
+{
+  PetscInt       n = xin->map->n,nt = VecSeqNumThreads,t;
+  PetscScalar    *xx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt i,start,end;
+
+    VecSeqThreadsGetRange_Private(n,nt,t,&start,&end);
+    for (i=start; i<end; i++) xx[i] = alpha;
+  }
+  ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPY_Seq_Threads(Vec yin,PetscScalar alpha,Vec xin)
+{
+  PetscInt          n = yin->map->n,nt = VecSeqNumThreads,t;
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt i,start,end;
+
+    VecSeqThreadsGetRange_Private(n,nt,t,&start,&end);
+    for (i=start; i<end; i++) yy[i] += alpha*xx[i];
+  }
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPY_Seq_Threads(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *y)
+{
+  PetscInt          n = xin->map->n,nt = VecSeqNumThreads,t,j;
+  const PetscScalar **yy;
+  PetscScalar       *xx;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nv,&yy);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(y[j],&yy[j]);CHKERRQ(ierr);}
+  ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt          i,k,start,end;
+    const PetscScalar *y0,*y1,*y2,*y3;
+    PetscScalar       a0,a1,a2,a3;
+
+    VecSeqThreadsGetRange_Private(n,nt,t,&start,&end);
+    /* update with four vectors at a time so x[] is streamed once per four vectors */
+    for (k=0; k+3<nv; k+=4) {
+      y0 = yy[k]; y1 = yy[k+1]; y2 = yy[k+2]; y3 = yy[k+3];
+      a0 = alpha[k]; a1 = alpha[k+1]; a2 = alpha[k+2]; a3 = alpha[k+3];
+      for (i=start; i<end; i++) xx[i] += a0*y0[i] + a1*y1[i] + a2*y2[i] + a3*y3[i];
+    }
+    switch (nv-k) {
+    case 3:
+      y0 = yy[k]; y1 = yy[k+1]; y2 = yy[k+2];
+      a0 = alpha[k]; a1 = alpha[k+1]; a2 = alpha[k+2];
+      for (i=start; i<end; i++) xx[i] += a0*y0[i] + a1*y1[i] + a2*y2[i];
+      break;
+    case 2:
+      y0 = yy[k]; y1 = yy[k+1];
+      a0 = alpha[k]; a1 = alpha[k+1];
+      for (i=start; i<end; i++) xx[i] += a0*y0[i] + a1*y1[i];
+      break;
+    case 1:
+      y0 = yy[k];
+      a0 = alpha[k];
+      for (i=start; i<end; i++) xx[i] += a0*y0[i];
+      break;
+    }
+  }
+  ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(y[j],&yy[j]);CHKERRQ(ierr);}
+  ierr = PetscFree(yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes z[j] = y[j]^H x (or y[j]^T x when conj is false) with one partial sum per chunk and vector,
+   the partial sums are then added in chunk order
+*/
+static PetscErrorCode VecMXDot_Seq_Threads_Private(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z,PetscBool conj)
+{
+  PetscInt          n = xin->map->n,nt = VecSeqNumThreads,t,j;
+  const PetscScalar **yy,*xx;
+  PetscScalar       *part;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc2(nv,&yy,nt*nv,&part);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(yin[j],&yy[j]);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt          i,k,start,end;
+    const PetscScalar *y0,*y1,*y2,*y3;
+    PetscScalar       s0,s1,s2,s3,xi,*p = part + t*nv;
+
+    VecSeqThreadsGetRange_Private(n,nt,t,&start,&end);
+    /* four vectors at a time so x[] is streamed once per four vectors */
+    for (k=0; k+3<nv; k+=4) {
+      y0 = yy[k]; y1 = yy[k+1]; y2 = yy[k+2]; y3 = yy[k+3];
+      s0 = s1 = s2 = s3 = 0.0;
+      if (conj) {
+        for (i=start; i<end; i++) {
+          xi  = xx[i];
+          s0 += xi*PetscConj(y0[i]); s1 += xi*PetscConj(y1[i]);
+          s2 += xi*PetscConj(y2[i]); s3 += xi*PetscConj(y3[i]);
+        }
+      } else {
+        for (i=start; i<end; i++) {
+          xi  = xx[i];
+          s0 += xi*y0[i]; s1 += xi*y1[i]; s2 += xi*y2[i]; s3 += xi*y3[i];
+        }
+      }
+      p[k] = s0; p[k+1] = s1; p[k+2] = s2; p[k+3] = s3;
+    }
+    for (; k<nv; k++) {
+      y0 = yy[k];
+      s0 = 0.0;
+      if (conj) {for (i=start; i<end; i++) s0 += xx[i]*PetscConj(y0[i]);}
+      else      {for (i=start; i<end; i++) s0 += xx[i]*y0[i];}
+      p[k] = s0;
+    }
+  }
+  for (j=0; j<nv; j++) {
+    z[j] = 0.0;
+    for (t=0; t<nt; t++) z[j] += part[t*nv+j];
+  }
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(yin[j],&yy[j]);CHKERRQ(ierr);}
+  ierr = PetscFree2(yy,part);CHKERRQ(ierr);
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMDot_Seq_Threads(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMXDot_Seq_Threads_Private(xin,nv,yin,z,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMTDot_Seq_Threads(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMXDot_Seq_Threads_Private(xin,nv,yin,z,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDot_Seq_Threads(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMXDot_Seq_Threads_Private(xin,1,&yin,z,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* For NORM_2 the sum of the squares is returned, so that VecNorm_MPI() can sum it over the processes */
+PetscErrorCode VecNormLocal_Seq_Threads(Vec xin,NormType type,PetscReal *z)
+{
+  PetscInt          n = xin->map->n,nt = VecSeqNumThreads,t;
+  const PetscScalar *xx;
+  PetscReal         *part;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nt,&part);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt  i,start,end;
+    PetscReal s = 0.0,tmp;
+
+    VecSeqThreadsGetRange_Private(n,nt,t,&start,&end);
+    if (type == NORM_2 || type == NORM_FROBENIUS) {
+      for (i=start; i<end; i++) s += PetscRealPart(xx[i]*PetscConj(xx[i]));
+    } else if (type == NORM_1) {
+      for (i=start; i<end; i++) s += PetscAbsScalar(xx[i]);
+    } else {
+      for (i=start; i<end; i++) {
+        tmp = PetscAbsScalar(xx[i]);
+        if (tmp > s) s = tmp;
+        /* check special case of tmp == NaN */
+        if (tmp != tmp) {s = tmp; break;}
+      }
+    }
+    part[t] = s;
+  }
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  *z = 0.0;
+  if (type == NORM_INFINITY) {
+    for (t=0; t<nt; t++) {
+      if (part[t] > *z || part[t] != part[t]) *z = part[t];
+      if (part[t] != part[t]) break;
+    }
+  } else {
+    for (t=0; t<nt; t++) *z += part[t];
+  }
+  ierr = PetscFree(part);CHKERRQ(ierr);
+  if (type == NORM_2 || type == NORM_FROBENIUS) {
+    ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  } else if (type == NORM_1) {
+    ierr = PetscLogFlops(PetscMax(n-1.0,0.0));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecNorm_Seq_Threads(Vec xin,NormType type,PetscReal *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (type == NORM_1_AND_2) {
+    ierr = VecNorm_Seq_Threads(xin,NORM_1,z);CHKERRQ(ierr);
+    ierr = VecNorm_Seq_Threads(xin,NORM_2,z+1);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecNormLocal_Seq_Threads(xin,type,z);CHKERRQ(ierr);
+  if (type == NORM_2 || type == NORM_FROBENIUS) *z = PetscSqrtReal(*z);
+  PetscFunctionReturn(0);
+}
@@ -234,6 +234,9 @@ PetscErrorCode  VecInitializePackage(void)
     if (pkg) {ierr = PetscLogEventExcludeClass(VEC_SCATTER_CLASSID);CHKERRQ(ierr);}
   }
 
+  /* Number of threads used by the sequential vector kernels */
+  ierr = VecSeqThreadsInitialize_Private();CHKERRQ(ierr);
+
   /*
     Create the special MPI reduction operation that may be used by VecNorm/DotBegin()
   */
@@ -169,4 +169,11 @@ int main(int argc,char **argv)
       # implemented message logging for them. Add this test to just test mpi3 vecscatter type works.
       filter: grep -v "VecScatter(bs="
       requires: double define(PETSC_USE_LOG) define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
+
+   test:
+      suffix: runs
+      nsize: 4
+      args: -vecscatter_run_min_bytes 0
+      output_file: output/ex4_1.out
+      requires: double define(PETSC_USE_LOG)
 TEST*/
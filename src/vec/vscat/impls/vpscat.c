@@ -276,6 +276,8 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI3(VecScatter ctx)
   ierr = PetscFree4(to->values,to->indices,to->starts,to->procs);CHKERRQ(ierr);
   ierr = PetscFree2(to->sstatus,to->rstatus);CHKERRQ(ierr);
   ierr = PetscFree4(from->values,from->indices,from->starts,from->procs);CHKERRQ(ierr);
+  ierr = VecScatterDestroyRuns_Private(to);CHKERRQ(ierr);
+  ierr = VecScatterDestroyRuns_Private(from);CHKERRQ(ierr);
   ierr = PetscFree(from);CHKERRQ(ierr);
   ierr = PetscFree(to);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -470,6 +472,8 @@ PetscErrorCode VecScatterCopy_PtoP_X(VecScatter in,VecScatter out)
     PetscMPIInt disp_unit;
     ierr = MPIU_Win_shared_query(out_to->sharedwin,jj,&isize,&disp_unit,&out_from->sharedspaces[jj]);CHKERRQ(ierr);
   }
+  ierr = VecScatterCreateRuns_Private(out,out_to);CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(out,out_from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -567,6 +571,8 @@ PetscErrorCode VecScatterCopy_PtoP_AllToAll(VecScatter in,VecScatter out)
   ierr = PetscMalloc2(size,&out_from->counts,size,&out_from->displs);CHKERRQ(ierr);
   ierr = PetscMemcpy(out_from->counts,in_from->counts,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
   ierr = PetscMemcpy(out_from->displs,in_from->displs,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(out,out_to);CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(out,out_from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 /* --------------------------------------------------------------------------------------------------
@@ -2952,6 +2958,10 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI3(VecScatter_MPI_General *from,Vec
   if (to->local.n) {
     ierr = VecScatterLocalOptimizeCopy_Private(ctx,&to->local,&from->local,bs);CHKERRQ(ierr);
   }
+
+  /* Check if the messages are made of long runs of consecutive entries */
+  ierr = VecScatterCreateRuns_Private(ctx,to);CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(ctx,from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -184,6 +184,8 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
   ierr = PetscFree4(to->values,to->indices,to->starts,to->procs);CHKERRQ(ierr);
   ierr = PetscFree2(to->sstatus,to->rstatus);CHKERRQ(ierr);
   ierr = PetscFree4(from->values,from->indices,from->starts,from->procs);CHKERRQ(ierr);
+  ierr = VecScatterDestroyRuns_Private(to);CHKERRQ(ierr);
+  ierr = VecScatterDestroyRuns_Private(from);CHKERRQ(ierr);
   ierr = PetscFree(from);CHKERRQ(ierr);
   ierr = PetscFree(to);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -257,6 +259,125 @@ PetscErrorCode VecScatterLocalOptimizeCopy_Private(VecScatter scatter,VecScatter
   PetscFunctionReturn(0);
 }
 
+/* --------------------------------------------------------------------------------------*/
+/*
+    Run-length encoding of the indices of the messages. Consecutive blocks of a message that are also consecutive in the
+    vector form a run, which is packed and unpacked with PetscMemcpy() or a unit stride loop instead of indexed accesses.
+*/
+PetscErrorCode VecScatterCreateRuns_Private(VecScatter scatter,VecScatter_MPI_General *gen)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,r,nruns = 0,n = gen->starts[gen->n],bs = gen->bs,minbytes = 64;
+
+  PetscFunctionBegin;
+  ierr = VecScatterDestroyRuns_Private(gen);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-vecscatter_run_min_bytes",&minbytes,NULL);CHKERRQ(ierr);
+  if (!n || minbytes < 0) PetscFunctionReturn(0);
+  for (i=0; i<gen->n; i++) {
+    for (j=gen->starts[i]; j<gen->starts[i+1]; j++) {
+      if (j == gen->starts[i] || gen->indices[j] != gen->indices[j-1] + bs) nruns++;
+    }
+  }
+  /* only worth it if the average run is long enough for PetscMemcpy() to beat indexed loads and stores */
+  if ((PetscInt)(bs*n*sizeof(PetscScalar)/nruns) < minbytes) PetscFunctionReturn(0);
+
+  ierr = PetscMalloc3(gen->n+1,&gen->runstarts,nruns,&gen->runpos,nruns,&gen->runlen);CHKERRQ(ierr);
+  r    = 0;
+  for (i=0; i<gen->n; i++) {
+    gen->runstarts[i] = r;
+    for (j=gen->starts[i]; j<gen->starts[i+1]; j++) {
+      if (j == gen->starts[i] || gen->indices[j] != gen->indices[j-1] + bs) {
+        gen->runpos[r] = j;
+        gen->runlen[r] = 0;
+        r++;
+      }
+      gen->runlen[r-1]++;
+    }
+  }
+  gen->runstarts[gen->n] = r;
+  ierr = PetscInfo3(scatter,"Messages with %D entries of block size %D are made of %D runs, packing them with memcpy\n",n,bs,nruns);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScatterDestroyRuns_Private(VecScatter_MPI_General *gen)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(gen->runstarts,gen->runpos,gen->runlen);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    VecScatterPackRuns_Private - Packs the entries of x for messages first to last-1 into the message buffer y
+
+    Runs write disjoint parts of y, so large messages are packed with -vec_threads threads.
+*/
+PetscErrorCode VecScatterPackRuns_Private(VecScatter_MPI_General *gen,PetscInt first,PetscInt last,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt       r,rstart = gen->runstarts[first],rend = gen->runstarts[last],bs = gen->bs;
+  const PetscInt *runpos = gen->runpos,*runlen = gen->runlen,*indices = gen->indices;
+
+  PetscFunctionBegin;
+  if (VecSeqUseThreads(bs*(gen->starts[last]-gen->starts[first]))) {
+#if defined(PETSC_HAVE_OPENMP)
+    PetscInt nt = VecSeqNumThreads;
+#pragma omp parallel for num_threads(nt) schedule(static)
+#endif
+    for (r=rstart; r<rend; r++) {
+      memcpy(y+bs*runpos[r],x+indices[runpos[r]],bs*runlen[r]*sizeof(PetscScalar)); /* PetscMemcpy() is not thread safe in debug mode */
+    }
+  } else {
+    PetscErrorCode ierr;
+    for (r=rstart; r<rend; r++) {
+      ierr = PetscMemcpy(y+bs*runpos[r],x+indices[runpos[r]],bs*runlen[r]*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+    VecScatterUnPackRuns_Private - Unpacks the message buffer x of messages first to last-1 into y
+
+    Runs of different messages may overlap in y with ADD_VALUES, so this is not threaded.
+*/
+PetscErrorCode VecScatterUnPackRuns_Private(VecScatter_MPI_General *gen,PetscInt first,PetscInt last,const PetscScalar *x,PetscScalar *y,InsertMode addv)
+{
+  PetscErrorCode ierr;
+  PetscInt       r,j,n,rstart = gen->runstarts[first],rend = gen->runstarts[last],bs = gen->bs;
+  PetscScalar    *yr;
+  const PetscScalar *xr;
+
+  PetscFunctionBegin;
+  for (r=rstart; r<rend; r++) {
+    n  = bs*gen->runlen[r];
+    xr = x + bs*gen->runpos[r];
+    yr = y + gen->indices[gen->runpos[r]];
+    switch (addv) {
+    case INSERT_VALUES:
+    case INSERT_ALL_VALUES:
+      ierr = PetscMemcpy(yr,xr,n*sizeof(PetscScalar));CHKERRQ(ierr);
+      break;
+    case ADD_VALUES:
+    case ADD_ALL_VALUES:
+      for (j=0; j<n; j++) yr[j] += xr[j];
+      break;
+#if !defined(PETSC_USE_COMPLEX)
+    case MAX_VALUES:
+      for (j=0; j<n; j++) yr[j] = PetscMax(yr[j],xr[j]);
+      break;
+#else
+    case MAX_VALUES:
+#endif
+    case NOT_SET_VALUES:
+      break;
+    default:
+      SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Cannot handle insert mode %d", addv);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /* --------------------------------------------------------------------------------------*/
 
 PetscErrorCode VecScatterCopy_PtoP_X_MPI1(VecScatter in,VecScatter out)
@@ -401,6 +522,8 @@ PetscErrorCode VecScatterCopy_PtoP_X_MPI1(VecScatter in,VecScatter out)
       ierr = MPI_Recv_init(Ssvalues+bs*sstarts[i],bs*sstarts[i+1]-bs*sstarts[i],MPIU_SCALAR,sprocs[i],tag,comm,rev_rwaits+i);CHKERRQ(ierr);
     }
   }
+  ierr = VecScatterCreateRuns_Private(out,out_to);CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(out,out_from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -496,6 +619,8 @@ PetscErrorCode VecScatterCopy_PtoP_AllToAll_MPI1(VecScatter in,VecScatter out)
   ierr = PetscMalloc2(size,&out_from->counts,size,&out_from->displs);CHKERRQ(ierr);
   ierr = PetscMemcpy(out_from->counts,in_from->counts,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
   ierr = PetscMemcpy(out_from->displs,in_from->displs,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(out,out_to);CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(out,out_from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 /* --------------------------------------------------------------------------------------------------
@@ -2150,6 +2275,68 @@ PETSC_STATIC_INLINE PetscErrorCode Scatter_MPI1_bs(PetscInt n,const PetscInt *in
 #define BS bs
 #include <../src/vec/vscat/impls/vpscat_mpi1.h>
 
+/*
+   VecScatterEndByMessageSupported_Private - Determines if VecScatterEndByMessage_Private() can be used with this scatter,
+   that is, if it is an MPI1 scatter with block size 1 where each message is received with its own request that is still
+   pending when VecScatterEnd() is called (with -vecscatter_merge the messages are already completed in VecScatterBegin())
+*/
+PetscErrorCode VecScatterEndByMessageSupported_Private(VecScatter ctx,PetscBool *flg)
+{
+  VecScatter_MPI_General *to,*from;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  if (ctx->ops->end != VecScatterEndMPI1_1) PetscFunctionReturn(0);
+  to   = (VecScatter_MPI_General*)ctx->todata;
+  from = (VecScatter_MPI_General*)ctx->fromdata;
+  if (ctx->beginandendtogether || ctx->packtogether || to->use_alltoallv || to->use_window || from->use_readyreceiver) PetscFunctionReturn(0);
+  *flg = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecScatterEndByMessage_Private - Replaces VecScatterEnd() for a forward INSERT_VALUES scatter, calling f(fctx,i,y) as
+   soon as the i-th message of the fromdata has been unpacked into the array y, so that the caller can use the entries it
+   carries while the other messages are still in flight
+
+   Only valid if VecScatterEndByMessageSupported_Private() returned PETSC_TRUE
+*/
+PetscErrorCode VecScatterEndByMessage_Private(VecScatter ctx,Vec xin,Vec yin,PetscErrorCode (*f)(void*,PetscInt,const PetscScalar*),void *fctx)
+{
+  VecScatter_MPI_General *to   = (VecScatter_MPI_General*)ctx->todata;
+  VecScatter_MPI_General *from = (VecScatter_MPI_General*)ctx->fromdata;
+  PetscScalar            *yv;
+  PetscErrorCode         ierr;
+  PetscInt               count,*rstarts = from->starts;
+  PetscMPIInt            imdex;
+  MPI_Status             xrstatus;
+
+  PetscFunctionBegin;
+  ctx->inuse = PETSC_FALSE;
+  ierr = VecGetArray(yin,&yv);CHKERRQ(ierr);
+  for (count=from->n; count; count--) {
+    ierr = PetscLogEventBegin(VEC_ScatterEnd,ctx,xin,yin,0);CHKERRQ(ierr);
+    if (ctx->reproduce) {
+      imdex = count - 1;
+      ierr  = MPI_Wait(from->requests+imdex,&xrstatus);CHKERRQ(ierr);
+    } else {
+      ierr = MPI_Waitany(from->n,from->requests,&imdex,&xrstatus);CHKERRQ(ierr);
+      if (imdex == MPI_UNDEFINED) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"No pending receive left although not all messages were unpacked");
+    }
+    if (from->runstarts) {ierr = VecScatterUnPackRuns_Private(from,imdex,imdex+1,from->values,yv,INSERT_VALUES);CHKERRQ(ierr);}
+    else {ierr = UnPack_MPI1_1(rstarts[imdex+1] - rstarts[imdex],from->values + rstarts[imdex],from->indices + rstarts[imdex],yv,INSERT_VALUES,1);CHKERRQ(ierr);}
+    ierr = PetscLogEventEnd(VEC_ScatterEnd,ctx,xin,yin,0);CHKERRQ(ierr);
+    ierr = (*f)(fctx,imdex,yv);CHKERRQ(ierr);
+  }
+  if (to->n) {
+    ierr = PetscLogEventBegin(VEC_ScatterEnd,ctx,xin,yin,0);CHKERRQ(ierr);
+    ierr = MPI_Waitall(to->n,to->requests,to->sstatus);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ScatterEnd,ctx,xin,yin,0);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(yin,&yv);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* ==========================================================================================*/
 
 /*              create parallel to sequential scatter context                           */
@@ -2638,6 +2825,10 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI1(VecScatter_MPI_General *from,Vec
   if (to->local.n) {
     ierr = VecScatterLocalOptimizeCopy_Private(ctx,&to->local,&from->local,bs);CHKERRQ(ierr);
   }
+
+  /* Check if the messages are made of long runs of consecutive entries */
+  ierr = VecScatterCreateRuns_Private(ctx,to);CHKERRQ(ierr);
+  ierr = VecScatterCreateRuns_Private(ctx,from);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 